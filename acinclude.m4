@@ -41,16 +41,20 @@ AC_REQUIRE([MPFR_CHECK_LIBM])
 AC_REQUIRE([MPFR_CHECK_LIBQUADMATH])
 AC_REQUIRE([AC_CANONICAL_HOST])
 
-dnl Features for the MPFR shared cache. This needs to be done
-dnl quite early since this may change CC, CFLAGS and LIBS, which
-dnl may affect the other tests.
+dnl Features for the MPFR shared cache and the parallel binary splitting.
+dnl This needs to be done quite early since this may change CC, CFLAGS
+dnl and LIBS, which may affect the other tests.
 
-if test "$enable_shared_cache" = yes; then
+if test "$enable_shared_cache" = yes || test "$enable_parallel_bs" = yes; then
 
-dnl Prefer ISO C11 threads (as in mpfr-thread.h).
-  MPFR_CHECK_C11_THREAD()
+dnl Prefer ISO C11 threads (as in mpfr-thread.h) for the shared cache.
+dnl The parallel binary splitting creates threads with pthread_create.
+  if test "$enable_shared_cache" = yes; then
+    MPFR_CHECK_C11_THREAD()
+  fi
 
-  if test "$mpfr_c11_thread_ok" != yes; then
+  if test "$mpfr_c11_thread_ok" != yes || test "$enable_parallel_bs" = yes
+  then
 dnl Check for POSIX threads. Since the AX_PTHREAD macro is not standard
 dnl (it is provided by autoconf-archive), we need to detect whether it
 dnl is left unexpanded, otherwise the configure script won't fail and
@@ -93,19 +97,32 @@ pthread_rwlock_t lock; (void) lock;
     fi
   fi
 
-  AC_MSG_CHECKING(if shared cache can be supported)
-  if test "$mpfr_c11_thread_ok" = yes; then
-    AC_MSG_RESULT([yes, with ISO C11 threads])
-  elif test "$mpfr_pthread_ok" = yes; then
-    AC_MSG_RESULT([yes, with pthread])
-  else
-    AC_MSG_RESULT(no)
-    AC_MSG_ERROR([shared cache needs C11 threads or pthread support])
+  if test "$enable_shared_cache" = yes; then
+    AC_MSG_CHECKING(if shared cache can be supported)
+    if test "$mpfr_c11_thread_ok" = yes; then
+      AC_MSG_RESULT([yes, with ISO C11 threads])
+    elif test "$mpfr_pthread_ok" = yes; then
+      AC_MSG_RESULT([yes, with pthread])
+    else
+      AC_MSG_RESULT(no)
+      AC_MSG_ERROR([shared cache needs C11 threads or pthread support])
+    fi
+  fi
+
+  if test "$enable_parallel_bs" = yes; then
+    AC_MSG_CHECKING(if parallel binary splitting can be supported)
+    if test "$mpfr_pthread_ok" = yes; then
+      AC_MSG_RESULT([yes, with pthread])
+    else
+      AC_MSG_RESULT(no)
+      AC_MSG_ERROR([parallel binary splitting needs pthread support])
+    fi
   fi
 
 fi
 
-dnl End of features for the MPFR shared cache.
+dnl End of features for the MPFR shared cache and the parallel binary
+dnl splitting.
 
 AC_CHECK_HEADER([limits.h],, AC_MSG_ERROR([limits.h not found]))
 AC_CHECK_HEADER([float.h],,  AC_MSG_ERROR([float.h not found]))
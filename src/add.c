@@ -104,6 +104,10 @@ mpfr_add (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       if (MPFR_LIKELY(MPFR_PREC(a) == MPFR_PREC(b)
                       && MPFR_PREC(b) == MPFR_PREC(c)))
         return mpfr_sub1sp(a, b, c, rnd_mode);
+#if !defined(MPFR_GENERIC_ABI)
+      else if (MPFR_PREC_LE2_P(a, b, c))
+        return mpfr_sub1sp_mixed(a, b, c, rnd_mode);
+#endif
       else
         return mpfr_sub1(a, b, c, rnd_mode);
     }
@@ -112,6 +116,10 @@ mpfr_add (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       if (MPFR_LIKELY(MPFR_PREC(a) == MPFR_PREC(b)
                       && MPFR_PREC(b) == MPFR_PREC(c)))
         return mpfr_add1sp(a, b, c, rnd_mode);
+#if !defined(MPFR_GENERIC_ABI)
+      else if (MPFR_PREC_LE2_P(a, b, c))
+        return mpfr_add1sp_mixed(a, b, c, rnd_mode);
+#endif
       else
         if (MPFR_GET_EXP(b) < MPFR_GET_EXP(c))
           return mpfr_add1(a, c, b, rnd_mode);
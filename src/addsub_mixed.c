@@ -0,0 +1,96 @@
+/* mpfr_add1sp_mixed, mpfr_sub1sp_mixed -- internal functions to perform
+   a "real" addition or subtraction when the operands do not all have the
+   same precision, but fit in at most 2 limbs
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The special code of mpfr_add1sp and mpfr_sub1sp for 1 and 2 limbs only
+   works when a, b and c have the same precision p. However it only relies
+   on the fact that the significands of b and c have (at most) p bits, so
+   that the low bits of their n limbs are zero. Thus if PREC(b) <= p and
+   PREC(c) <= p with p = PREC(a), we extend b and c to p bits (this is
+   exact and done without any memory allocation, see MPFR_WIDEN_LE2), and
+   use the special code directly. This is the common case of a small input
+   added to an accumulator with a larger precision.
+
+   Otherwise the result has to be rounded to fewer bits than the inputs.
+   Rounding to odd on max(PREC(b), PREC(c)) bits with the special code,
+   followed by a rounding to PREC(a) bits, would avoid double rounding,
+   but the second rounding (done by mpfr_set) costs more than the generic
+   code of mpfr_add1 and mpfr_sub1, which is used in this case.
+
+   The caller must make sure that b and c are regular numbers, and that
+   PREC(a), PREC(b), PREC(c) <= 2 * GMP_NUMB_BITS. */
+
+static int
+mpfr_addsub1sp_mixed (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c,
+                      mpfr_rnd_t rnd_mode, int sub)
+{
+  mpfr_t bb, cc;
+  mp_limb_t bp[2], cp[2];
+  mpfr_prec_t p;
+
+  MPFR_ASSERTD (MPFR_IS_PURE_FP (b));
+  MPFR_ASSERTD (MPFR_IS_PURE_FP (c));
+
+  p = MPFR_GET_PREC (a);
+  MPFR_ASSERTD (p <= 2 * GMP_NUMB_BITS);
+
+  if (MPFR_LIKELY (MPFR_GET_PREC (b) <= p && MPFR_GET_PREC (c) <= p))
+    {
+      /* For MPFR_RNDF, the special code may return the other neighbor
+         than mpfr_add1 and mpfr_sub1 when |c| is tiny compared to |b|
+         (e.g., in mpfr_fma when x*y underflows). Both are correct, but
+         we keep the results of the generic code by rounding to nearest,
+         which costs almost nothing here. */
+      if (rnd_mode == MPFR_RNDF)
+        rnd_mode = MPFR_RNDN;
+      MPFR_WIDEN_LE2 (bb, bp, b, p);
+      MPFR_WIDEN_LE2 (cc, cp, c, p);
+      return sub ? mpfr_sub1sp (a, bb, cc, rnd_mode)
+        : mpfr_add1sp (a, bb, cc, rnd_mode);
+    }
+  else if (sub)
+    return mpfr_sub1 (a, b, c, rnd_mode);
+  else if (MPFR_GET_EXP (b) < MPFR_GET_EXP (c))
+    return mpfr_add1 (a, c, b, rnd_mode);
+  else
+    return mpfr_add1 (a, b, c, rnd_mode);
+}
+
+/* Same as mpfr_add1sp, but PREC(a), PREC(b), PREC(c) may differ and are
+   at most 2 * GMP_NUMB_BITS. */
+int
+mpfr_add1sp_mixed (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c,
+                   mpfr_rnd_t rnd_mode)
+{
+  return mpfr_addsub1sp_mixed (a, b, c, rnd_mode, 0);
+}
+
+/* Same as mpfr_sub1sp, but PREC(a), PREC(b), PREC(c) may differ and are
+   at most 2 * GMP_NUMB_BITS. */
+int
+mpfr_sub1sp_mixed (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c,
+                   mpfr_rnd_t rnd_mode)
+{
+  return mpfr_addsub1sp_mixed (a, b, c, rnd_mode, 1);
+}
@@ -281,8 +281,13 @@ mpfr_atan_aux (mpfr_ptr y, mpz_ptr p, unsigned long r, int m, mpz_t *tab)
   MPFR_SET_EXP (y, expo);
 }
 
-int
-mpfr_atan (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+/* Compute atan(x) with the argument reduction
+   atan(x) = 2 atan((sqrt(1+x^2)-1)/x) and binary splitting, for x regular
+   with |x| <> 1. Must be called in the extended exponent range.
+   Return the ternary value (the result is not checked against the current
+   exponent range). */
+static int
+mpfr_atan_general (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
   mpfr_t xp, arctgt, sk, tmp, tmp2;
   mpz_t  ukz;
@@ -293,73 +298,11 @@ mpfr_atan (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   int comparison, inexact;
   int i, n0, oldn0;
   MPFR_GROUP_DECL (group);
-  MPFR_SAVE_EXPO_DECL (expo);
   MPFR_ZIV_DECL (loop);
 
-  MPFR_LOG_FUNC
-    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
-     ("atan[%Pd]=%.*Rg inexact=%d",
-      mpfr_get_prec (atan), mpfr_log_prec, atan, inexact));
-
-  /* Singular cases */
-  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
-    {
-      if (MPFR_IS_NAN (x))
-        {
-          MPFR_SET_NAN (atan);
-          MPFR_RET_NAN;
-        }
-      else if (MPFR_IS_INF (x))
-        {
-          MPFR_SAVE_EXPO_MARK (expo);
-          if (MPFR_IS_POS (x))  /* arctan(+inf) = Pi/2 */
-            inexact = mpfr_const_pi (atan, rnd_mode);
-          else /* arctan(-inf) = -Pi/2 */
-            {
-              inexact = -mpfr_const_pi (atan,
-                                        MPFR_INVERT_RND (rnd_mode));
-              MPFR_CHANGE_SIGN (atan);
-            }
-          mpfr_div_2ui (atan, atan, 1, rnd_mode);  /* exact (no exceptions) */
-          MPFR_SAVE_EXPO_FREE (expo);
-          return mpfr_check_range (atan, inexact, rnd_mode);
-        }
-      else /* x is necessarily 0 */
-        {
-          MPFR_ASSERTD (MPFR_IS_ZERO (x));
-          MPFR_SET_ZERO (atan);
-          MPFR_SET_SAME_SIGN (atan, x);
-          MPFR_RET (0);
-        }
-    }
-
-  /* atan(x) = x - x^3/3 + x^5/5...
-     so the error is < 2^(3*EXP(x)-1)
-     so `EXP(x)-(3*EXP(x)-1)` = -2*EXP(x)+1 */
-  MPFR_FAST_COMPUTE_IF_SMALL_INPUT (atan, x, -2 * MPFR_GET_EXP (x), 1, 0,
-                                    rnd_mode, {});
-
-  /* Set x_p=|x| */
   MPFR_TMP_INIT_ABS (xp, x);
-
-  MPFR_SAVE_EXPO_MARK (expo);
-
-  /* Other simple case arctan(-+1)=-+pi/4 */
   comparison = mpfr_cmp_ui (xp, 1);
-  if (MPFR_UNLIKELY (comparison == 0))
-    {
-      int neg = MPFR_IS_NEG (x);
-      inexact = mpfr_const_pi (atan, MPFR_IS_POS (x) ? rnd_mode
-                               : MPFR_INVERT_RND (rnd_mode));
-      if (neg)
-        {
-          inexact = -inexact;
-          MPFR_CHANGE_SIGN (atan);
-        }
-      mpfr_div_2ui (atan, atan, 2, rnd_mode);  /* exact (no exceptions) */
-      MPFR_SAVE_EXPO_FREE (expo);
-      return mpfr_check_range (atan, inexact, rnd_mode);
-    }
+  MPFR_ASSERTD (comparison != 0);
 
   realprec = MPFR_PREC (atan) + MPFR_INT_CEIL_LOG2 (MPFR_PREC (atan)) + 4;
   prec = realprec + GMP_NUMB_BITS;
@@ -516,6 +459,304 @@ mpfr_atan (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpz_clear (ukz);
   MPFR_GROUP_CLEAR (group);
 
+  return inexact;
+}
+
+/* Table-based evaluation in moderate precision. Starting from
+   t = min(|x|, 1/|x|), the argument is reduced in ATAN_TAB_LEVELS steps:
+   at level l, with j = ATAN_TAB_J0 + ATAN_TAB_STEP * l, let k be the
+   nearest integer to t*2^j and c = k/2^j, then
+   atan(t) = atan(c) + atan((t-c)/(1+c*t)), where atan(c) is read from a
+   table. Since c*t >= 0, the new argument satisfies |t| <= 2^(-j-1), thus
+   |k| <= 2^(ATAN_TAB_STEP-1) at the next level (and k <= 2^ATAN_TAB_J0 at
+   the first level since t <= 1). After the last level, atan(t) is computed
+   with a few terms of its Taylor series. */
+#define ATAN_TAB_LEVELS 3
+#define ATAN_TAB_J0 5
+#define ATAN_TAB_STEP 6
+#define ATAN_TAB_SIZE 32 /* 2^ATAN_TAB_J0 = 2^(ATAN_TAB_STEP-1) */
+
+/* atan_tab[l][k-1] is atan(k/2^(ATAN_TAB_J0+ATAN_TAB_STEP*l)) rounded to
+   nearest on atan_tab_prec bits; atan_tab_prec = 0 when the table is not
+   allocated. Like the other caches of mpfr_free_local_cache, the table is
+   always local to a thread. */
+static MPFR_THREAD_ATTR __mpfr_struct atan_tab[ATAN_TAB_LEVELS][ATAN_TAB_SIZE];
+static MPFR_THREAD_ATTR mpfr_prec_t atan_tab_prec = 0;
+
+void
+mpfr_atan_freecache (void)
+{
+  int l, k;
+
+  if (atan_tab_prec != 0)
+    {
+      for (l = 0; l < ATAN_TAB_LEVELS; l++)
+        for (k = 0; k < ATAN_TAB_SIZE; k++)
+          mpfr_clear (&atan_tab[l][k]);
+      atan_tab_prec = 0;
+    }
+}
+
+/* Make sure that the table has at least w bits of precision.
+   Must be called in the extended exponent range. */
+static void
+atan_tab_extend (mpfr_prec_t w)
+{
+  mpfr_t c;
+  mpfr_prec_t p;
+  int l, k;
+
+  if (atan_tab_prec >= w)
+    return;
+
+  /* Grow geometrically, so that the successive Ziv iterations and calls
+     with increasing precisions do not recompute the table each time. */
+  p = MAX (w, atan_tab_prec + atan_tab_prec / 2);
+  p = MPFR_PREC2LIMBS (p) * GMP_NUMB_BITS;
+
+  mpfr_init2 (c, ATAN_TAB_STEP);
+  for (l = 0; l < ATAN_TAB_LEVELS; l++)
+    for (k = 1; k <= ATAN_TAB_SIZE; k++)
+      {
+        mpfr_ptr a = &atan_tab[l][k - 1];
+
+        if (atan_tab_prec == 0)
+          mpfr_init2 (a, p);
+        else
+          mpfr_set_prec (a, p);
+        if (l == 0 && k == ATAN_TAB_SIZE) /* atan(1) = Pi/4 */
+          {
+            mpfr_const_pi (a, MPFR_RNDN);
+            mpfr_div_2ui (a, a, 2, MPFR_RNDN);
+          }
+        else
+          {
+            mpfr_set_ui_2exp (c, k, - (ATAN_TAB_J0 + ATAN_TAB_STEP * l),
+                              MPFR_RNDN);
+            mpfr_atan_general (a, c, MPFR_RNDN);
+          }
+      }
+  mpfr_clear (c);
+  atan_tab_prec = p;
+}
+
+/* Compute atan(x) with the table-based argument reduction, for x regular
+   with |x| <> 1. Must be called in the extended exponent range.
+   Return the ternary value (the result is not checked against the current
+   exponent range).
+
+   Error analysis, with all operations on w bits (or more) rounded to
+   nearest: the initial t has an error of at most 2^(-w-1), and each
+   reduction adds an error of at most 2^(-j-w+1) < 2^(-w-2) to atan(t),
+   since |t| <= 2^(-j-1) afterwards and 1 <= 1+c*t < 2 (the error on the
+   previous value of t is not amplified in terms of atan(t), since
+   d(atan(t))/dt <= 1). The table values and the additions to r < 1 add
+   at most 7 * 2^(-w-1). The series sum_{n<N} (-1)^n z^n/(2n+1) with
+   z = t^2 <= 2^(2e) is evaluated with Horner's scheme, the step n
+   being done on p(n) >= w + 2*e*n bits, so that its error, multiplied by
+   z^n, is at most 3 * 2^(-w); with the truncation error
+   z^N/(2N+1) <= 2^(2eN) <= 2^(-w) and the final multiplication by t, the
+   error on atan(t) is at most 2^e * (3N+2) * 2^(-w). In total, the error
+   on r is less than (3N+10) * 2^(-w), including the final subtraction
+   from Pi/2 when |x| > 1. */
+static int
+mpfr_atan_table (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xp, r, t, u, a, z, c, y;
+  mpfr_prec_t prec, w, p;
+  mpfr_exp_t e;
+  unsigned long N, n;
+  long k;
+  int l, j, comparison, inexact;
+  MPFR_GROUP_DECL (group);
+  MPFR_ZIV_DECL (loop);
+
+  MPFR_TMP_INIT_ABS (xp, x);
+  comparison = mpfr_cmp_ui (xp, 1);
+  MPFR_ASSERTD (comparison != 0);
+
+  prec = MPFR_PREC (atan);
+  w = prec + MPFR_INT_CEIL_LOG2 (prec) + 10;
+  /* For |x| < 1, atan(|x|) > |x|/2, and the error is absolute. */
+  if (MPFR_GET_EXP (xp) < 0)
+    w -= MPFR_GET_EXP (xp);
+
+  MPFR_GROUP_INIT_3 (group, w, r, t, z);
+  /* a and u are not in the group, since their precision is changed with
+     mpfr_set_prec_raw below */
+  mpfr_init2 (a, w);
+  mpfr_init2 (u, w);
+  mpfr_init2 (c, ATAN_TAB_STEP + 1); /* c = k/2^j is exact */
+
+  MPFR_ZIV_INIT (loop, w);
+  for (;;)
+    {
+      atan_tab_extend (w);
+
+      if (comparison > 0) /* use atan(xp) = Pi/2 - atan(1/xp) */
+        mpfr_ui_div (t, 1, xp, MPFR_RNDN);
+      else
+        mpfr_set (t, xp, MPFR_RNDN);
+      /* now 0 < t <= 1 */
+
+      mpfr_set_ui (r, 0, MPFR_RNDN);
+      for (l = 0; l < ATAN_TAB_LEVELS && MPFR_NOTZERO (t); l++)
+        {
+          j = ATAN_TAB_J0 + ATAN_TAB_STEP * l;
+          if (MPFR_GET_EXP (t) < - j) /* |t| < 2^(-j-1), thus k = 0 */
+            continue;
+          MPFR_ALIAS (y, t, MPFR_SIGN (t), MPFR_GET_EXP (t) + j);
+          k = mpfr_get_si (y, MPFR_RNDN);
+          if (k == 0)
+            continue;
+          MPFR_ASSERTD (k >= - ATAN_TAB_SIZE && k <= ATAN_TAB_SIZE);
+          /* t <- (t-c)/(1+c*t), where c*t > 0 */
+          mpfr_set_si_2exp (c, k, - j, MPFR_RNDN);
+          mpfr_mul (u, t, c, MPFR_RNDN);
+          mpfr_add_ui (u, u, 1, MPFR_RNDN);
+          mpfr_sub (t, t, c, MPFR_RNDN);
+          mpfr_div (t, t, u, MPFR_RNDN);
+          if (k > 0)
+            mpfr_add (r, r, &atan_tab[l][k - 1], MPFR_RNDN);
+          else
+            mpfr_sub (r, r, &atan_tab[l][- k - 1], MPFR_RNDN);
+        }
+
+      N = 0;
+      if (MPFR_NOTZERO (t))
+        {
+          e = MPFR_GET_EXP (t);
+          MPFR_ASSERTD (e <= - (ATAN_TAB_J0 + ATAN_TAB_STEP *
+                                (ATAN_TAB_LEVELS - 1)));
+          mpfr_sqr (z, t, MPFR_RNDN);
+          N = (w - 1) / (-2 * e) + 1; /* 2eN <= -w */
+          /* a = 1/(2N-1), then a <- 1/(2n+1) - z*a for n = N-2 down to 0,
+             with decreasing precision p(n) = w + 2*e*n */
+          p = w + 2 * e * (mpfr_prec_t) (N - 1);
+          mpfr_set_prec_raw (a, MAX (p, MPFR_PREC_MIN));
+          mpfr_set_ui (a, 1, MPFR_RNDN);
+          mpfr_div_ui (a, a, 2 * N - 1, MPFR_RNDN);
+          for (n = N - 1; n-- > 0; )
+            {
+              p = w + 2 * e * (mpfr_prec_t) n;
+              p = MAX (p, MPFR_PREC_MIN);
+              mpfr_set_prec_raw (u, p);
+              mpfr_mul (u, z, a, MPFR_RNDN);
+              mpfr_set_prec_raw (a, p);
+              mpfr_set_ui (a, 1, MPFR_RNDN);
+              mpfr_div_ui (a, a, 2 * n + 1, MPFR_RNDN);
+              mpfr_sub (a, a, u, MPFR_RNDN);
+            }
+          mpfr_set_prec_raw (u, w);
+          mpfr_mul (u, t, a, MPFR_RNDN);
+          mpfr_add (r, r, u, MPFR_RNDN);
+        }
+
+      if (comparison > 0)
+        { /* atan(x) = Pi/2-atan(1/x) for x > 0 */
+          mpfr_const_pi (u, MPFR_RNDN);
+          mpfr_div_2ui (u, u, 1, MPFR_RNDN);
+          mpfr_sub (r, u, r, MPFR_RNDN);
+        }
+      MPFR_ASSERTD (MPFR_IS_POS (r));
+
+      if (MPFR_LIKELY (MPFR_CAN_ROUND (r, w + MPFR_GET_EXP (r)
+                                       - MPFR_INT_CEIL_LOG2 (3 * N + 10),
+                                       prec, rnd_mode)))
+        break;
+      MPFR_ZIV_NEXT (loop, w);
+      MPFR_GROUP_REPREC_3 (group, w, r, t, z);
+      mpfr_set_prec (a, w);
+      mpfr_set_prec (u, w);
+    }
+  MPFR_ZIV_FREE (loop);
+
+  inexact = mpfr_set4 (atan, r, rnd_mode, MPFR_SIGN (x));
+
+  mpfr_clear (a);
+  mpfr_clear (u);
+  mpfr_clear (c);
+  MPFR_GROUP_CLEAR (group);
+  return inexact;
+}
+
+int
+mpfr_atan (mpfr_ptr atan, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xp;
+  int comparison, inexact;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_LOG_FUNC
+    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
+     ("atan[%Pd]=%.*Rg inexact=%d",
+      mpfr_get_prec (atan), mpfr_log_prec, atan, inexact));
+
+  /* Singular cases */
+  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+    {
+      if (MPFR_IS_NAN (x))
+        {
+          MPFR_SET_NAN (atan);
+          MPFR_RET_NAN;
+        }
+      else if (MPFR_IS_INF (x))
+        {
+          MPFR_SAVE_EXPO_MARK (expo);
+          if (MPFR_IS_POS (x))  /* arctan(+inf) = Pi/2 */
+            inexact = mpfr_const_pi (atan, rnd_mode);
+          else /* arctan(-inf) = -Pi/2 */
+            {
+              inexact = -mpfr_const_pi (atan,
+                                        MPFR_INVERT_RND (rnd_mode));
+              MPFR_CHANGE_SIGN (atan);
+            }
+          mpfr_div_2ui (atan, atan, 1, rnd_mode);  /* exact (no exceptions) */
+          MPFR_SAVE_EXPO_FREE (expo);
+          return mpfr_check_range (atan, inexact, rnd_mode);
+        }
+      else /* x is necessarily 0 */
+        {
+          MPFR_ASSERTD (MPFR_IS_ZERO (x));
+          MPFR_SET_ZERO (atan);
+          MPFR_SET_SAME_SIGN (atan, x);
+          MPFR_RET (0);
+        }
+    }
+
+  /* atan(x) = x - x^3/3 + x^5/5...
+     so the error is < 2^(3*EXP(x)-1)
+     so `EXP(x)-(3*EXP(x)-1)` = -2*EXP(x)+1 */
+  MPFR_FAST_COMPUTE_IF_SMALL_INPUT (atan, x, -2 * MPFR_GET_EXP (x), 1, 0,
+                                    rnd_mode, {});
+
+  /* Set x_p=|x| */
+  MPFR_TMP_INIT_ABS (xp, x);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+
+  /* Other simple case arctan(-+1)=-+pi/4 */
+  comparison = mpfr_cmp_ui (xp, 1);
+  if (MPFR_UNLIKELY (comparison == 0))
+    {
+      int neg = MPFR_IS_NEG (x);
+      inexact = mpfr_const_pi (atan, MPFR_IS_POS (x) ? rnd_mode
+                               : MPFR_INVERT_RND (rnd_mode));
+      if (neg)
+        {
+          inexact = -inexact;
+          MPFR_CHANGE_SIGN (atan);
+        }
+      mpfr_div_2ui (atan, atan, 2, rnd_mode);  /* exact (no exceptions) */
+      MPFR_SAVE_EXPO_FREE (expo);
+      return mpfr_check_range (atan, inexact, rnd_mode);
+    }
+
+  if (MPFR_PREC (atan) < MPFR_ATAN_TABLE_THRESHOLD)
+    inexact = mpfr_atan_table (atan, x, rnd_mode);
+  else
+    inexact = mpfr_atan_general (atan, x, rnd_mode);
+
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (atan, inexact, rnd_mode);
 }
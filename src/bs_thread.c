@@ -0,0 +1,182 @@
+/* Parallel binary splitting: thread count, minimum subtree size, and
+   fork/join of independent computations.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The threads created here only do integer computations (mpz_t) and
+   conversions of the results, in the extended exponent range like the
+   functions that create them. They do not depend on the other thread-local
+   data of MPFR (flags), except the mpz_t pool, which is freed at the end of
+   each thread. Without TLS, these data would be shared by all threads,
+   thus the threads are not used. */
+#if defined(MPFR_WANT_PARALLEL_BS) && defined(HAVE_PTHREAD) && \
+  defined(MPFR_USE_THREAD_SAFE)
+# define MPFR_BS_PTHREAD 1
+# include <pthread.h>
+#endif
+
+#ifndef MPFR_BS_MIN_TERMS
+# define MPFR_BS_MIN_TERMS 4096
+#endif
+
+/* These settings are global (not thread-local), since they are read by
+   the threads created below. */
+static unsigned long bs_threads = 1;
+static unsigned long bs_min_terms = MPFR_BS_MIN_TERMS;
+
+int
+mpfr_set_bs_threads (unsigned long n)
+{
+#ifdef MPFR_BS_PTHREAD
+  if (n == 0)
+    return 1;
+#else
+  if (n != 1)
+    return 1;
+#endif
+  bs_threads = n;
+  return 0;
+}
+
+unsigned long
+mpfr_get_bs_threads (void)
+{
+  return bs_threads;
+}
+
+void
+mpfr_set_bs_min_terms (unsigned long n)
+{
+  bs_min_terms = n;
+}
+
+unsigned long
+mpfr_get_bs_min_terms (void)
+{
+  return bs_min_terms;
+}
+
+#ifdef MPFR_BS_PTHREAD
+
+typedef struct {
+  mpfr_bs_func_t f;
+  void *arg;
+} mpfr_bs_job_t;
+
+static void *
+bs_thread_start (void *p)
+{
+  mpfr_bs_job_t *job = (mpfr_bs_job_t *) p;
+
+  __gmpfr_emin = MPFR_EMIN_MIN;
+  __gmpfr_emax = MPFR_EMAX_MAX;
+  job->f (job->arg);
+  mpfr_free_pool ();
+  return NULL;
+}
+
+#endif
+
+/* Compute f(a) and g(b), which must be independent. If nthreads >= 2 and
+   the number of terms n is at least the minimum subtree size, g(b) is
+   computed in a new thread (if it can be created), the caller splitting
+   its thread budget between both calls. */
+void
+mpfr_bs_run2 (mpfr_bs_func_t f, void *a, mpfr_bs_func_t g, void *b,
+              unsigned long nthreads, unsigned long n)
+{
+#ifdef MPFR_BS_PTHREAD
+  if (nthreads >= 2 && n >= bs_min_terms)
+    {
+      mpfr_bs_job_t job;
+      pthread_t th;
+
+      job.f = g;
+      job.arg = b;
+      if (pthread_create (&th, NULL, bs_thread_start, &job) == 0)
+        {
+          f (a);
+          MPFR_ASSERTN (pthread_join (th, NULL) == 0);
+          return;
+        }
+    }
+#else
+  (void) nthreads;
+  (void) n;
+#endif
+  f (a);
+  g (b);
+}
+
+typedef struct {
+  mpfr_bs_func_t f;
+  char *tab;
+  size_t size;
+  unsigned long n;
+  unsigned long nthreads;
+  unsigned long nterms;
+} mpfr_bs_range_t;
+
+static void
+bs_run_range (void *p)
+{
+  mpfr_bs_range_t *r = (mpfr_bs_range_t *) p;
+
+  if (r->nthreads < 2 || r->n < 2)
+    {
+      unsigned long i;
+
+      for (i = 0; i < r->n; i++)
+        r->f (r->tab + i * r->size);
+    }
+  else
+    {
+      mpfr_bs_range_t left = *r, right = *r;
+
+      left.n = r->n / 2;
+      left.nthreads = r->nthreads - r->nthreads / 2;
+      right.tab = r->tab + left.n * r->size;
+      right.n = r->n - left.n;
+      right.nthreads = r->nthreads / 2;
+      mpfr_bs_run2 (bs_run_range, &left, bs_run_range, &right,
+                    r->nthreads, r->nterms);
+    }
+}
+
+/* Call f on each of the n elements (of size size) of the array tab, which
+   must be independent, using at most nthreads threads. The parameter
+   nterms is an estimate of the number of terms of each computation,
+   compared to the minimum subtree size. */
+void
+mpfr_bs_run (mpfr_bs_func_t f, void *tab, size_t size, unsigned long n,
+             unsigned long nthreads, unsigned long nterms)
+{
+  mpfr_bs_range_t r;
+
+  r.f = f;
+  r.tab = (char *) tab;
+  r.size = size;
+  r.n = n;
+  r.nthreads = nthreads;
+  r.nterms = nterms;
+  bs_run_range (&r);
+}
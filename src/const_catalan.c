@@ -32,9 +32,20 @@ mpfr_const_catalan (mpfr_ptr x, mpfr_rnd_t rnd_mode) {
   return mpfr_cache (x, __gmpfr_cache_const_catalan, rnd_mode);
 }
 
-/* return T, Q such that T/Q = sum(k!^2/(2k)!/(2k+1)^2, k=n1..n2-1) */
+typedef struct
+{
+  mpz_ptr T, P, Q;
+  unsigned long n1, n2;
+  unsigned long nthreads;
+} S_task_t;
+
+static void S_task (void *);
+
+/* return T, Q such that T/Q = sum(k!^2/(2k)!/(2k+1)^2, k=n1..n2-1),
+   using at most nthreads threads */
 static void
-S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
+S (mpz_ptr T, mpz_ptr P, mpz_ptr Q, unsigned long n1, unsigned long n2,
+   unsigned long nthreads)
 {
   if (n2 == n1 + 1)
     {
@@ -56,11 +67,32 @@ S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
     {
       unsigned long m = (n1 + n2) / 2;
       mpz_t T2, P2, Q2;
-      S (T, P, Q, n1, m);
       mpz_init (T2);
       mpz_init (P2);
       mpz_init (Q2);
-      S (T2, P2, Q2, m, n2);
+      if (nthreads >= 2)
+        {
+          S_task_t tl, tr;
+
+          tl.T = T;
+          tl.P = P;
+          tl.Q = Q;
+          tl.n1 = n1;
+          tl.n2 = m;
+          tl.nthreads = nthreads - nthreads / 2;
+          tr.T = T2;
+          tr.P = P2;
+          tr.Q = Q2;
+          tr.n1 = m;
+          tr.n2 = n2;
+          tr.nthreads = nthreads / 2;
+          mpfr_bs_run2 (S_task, &tl, S_task, &tr, nthreads, n2 - n1);
+        }
+      else
+        {
+          S (T, P, Q, n1, m, 1);
+          S (T2, P2, Q2, m, n2, 1);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
@@ -72,6 +104,14 @@ S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
     }
 }
 
+static void
+S_task (void *p)
+{
+  S_task_t *t = (S_task_t *) p;
+
+  S (t->T, t->P, t->Q, t->n1, t->n2, t->nthreads);
+}
+
 /* Don't need to save/restore exponent range: the cache does it.
    Catalan's constant is G = sum((-1)^k/(2*k+1)^2, k=0..infinity).
    We compute it using formula (31) of Victor Adamchik's page
@@ -126,7 +166,7 @@ mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
     mpfr_log (x, x, MPFR_RNDU);
     mpfr_const_pi (y, MPFR_RNDU);
     mpfr_mul (x, x, y, MPFR_RNDN);
-    S (T, P, Q, 0, (p - 1) / 2);
+    S (T, P, Q, 0, (p - 1) / 2, mpfr_get_bs_threads ());
     mpz_mul_ui (T, T, 3);
     mpfr_set_z (y, T, MPFR_RNDU);
     mpfr_set_z (z, Q, MPFR_RNDD);
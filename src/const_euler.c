@@ -70,10 +70,22 @@ mpfr_const_euler_bs_clear (mpfr_const_euler_bs_t s)
   mpz_clear (s->V);
 }
 
+/* Binary splitting on [n1, n2) with at most nthreads threads */
+typedef struct
+{
+  mpfr_const_euler_bs_struct *s;
+  mpz_ptr P, Q, T;
+  unsigned long n1, n2, N;
+  unsigned long nthreads;
+} mpfr_const_euler_bs_task_t;
+
+static void mpfr_const_euler_bs_1_task (void *);
+static void mpfr_const_euler_bs_2_task (void *);
+
 static void
 mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
                        unsigned long n1, unsigned long n2, unsigned long N,
-                       int cont)
+                       int cont, unsigned long nthreads)
 {
   if (n2 - n1 == 1)
     {
@@ -94,8 +106,28 @@ mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
 
       mpfr_const_euler_bs_init (L);
       mpfr_const_euler_bs_init (R);
-      mpfr_const_euler_bs_1 (L, n1, m, N, 1);
-      mpfr_const_euler_bs_1 (R, m, n2, N, 1);
+      if (nthreads >= 2)
+        {
+          mpfr_const_euler_bs_task_t tl, tr;
+
+          tl.s = L;
+          tl.n1 = n1;
+          tl.n2 = m;
+          tl.N = N;
+          tl.nthreads = nthreads - nthreads / 2;
+          tr.s = R;
+          tr.n1 = m;
+          tr.n2 = n2;
+          tr.N = N;
+          tr.nthreads = nthreads / 2;
+          mpfr_bs_run2 (mpfr_const_euler_bs_1_task, &tl,
+                        mpfr_const_euler_bs_1_task, &tr, nthreads, n2 - n1);
+        }
+      else
+        {
+          mpfr_const_euler_bs_1 (L, n1, m, N, 1, 1);
+          mpfr_const_euler_bs_1 (R, m, n2, N, 1, 1);
+        }
 
       mpz_init (t);
       mpz_init (u);
@@ -136,9 +168,17 @@ mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
 }
 
 static void
-mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
+mpfr_const_euler_bs_1_task (void *p)
+{
+  mpfr_const_euler_bs_task_t *t = (mpfr_const_euler_bs_task_t *) p;
+
+  mpfr_const_euler_bs_1 (t->s, t->n1, t->n2, t->N, 1, t->nthreads);
+}
+
+static void
+mpfr_const_euler_bs_2 (mpz_ptr P, mpz_ptr Q, mpz_ptr T,
                        unsigned long n1, unsigned long n2, unsigned long N,
-                       int cont)
+                       int cont, unsigned long nthreads)
 {
   if (n2 - n1 == 1)
     {
@@ -165,8 +205,32 @@ mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
       mpz_init (P2);
       mpz_init (Q2);
       mpz_init (T2);
-      mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1);
-      mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1);
+      if (nthreads >= 2)
+        {
+          mpfr_const_euler_bs_task_t tl, tr;
+
+          tl.P = P;
+          tl.Q = Q;
+          tl.T = T;
+          tl.n1 = n1;
+          tl.n2 = m;
+          tl.N = N;
+          tl.nthreads = nthreads - nthreads / 2;
+          tr.P = P2;
+          tr.Q = Q2;
+          tr.T = T2;
+          tr.n1 = m;
+          tr.n2 = n2;
+          tr.N = N;
+          tr.nthreads = nthreads / 2;
+          mpfr_bs_run2 (mpfr_const_euler_bs_2_task, &tl,
+                        mpfr_const_euler_bs_2_task, &tr, nthreads, n2 - n1);
+        }
+      else
+        {
+          mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1, 1);
+          mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1, 1);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
@@ -179,6 +243,15 @@ mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
     }
 }
 
+static void
+mpfr_const_euler_bs_2_task (void *p)
+{
+  mpfr_const_euler_bs_task_t *t = (mpfr_const_euler_bs_task_t *) p;
+
+  mpfr_const_euler_bs_2 (t->P, t->Q, t->T, t->n1, t->n2, t->N, 1,
+                         t->nthreads);
+}
+
 int
 mpfr_const_euler_internal (mpfr_ptr x, mpfr_rnd_t rnd)
 {
@@ -222,7 +295,7 @@ mpfr_const_euler_internal (mpfr_ptr x, mpfr_rnd_t rnd)
       /* V / ((T + Q) * D) = S / I
          where S = sum_{k=0}^{N-1} H_k n^(2k) / (k!)^2,
                I = sum_{k=0}^{N-1} n^(2k) / (k!)^2 */
-      mpfr_const_euler_bs_1 (sum, 0, N, n, 0);
+      mpfr_const_euler_bs_1 (sum, 0, N, n, 0, mpfr_get_bs_threads ());
       mpz_add (sum->T, sum->T, sum->Q);
       mpz_mul (t, sum->T, sum->D);
       mpz_mul_2exp (u, sum->V, wp);
@@ -231,7 +304,8 @@ mpfr_const_euler_internal (mpfr_ptr x, mpfr_rnd_t rnd)
 
       /* C / (D * V) = U where
          U = (1/(4n)) sum_{k=0}^{2n-1} [(2k)!]^3 / ((k!)^4 8^(2k) (2n)^(2k)) */
-      mpfr_const_euler_bs_2 (sum->C, sum->D, sum->V, 0, 2*n, n, 0);
+      mpfr_const_euler_bs_2 (sum->C, sum->D, sum->V, 0, 2*n, n, 0,
+                             mpfr_get_bs_threads ());
       mpz_mul (t, sum->Q, sum->Q);
       mpz_mul (t, t, sum->V);
       mpz_mul (u, sum->T, sum->T);
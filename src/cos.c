@@ -133,7 +133,7 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
   mpfr_prec_t K0, K, precy, m, k, l;
   int inexact, reduce = 0;
-  mpfr_t r, s, xr, c;
+  mpfr_t r, s, xr;
   mpfr_exp_t exps, cancel = 0, expx;
   MPFR_ZIV_DECL (loop);
   MPFR_SAVE_EXPO_DECL (expo);
@@ -168,6 +168,16 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   /* Compute initial precision */
   precy = MPFR_PREC (y);
 
+#ifdef MPFR_FIXED_MAXPREC
+  /* table-driven kernel, 0 if it cannot round */
+  if (precy <= MPFR_FIXED_MAXPREC &&
+      (inexact = mpfr_sincos_fixed (NULL, y, x, rnd_mode)) != 0)
+    {
+      inexact = (inexact >> 2) == 2 ? -1 : 1;
+      goto end;
+    }
+#endif
+
   if (precy >= MPFR_SINCOS_THRESHOLD)
     {
       inexact = mpfr_cos_fast (y, x, rnd_mode);
@@ -176,15 +186,11 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
   K0 = __gmpfr_isqrt (precy / 3);
   m = precy + 2 * MPFR_INT_CEIL_LOG2 (precy) + 2 * K0 + 4;
+  MPFR_ZIV_ADAPT (loop, m);
 
   if (expx >= 3)
     {
       reduce = 1;
-      /* As expx + m - 1 will silently be converted into mpfr_prec_t
-         in the mpfr_init2 call, the assert below may be useful to
-         avoid undefined behavior. */
-      MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
-      mpfr_init2 (c, expx + m - 1);
       mpfr_init2 (xr, m);
     }
 
@@ -192,20 +198,12 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   MPFR_ZIV_INIT (loop, m);
   for (;;)
     {
-      /* If |x| >= 4, first reduce x cmod (2*Pi) into xr, using mpfr_remainder:
-         let e = EXP(x) >= 3, and m the target precision:
-         (1) c <- 2*Pi              [precision e+m-1, nearest]
-         (2) xr <- remainder (x, c) [precision m, nearest]
-         We have |c - 2*Pi| <= 1/2ulp(c) = 2^(3-e-m)
-                 |xr - x - k c| <= 1/2ulp(xr) <= 2^(1-m)
-                 |k| <= |x|/(2*Pi) <= 2^(e-2)
-         Thus |xr - x - 2kPi| <= |k| |c - 2Pi| + 2^(1-m) <= 2^(2-m).
-         It follows |cos(xr) - cos(x)| <= 2^(2-m). */
+      /* If |x| >= 4, first reduce x cmod (2*Pi) into xr, with precision m:
+         we have |xr - x - 2kPi| < 2^(2-m) (see trig_reduce.c), thus
+         |cos(xr) - cos(x)| < 2^(2-m). */
       if (reduce)
         {
-          mpfr_const_pi (c, MPFR_RNDN);
-          mpfr_mul_2ui (c, c, 1, MPFR_RNDN); /* 2Pi */
-          mpfr_remainder (xr, x, c, MPFR_RNDN);
+          mpfr_trig_reduce (xr, NULL, x);
           if (MPFR_IS_ZERO(xr))
             goto ziv_next;
           /* now |xr| <= 4, thus r <= 16 below */
@@ -280,19 +278,13 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       MPFR_ZIV_NEXT (loop, m);
       MPFR_GROUP_REPREC_2 (group, m, r, s);
       if (reduce)
-        {
-          mpfr_set_prec (xr, m);
-          mpfr_set_prec (c, expx + m - 1);
-        }
+        mpfr_set_prec (xr, m);
     }
   MPFR_ZIV_FREE (loop);
   inexact = mpfr_set (y, s, rnd_mode);
   MPFR_GROUP_CLEAR (group);
   if (reduce)
-    {
-      mpfr_clear (xr);
-      mpfr_clear (c);
-    }
+    mpfr_clear (xr);
 
  end:
   MPFR_SAVE_EXPO_FREE (expo);
@@ -36,27 +36,42 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "invert_limb.h"
 
+/* Return the approximate inverse of the significand of v used by the
+   special code below: if v has one limb v0, a lower approximation of
+   B^2/v0 - B (for mpfr_div_1 and mpfr_div_1n), and if v has two limbs
+   v1:v0, a lower approximation of B^2/(v1+1) - B (for mpfr_div_2).
+   Note: this function requires __gmpfr_invert_limb_approx (from invert_limb.h)
+   which is only provided so far for 64-bit limb. */
+static MPFR_ALWAYS_INLINE mp_limb_t
+mpfr_div_inv (mpfr_srcptr v)
+{
+  mp_limb_t inv, v1;
+
+  v1 = MPFR_MANT(v)[MPFR_LIMB_SIZE(v) - 1];
+  if (MPFR_LIMB_SIZE(v) == 1)
+    __gmpfr_invert_limb_approx (inv, v1);
+  else if (MPFR_UNLIKELY(v1 == MPFR_LIMB_MAX))
+    inv = MPFR_LIMB_ZERO;
+  else
+    __gmpfr_invert_limb_approx (inv, v1 + 1);
+  return inv;
+}
+
 /* Given u = u1*B+u0 < v = v1*B+v0 with v normalized (high bit of v1 set),
    put in q = Q1*B+Q0 an approximation of floor(u*B^2/v), with:
-   B = 2^GMP_NUMB_BITS and q <= floor(u*B^2/v) <= q + 21.
-   Note: this function requires __gmpfr_invert_limb_approx (from invert_limb.h)
-   which is only provided so far for 64-bit limb.
+   B = 2^GMP_NUMB_BITS and q <= floor(u*B^2/v) <= q + 21,
+   where inv <= B^2/(v1+1) - B is given by mpfr_div_inv.
    Note: __gmpfr_invert_limb_approx can be replaced by __gmpfr_invert_limb,
    in that case the bound 21 reduces to 16. */
 static void
 mpfr_div2_approx (mpfr_limb_ptr Q1, mpfr_limb_ptr Q0,
                   mp_limb_t u1, mp_limb_t u0,
-                  mp_limb_t v1, mp_limb_t v0)
+                  mp_limb_t v1, mp_limb_t v0, mp_limb_t inv)
 {
-  mp_limb_t inv, q1, q0, r1, r0, cy, xx, yy;
+  mp_limb_t q1, q0, r1, r0, cy, xx, yy;
 
-  /* first compute an approximation of q1, using a lower approximation of
-     B^2/(v1+1) - B */
-  if (MPFR_UNLIKELY(v1 == MPFR_LIMB_MAX))
-    inv = MPFR_LIMB_ZERO;
-  else
-    __gmpfr_invert_limb_approx (inv, v1 + 1);
-  /* now inv <= B^2/(v1+1) - B */
+  /* first compute an approximation of q1, using the lower approximation
+     inv of B^2/(v1+1) - B */
   umul_ppmm (q1, q0, u1, inv);
   q1 += u1;
   /* now q1 <= u1*B/(v1+1) < (u1*B+u0)*B/(v1*B+v0) */
@@ -102,11 +117,18 @@ mpfr_div2_approx (mpfr_limb_ptr Q1, mpfr_limb_ptr Q0,
   *Q0 = q0;
 }
 
+#else
+
+/* The special code below does not use an approximate inverse. */
+#define mpfr_div_inv(v) MPFR_LIMB_ZERO
+
 #endif /* GMP_NUMB_BITS == 64 */
 
-/* Special code for PREC(q) = PREC(u) = PREC(v) = p < GMP_NUMB_BITS */
-static int
-mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
+/* Special code for PREC(q) = PREC(u) = PREC(v) = p < GMP_NUMB_BITS,
+   where inv = mpfr_div_inv (v) */
+static MPFR_ALWAYS_INLINE int
+mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode,
+            mp_limb_t inv)
 {
   mpfr_prec_t p = MPFR_GET_PREC(q);
   mpfr_limb_ptr qp = MPFR_MANT(q);
@@ -125,11 +147,7 @@ mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
      FIXME: for p<=62 we have sh-1<2 and will never be able to round correctly.
      Even for p=61 we have sh-1=2 and we can round correctly only when the two
      last bist of q0 are 01, which happens with probability 25% only. */
-  {
-    mp_limb_t inv;
-    __gmpfr_invert_limb_approx (inv, v0);
-    umul_ppmm (rb, sb, u0, inv);
-  }
+  umul_ppmm (rb, sb, u0, inv);
   rb += u0;
   q0 = rb >> extra;
   /* rb does not exceed the true quotient floor(u0*2^GMP_NUMB_BITS/v0),
@@ -251,9 +269,10 @@ mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 }
 
 /* Special code for PREC(q) = GMP_NUMB_BITS,
-   with PREC(u), PREC(v) <= GMP_NUMB_BITS. */
-static int
-mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
+   with PREC(u), PREC(v) <= GMP_NUMB_BITS, where inv = mpfr_div_inv (v). */
+static MPFR_ALWAYS_INLINE int
+mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode,
+             mp_limb_t inv)
 {
   mpfr_limb_ptr qp = MPFR_MANT(q);
   mpfr_exp_t qx = MPFR_GET_EXP(u) - MPFR_GET_EXP(v);
@@ -271,10 +290,9 @@ mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 
 #if GMP_NUMB_BITS == 64 /* __gmpfr_invert_limb_approx only exists for 64-bit */
   {
-    mp_limb_t inv, h;
+    mp_limb_t h;
 
     /* First compute an approximate quotient. */
-    __gmpfr_invert_limb_approx (inv, v0);
     umul_ppmm (rb, sb, u0, inv);
     q0 = u0 + rb;
     /* rb does not exceed the true quotient floor(u0*2^GMP_NUMB_BITS/v0),
@@ -388,9 +406,10 @@ mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 }
 
 /* Special code for GMP_NUMB_BITS < PREC(q) < 2*GMP_NUMB_BITS and
-   PREC(u) = PREC(v) = PREC(q) */
-static int
-mpfr_div_2 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
+   PREC(u) = PREC(v) = PREC(q), where inv = mpfr_div_inv (v) */
+static MPFR_ALWAYS_INLINE int
+mpfr_div_2 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode,
+            mp_limb_t inv)
 {
   mpfr_prec_t p = MPFR_GET_PREC(q);
   mpfr_limb_ptr qp = MPFR_MANT(q);
@@ -410,7 +429,7 @@ mpfr_div_2 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
   MPFR_ASSERTD(r3 < v1 || (r3 == v1 && r2 < v0));
 
 #if GMP_NUMB_BITS == 64
-  mpfr_div2_approx (&q1, &q0, r3, r2, v1, v0);
+  mpfr_div2_approx (&q1, &q0, r3, r2, v1, v0, inv);
   /* we know q1*B+q0 is smaller or equal to the exact quotient, with
      difference at most 21 */
   if (MPFR_LIKELY(((q0 + 21) & (mask >> 1)) > 21))
@@ -836,17 +855,31 @@ mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
       MPFR_GET_PREC(v) == MPFR_GET_PREC(q))
     {
       if (MPFR_GET_PREC(q) < GMP_NUMB_BITS)
-        return mpfr_div_1 (q, u, v, rnd_mode);
+        return mpfr_div_1 (q, u, v, rnd_mode, mpfr_div_inv (v));
 
       if (GMP_NUMB_BITS < MPFR_GET_PREC(q) &&
           MPFR_GET_PREC(q) < 2 * GMP_NUMB_BITS)
-        return mpfr_div_2 (q, u, v, rnd_mode);
+        return mpfr_div_2 (q, u, v, rnd_mode, mpfr_div_inv (v));
 
       if (MPFR_GET_PREC(q) == GMP_NUMB_BITS)
-        return mpfr_div_1n (q, u, v, rnd_mode);
+        return mpfr_div_1n (q, u, v, rnd_mode, mpfr_div_inv (v));
     }
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
+  /* For large precisions, first try a Newton step from an approximation
+     of 1/v on about half the precision. This can only fail in rare cases,
+     for instance when the quotient is exact. The exponent of the result
+     is EXP(u) - EXP(v) + {0, 1, 2}, and must be in the current range. */
+  if (MPFR_UNLIKELY (MPFR_GET_PREC (q) >= MPFR_DIV_NEWTON_THRESHOLD) &&
+      MPFR_GET_PREC (q) >= MPFR_NEWTON_PREC_MIN &&
+      MPFR_GET_EXP (u) - MPFR_GET_EXP (v) >= __gmpfr_emin &&
+      MPFR_GET_EXP (u) - MPFR_GET_EXP (v) <= __gmpfr_emax - 2)
+    {
+      inex = mpfr_div_newton (q, u, v, rnd_mode);
+      if (inex != 0)
+        return inex;
+    }
+
   usize = MPFR_LIMB_SIZE(u);
   vsize = MPFR_LIMB_SIZE(v);
   q0size = MPFR_LIMB_SIZE(q); /* number of limbs of destination */
@@ -1443,3 +1476,91 @@ mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
   inex *= sign_quotient;
   MPFR_RET (inex);
 }
+
+/* Initialize d for divisions by v with mpfr_div_by_precomp: d keeps a copy
+   of v, the approximate inverse used by the special code for 1 and 2 limbs,
+   and when PREC(v) >= MPFR_DIV_PRECOMP_THRESHOLD, an approximation of the
+   reciprocal of v for mpfr_div_newton_r (for quotients of precision at
+   most PREC(v)). */
+void
+mpfr_divisor_init (mpfr_divisor_ptr d, mpfr_srcptr v)
+{
+  mpfr_prec_t p = MPFR_GET_PREC (v);
+
+  mpfr_init2 (&d->_mpfr_v, p);
+  mpfr_set (&d->_mpfr_v, v, MPFR_RNDN); /* exact */
+  d->_mpfr_inv = MPFR_LIMB_ZERO;
+  if (MPFR_IS_SINGULAR (v))
+    {
+      mpfr_init2 (&d->_mpfr_r, MPFR_PREC_MIN);
+      return;
+    }
+
+#if !defined(MPFR_GENERIC_ABI)
+  if (p < 2 * GMP_NUMB_BITS)
+    d->_mpfr_inv = mpfr_div_inv (v);
+#endif
+
+  if (p >= MPFR_DIV_PRECOMP_THRESHOLD && p >= MPFR_NEWTON_PREC_MIN)
+    {
+      mpfr_t va;
+      MPFR_SAVE_EXPO_DECL (expo);
+
+      MPFR_SAVE_EXPO_MARK (expo);
+      mpfr_init2 (&d->_mpfr_r, mpfr_div_newton_prec (p));
+      MPFR_ALIAS (va, v, MPFR_SIGN_POS, 0);
+      mpfr_ui_div (&d->_mpfr_r, 1, va, MPFR_RNDN);
+      MPFR_SAVE_EXPO_FREE (expo);
+    }
+  else
+    mpfr_init2 (&d->_mpfr_r, MPFR_PREC_MIN);
+}
+
+void
+mpfr_divisor_clear (mpfr_divisor_ptr d)
+{
+  mpfr_clear (&d->_mpfr_v);
+  mpfr_clear (&d->_mpfr_r);
+}
+
+/* Same as mpfr_div (q, u, v, rnd_mode), where d has been initialized by
+   mpfr_divisor_init (d, v). */
+int
+mpfr_div_by_precomp (mpfr_ptr q, mpfr_srcptr u, mpfr_divisor_srcptr d,
+                     mpfr_rnd_t rnd_mode)
+{
+  mpfr_srcptr v = &d->_mpfr_v;
+  mpfr_prec_t p = MPFR_GET_PREC (q);
+
+  if (MPFR_UNLIKELY (MPFR_ARE_SINGULAR (u, v)))
+    return mpfr_div (q, u, v, rnd_mode);
+
+#if !defined(MPFR_GENERIC_ABI)
+  if (MPFR_GET_PREC(u) == p && MPFR_GET_PREC(v) == p)
+    {
+      if (p < GMP_NUMB_BITS)
+        return mpfr_div_1 (q, u, v, rnd_mode, d->_mpfr_inv);
+
+      if (GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS)
+        return mpfr_div_2 (q, u, v, rnd_mode, d->_mpfr_inv);
+
+      if (p == GMP_NUMB_BITS)
+        return mpfr_div_1n (q, u, v, rnd_mode, d->_mpfr_inv);
+    }
+#endif /* !defined(MPFR_GENERIC_ABI) */
+
+  /* Since the reciprocal of v is already known, the Newton step only needs
+     three short products (see newton.c). */
+  if (MPFR_UNLIKELY (p >= MPFR_DIV_PRECOMP_THRESHOLD) &&
+      p >= MPFR_NEWTON_PREC_MIN &&
+      mpfr_div_newton_prec (p) <= MPFR_GET_PREC (&d->_mpfr_r) &&
+      MPFR_GET_EXP (u) - MPFR_GET_EXP (v) >= __gmpfr_emin &&
+      MPFR_GET_EXP (u) - MPFR_GET_EXP (v) <= __gmpfr_emax - 2)
+    {
+      int inex = mpfr_div_newton_r (q, u, v, &d->_mpfr_r, rnd_mode);
+      if (inex != 0)
+        return inex;
+    }
+
+  return mpfr_div (q, u, v, rnd_mode);
+}
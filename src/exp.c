@@ -179,6 +179,12 @@ mpfr_exp (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       else
         {
           MPFR_SAVE_EXPO_MARK (expo);
+#ifdef MPFR_FIXED_MAXPREC
+          /* table-driven kernel, 0 if it cannot round */
+          inexact = precy <= MPFR_FIXED_MAXPREC ?
+            mpfr_exp_fixed (y, x, rnd_mode) : 0;
+          if (inexact == 0)
+#endif
           inexact = mpfr_exp_2 (y, x, rnd_mode); /* O(n^(1/3) M(n)) */
           MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
           MPFR_SAVE_EXPO_FREE (expo);
@@ -183,18 +183,39 @@ mpfr_exp_rational (mpfr_ptr y, mpz_ptr p, long r, int m,
   MPFR_SET_EXP (y, expo);
 }
 
+/* Computation of exp(p/2^r) for one part of the input of mpfr_exp_3.
+   The parts are independent, thus may be computed in parallel, each one
+   with its own tables Q and mult. */
+typedef struct
+{
+  mpfr_t y;
+  mpz_t p;
+  long r;
+  int m;
+  mpz_t *Q;
+  mpfr_prec_t *mult;
+} mpfr_exp_rational_task_t;
+
+static void
+mpfr_exp_rational_task (void *p)
+{
+  mpfr_exp_rational_task_t *t = (mpfr_exp_rational_task_t *) p;
+
+  mpfr_exp_rational (t->y, t->p, t->r, t->m, t->Q, t->mult);
+}
+
 #define shift (GMP_NUMB_BITS/2)
 
 int
 mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
   mpfr_t t, x_copy, tmp;
-  mpz_t uk;
   mpfr_exp_t ttt, shift_x;
-  unsigned long twopoweri;
-  mpz_t *P;
+  unsigned long twopoweri, nthreads;
+  mpz_t *P, uk;
   mpfr_prec_t *mult;
-  int i, k, loop;
+  mpfr_exp_rational_task_t *tasks;
+  int i, k, loop, n, nw;
   int prec_x;
   mpfr_prec_t realprec, Prec;
   int iter;
@@ -237,6 +258,7 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpfr_init2 (t, Prec);
   mpfr_init2 (tmp, Prec);
   mpz_init (uk);
+  nthreads = mpfr_get_bs_threads ();
 
   /* Main loop */
   MPFR_ZIV_INIT (ziv_loop, realprec);
@@ -249,40 +271,97 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       /* now we have to extract */
       twopoweri = GMP_NUMB_BITS;
+      iter = (k <= prec_x) ? k : prec_x;
 
-      /* Allocate tables */
-      P    = (mpz_t*) mpfr_allocate_func (3*(k+2)*sizeof(mpz_t));
-      for (i = 0; i < 3*(k+2); i++)
+      /* Allocate tables: one set for each part if they are computed in
+         parallel, a single one otherwise */
+      nw = nthreads >= 2 ? iter + 1 : 1;
+      P    = (mpz_t*) mpfr_allocate_func (nw*3*(k+2)*sizeof(mpz_t));
+      for (i = 0; i < nw*3*(k+2); i++)
         mpz_init (P[i]);
-      mult = (mpfr_prec_t*) mpfr_allocate_func (2*(k+2)*sizeof(mpfr_prec_t));
-
-      /* Particular case for i==0 */
-      mpfr_extract (uk, x_copy, 0);
-      MPFR_ASSERTD (mpz_cmp_ui (uk, 0) != 0);
-      mpfr_exp_rational (tmp, uk, shift + twopoweri - ttt, k + 1, P, mult);
-      for (loop = 0; loop < shift; loop++)
-        mpfr_sqr (tmp, tmp, MPFR_RNDD);
-      twopoweri *= 2;
+      mult = (mpfr_prec_t*) mpfr_allocate_func (nw*2*(k+2)*
+                                                sizeof(mpfr_prec_t));
 
-      /* General case */
-      iter = (k <= prec_x) ? k : prec_x;
-      for (i = 1; i <= iter; i++)
+      if (nthreads < 2)
         {
-          mpfr_extract (uk, x_copy, i);
-          if (MPFR_LIKELY (mpz_cmp_ui (uk, 0) != 0))
+          /* Multiply each part into tmp as soon as it is computed, so that
+             only one part is in memory at a time. */
+
+          /* Particular case for i==0 */
+          mpfr_extract (uk, x_copy, 0);
+          MPFR_ASSERTD (mpz_cmp_ui (uk, 0) != 0);
+          mpfr_exp_rational (tmp, uk, shift + twopoweri - ttt, k + 1, P,
+                             mult);
+          for (loop = 0; loop < shift; loop++)
+            mpfr_sqr (tmp, tmp, MPFR_RNDD);
+          twopoweri *= 2;
+
+          /* General case */
+          for (i = 1; i <= iter; i++)
+            {
+              mpfr_extract (uk, x_copy, i);
+              if (MPFR_LIKELY (mpz_cmp_ui (uk, 0) != 0))
+                {
+                  mpfr_exp_rational (t, uk, twopoweri - ttt, k  - i + 1,
+                                     P, mult);
+                  mpfr_mul (tmp, tmp, t, MPFR_RNDD);
+                }
+              MPFR_ASSERTN (twopoweri <= LONG_MAX/2);
+              twopoweri *=2;
+            }
+        }
+      else
+        {
+          tasks = (mpfr_exp_rational_task_t *)
+            mpfr_allocate_func ((iter+1)*sizeof(mpfr_exp_rational_task_t));
+
+          /* Extract the parts: the particular case i==0 is the only one
+             that cannot be zero */
+          for (i = n = 0; i <= iter; i++)
+            {
+              mpz_init (tasks[n].p);
+              mpfr_extract (tasks[n].p, x_copy, i);
+              MPFR_ASSERTD (i > 0 || mpz_cmp_ui (tasks[n].p, 0) != 0);
+              if (MPFR_LIKELY (mpz_cmp_ui (tasks[n].p, 0) != 0))
+                {
+                  mpfr_init2 (tasks[n].y, Prec);
+                  tasks[n].r = (i == 0 ? shift : 0) + twopoweri - ttt;
+                  tasks[n].m = k - i + 1;
+                  tasks[n].Q = P + n*3*(k+2);
+                  tasks[n].mult = mult + n*2*(k+2);
+                  n++;
+                }
+              else
+                mpz_clear (tasks[n].p);
+              if (i > 0)
+                MPFR_ASSERTN (twopoweri <= LONG_MAX/2);
+              twopoweri *=2;
+            }
+
+          mpfr_bs_run (mpfr_exp_rational_task, tasks,
+                       sizeof (mpfr_exp_rational_task_t), n, nthreads,
+                       Prec / GMP_NUMB_BITS);
+
+          /* same operations as above, thus the same result */
+          mpfr_swap (tmp, tasks[0].y);
+          for (loop = 0; loop < shift; loop++)
+            mpfr_sqr (tmp, tmp, MPFR_RNDD);
+          for (i = 1; i < n; i++)
+            mpfr_mul (tmp, tmp, tasks[i].y, MPFR_RNDD);
+
+          for (i = 0; i < n; i++)
             {
-              mpfr_exp_rational (t, uk, twopoweri - ttt, k  - i + 1, P, mult);
-              mpfr_mul (tmp, tmp, t, MPFR_RNDD);
+              mpfr_clear (tasks[i].y);
+              mpz_clear (tasks[i].p);
             }
-          MPFR_ASSERTN (twopoweri <= LONG_MAX/2);
-          twopoweri *=2;
+          mpfr_free_func (tasks, (iter+1)*sizeof(mpfr_exp_rational_task_t));
         }
 
       /* Clear tables */
-      for (i = 0; i < 3*(k+2); i++)
+      for (i = 0; i < nw*3*(k+2); i++)
         mpz_clear (P[i]);
-      mpfr_free_func (P, 3*(k+2)*sizeof(mpz_t));
-      mpfr_free_func (mult, 2*(k+2)*sizeof(mpfr_prec_t));
+      mpfr_free_func (P, nw*3*(k+2)*sizeof(mpz_t));
+      mpfr_free_func (mult, nw*2*(k+2)*sizeof(mpfr_prec_t));
 
       if (shift_x > 0)
         {
@@ -161,6 +161,7 @@ mpfr_exp_2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   /* if |x| >> 1, take into account the cancelled bits */
   if (expx > 0)
     q += expx;
+  MPFR_ZIV_ADAPT (loop, q);
 
   /* Even with to the mpfr_prec_round below, it is possible to use
      the MPFR_GROUP_* macros here because mpfr_prec_round is only
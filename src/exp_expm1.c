@@ -0,0 +1,167 @@
+/* mpfr_exp_expm1 -- exponential and exponential minus one
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* Both results are obtained from a single Ziv loop:
+   * if x > -1, exp(x) = 1 + expm1(x), where 1 + expm1(x) > 1/e does not
+     suffer from a cancellation;
+   * if x <= -1, expm1(x) = exp(x) - 1, where exp(x) <= 1/e.
+   A result that cannot be rounded after two iterations (this can happen
+   for tiny x, where exp(x) is very close to 1), or when an exception
+   occurs in the extended exponent range, is computed separately by
+   mpfr_exp or mpfr_expm1, which handle these cases. */
+
+int
+mpfr_exp_expm1 (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xc, e, t;
+  mpfr_prec_t N;
+  int inex_y = 0, inex_z = 0, ok_y = 0, ok_z = 0, copied = 0, iter;
+
+  MPFR_ASSERTN (y != z);
+
+  MPFR_LOG_FUNC
+    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
+     ("exp[%Pd]=%.*Rg expm1[%Pd]=%.*Rg",
+      mpfr_get_prec (y), mpfr_log_prec, y,
+      mpfr_get_prec (z), mpfr_log_prec, z));
+
+  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+    {
+      if (MPFR_IS_NAN (x))
+        {
+          MPFR_SET_NAN (y);
+          MPFR_SET_NAN (z);
+          MPFR_RET_NAN;
+        }
+      else if (MPFR_IS_INF (x))
+        {
+          if (MPFR_IS_POS (x)) /* exp(+Inf) = expm1(+Inf) = +Inf */
+            {
+              MPFR_SET_INF (y);
+              MPFR_SET_POS (y);
+              MPFR_SET_INF (z);
+              MPFR_SET_POS (z);
+              MPFR_RET (0);
+            }
+          else /* exp(-Inf) = +0, expm1(-Inf) = -1 */
+            {
+              MPFR_SET_ZERO (y);
+              MPFR_SET_POS (y);
+              inex_z = mpfr_set_si (z, -1, rnd_mode);
+              return INEX (0, inex_z);
+            }
+        }
+      else /* x is zero: exp(0) = 1, expm1(0) = 0 with the sign of x */
+        {
+          MPFR_ASSERTD (MPFR_IS_ZERO (x));
+          /* z first, in case y = x */
+          MPFR_SET_ZERO (z);
+          MPFR_SET_SAME_SIGN (z, x);
+          inex_y = mpfr_set_ui (y, 1, rnd_mode);
+          return INEX (inex_y, 0);
+        }
+    }
+
+  /* The fallbacks below need x after one of the results has been set. */
+  if (y == x || z == x)
+    {
+      mpfr_init2 (xc, MPFR_PREC (x));
+      mpfr_set (xc, x, MPFR_RNDN); /* exact */
+      x = xc;
+      copied = 1;
+    }
+
+  N = MAX (MPFR_PREC (y), MPFR_PREC (z));
+  /* For |x| < 2^(-N), exp(x) cannot be rounded from 1 + expm1(x) at a
+     reasonable precision: use the fast paths of the separate functions. */
+  if (MPFR_GET_EXP (x) >= - (mpfr_exp_t) N)
+    {
+      MPFR_ZIV_DECL (loop);
+      MPFR_SAVE_EXPO_DECL (expo);
+      MPFR_GROUP_DECL (group);
+
+      MPFR_SAVE_EXPO_MARK (expo);
+
+      N += MPFR_INT_CEIL_LOG2 (N) + 6;
+      MPFR_GROUP_INIT_2 (group, N, e, t);
+
+      MPFR_ZIV_INIT (loop, N);
+      for (iter = 0; ; iter++)
+        {
+          MPFR_BLOCK_DECL (flags);
+
+          if (MPFR_IS_POS (x) || MPFR_GET_EXP (x) <= 0) /* x > -1 */
+            {
+              /* The error on t is at most 1/2 ulp(t), and since
+                 |expm1(x)| < 2 exp(x), ulp(t) <= 2 ulp(e), thus the
+                 error on e is at most 3/2 ulp(e). */
+              MPFR_BLOCK (flags, mpfr_expm1 (t, x, MPFR_RNDN));
+              mpfr_add_ui (e, t, 1, MPFR_RNDN);
+            }
+          else
+            {
+              /* The error on e is at most 1/2 ulp(e), and since
+                 exp(x) <= 1/e, ulp(e) <= ulp(t)/2, thus the error on t
+                 is at most 3/4 ulp(t). */
+              MPFR_BLOCK (flags, mpfr_exp (e, x, MPFR_RNDN));
+              mpfr_sub_ui (t, e, 1, MPFR_RNDN);
+            }
+
+          if (MPFR_OVERFLOW (flags) || MPFR_UNDERFLOW (flags))
+            {
+              ok_y = ok_z = 0;
+              break;
+            }
+          ok_y = MPFR_CAN_ROUND (e, N - 1, MPFR_PREC (y), rnd_mode);
+          ok_z = MPFR_CAN_ROUND (t, N - 1, MPFR_PREC (z), rnd_mode);
+          if ((ok_y && ok_z) || iter == 1)
+            break;
+          MPFR_ZIV_NEXT (loop, N);
+          MPFR_GROUP_REPREC_2 (group, N, e, t);
+        }
+      MPFR_ZIV_FREE (loop);
+
+      if (ok_y)
+        inex_y = mpfr_set (y, e, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_set (z, t, rnd_mode);
+      MPFR_GROUP_CLEAR (group);
+      MPFR_SAVE_EXPO_FREE (expo);
+
+      if (ok_y)
+        inex_y = mpfr_check_range (y, inex_y, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_check_range (z, inex_z, rnd_mode);
+    }
+
+  if (! ok_y)
+    inex_y = mpfr_exp (y, x, rnd_mode);
+  if (! ok_z)
+    inex_z = mpfr_expm1 (z, x, rnd_mode);
+
+  if (copied)
+    mpfr_clear (xc);
+  return INEX (inex_y, inex_z);
+}
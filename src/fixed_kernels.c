@@ -0,0 +1,676 @@
+/* mpfr_exp_fixed, mpfr_log_fixed, mpfr_sincos_fixed -- table-driven
+   kernels in fixed-point arithmetic for small precisions
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+#ifdef MPFR_FIXED_MAXPREC
+
+/* The functions of this file compute exp(x), log(x), sin(x) and cos(x)
+   for a target precision of at most MPFR_FIXED_MAXPREC bits, with a single
+   evaluation in fixed-point arithmetic on FX_F limbs after the binary
+   point, i.e., FX_BITS >= MPFR_FIXED_MAXPREC + 32 bits, instead of a Ziv
+   loop on mpfr_t numbers.
+
+   A "fraction" is an array of FX_F limbs, representing a number in [0,1)
+   in units of 2^(-FX_BITS), called ulps below. A "wide" number has one
+   more limb for the integer part (FX_N limbs), possibly in two's
+   complement. After the usual argument reduction, the argument is reduced
+   further with a table, so that a polynomial of small degree is enough,
+   which is evaluated by Horner's rule with one FX_F x FX_F limb product
+   per step. The tables are computed at the first call in each thread and
+   freed by mpfr_free_cache.
+
+   The final error is at most 2^FX_ERR ulps, and the result is rounded
+   only if MPFR_CAN_ROUND succeeds. Otherwise these functions return 0
+   and the caller falls back to its general algorithm: this happens for
+   about one input out of 2^(FX_BITS-FX_ERR-MPFR_FIXED_MAXPREC), and when
+   the result is too small compared to the absolute error, e.g., log(x)
+   for x very close to 1, or sin(x) for x very close to a multiple of Pi.
+   Since none of the results computed here can be exact, a nonzero
+   ternary value always means success; for this reason, MPFR_RNDF is
+   replaced by MPFR_RNDZ, since mpfr_set may return 0 in this mode. These
+   functions must be called in the extended exponent range. */
+
+#define FX_F ((MPFR_FIXED_MAXPREC - 1) / GMP_NUMB_BITS + 2)
+#define FX_N (FX_F + 1)
+#define FX_BITS ((mpfr_prec_t) FX_F * GMP_NUMB_BITS)
+#define FX_ERR 5
+
+/* bound on the exponent of the input of mpfr_exp_fixed and
+   mpfr_sincos_fixed, and on the absolute value of the one of the input of
+   mpfr_log_fixed, so that the integer parts fit in a limb */
+#define FX_EMAX 30
+
+/* working precision for the computation of the tables */
+#define FX_TAB_PREC (FX_BITS + 2 * GMP_NUMB_BITS)
+
+/* a <- b * c truncated, where a, b, c are fractions (a may be b or c),
+   with an error less than 1 ulp */
+static void
+fx_mul (mp_limb_t *a, const mp_limb_t *b, const mp_limb_t *c)
+{
+  mp_limb_t t[2 * FX_F];
+
+  mpn_mul_n (t, b, c, FX_F);
+  MPN_COPY (a, t + FX_F, FX_F);
+}
+
+/* Set {a, n} to |x| * 2^FX_BITS truncated, i.e., to |x| with an error less
+   than 1 ulp, where x is zero or regular, |x| < 2^(GMP_NUMB_BITS*(n-FX_F))
+   and n <= FX_N + 1. Only the limbs of x that matter are read. */
+static void
+fx_set (mp_limb_t *a, mp_size_t n, mpfr_srcptr x)
+{
+  mp_limb_t t[FX_N + 3];
+  mp_limb_t *xp = MPFR_MANT (x);
+  mp_size_t xn = MPFR_LIMB_SIZE (x), j;
+  mpfr_exp_t s, q;
+  int r;
+
+  MPFR_ASSERTD (n <= FX_N + 1);
+  MPN_ZERO (a, n);
+  if (MPFR_IS_ZERO (x))
+    return;
+  if (xn > n + 1)
+    {
+      xp += xn - (n + 1);
+      xn = n + 1;
+    }
+  /* |x| = {xp, xn} * 2^(s - FX_BITS), up to the limbs that were ignored */
+  s = MPFR_GET_EXP (x) + (mpfr_exp_t) (FX_F - xn) * GMP_NUMB_BITS;
+  if (s <= - (mpfr_exp_t) xn * GMP_NUMB_BITS)
+    return;
+  q = s / GMP_NUMB_BITS;
+  r = (int) (s % GMP_NUMB_BITS);
+  if (r < 0)
+    {
+      r += GMP_NUMB_BITS;
+      q--;
+    }
+  if (r != 0)
+    t[xn] = mpn_lshift (t, xp, xn, r);
+  else
+    {
+      MPN_COPY (t, xp, xn);
+      t[xn] = 0;
+    }
+  for (j = 0; j <= xn; j++)
+    if (j + q >= 0 && j + q < n)
+      a[j + q] = t[j];
+    else
+      MPFR_ASSERTD (j + q < n || t[j] == 0);
+}
+
+/* Make t be (-1)^neg * {a, n} * 2^(-FX_BITS), where {a, n} is nonnegative
+   and has an error of at most 2^FX_ERR ulps, the significand of t being a
+   (which is modified). Return non-zero iff t can be rounded to the
+   precision of y in the rounding mode rnd. */
+static int
+fx_can_round (mpfr_ptr t, mp_limb_t *a, mp_size_t n, int neg, mpfr_ptr y,
+              mpfr_rnd_t rnd)
+{
+  mpfr_exp_t e;
+  int cnt;
+
+  MPN_NORMALIZE (a, n);
+  if (n == 0)
+    return 0;
+  count_leading_zeros (cnt, a[n - 1]);
+  if (cnt != 0)
+    mpn_lshift (a, a, n, cnt);
+  e = (mpfr_exp_t) n * GMP_NUMB_BITS - cnt - FX_BITS;
+  MPFR_TMP_INIT1 (a, t, (mpfr_prec_t) n * GMP_NUMB_BITS);
+  MPFR_SET_EXP (t, e);
+  if (neg)
+    MPFR_SET_NEG (t);
+  return MPFR_CAN_ROUND (t, e + FX_BITS - FX_ERR, MPFR_PREC (y), rnd);
+}
+
+/* Return the smallest n such that 2^(-b*n)/n! if fact is non-zero, or
+   2^(-b*n) otherwise, is less than 2^(-FX_BITS-3), i.e., the degree of
+   the first term that can be neglected in a series of argument less than
+   2^(-b). */
+static int
+fx_degree (int b, int fact)
+{
+  mpfr_prec_t bits = 0;
+  int n = 0;
+
+  while (bits < FX_BITS + 3)
+    {
+      n++;
+      bits += b;
+      if (fact)
+        bits += MPFR_INT_CEIL_LOG2 (n + 1) - 1; /* floor(log2(n)) */
+    }
+  return n;
+}
+
+/* Tables for exp: expm1(j/2^8) for 0 <= j < 178 (since log(2) < 178/2^8),
+   expm1(j/2^16) for 0 <= j < 2^8, log(2), 1/log(2) with one limb for the
+   integer part and FX_F+1 limbs after the binary point, and 1/i! for
+   2 <= i < fx_exp_deg. */
+#define FX_EXP_T1 0
+#define FX_EXP_T2 (FX_EXP_T1 + 178 * FX_F)
+#define FX_EXP_LOG2 (FX_EXP_T2 + 256 * FX_F)
+#define FX_EXP_INVLOG2 (FX_EXP_LOG2 + FX_F)
+#define FX_EXP_COEFF (FX_EXP_INVLOG2 + FX_F + 2)
+
+/* Tables for log: -log(c_j) for 0 <= j < 2^8 where c_j = C_j/2^16 with
+   C_j = floor(2^24/(2^8+j+1)), log1p(j/2^16) for 0 <= j < FX_LOG_T2_SIZE,
+   log(2) with FX_F+1 limbs, and 1/i for 2 <= i < fx_log_deg. */
+#define FX_LOG_T2_SIZE 259
+#define FX_LOG_T1 0
+#define FX_LOG_T2 (FX_LOG_T1 + 256 * FX_F)
+#define FX_LOG_LOG2 (FX_LOG_T2 + FX_LOG_T2_SIZE * FX_F)
+#define FX_LOG_COEFF (FX_LOG_LOG2 + FX_F + 1)
+
+/* Tables for sin and cos: sin(j/2^7) and 1-cos(j/2^7) for 0 <= j <= 100
+   (since Pi/4 < 101/2^7), 2/Pi with FX_F+1 limbs, Pi/2 as a wide number,
+   then 1/(2i+1)! for 1 <= i <= fx_sin_deg and 1/(2i)! for
+   1 <= i <= fx_cos_deg. */
+#define FX_TRIG_SIN 0
+#define FX_TRIG_COS (FX_TRIG_SIN + 101 * FX_F)
+#define FX_TRIG_TWOOPI (FX_TRIG_COS + 101 * FX_F)
+#define FX_TRIG_PIO2 (FX_TRIG_TWOOPI + FX_F + 1)
+#define FX_TRIG_COEFF (FX_TRIG_PIO2 + FX_N)
+
+static MPFR_THREAD_ATTR mp_limb_t *fx_exp_tab = NULL;
+static MPFR_THREAD_ATTR size_t fx_exp_size;
+static MPFR_THREAD_ATTR int fx_exp_deg;
+static MPFR_THREAD_ATTR mp_limb_t *fx_log_tab = NULL;
+static MPFR_THREAD_ATTR size_t fx_log_size;
+static MPFR_THREAD_ATTR int fx_log_deg;
+static MPFR_THREAD_ATTR mp_limb_t *fx_trig_tab = NULL;
+static MPFR_THREAD_ATTR size_t fx_trig_size;
+static MPFR_THREAD_ATTR int fx_sin_deg, fx_cos_deg;
+
+/* Set the FX_F limbs a to the coefficients 1/i (or 1/i! if fact is
+   non-zero) for i = i0, i0 + step, ..., i1, in this order, where
+   fact is non-zero only if step is 1 or 2. */
+static void
+fx_set_coeffs (mp_limb_t *a, int i0, int i1, int step, int fact, mpfr_ptr v)
+{
+  int i, k;
+
+  mpfr_set_ui (v, 1, MPFR_RNDN);
+  for (i = fact ? 2 : i0; i <= i1; i++)
+    {
+      if (! fact)
+        mpfr_set_ui (v, 1, MPFR_RNDN);
+      mpfr_div_ui (v, v, i, MPFR_RNDN);
+      if (i >= i0 && (i - i0) % step == 0)
+        {
+          k = (i - i0) / step;
+          fx_set (a + k * FX_F, FX_F, v);
+        }
+    }
+}
+
+static mp_limb_t *
+fx_exp_init (void)
+{
+  mpfr_t v, e1;
+  mp_limb_t *tab;
+  int j;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  fx_exp_deg = fx_degree (16, 1);
+  fx_exp_size = (FX_EXP_COEFF + (fx_exp_deg - 2) * FX_F)
+    * MPFR_BYTES_PER_MP_LIMB;
+  tab = (mp_limb_t *) mpfr_allocate_func (fx_exp_size);
+  mpfr_init2 (v, FX_TAB_PREC);
+  mpfr_init2 (e1, FX_TAB_PREC);
+
+  /* exp(j/2^8) = exp(1/2^8)^j, with an error much less than 1 ulp */
+  mpfr_set_ui_2exp (v, 1, -8, MPFR_RNDN);
+  mpfr_exp (e1, v, MPFR_RNDN);
+  mpfr_set_ui (v, 1, MPFR_RNDN);
+  for (j = 0; j < 178; j++)
+    {
+      mpfr_sub_ui (v, v, 1, MPFR_RNDN);
+      fx_set (tab + FX_EXP_T1 + j * FX_F, FX_F, v);
+      mpfr_add_ui (v, v, 1, MPFR_RNDN);
+      mpfr_mul (v, v, e1, MPFR_RNDN);
+    }
+  mpfr_set_ui_2exp (v, 1, -16, MPFR_RNDN);
+  mpfr_exp (e1, v, MPFR_RNDN);
+  mpfr_set_ui (v, 1, MPFR_RNDN);
+  for (j = 0; j < 256; j++)
+    {
+      mpfr_sub_ui (v, v, 1, MPFR_RNDN);
+      fx_set (tab + FX_EXP_T2 + j * FX_F, FX_F, v);
+      mpfr_add_ui (v, v, 1, MPFR_RNDN);
+      mpfr_mul (v, v, e1, MPFR_RNDN);
+    }
+
+  mpfr_const_log2 (v, MPFR_RNDN);
+  fx_set (tab + FX_EXP_LOG2, FX_F, v);
+  mpfr_ui_div (v, 1, v, MPFR_RNDN);
+  mpfr_mul_2ui (v, v, GMP_NUMB_BITS, MPFR_RNDN);
+  fx_set (tab + FX_EXP_INVLOG2, FX_F + 2, v);
+
+  fx_set_coeffs (tab + FX_EXP_COEFF, 2, fx_exp_deg - 1, 1, 1, v);
+
+  mpfr_clear (v);
+  mpfr_clear (e1);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return fx_exp_tab = tab;
+}
+
+static mp_limb_t *
+fx_log_init (void)
+{
+  mpfr_t v;
+  mp_limb_t *tab;
+  int j;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  fx_log_deg = fx_degree (14, 0);
+  fx_log_size = (FX_LOG_COEFF + (fx_log_deg - 2) * FX_F)
+    * MPFR_BYTES_PER_MP_LIMB;
+  tab = (mp_limb_t *) mpfr_allocate_func (fx_log_size);
+  mpfr_init2 (v, FX_TAB_PREC);
+
+  for (j = 0; j < 256; j++)
+    {
+      /* -log(C_j/2^16) = log(2^16/C_j) */
+      mpfr_set_ui_2exp (v, 1, 16, MPFR_RNDN);
+      mpfr_div_ui (v, v, 0x1000000 / (257 + j), MPFR_RNDN);
+      mpfr_log (v, v, MPFR_RNDN);
+      fx_set (tab + FX_LOG_T1 + j * FX_F, FX_F, v);
+    }
+  for (j = 0; j < FX_LOG_T2_SIZE; j++)
+    {
+      mpfr_set_ui_2exp (v, j, -16, MPFR_RNDN);
+      mpfr_log1p (v, v, MPFR_RNDN);
+      fx_set (tab + FX_LOG_T2 + j * FX_F, FX_F, v);
+    }
+
+  mpfr_const_log2 (v, MPFR_RNDN);
+  mpfr_mul_2ui (v, v, GMP_NUMB_BITS, MPFR_RNDN);
+  fx_set (tab + FX_LOG_LOG2, FX_F + 1, v);
+
+  fx_set_coeffs (tab + FX_LOG_COEFF, 2, fx_log_deg - 1, 1, 0, v);
+
+  mpfr_clear (v);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return fx_log_tab = tab;
+}
+
+static mp_limb_t *
+fx_trig_init (void)
+{
+  mpfr_t s, c, s1, c1, t;
+  mp_limb_t *tab;
+  int j, n;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  n = fx_degree (7, 1);
+  fx_sin_deg = (n - 2) / 2;
+  fx_cos_deg = (n - 1) / 2;
+  fx_trig_size = (FX_TRIG_COEFF + (fx_sin_deg + fx_cos_deg) * FX_F)
+    * MPFR_BYTES_PER_MP_LIMB;
+  tab = (mp_limb_t *) mpfr_allocate_func (fx_trig_size);
+  mpfr_inits2 (FX_TAB_PREC, s, c, s1, c1, t, (mpfr_ptr) 0);
+
+  /* (cos(j/2^7), sin(j/2^7)) by successive rotations of angle 1/2^7 */
+  mpfr_set_ui_2exp (t, 1, -7, MPFR_RNDN);
+  mpfr_sin_cos (s1, c1, t, MPFR_RNDN);
+  mpfr_set_ui (s, 0, MPFR_RNDN);
+  mpfr_set_ui (c, 1, MPFR_RNDN);
+  for (j = 0; j <= 100; j++)
+    {
+      fx_set (tab + FX_TRIG_SIN + j * FX_F, FX_F, s);
+      mpfr_ui_sub (t, 1, c, MPFR_RNDN);
+      fx_set (tab + FX_TRIG_COS + j * FX_F, FX_F, t);
+      mpfr_mul (t, s, s1, MPFR_RNDN);
+      mpfr_mul (s, s, c1, MPFR_RNDN);
+      mpfr_fma (s, c, s1, s, MPFR_RNDN);
+      mpfr_fms (c, c, c1, t, MPFR_RNDN);
+    }
+
+  mpfr_const_pi (t, MPFR_RNDN);
+  mpfr_div_2ui (t, t, 1, MPFR_RNDN);
+  fx_set (tab + FX_TRIG_PIO2, FX_N, t);
+  mpfr_ui_div (t, 1, t, MPFR_RNDN);
+  mpfr_mul_2ui (t, t, GMP_NUMB_BITS, MPFR_RNDN);
+  fx_set (tab + FX_TRIG_TWOOPI, FX_F + 1, t);
+
+  fx_set_coeffs (tab + FX_TRIG_COEFF, 3, 2 * fx_sin_deg + 1, 2, 1, t);
+  fx_set_coeffs (tab + FX_TRIG_COEFF + fx_sin_deg * FX_F, 2, 2 * fx_cos_deg,
+                 2, 1, t);
+
+  mpfr_clears (s, c, s1, c1, t, (mpfr_ptr) 0);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return fx_trig_tab = tab;
+}
+
+void
+mpfr_fixed_freecache (void)
+{
+  if (fx_exp_tab != NULL)
+    {
+      mpfr_free_func (fx_exp_tab, fx_exp_size);
+      fx_exp_tab = NULL;
+    }
+  if (fx_log_tab != NULL)
+    {
+      mpfr_free_func (fx_log_tab, fx_log_size);
+      fx_log_tab = NULL;
+    }
+  if (fx_trig_tab != NULL)
+    {
+      mpfr_free_func (fx_trig_tab, fx_trig_size);
+      fx_trig_tab = NULL;
+    }
+}
+
+/* Set y to exp(x) for x regular, if it can be rounded. */
+int
+mpfr_exp_fixed (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mp_limb_t xa[FX_N], t[2 * FX_F + 3], u[FX_F], v[FX_F], w[FX_N];
+  mp_limb_t *tab, *r, *tt, cy;
+  mpfr_exp_t k;
+  mpfr_t z;
+  int i, j1, j2;
+
+  MPFR_ASSERTD (MPFR_PREC (y) <= MPFR_FIXED_MAXPREC);
+  if (rnd_mode == MPFR_RNDF)
+    rnd_mode = MPFR_RNDZ;
+  if (MPFR_GET_EXP (x) > FX_EMAX)
+    return 0;
+  tab = fx_exp_tab != NULL ? fx_exp_tab : fx_exp_init ();
+
+  /* |x|/log(2) = t, where the integer part of t is in tt[FX_F] and its
+     fractional part in {tt, FX_F}. The error on t is at most 1.45 ulps
+     from the truncation of x, plus 2^(FX_EMAX-GMP_NUMB_BITS) <= 1/4 ulp
+     from the error on 1/log(2), plus 1 ulp for the truncation. */
+  fx_set (xa, FX_N, x);
+  mpn_mul (t, tab + FX_EXP_INVLOG2, FX_F + 2, xa, FX_N);
+  tt = t + FX_F + 1;
+  MPFR_ASSERTD (tt[FX_F + 1] == 0);
+  k = (mpfr_exp_t) tt[FX_F];
+  /* x = (k + f) log(2) with 0 <= f < 1 */
+  if (MPFR_IS_NEG (x))
+    k = mpn_neg (tt, tt, FX_F) ? - k - 1 : - k;
+
+  /* r = f log(2) in [0, log(2)), with an error at most 2.7*log(2) + 1 + 1
+     < 4 ulps; then r = j1/2^8 + j2/2^16 + r', with r' < 2^(-16) */
+  r = t;
+  fx_mul (r, tt, tab + FX_EXP_LOG2);
+  j1 = (int) (r[FX_F - 1] >> (GMP_NUMB_BITS - 8));
+  j2 = (int) (r[FX_F - 1] >> (GMP_NUMB_BITS - 16)) & 0xff;
+  r[FX_F - 1] &= MPFR_LIMB_MASK (GMP_NUMB_BITS - 16);
+  MPFR_ASSERTD (j1 < 178);
+
+  /* u = expm1(r') = r' + r'^2 (1/2! + r'/3! + ...), with an error at most
+     2 ulps for Horner's rule, plus 2 ulps for the last products, plus
+     2^(-3) ulp for the neglected terms */
+  MPN_COPY (u, tab + FX_EXP_COEFF + (fx_exp_deg - 3) * FX_F, FX_F);
+  for (i = fx_exp_deg - 2; i >= 2; i--)
+    {
+      fx_mul (u, u, r);
+      mpn_add_n (u, u, tab + FX_EXP_COEFF + (i - 2) * FX_F, FX_F);
+    }
+  fx_mul (u, u, r);
+  fx_mul (u, u, r);
+  cy = mpn_add_n (u, u, r, FX_F);
+
+  /* exp(r) = (1 + a)(1 + b)(1 + u) = 1 + v, where a and b are given by the
+     tables with an error at most 1 ulp each. The products and tables give
+     at most 6 ulps, the error on u at most 4.2*2, and the one on r at most
+     4*2, thus the error on v is less than 2^FX_ERR ulps. The sums cannot
+     give any carry, but since v may be very close to 1, we check it. */
+  fx_mul (v, tab + FX_EXP_T1 + j1 * FX_F, tab + FX_EXP_T2 + j2 * FX_F);
+  cy |= mpn_add_n (v, v, tab + FX_EXP_T1 + j1 * FX_F, FX_F);
+  cy |= mpn_add_n (v, v, tab + FX_EXP_T2 + j2 * FX_F, FX_F);
+  fx_mul (w, v, u);
+  cy |= mpn_add_n (v, v, u, FX_F);
+  cy |= mpn_add_n (w, w, v, FX_F);
+  if (cy != 0)
+    return 0;
+
+  /* exp(x) = 2^k (1 + v) */
+  w[FX_F] = 1;
+  if (! fx_can_round (z, w, FX_N, 0, y, rnd_mode))
+    return 0;
+  MPFR_SET_EXP (z, MPFR_GET_EXP (z) + k);
+  return mpfr_set (y, z, rnd_mode);
+}
+
+/* Set y to log(x) for x positive, x <> 1, if it can be rounded. */
+int
+mpfr_log_fixed (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mp_limb_t a[FX_N], w[FX_N], t[FX_N + 1], u[FX_F];
+  mp_limb_t *tab, c, j2;
+  mpfr_exp_t e = MPFR_GET_EXP (x) - 1;
+  mpfr_t x1, z;
+  int i, j, neg;
+
+  MPFR_ASSERTD (MPFR_PREC (y) <= MPFR_FIXED_MAXPREC);
+  if (rnd_mode == MPFR_RNDF)
+    rnd_mode = MPFR_RNDZ;
+  MPFR_ASSERTD (MPFR_IS_POS (x));
+  if (e > FX_EMAX || e < - FX_EMAX)
+    return 0;
+  tab = fx_log_tab != NULL ? fx_log_tab : fx_log_init ();
+
+  /* x = 2^e (1 + a) with 0 <= a < 1, with an error at most 1 ulp on a */
+  MPFR_ALIAS (x1, x, MPFR_SIGN_POS, 1);
+  fx_set (a, FX_N, x1);
+  MPFR_ASSERTD (a[FX_F] == 1);
+
+  /* Let c = C_j/2^16 with C_j = floor(2^24/(2^8+j+1)) where j is given by
+     the first 8 bits of a. Then (1 + a) c = 1 - w with 0 <= w < 2^(-8) +
+     2^(-15). We compute 2^16 (1 - w) exactly, then w with an error at
+     most 1 ulp, plus 1 ulp from the error on a. */
+  j = (int) (a[FX_F - 1] >> (GMP_NUMB_BITS - 8));
+  c = 0x1000000 / (257 + j);
+  a[FX_F] = mpn_mul_1 (a, a, FX_F, c) + c;
+  mpn_neg (a, a, FX_N);
+  a[FX_F] += 0x10000;
+  mpn_rshift (w, a, FX_N, 16);
+  MPFR_ASSERTD (w[FX_F] == 0);
+
+  /* With d = j2/2^16 given by the first 16 bits of w, let
+     1 - w' = (1 - w)(1 + d), i.e., w' = (w - d) + w d < 2^(-14), with an
+     error at most 3 ulps */
+  j2 = w[FX_F - 1] >> (GMP_NUMB_BITS - 16);
+  MPFR_ASSERTD (j2 < FX_LOG_T2_SIZE);
+  t[FX_F] = mpn_mul_1 (t, w, FX_F, j2);
+  mpn_rshift (t, t, FX_F + 1, 16);
+  w[FX_F - 1] &= MPFR_LIMB_MASK (GMP_NUMB_BITS - 16);
+  mpn_add_n (w, w, t, FX_F);
+
+  /* u = -log(1 - w') = w' + w'^2 (1/2 + w'/3 + ...), with an error at most
+     3*(1+2^(-13)) ulps from w', plus 2 ulps for Horner's rule and 2 ulps
+     for the last products */
+  MPN_COPY (u, tab + FX_LOG_COEFF + (fx_log_deg - 3) * FX_F, FX_F);
+  for (i = fx_log_deg - 2; i >= 2; i--)
+    {
+      fx_mul (u, u, w);
+      mpn_add_n (u, u, tab + FX_LOG_COEFF + (i - 2) * FX_F, FX_F);
+    }
+  fx_mul (u, u, w);
+  fx_mul (u, u, w);
+  mpn_add_n (u, u, w, FX_F);
+
+  /* log(x) = e log(2) - log(c) - log(1 + d) - u, computed as a wide number
+     in two's complement, where e log(2) has an error at most
+     2^(FX_EMAX-GMP_NUMB_BITS) + 1 <= 1.25 ulps, and each table entry at
+     most 1 ulp, thus the error is less than 2^FX_ERR ulps. */
+  if (e != 0)
+    {
+      t[FX_F + 1] = mpn_mul_1 (t, tab + FX_LOG_LOG2, FX_F + 1,
+                               (mp_limb_t) (e < 0 ? - e : e));
+      MPN_COPY (a, t + 1, FX_N);
+      if (e < 0)
+        mpn_neg (a, a, FX_N);
+    }
+  else
+    MPN_ZERO (a, FX_N);
+  mpn_add (a, a, FX_N, tab + FX_LOG_T1 + j * FX_F, FX_F);
+  mpn_sub (a, a, FX_N, tab + FX_LOG_T2 + j2 * FX_F, FX_F);
+  mpn_sub (a, a, FX_N, u, FX_F);
+  neg = (a[FX_F] & MPFR_LIMB_HIGHBIT) != 0;
+  if (neg)
+    mpn_neg (a, a, FX_N);
+
+  if (! fx_can_round (z, a, FX_N, neg, y, rnd_mode))
+    return 0;
+  return mpfr_set (y, z, rnd_mode);
+}
+
+/* Set s to sin(x) and c to cos(x) for x regular, where s or c may be NULL,
+   if they can both be rounded. Return INEX(inexs, inexc) like
+   mpfr_sincos_fast. */
+int
+mpfr_sincos_fixed (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x,
+                   mpfr_rnd_t rnd_mode)
+{
+  mp_limb_t xa[FX_N], t[2 * FX_F + 2], ra[2 * FX_F + 1], q[FX_F], sp[FX_F],
+    cp[FX_F], p[FX_F], sv[FX_N], cv[FX_N];
+  mp_limb_t *tab, *tt, *rho, *st, *ct, *coeff, k;
+  mp_limb_t *sa, *ca;
+  mpfr_t zs, zc;
+  int i, j, sr, q4, negs, negc, inexs, inexc;
+
+  MPFR_ASSERTD (s == NULL || MPFR_PREC (s) <= MPFR_FIXED_MAXPREC);
+  MPFR_ASSERTD (c == NULL || MPFR_PREC (c) <= MPFR_FIXED_MAXPREC);
+  if (rnd_mode == MPFR_RNDF)
+    rnd_mode = MPFR_RNDZ;
+  if (MPFR_GET_EXP (x) > FX_EMAX)
+    return 0;
+  tab = fx_trig_tab != NULL ? fx_trig_tab : fx_trig_init ();
+
+  /* |x| 2/Pi = k + f, with an error on f at most 2/Pi ulps from x, plus
+     2^(FX_EMAX-GMP_NUMB_BITS) <= 1/4 ulp from 2/Pi and 1 ulp from the
+     truncation, i.e., less than 1.9 ulps. If f >= 1/2, we replace k by
+     k + 1 and f by 1 - f, and sr = 1 gives the sign of the remainder. */
+  fx_set (xa, FX_N, x);
+  mpn_mul (t, xa, FX_N, tab + FX_TRIG_TWOOPI, FX_F + 1);
+  tt = t + FX_F + 1;
+  k = tt[FX_F];
+  sr = (tt[FX_F - 1] & MPFR_LIMB_HIGHBIT) != 0;
+  if (sr)
+    {
+      k++;
+      mpn_neg (tt, tt, FX_F);
+    }
+
+  /* |x| = k Pi/2 +/- ra where ra = f Pi/2 <= Pi/4, with an error at most
+     1.9*Pi/2 + 1/2 + 1 < 4.5 ulps, then ra = j/2^7 + rho with
+     rho < 2^(-7) */
+  mpn_mul (ra, tab + FX_TRIG_PIO2, FX_N, tt, FX_F);
+  rho = ra + FX_F;
+  MPFR_ASSERTD (rho[FX_F] == 0);
+  j = (int) (rho[FX_F - 1] >> (GMP_NUMB_BITS - 7));
+  rho[FX_F - 1] &= MPFR_LIMB_MASK (GMP_NUMB_BITS - 7);
+  MPFR_ASSERTD (j <= 100);
+
+  /* sp = sin(rho) = rho - rho q (1/3! - q/5! + ...) and
+     cp = 1 - cos(rho) = q (1/2! - q/4! + ...) with q = rho^2, each with
+     an error at most 2 ulps (the error on q is divided by about 6 or 2,
+     and the ones of Horner's rule by 2^14) */
+  fx_mul (q, rho, rho);
+  coeff = tab + FX_TRIG_COEFF;
+  MPN_COPY (sp, coeff + (fx_sin_deg - 1) * FX_F, FX_F);
+  for (i = fx_sin_deg - 2; i >= 0; i--)
+    {
+      fx_mul (sp, sp, q);
+      mpn_sub_n (sp, coeff + i * FX_F, sp, FX_F);
+    }
+  fx_mul (sp, sp, q);
+  fx_mul (sp, sp, rho);
+  mpn_sub_n (sp, rho, sp, FX_F);
+  coeff += fx_sin_deg * FX_F;
+  MPN_COPY (cp, coeff + (fx_cos_deg - 1) * FX_F, FX_F);
+  for (i = fx_cos_deg - 2; i >= 0; i--)
+    {
+      fx_mul (cp, cp, q);
+      mpn_sub_n (cp, coeff + i * FX_F, cp, FX_F);
+    }
+  fx_mul (cp, cp, q);
+
+  /* With st = sin(j/2^7) and ct = 1 - cos(j/2^7), each with an error at
+     most 1 ulp:
+     sin(ra) = st - st cp + sp - ct sp,
+     1 - cos(ra) = ct + cp - ct cp + st sp,
+     with an error at most 1 + 1 + 2 + 1 + 2 = 7 ulps from the above
+     values and products, plus 4.5 ulps from the error on ra, i.e., less
+     than 2^FX_ERR ulps. */
+  st = tab + FX_TRIG_SIN + j * FX_F;
+  ct = tab + FX_TRIG_COS + j * FX_F;
+  fx_mul (p, st, cp);
+  mpn_sub_n (sv, st, p, FX_F);
+  mpn_add_n (sv, sv, sp, FX_F);
+  fx_mul (p, ct, sp);
+  mpn_sub_n (sv, sv, p, FX_F);
+  sv[FX_F] = 0;
+  fx_mul (p, ct, cp);
+  mpn_add_n (cv, ct, cp, FX_F);
+  mpn_sub_n (cv, cv, p, FX_F);
+  fx_mul (p, st, sp);
+  mpn_add_n (cv, cv, p, FX_F);
+  cv[FX_F] = 1 - mpn_neg (cv, cv, FX_F);
+
+  /* sin(|x|) and cos(|x|) from sin(ra) and cos(ra) according to k mod 4 */
+  q4 = (int) (k & 3);
+  if (q4 & 1)
+    {
+      sa = cv;
+      negs = q4 == 3;
+      ca = sv;
+      negc = (q4 == 1) ^ sr;
+    }
+  else
+    {
+      sa = sv;
+      negs = (q4 == 2) ^ sr;
+      ca = cv;
+      negc = q4 == 2;
+    }
+  negs ^= MPFR_IS_NEG (x);
+
+  if ((s != NULL && ! fx_can_round (zs, sa, FX_N, negs, s, rnd_mode)) ||
+      (c != NULL && ! fx_can_round (zc, ca, FX_N, negc, c, rnd_mode)))
+    return 0;
+  inexs = s == NULL ? 0 : mpfr_set (s, zs, rnd_mode);
+  inexc = c == NULL ? 0 : mpfr_set (c, zc, rnd_mode);
+  return INEX (inexs, inexc);
+}
+
+#else
+
+void
+mpfr_fixed_freecache (void)
+{
+}
+
+#endif
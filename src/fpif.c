@@ -63,6 +63,27 @@ If not, see <https://www.gnu.org/licenses/>. */
    start with a null byte. Otherwise the import may fail.
 */
 
+/* The array format (mpfr_fpif_export_array) stores a record of n >= 1
+   numbers as follows, reusing the encodings described above.
+
+   1. We first store n, encoded like a precision.
+
+   2. Then we store one or several runs of consecutive numbers having the
+      same precision, until the n numbers have been stored. A run consists
+      of:
+        * the precision p of its numbers;
+        * the number r >= 1 of numbers of the run, encoded like a precision;
+        * the size (in bytes) of the next item, encoded like a precision;
+        * the r signs and exponents (or special values), encoded as in 2.;
+        * the significands of the regular numbers of the run, encoded as
+          in 3. on ceil(p/8) bytes each, one after another.
+
+   Thus the precision is stored only once per run, and the significands
+   are contiguous. MPFR splits long runs, so that a record can be written
+   and read with a bounded amount of memory, but any run length r may be
+   read. The import never reads beyond the end of the record.
+*/
+
 #define MPFR_MAX_PRECSIZE 7
 #define MPFR_MAX_EMBEDDED_PRECISION (255 - MPFR_MAX_PRECSIZE)
 
@@ -83,35 +104,15 @@ If not, see <https://www.gnu.org/licenses/>. */
     }                                           \
   while ((storage) != 0)
 
-#define ALLOC_RESULT(buffer, buffer_size, wanted_size)                  \
-  do                                                                    \
-    {                                                                   \
-      if ((buffer) == NULL || *(buffer_size) < (wanted_size))           \
-        {                                                               \
-          (buffer) = (unsigned char *) mpfr_reallocate_func             \
-            ((buffer), *(buffer_size), (wanted_size));                  \
-          MPFR_ASSERTN((buffer) != 0);                                  \
-        }                                                               \
-      *(buffer_size) = (wanted_size);                                   \
-    }                                                                   \
-  while (0)
-
-/*
- * size in byte of a MPFR number in a binary object of a variable size
- */
-#define MAX_VARIABLE_STORAGE(exponent_size, precision) \
-  ((size_t)(((precision) >> 3) + (exponent_size) +     \
-            ((precision) > 248 ? sizeof(mpfr_prec_t) : 0) + 3))
-
 /* copy in result[] the values in data[] with a different endianness,
    where data_size might be smaller than data_max_size, so that we only
    copy data_size bytes from the end of data[]. */
 static void
 #if defined (HAVE_BIG_ENDIAN)
-putLittleEndianData (unsigned char *result, unsigned char *data,
+putLittleEndianData (unsigned char *result, const unsigned char *data,
                      size_t data_max_size, size_t data_size)
 #elif defined (HAVE_LITTLE_ENDIAN)
-putBigEndianData (unsigned char *result, unsigned char *data,
+putBigEndianData (unsigned char *result, const unsigned char *data,
                   size_t data_max_size, size_t data_size)
 #endif
 {
@@ -125,10 +126,10 @@ putBigEndianData (unsigned char *result, unsigned char *data,
 /* copy in result[] the values in data[] with the same endianness */
 static void
 #if defined (HAVE_BIG_ENDIAN)
-putBigEndianData (unsigned char *result, unsigned char *data,
+putBigEndianData (unsigned char *result, const unsigned char *data,
                   size_t data_max_size, size_t data_size)
 #elif defined (HAVE_LITTLE_ENDIAN)
-putLittleEndianData (unsigned char *result, unsigned char *data,
+putLittleEndianData (unsigned char *result, const unsigned char *data,
                      size_t data_max_size, size_t data_size)
 #endif
 {
@@ -142,10 +143,10 @@ putLittleEndianData (unsigned char *result, unsigned char *data,
    left untouched). */
 static void
 #if defined (HAVE_BIG_ENDIAN)
-getLittleEndianData (unsigned char *result, unsigned char *data,
+getLittleEndianData (unsigned char *result, const unsigned char *data,
                      size_t data_max_size, size_t data_size)
 #elif defined (HAVE_LITTLE_ENDIAN)
-getBigEndianData (unsigned char *result, unsigned char *data,
+getBigEndianData (unsigned char *result, const unsigned char *data,
                   size_t data_max_size, size_t data_size)
 #endif
 {
@@ -159,10 +160,10 @@ getBigEndianData (unsigned char *result, unsigned char *data,
 /* copy in result[] the values in data[] with the same endianness */
 static void
 #if defined (HAVE_BIG_ENDIAN)
-getBigEndianData (unsigned char *result, unsigned char *data,
+getBigEndianData (unsigned char *result, const unsigned char *data,
                   size_t data_max_size, size_t data_size)
 #elif defined (HAVE_LITTLE_ENDIAN)
-getLittleEndianData (unsigned char *result, unsigned char *data,
+getLittleEndianData (unsigned char *result, const unsigned char *data,
                      size_t data_max_size, size_t data_size)
 #endif
 {
@@ -170,21 +171,17 @@ getLittleEndianData (unsigned char *result, unsigned char *data,
   memcpy (result, data, data_size);
 }
 
-/* End: Low level helper functions */
-
 /* Internal Function */
 /*
- * buffer : OUT : store the precision in binary format, can be null
- *               (may be reallocated if too small)
- * buffer_size : IN/OUT : size of the buffer => size used in the buffer
+ * result : OUT : store the precision in binary format, can be null
  * precision : IN : precision to store
- * return pointer to a buffer storing the precision in binary format
+ * return the size (in bytes) of the precision in binary format
+ * If result is null, only the size is computed. Otherwise result must
+ * have room for this size.
  */
-static unsigned char *
-mpfr_fpif_store_precision (unsigned char *buffer, size_t *buffer_size,
-                           mpfr_prec_t precision)
+static size_t
+mpfr_fpif_store_precision (unsigned char *result, mpfr_prec_t precision)
 {
-  unsigned char *result;
   size_t size_precision;
 
   MPFR_ASSERTD (precision >= 1);
@@ -198,8 +195,8 @@ mpfr_fpif_store_precision (unsigned char *buffer, size_t *buffer_size,
       COUNT_NB_BYTE(copy_precision, size_precision);
     }
 
-  result = buffer;
-  ALLOC_RESULT(result, buffer_size, size_precision + 1);
+  if (result == NULL)
+    return size_precision + 1;
 
   if (precision > MPFR_MAX_EMBEDDED_PRECISION)
     {
@@ -211,38 +208,41 @@ mpfr_fpif_store_precision (unsigned char *buffer, size_t *buffer_size,
   else
     result[0] = precision + MPFR_MAX_PRECSIZE;
 
-  return result;
+  return size_precision + 1;
 }
 
 #define BUFFER_SIZE 8
 
 /*
- * fh : IN : file handler
+ * buffer : IN : precision in binary format
+ * buffer_size : IN : number of bytes available in the buffer
+ * used_size : OUT : number of bytes of the precision in binary format
  * return the precision stored in the binary buffer, 0 in case of error
  */
 static mpfr_prec_t
-mpfr_fpif_read_precision_from_file (FILE *fh)
+mpfr_fpif_read_precision (const unsigned char *buffer, size_t buffer_size,
+                          size_t *used_size)
 {
   mpfr_prec_t precision;
   size_t precision_size;
-  unsigned char buffer[BUFFER_SIZE];
-
-  if (fh == NULL)
-    return 0;
 
-  if (fread (buffer, 1, 1, fh) != 1)
+  if (buffer_size < 1)
     return 0;
 
   precision_size = buffer[0];
   if (precision_size > MPFR_MAX_PRECSIZE)
-    return precision_size - MPFR_MAX_PRECSIZE;
+    {
+      *used_size = 1;
+      return precision_size - MPFR_MAX_PRECSIZE;
+    }
 
   precision_size++;
   MPFR_ASSERTD (precision_size <= BUFFER_SIZE);
 
-  /* Read the precision in little-endian format. */
-  if (fread (buffer, precision_size, 1, fh) != 1)
+  if (buffer_size < precision_size + 1)
     return 0;
+  *used_size = precision_size + 1;
+  buffer++;
 
   /* Justification of the #if below. */
   MPFR_ASSERTD (precision_size <= MPFR_MAX_PRECSIZE + 1);
@@ -277,23 +277,46 @@ mpfr_fpif_read_precision_from_file (FILE *fh)
 }
 
 /*
- * buffer : OUT : store the kind of the MPFR number x, its sign, the size of
+ * fh : IN : file handler
+ * return the precision stored in the binary buffer, 0 in case of error
+ */
+static mpfr_prec_t
+mpfr_fpif_read_precision_from_file (FILE *fh)
+{
+  unsigned char buffer[BUFFER_SIZE + 1];
+  size_t used_size;
+
+  if (fh == NULL)
+    return 0;
+
+  if (fread (buffer, 1, 1, fh) != 1)
+    return 0;
+
+  /* Read the precision in little-endian format. */
+  if (buffer[0] <= MPFR_MAX_PRECSIZE &&
+      fread (buffer + 1, buffer[0] + 1, 1, fh) != 1)
+    return 0;
+
+  return mpfr_fpif_read_precision (buffer, sizeof (buffer), &used_size);
+}
+
+/*
+ * result : OUT : store the kind of the MPFR number x, its sign, the size of
  *                its exponent and its exponent value in a binary format,
- *                can be null (may be reallocated if too small)
- * buffer_size : IN/OUT : size of the buffer => size used in the buffer
+ *                can be null
  * x : IN : MPFR number
- * return pointer to a buffer storing the kind of the MPFR number x, its sign,
- *        the size of its exponent and its exponent value in a binary format,
+ * return the size (in bytes) of the kind of the MPFR number x, its sign,
+ *        the size of its exponent and its exponent value in a binary format
+ * If result is null, only the size is computed. Otherwise result must
+ * have room for this size.
  */
 /* TODO
  *   Exponents that use more than 16 bytes are not managed (not an issue
  *   until one has integer types larger than 128 bits).
  */
-static unsigned char*
-mpfr_fpif_store_exponent (unsigned char *buffer, size_t *buffer_size,
-                          mpfr_srcptr x)
+static size_t
+mpfr_fpif_store_exponent (unsigned char *result, mpfr_srcptr x)
 {
-  unsigned char *result;
   mpfr_uexp_t uexp;
   size_t exponent_size;
 
@@ -329,8 +352,8 @@ mpfr_fpif_store_exponent (unsigned char *buffer, size_t *buffer_size,
         uexp = exponent + MPFR_MAX_EMBEDDED_EXPONENT;
     }
 
-  result = buffer;
-  ALLOC_RESULT(result, buffer_size, exponent_size + 1);
+  if (result == NULL)
+    return exponent_size + 1;
 
   if (MPFR_IS_PURE_FP (x))
     {
@@ -358,12 +381,14 @@ mpfr_fpif_store_exponent (unsigned char *buffer, size_t *buffer_size,
   if (MPFR_IS_NEG (x))
     result[0] |= 0x80;
 
-  return result;
+  return exponent_size + 1;
 }
 
 /*
  * x : OUT : MPFR number extracted from the binary buffer
- * fh : IN : file handler (should not be NULL)
+ * buffer : IN : exponent in binary format
+ * buffer_size : IN : number of bytes available in the buffer
+ * used_size : OUT : number of bytes of the exponent in binary format
  * return 0 if successful
  */
 /* TODO
@@ -372,17 +397,15 @@ mpfr_fpif_store_exponent (unsigned char *buffer, size_t *buffer_size,
  *   than 128 bits).
  */
 static int
-mpfr_fpif_read_exponent_from_file (mpfr_ptr x, FILE * fh)
+mpfr_fpif_read_exponent (mpfr_ptr x, const unsigned char *buffer,
+                         size_t buffer_size, size_t *used_size)
 {
   mpfr_exp_t exponent;
   mpfr_uexp_t uexp;
   size_t exponent_size;
   int sign;
-  unsigned char buffer[sizeof(mpfr_exp_t)];
 
-  MPFR_ASSERTD(fh != NULL);
-
-  if (fread (buffer, 1, 1, fh) != 1)
+  if (buffer_size < 1)
     return 1;
 
   /* sign value that can be used with MPFR_SET_SIGN,
@@ -406,11 +429,11 @@ mpfr_fpif_read_exponent_from_file (mpfr_ptr x, FILE * fh)
                          exponent_size > sizeof(mpfr_exp_t)))
         return 1;
 
-      if (MPFR_UNLIKELY (fread (buffer, exponent_size, 1, fh) != 1))
+      if (MPFR_UNLIKELY (buffer_size < exponent_size + 1))
         return 1;
 
       uexp = 0;
-      getLittleEndianData ((unsigned char *) &uexp, buffer,
+      getLittleEndianData ((unsigned char *) &uexp, buffer + 1,
                            sizeof(mpfr_exp_t), exponent_size);
 
       /* Sign bit of the exponent. */
@@ -444,45 +467,86 @@ mpfr_fpif_read_exponent_from_file (mpfr_ptr x, FILE * fh)
   else
     return 1;
 
+  *used_size = exponent_size;
   return 0;
 }
 
 /*
- * buffer : OUT : store the limb of the MPFR number x in a binary format,
- *                can be null (may be reallocated if too small)
- * buffer_size : IN/OUT : size of the buffer => size used in the buffer
+ * x : OUT : MPFR number extracted from the binary buffer
+ * fh : IN : file handler (should not be NULL)
+ * return 0 if successful
+ */
+static int
+mpfr_fpif_read_exponent_from_file (mpfr_ptr x, FILE * fh)
+{
+  size_t exponent_size, used_size;
+  unsigned char buffer[sizeof(mpfr_exp_t) + 1];
+
+  MPFR_ASSERTD(fh != NULL);
+
+  if (fread (buffer, 1, 1, fh) != 1)
+    return 1;
+
+  exponent_size = 0;
+  if ((buffer[0] & 0x7F) > MPFR_EXTERNAL_EXPONENT &&
+      (buffer[0] & 0x7F) < MPFR_KIND_ZERO)
+    {
+      exponent_size = (buffer[0] & 0x7F) - MPFR_EXTERNAL_EXPONENT;
+      /* If the exponent is too large, mpfr_fpif_read_exponent fails
+         from the first byte only. */
+      if (exponent_size > sizeof(mpfr_exp_t))
+        exponent_size = 0;
+      else if (MPFR_UNLIKELY (fread (buffer + 1, exponent_size, 1, fh) != 1))
+        return 1;
+    }
+
+  return mpfr_fpif_read_exponent (x, buffer, exponent_size + 1, &used_size);
+}
+
+/*
+ * result : OUT : store the limb of the MPFR number x in a binary format,
+ *                can be null
  * x : IN : MPFR number
- * return pointer to a buffer storing the limb of the MPFR number x in a binary
+ * return the size (in bytes) of the limb of the MPFR number x in a binary
  *        format
+ * If result is null, only the size is computed. Otherwise result must
+ * have room for this size.
  */
-static unsigned char*
-mpfr_fpif_store_limbs (unsigned char *buffer, size_t *buffer_size,
-                       mpfr_srcptr x)
+static size_t
+mpfr_fpif_store_limbs (unsigned char *result, mpfr_srcptr x)
 {
-  unsigned char *result;
   mpfr_prec_t precision;
   size_t nb_byte;
-  size_t nb_limb, mp_bytes_per_limb;
+  size_t mp_bytes_per_limb;
   size_t nb_partial_byte;
-  size_t i, j;
 
   precision = mpfr_get_prec (x);
   nb_byte = (precision + 7) >> 3;
+  if (result == NULL)
+    return nb_byte;
+
   mp_bytes_per_limb = mp_bits_per_limb >> 3;
   nb_partial_byte = nb_byte % mp_bytes_per_limb;
-  nb_limb = (nb_byte + mp_bytes_per_limb - 1) / mp_bytes_per_limb;
-
-  result = buffer;
-  ALLOC_RESULT(result, buffer_size, nb_byte);
 
   putBigEndianData (result, (unsigned char*) MPFR_MANT(x),
                     sizeof(mp_limb_t), nb_partial_byte);
-  for (i = nb_partial_byte, j = (nb_partial_byte == 0) ? 0 : 1; j < nb_limb;
-       i += mp_bytes_per_limb, j++)
-    putLittleEndianData (result + i, (unsigned char*) (MPFR_MANT(x) + j),
-                         sizeof(mp_limb_t), sizeof(mp_limb_t));
+#if defined (HAVE_LITTLE_ENDIAN)
+  /* The full limbs are stored as in memory. */
+  memcpy (result + nb_partial_byte, MPFR_MANT(x) + (nb_partial_byte != 0),
+          nb_byte - nb_partial_byte);
+#else
+  {
+    size_t nb_limb, i, j;
+
+    nb_limb = (nb_byte + mp_bytes_per_limb - 1) / mp_bytes_per_limb;
+    for (i = nb_partial_byte, j = (nb_partial_byte == 0) ? 0 : 1;
+         j < nb_limb; i += mp_bytes_per_limb, j++)
+      putLittleEndianData (result + i, (unsigned char*) (MPFR_MANT(x) + j),
+                           sizeof(mp_limb_t), sizeof(mp_limb_t));
+  }
+#endif
 
-  return result;
+  return nb_byte;
 }
 
 /*
@@ -493,11 +557,10 @@ mpfr_fpif_store_limbs (unsigned char *buffer, size_t *buffer_size,
  * Assume buffer is not NULL.
  */
 static void
-mpfr_fpif_read_limbs (mpfr_ptr x, unsigned char *buffer, size_t nb_byte)
+mpfr_fpif_read_limbs (mpfr_ptr x, const unsigned char *buffer, size_t nb_byte)
 {
   size_t mp_bytes_per_limb;
   size_t nb_partial_byte;
-  size_t i, j;
 
   MPFR_ASSERTD (buffer != NULL);
 
@@ -510,13 +573,64 @@ mpfr_fpif_read_limbs (mpfr_ptr x, unsigned char *buffer, size_t nb_byte)
       getBigEndianData ((unsigned char*) MPFR_MANT(x), buffer,
                         sizeof(mp_limb_t), nb_partial_byte);
     }
-  for (i = nb_partial_byte, j = (nb_partial_byte == 0) ? 0 : 1; i < nb_byte;
-       i += mp_bytes_per_limb, j++)
-    getLittleEndianData ((unsigned char*) (MPFR_MANT(x) + j), buffer + i,
-                         sizeof(mp_limb_t), sizeof(mp_limb_t));
+#if defined (HAVE_LITTLE_ENDIAN)
+  /* The full limbs are stored as in memory. */
+  memcpy (MPFR_MANT(x) + (nb_partial_byte != 0), buffer + nb_partial_byte,
+          nb_byte - nb_partial_byte);
+#else
+  {
+    size_t i, j;
+
+    for (i = nb_partial_byte, j = (nb_partial_byte == 0) ? 0 : 1;
+         i < nb_byte; i += mp_bytes_per_limb, j++)
+      getLittleEndianData ((unsigned char*) (MPFR_MANT(x) + j), buffer + i,
+                           sizeof(mp_limb_t), sizeof(mp_limb_t));
+  }
+#endif
 }
 
 /* External Function */
+/*
+ * x : IN : MPFR number
+ * return the size (in bytes) of x in the binary format
+ */
+size_t
+mpfr_fpif_size (mpfr_srcptr x)
+{
+  size_t size;
+
+  size = mpfr_fpif_store_precision (NULL, mpfr_get_prec (x))
+    + mpfr_fpif_store_exponent (NULL, x);
+  if (mpfr_regular_p (x))
+    size += mpfr_fpif_store_limbs (NULL, x);
+  return size;
+}
+
+/*
+ * buffer : OUT : buffer where x is stored in the binary format
+ * buffer_size : IN : size of the buffer (in bytes)
+ * x : IN : MPFR number to put in the buffer
+ * return the number of bytes written, 0 if the buffer is too small
+ */
+size_t
+mpfr_fpif_export_buf (void *buffer, size_t buffer_size, mpfr_srcptr x)
+{
+  unsigned char *result = (unsigned char *) buffer;
+  size_t size;
+
+  size = mpfr_fpif_size (x);
+  if (buffer_size < size)
+    return 0;
+
+  buffer_size = mpfr_fpif_store_precision (result, mpfr_get_prec (x));
+  buffer_size += mpfr_fpif_store_exponent (result + buffer_size, x);
+  if (mpfr_regular_p (x))
+    buffer_size += mpfr_fpif_store_limbs (result + buffer_size, x);
+  MPFR_ASSERTD (buffer_size == size);
+
+  return size;
+}
+
 /*
  * fh : IN : file handler
  * x : IN : MPFR number to put in the file
@@ -527,53 +641,66 @@ mpfr_fpif_export (FILE *fh, mpfr_srcptr x)
 {
   int status;
   unsigned char *buf;
-  unsigned char *bufResult;
-  size_t used_size, buf_size;
+  size_t buf_size;
+  MPFR_TMP_DECL(marker);
 
   if (fh == NULL)
     return -1;
 
-  buf_size = MAX_VARIABLE_STORAGE(sizeof(mpfr_exp_t), mpfr_get_prec (x));
-  buf = (unsigned char*) mpfr_allocate_func (buf_size);
-  MPFR_ASSERTN(buf != NULL);
+  MPFR_TMP_MARK(marker);
+  buf_size = mpfr_fpif_size (x);
+  buf = (unsigned char *) MPFR_TMP_ALLOC (buf_size);
+  mpfr_fpif_export_buf (buf, buf_size, x);
+  status = fwrite (buf, buf_size, 1, fh);
+  MPFR_TMP_FREE(marker);
 
-  used_size = buf_size;
-  buf = mpfr_fpif_store_precision (buf, &used_size, mpfr_get_prec (x));
-  used_size > buf_size ? buf_size = used_size : 0;
-  status = fwrite (buf, used_size, 1, fh);
-  if (status != 1)
-    {
-      mpfr_free_func (buf, buf_size);
-      return -1;
-    }
-  used_size = buf_size;
-  bufResult = mpfr_fpif_store_exponent (buf, &used_size, x);
-  /* bufResult cannot be NULL: if reallocation failed in
-     mpfr_fpif_store_exponent, an assertion failed */
-  buf = bufResult;
-  used_size > buf_size ? buf_size = used_size : 0;
-  status = fwrite (buf, used_size, 1, fh);
-  if (status != 1)
+  return status == 1 ? 0 : -1;
+}
+
+/*
+ * x : IN/OUT : MPFR number extracted from the buffer, its precision is reset
+ *              to be able to hold the number
+ * buffer : IN : buffer containing x in the binary format
+ * buffer_size : IN : size of the buffer (in bytes)
+ * Return the number of bytes read, 0 in case of error.
+ */
+size_t
+mpfr_fpif_import_buf (mpfr_ptr x, const void *buffer, size_t buffer_size)
+{
+  const unsigned char *data = (const unsigned char *) buffer;
+  mpfr_prec_t precision;
+  size_t size, used_size;
+
+  precision = mpfr_fpif_read_precision (data, buffer_size, &size);
+  if (precision == 0) /* precision = 0 means an error */
+    return 0;
+  if (precision > MPFR_PREC_MAX)
+    return 0;
+  mpfr_set_prec (x, precision);
+
+  if (mpfr_fpif_read_exponent (x, data + size, buffer_size - size,
+                               &used_size) != 0)
     {
-      mpfr_free_func (buf, buf_size);
-      return -1;
+      mpfr_set_nan (x);
+      return 0;
     }
+  size += used_size;
 
-  if (mpfr_regular_p (x))
+  /* Warning! The significand of x is not set yet. Thus use MPFR_IS_SINGULAR
+     for the test. */
+  if (!MPFR_IS_SINGULAR (x))
     {
-      used_size = buf_size;
-      buf = mpfr_fpif_store_limbs (buf, &used_size, x);
-      used_size > buf_size ? buf_size = used_size : 0;
-      status = fwrite (buf, used_size, 1, fh);
-      if (status != 1)
+      used_size = (precision + 7) >> 3; /* ceil(precision/8) */
+      if (buffer_size - size < used_size)
         {
-          mpfr_free_func (buf, buf_size);
-          return -1;
+          mpfr_set_nan (x);
+          return 0;
         }
+      mpfr_fpif_read_limbs (x, data + size, used_size);
+      size += used_size;
     }
 
-  mpfr_free_func (buf, buf_size);
-  return 0;
+  return size;
 }
 
 /*
@@ -633,3 +760,234 @@ mpfr_fpif_import (mpfr_ptr x, FILE *fh)
 
   return 0;
 }
+
+/* Array format, see the description at the beginning of this file. */
+
+#define MPFR_FPIF_ARRAY_RUN 1024      /* maximal length of the runs written */
+#define MPFR_FPIF_ARRAY_BUFSIZE 65536 /* initial size of the buffers */
+
+typedef struct {
+  FILE *fh;
+  unsigned char *buf;
+  size_t size;  /* allocated size of buf */
+  size_t used;  /* number of bytes of buf not written yet */
+} mpfr_fpif_writer;
+
+/*
+ * w : IN/OUT : writer
+ * k : IN : number of bytes
+ * return a pointer to at least k free bytes in the buffer of w, after
+ *        writing its contents to the file or enlarging it if need be,
+ *        or NULL if the write failed
+ */
+static unsigned char *
+mpfr_fpif_writer_room (mpfr_fpif_writer *w, size_t k)
+{
+  if (w->size - w->used < k)
+    {
+      if (w->used != 0 && fwrite (w->buf, w->used, 1, w->fh) != 1)
+        return NULL;
+      w->used = 0;
+      if (w->size < k)
+        {
+          w->buf = (unsigned char *) mpfr_reallocate_func (w->buf, w->size,
+                                                           k);
+          MPFR_ASSERTN(w->buf != NULL);
+          w->size = k;
+        }
+    }
+  return w->buf + w->used;
+}
+
+/*
+ * w : IN/OUT : writer
+ * n : IN : positive integer, encoded like a precision
+ * return 0 if successful
+ */
+static int
+mpfr_fpif_writer_size (mpfr_fpif_writer *w, mpfr_prec_t n)
+{
+  unsigned char *result;
+
+  result = mpfr_fpif_writer_room (w, MPFR_MAX_PRECSIZE + 2);
+  if (result == NULL)
+    return 1;
+  w->used += mpfr_fpif_store_precision (result, n);
+  return 0;
+}
+
+/*
+ * fh : IN : file handler
+ * x : IN : array of n MPFR numbers to put in the file
+ * n : IN : number of elements of x
+ * return 0 if successful
+ */
+int
+mpfr_fpif_export_array (FILE *fh, const mpfr_ptr *x, size_t n)
+{
+  mpfr_fpif_writer w;
+  unsigned char *result;
+  mpfr_prec_t precision;
+  size_t i, j, k, exponents_size;
+  int status = -1;
+
+  if (fh == NULL || n > MPFR_PREC_MAX)
+    return -1;
+  if (n == 0)
+    return 0;
+
+  w.fh = fh;
+  w.size = MPFR_FPIF_ARRAY_BUFSIZE;
+  w.used = 0;
+  w.buf = (unsigned char *) mpfr_allocate_func (w.size);
+  MPFR_ASSERTN(w.buf != NULL);
+
+  if (mpfr_fpif_writer_size (&w, n))
+    goto end;
+
+  for (i = 0; i < n; i = j)
+    {
+      /* the run consists of x[i] to x[j-1] */
+      precision = MPFR_GET_PREC (x[i]);
+      exponents_size = 0;
+      for (j = i; j < n && j - i < MPFR_FPIF_ARRAY_RUN &&
+             MPFR_GET_PREC (x[j]) == precision; j++)
+        exponents_size += mpfr_fpif_store_exponent (NULL, x[j]);
+
+      if (mpfr_fpif_writer_size (&w, precision) ||
+          mpfr_fpif_writer_size (&w, j - i) ||
+          mpfr_fpif_writer_size (&w, exponents_size))
+        goto end;
+
+      for (k = i; k < j; k++)
+        {
+          result = mpfr_fpif_writer_room (&w, sizeof(mpfr_exp_t) + 1);
+          if (result == NULL)
+            goto end;
+          w.used += mpfr_fpif_store_exponent (result, x[k]);
+        }
+
+      for (k = i; k < j; k++)
+        if (mpfr_regular_p (x[k]))
+          {
+            result = mpfr_fpif_writer_room (&w, (precision + 7) >> 3);
+            if (result == NULL)
+              goto end;
+            w.used += mpfr_fpif_store_limbs (result, x[k]);
+          }
+    }
+
+  if (fwrite (w.buf, w.used, 1, fh) == 1)
+    status = 0;
+
+ end:
+  mpfr_free_func (w.buf, w.size);
+  return status;
+}
+
+/*
+ * x : IN/OUT : array of MPFR numbers extracted from the file, their
+ *              precision is reset to be able to hold the numbers
+ * n : IN : number of elements of x
+ * fh : IN : file handler
+ * Return the number of elements read (at most n), 0 in case of error.
+ */
+size_t
+mpfr_fpif_import_array (mpfr_ptr *x, size_t n, FILE *fh)
+{
+  unsigned char *buf;
+  mpfr_prec_t precision, value;
+  size_t size, count, done, set, run, nb_byte, nb_regular;
+  size_t left, pos, have, used, i, k;
+
+  value = mpfr_fpif_read_precision_from_file (fh);
+  if (value == 0 || (mpfr_uprec_t) value > n)
+    return 0;
+  count = value;
+
+  size = MPFR_FPIF_ARRAY_BUFSIZE;
+  buf = (unsigned char *) mpfr_allocate_func (size);
+  MPFR_ASSERTN(buf != NULL);
+
+  /* x[0] to x[done-1] are read, and the precision of x[0] to x[set-1]
+     has been changed */
+  for (done = set = 0; done < count; done += run)
+    {
+      precision = mpfr_fpif_read_precision_from_file (fh);
+      if (precision == 0 || precision > MPFR_PREC_MAX)
+        goto error;
+      value = mpfr_fpif_read_precision_from_file (fh);
+      if (value == 0 || (mpfr_uprec_t) value > count - done)
+        goto error;
+      run = value;
+      value = mpfr_fpif_read_precision_from_file (fh);
+      if ((mpfr_uprec_t) value < run)
+        goto error;
+      left = value;
+
+      for (set = done; set < done + run; set++)
+        mpfr_set_prec (x[set], precision);
+
+      /* Read the signs and exponents, keeping at least the largest encoded
+         exponent in the buffer (when not at the end). */
+      pos = have = 0;
+      nb_regular = 0;
+      for (i = done; i < done + run; i++)
+        {
+          if (have - pos <= sizeof(mpfr_exp_t) && left > 0)
+            {
+              memmove (buf, buf + pos, have - pos);
+              have -= pos;
+              pos = 0;
+              k = MIN (left, size - have);
+              if (fread (buf + have, k, 1, fh) != 1)
+                goto error;
+              have += k;
+              left -= k;
+            }
+          if (mpfr_fpif_read_exponent (x[i], buf + pos, have - pos, &used))
+            goto error;
+          pos += used;
+          /* Warning! The significand of x[i] is not set yet. Thus use
+             MPFR_IS_SINGULAR for the test. */
+          nb_regular += !MPFR_IS_SINGULAR (x[i]);
+        }
+      if (pos != have || left != 0)
+        goto error;
+
+      /* Read the significands, by blocks of at most size bytes (unless a
+         single significand is larger). */
+      nb_byte = (precision + 7) >> 3; /* ceil(precision/8) */
+      if (size < nb_byte)
+        {
+          buf = (unsigned char *) mpfr_reallocate_func (buf, size, nb_byte);
+          MPFR_ASSERTN(buf != NULL);
+          size = nb_byte;
+        }
+      pos = have = 0;
+      for (i = done; i < done + run; i++)
+        if (!MPFR_IS_SINGULAR (x[i]))
+          {
+            if (pos == have)
+              {
+                k = MIN (nb_regular, size / nb_byte);
+                if (fread (buf, nb_byte, k, fh) != k)
+                  goto error;
+                pos = 0;
+                have = k * nb_byte;
+                nb_regular -= k;
+              }
+            mpfr_fpif_read_limbs (x[i], buf + pos, nb_byte);
+            pos += nb_byte;
+          }
+    }
+
+  mpfr_free_func (buf, size);
+  return count;
+
+ error:
+  for (i = 0; i < set; i++)
+    mpfr_set_nan (x[i]);
+  mpfr_free_func (buf, size);
+  return 0;
+}
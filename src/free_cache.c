@@ -46,6 +46,11 @@ mpfr_free_local_cache (void)
      mpz_t numbers, since freeing such a cache may add entries to
      the mpz_t pool. */
   mpfr_bernoulli_freecache ();
+  mpfr_mpn_get_str_freecache ();
+  mpfr_get_str_shortest_freecache ();
+  mpfr_trig_reduce_freecache ();
+  mpfr_atan_freecache ();
+  mpfr_fixed_freecache ();
   mpfr_free_pool ();
 }
 
@@ -31,6 +31,11 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_DIVHIGH_TAB 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
 #endif
 
+#ifndef MPFR_MULHIGH_NM_TAB
+/* the value of mulhigh_nm_tab[n] should be -1 or >= 1 */
+# define MPFR_MULHIGH_NM_TAB -1,16,8,6,4,3,2,2,1,1,1,1,1,1,1,1,1
+#endif
+
 #ifndef MPFR_MUL_THRESHOLD
 # define MPFR_MUL_THRESHOLD 20 /* limbs */
 #endif
@@ -43,6 +48,31 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_DIV_THRESHOLD 25 /* limbs */
 #endif
 
+/* The Newton division and square root (newton.c) are disabled by default,
+   since they were found slower than the subquadratic division and square
+   root of GMP on x86_64. Run tuneup to enable them on other platforms. */
+#ifndef MPFR_DIV_NEWTON_THRESHOLD
+# define MPFR_DIV_NEWTON_THRESHOLD MPFR_PREC_MAX /* bits */
+#endif
+
+#ifndef MPFR_SQRT_NEWTON_THRESHOLD
+# define MPFR_SQRT_NEWTON_THRESHOLD MPFR_PREC_MAX /* bits */
+#endif
+
+#ifndef MPFR_DIV_PRECOMP_THRESHOLD
+# define MPFR_DIV_PRECOMP_THRESHOLD 15000 /* bits */
+#endif
+
+/* Below this number of limbs, mpfr_mpn_get_str simply calls mpn_get_str. */
+#ifndef MPFR_GET_STR_DC_THRESHOLD
+# define MPFR_GET_STR_DC_THRESHOLD 2000 /* limbs */
+#endif
+
+/* Below this number of limbs, mpfr_mpn_set_str simply calls mpn_set_str. */
+#ifndef MPFR_SET_STR_DC_THRESHOLD
+# define MPFR_SET_STR_DC_THRESHOLD 2000 /* limbs */
+#endif
+
 #ifndef MPFR_EXP_2_THRESHOLD
 # define MPFR_EXP_2_THRESHOLD 100 /* bits */
 #endif
@@ -55,6 +85,18 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_SINCOS_THRESHOLD 30000 /* bits */
 #endif
 
+#ifndef MPFR_SIN_DIRECT_THRESHOLD
+# define MPFR_SIN_DIRECT_THRESHOLD 1000 /* bits */
+#endif
+
+#ifndef MPFR_ATAN_TABLE_THRESHOLD
+# define MPFR_ATAN_TABLE_THRESHOLD 6000 /* bits */
+#endif
+
+#ifndef MPFR_LOG_THRESHOLD
+# define MPFR_LOG_THRESHOLD 400000 /* bits */
+#endif
+
 #ifndef MPFR_AI_THRESHOLD1
 # define MPFR_AI_THRESHOLD1 -13107 /* threshold for negative input of mpfr_ai */
 #endif
@@ -27,6 +27,7 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
   mpfr_prec_t prec;
   long s;
   mpfr_t x;
+  mp_limb_t xm[(sizeof (long) - 1) / MPFR_BYTES_PER_MP_LIMB + 1];
   MPFR_SAVE_EXPO_DECL (expo);
 
   if (MPFR_UNLIKELY (!mpfr_fits_slong_p (f, rnd)))
@@ -48,7 +49,7 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* first round to prec bits */
-  mpfr_init2 (x, prec);
+  MPFR_TMP_INIT1 (xm, x, prec);
   mpfr_rint (x, f, rnd);
 
   /* The flags from mpfr_rint are the wanted ones. In particular,
@@ -83,8 +84,6 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
       s = MPFR_IS_POS (f) ? u : u <= LONG_MAX ? - (long) u : LONG_MIN;
     }
 
-  mpfr_clear (x);
-
   MPFR_SAVE_EXPO_FREE (expo);
 
   return s;
@@ -30,6 +30,7 @@ mpfr_get_sj (mpfr_srcptr f, mpfr_rnd_t rnd)
   intmax_t r;
   mpfr_prec_t prec;
   mpfr_t x;
+  mp_limb_t xm[(sizeof (intmax_t) - 1) / MPFR_BYTES_PER_MP_LIMB + 1];
   MPFR_SAVE_EXPO_DECL (expo);
 
   if (MPFR_UNLIKELY (!mpfr_fits_intmax_p (f, rnd)))
@@ -52,7 +53,7 @@ mpfr_get_sj (mpfr_srcptr f, mpfr_rnd_t rnd)
 
   MPFR_SAVE_EXPO_MARK (expo);
 
-  mpfr_init2 (x, prec);
+  MPFR_TMP_INIT1 (xm, x, prec);
   mpfr_rint (x, f, rnd);
   MPFR_ASSERTN (MPFR_IS_FP (x));
 
@@ -115,8 +116,6 @@ mpfr_get_sj (mpfr_srcptr f, mpfr_rnd_t rnd)
         }
     }
 
-  mpfr_clear (x);
-
   MPFR_SAVE_EXPO_FREE (expo);
 
   return r;
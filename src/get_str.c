@@ -155,7 +155,7 @@ mpfr_get_str_aux (char *const str, mpfr_exp_t *const exp, mp_limb_t *const r,
 
       /* convert r+i0 into base b: we use b0 which might be in -36..-2 */
       str1 = (unsigned char*) MPFR_TMP_ALLOC (m + 3); /* need one extra character for mpn_get_str */
-      size_s1 = mpn_get_str (str1, b, r + i0, n - i0);
+      size_s1 = mpfr_mpn_get_str (str1, b, r + i0, n - i0);
 
       /* round str1 */
       MPFR_ASSERTN(size_s1 >= m);
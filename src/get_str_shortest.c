@@ -0,0 +1,527 @@
+/* mpfr_get_str_shortest -- shortest string of digits that reads back
+   to the same number
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <string.h> /* for strlen */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* A positive number x = m*2^(E-p), with 2^(p-1) <= m < 2^p, is read back
+   as x (in precision p and rounding to nearest) by any number in the
+   interval [x - hl, x + hu], where hu = 2^(E-p-1), and hl = hu/2 if m is a
+   power of 2 (the gap below x is then half the gap above), hl = hu
+   otherwise; the end points are included iff m is even (since they are
+   midpoints, they round to the number with an even significand).
+   The shortest output is the number of this interval with the fewest
+   digits, and among them, the closest one to x.
+
+   Fast path (base 10, SHORTEST_MINPREC <= p <= SHORTEST_MAXPREC and
+   |E| <= SHORTEST_MAXEXP):
+   with K = mpfr_get_str_ndigits (10, p) and s chosen such that
+   10^(K-1) <= y = x*10^s < 2*10^(K+1), the interval scaled by 10^s has a
+   width larger than 1, and it is enough to find the largest t such that
+   it contains a multiple of 10^t, by dividing its integer end points by 10
+   until they become equal. The numbers y, hl*10^s and hu*10^s are computed
+   on SHORTEST_WP bits, with 10^s obtained from a table of powers of 10
+   (10^s = 10^(32j) * 10^i, with 0 <= i < 32), so that their error is less
+   than 2^(-50), and converted into fixed-point numbers with a fractional
+   part of 64 bits. If an end point or the rounding of y/10^t cannot be
+   decided because the corresponding fractional part is too close to an
+   integer (or to 1/2), the fast path fails. This never happens when all
+   these computations are exact (small values of s), since the end points
+   are then known exactly. The lower bound on p ensures that the relative
+   width of the interval is less than 1/10, so that it cannot contain both
+   a power of 10 and another number with a single digit (which would be
+   found with a smaller t, but might be closer to x).
+
+   Otherwise, mpfr_get_str is used to find the smallest number of digits
+   n such that the n-digit number nearest to x (or the next one above x,
+   in case the gap below x is smaller) reads back as x, by a binary search
+   on n, which is valid since a n-digit number is also a (n+1)-digit one.
+   The table of powers of 10 is computed at the first use in each thread,
+   and freed by mpfr_free_cache; it is also used by mpfr_strtofr. The fast
+   path is only enabled for 32-bit and 64-bit limbs (MPFR_POW10_TAB). */
+
+#define SHORTEST_MINPREC 8
+#define SHORTEST_MAXPREC 128
+#define SHORTEST_MAXEXP 16500
+#define SHORTEST_MAXDIGITS 48  /* more than the digits of the fast path */
+#define SHORTEST_WP 192
+#define SHORTEST_JMAX (MPFR_POW10_MAX / 32)  /* 10^(32j), |j| <= JMAX */
+#define NI MPFR_PREC2LIMBS (SHORTEST_WP)  /* integer part of fixed point */
+#define NF MPFR_PREC2LIMBS (64)           /* fractional part */
+#define NL (NI + NF)
+#define NTAB (2 * SHORTEST_JMAX + 1 + 32)
+
+#ifdef MPFR_POW10_TAB
+
+/* pow10_tab[j + SHORTEST_JMAX] = 10^(32j) rounded to nearest, and
+   pow10_tab[2 * SHORTEST_JMAX + 1 + i] = 10^i (exact), on SHORTEST_WP bits */
+static MPFR_THREAD_ATTR mpfr_ptr pow10_tab = NULL;
+
+#define POW10_TAB_BYTES \
+  (NTAB * (sizeof (__mpfr_struct) + NI * MPFR_BYTES_PER_MP_LIMB))
+
+void
+mpfr_get_str_shortest_freecache (void)
+{
+  if (pow10_tab != NULL)
+    {
+      mpfr_free_func (pow10_tab, POW10_TAB_BYTES);
+      pow10_tab = NULL;
+    }
+}
+
+/* Must be called in the extended exponent range. */
+static void
+pow10_init (void)
+{
+  mp_limb_t *limbs;
+  mpfr_t ten;
+  int k;
+
+  pow10_tab = (mpfr_ptr) mpfr_allocate_func (POW10_TAB_BYTES);
+  limbs = (mp_limb_t *) (pow10_tab + NTAB);
+  mpfr_init2 (ten, 4);
+  mpfr_set_ui (ten, 10, MPFR_RNDN);
+  for (k = 0; k < NTAB; k++)
+    {
+      long n = k <= 2 * SHORTEST_JMAX ? 32L * (k - SHORTEST_JMAX)
+        : k - (2 * SHORTEST_JMAX + 1);
+
+      MPFR_TMP_INIT1 (limbs + k * NI, pow10_tab + k, SHORTEST_WP);
+      mpfr_pow_si (pow10_tab + k, ten, n, MPFR_RNDN);
+    }
+  mpfr_clear (ten);
+}
+
+/* Set z to 10^k, where |k| <= MPFR_POW10_MAX and the precision of z is at
+   least MPFR_POW10_PREC, as the product of two entries of the table, with
+   a relative error less than 3*2^(-MPFR_POW10_PREC). Return 0 iff z is
+   exactly 10^k. Must be called in the extended exponent range. */
+int
+mpfr_pow10_approx (mpfr_ptr z, long k)
+{
+  long j, i;
+  int inex;
+
+  MPFR_STAT_STATIC_ASSERT (SHORTEST_WP == MPFR_POW10_PREC);
+  MPFR_ASSERTD (-MPFR_POW10_MAX <= k && k <= MPFR_POW10_MAX);
+  MPFR_ASSERTD (MPFR_PREC (z) >= MPFR_POW10_PREC);
+  j = k >= 0 ? k / 32 : - ((31 - k) / 32);
+  i = k - 32 * j;
+  if (pow10_tab == NULL)
+    pow10_init ();
+  inex = mpfr_mul (z, pow10_tab + (j + SHORTEST_JMAX),
+                   pow10_tab + (2 * SHORTEST_JMAX + 1 + i), MPFR_RNDN);
+  /* 10^(32j) is exact on 192 bits iff 0 <= j <= 2 (5^64 < 2^192 < 5^96) */
+  MPFR_STAT_STATIC_ASSERT (SHORTEST_WP == 192);
+  return inex != 0 || j < 0 || j > 2;
+}
+
+/* Set r[0..NL-1] to floor(v * 2^(NF*GMP_NUMB_BITS)), where v is a positive
+   number less than 2^(NI*GMP_NUMB_BITS) whose significand has at most NL
+   limbs. */
+static void
+shortest_fixed (mp_limb_t *r, mpfr_srcptr v)
+{
+  mp_size_t vn = MPFR_LIMB_SIZE (v), k;
+  mp_limb_t *vp = MPFR_MANT (v);
+  mpfr_exp_t sh;
+  int c;
+
+  MPFR_ASSERTD (vn <= NL && MPFR_GET_EXP (v) <= NI * GMP_NUMB_BITS);
+  MPN_ZERO (r, NL);
+  /* v * 2^(NF*GMP_NUMB_BITS) = V * 2^sh, where V is the significand of v
+     regarded as an integer */
+  sh = MPFR_GET_EXP (v) + (mpfr_exp_t) (NF - vn) * GMP_NUMB_BITS;
+  if (sh >= 0)
+    {
+      k = sh / GMP_NUMB_BITS;
+      c = sh % GMP_NUMB_BITS;
+      if (c != 0)
+        {
+          mp_limb_t cy = mpn_lshift (r + k, vp, vn, c);
+          if (k + vn < NL)
+            r[k + vn] = cy;
+          else
+            MPFR_ASSERTD (cy == 0);
+        }
+      else
+        MPN_COPY (r + k, vp, vn);
+    }
+  else
+    {
+      k = (-sh) / GMP_NUMB_BITS;
+      c = (-sh) % GMP_NUMB_BITS;
+      if (k < vn)
+        {
+          if (c != 0)
+            mpn_rshift (r, vp + k, vn - k, c);
+          else
+            MPN_COPY (r, vp + k, vn - k);
+        }
+    }
+}
+
+/* The 32 most significant bits of the fractional part of r. */
+#define FRAC32(r) ((unsigned long) ((r)[NF - 1] >> (GMP_NUMB_BITS - 32)))
+
+/* Return non-zero iff the fractional part of r is zero (if h = 0), or
+   exactly 1/2 (if h = 1). */
+static int
+frac_is (const mp_limb_t *r, int h)
+{
+  mp_size_t k;
+
+  for (k = 0; k < NF - 1; k++)
+    if (r[k] != 0)
+      return 0;
+  return r[NF - 1] == (h ? MPFR_LIMB_HIGHBIT : 0);
+}
+
+/* Return non-zero iff c*10^q = x, where c is the integer {cp, n}, with
+   cp[n-1] != 0 and c not divisible by 10. If q > 64, the odd part of
+   c*10^q is larger than 5^64 > 2^128, and if q < -64, c cannot be
+   divisible by 5^64 > 2^148, thus this is not possible. Otherwise the
+   comparison is done exactly on 2*SHORTEST_WP bits. */
+static int
+shortest_exact_p (const mp_limb_t *cp, mp_size_t n, long q, mpfr_srcptr x)
+{
+  mp_limb_t zp[2 * NI], up[2 * NI];
+  mpfr_t z, u;
+  long aq = q < 0 ? -q : q;
+  int cnt, inex;
+
+  if (q > 64 || q < -64 ||
+      (q < 0 ? mpn_mod_1 (cp, n, 5) != 0 : ! mpfr_integer_p (x)))
+    return 0;
+
+  /* z = c */
+  MPFR_TMP_INIT1 (zp, z, 2 * SHORTEST_WP);
+  MPN_ZERO (zp, 2 * NI - n);
+  count_leading_zeros (cnt, cp[n - 1]);
+  if (cnt != 0)
+    mpn_lshift (zp + 2 * NI - n, cp, n, cnt);
+  else
+    MPN_COPY (zp + 2 * NI - n, cp, n);
+  MPFR_SET_EXP (z, n * GMP_NUMB_BITS - cnt);
+
+  /* u = 10^|q|, exactly */
+  MPFR_TMP_INIT1 (up, u, 2 * SHORTEST_WP);
+  MPFR_DBGRES (inex = mpfr_pow10_approx (u, aq));
+  MPFR_ASSERTD (inex == 0);
+  if (q >= 0)
+    {
+      mpfr_mul (z, z, u, MPFR_RNDN);
+      return mpfr_equal_p (z, x);
+    }
+  else
+    {
+      mpfr_mul (u, x, u, MPFR_RNDN);
+      return mpfr_equal_p (u, z);
+    }
+}
+
+/* Fast path for x > 0 in base 10: write the digits to s (without the final
+   '\0') and the exponent to *e, and return the number of digits; set
+   *inexp to 1 if the output differs from x. Return 0 if the fast path
+   cannot decide. Must be called in the extended exponent range. */
+static size_t
+shortest_fast (char *s, mpfr_exp_t *e, mpfr_srcptr x, int *inexp)
+{
+  mpfr_prec_t p = MPFR_PREC (x);
+  mpfr_exp_t ex = MPFR_GET_EXP (x);
+  mp_limb_t yp[NI], pp[NI], ylimbs[NL], lo[NL], hi[NL], h2[NL], t1[NI];
+  mp_limb_t *a, *b, *yi, *hl;
+  unsigned char digits[NI * GMP_NUMB_BITS / 3 + 1];
+  mpfr_t y, pw;
+  long K, f, s10, t;
+  mp_size_t n;
+  size_t nd, k;
+  int sh, exact, incl, inex, up, r, z, ambiguous;
+
+  MPFR_ASSERTD (SHORTEST_MINPREC <= p && p <= SHORTEST_MAXPREC);
+  if (ex > SHORTEST_MAXEXP || ex < -SHORTEST_MAXEXP)
+    return 0;
+
+  /* K = 1 + ceil(p*log10(2)), using 78913/2^18 < log10(2), where
+     p*log10(2) is never an integer */
+  K = 2 + (((long) p * 78913) >> 18);
+  MPFR_ASSERTD ((size_t) K == mpfr_get_str_ndigits (10, p));
+  /* f <= floor((ex-1)*log10(2)) <= f + 1, using
+     78913/2^18 < log10(2) < 78914/2^18 and |ex-1| <= SHORTEST_MAXEXP + 1,
+     so that 10^(K-1) <= y = x*10^s10 < 2*10^(K+1) */
+  f = ex - 1 >= 0 ? ((long) (ex - 1) * 78913) >> 18
+    : - (((long) (1 - ex) * 78914 + 262143) >> 18);
+  s10 = K - 1 - f;
+
+  /* pw = 10^s10 and y = x*10^s10, with a relative error less than
+     4*2^(-SHORTEST_WP) */
+  MPFR_TMP_INIT1 (yp, y, SHORTEST_WP);
+  MPFR_TMP_INIT1 (pp, pw, SHORTEST_WP);
+  inex = mpfr_pow10_approx (pw, s10);
+  inex |= mpfr_mul (y, x, pw, MPFR_RNDN);
+  /* If y is exact, then y and the end points of the interval are multiples
+     of 2^(ex-p-2), thus their fixed-point values are exact if
+     ex - p - 2 >= -64. */
+  exact = inex == 0 && ex - p - 2 >= -64;
+
+  shortest_fixed (ylimbs, y);
+  MPFR_SET_EXP (pw, MPFR_GET_EXP (pw) + ex - p - 1);  /* hu*10^s10 */
+  shortest_fixed (hi, pw);
+  hl = hi;
+  if (mpfr_powerof2_raw (x))
+    {
+      mpn_rshift (h2, hi, NL, 1);
+      hl = h2;
+    }
+  mpn_sub_n (lo, ylimbs, hl, NL);
+  mpn_add_n (hi, ylimbs, hi, NL);
+
+  /* the end points are included iff the significand of x is even */
+  sh = (int) (MPFR_LIMB_SIZE (x) * GMP_NUMB_BITS - p);
+  incl = (MPFR_MANT (x)[0] & (MPFR_LIMB_ONE << sh)) == 0;
+  if (! exact &&
+      (FRAC32 (lo) == 0 || FRAC32 (lo) == 0xffffffffUL ||
+       FRAC32 (hi) == 0 || FRAC32 (hi) == 0xffffffffUL))
+    return 0;
+
+  /* the integers of the scaled interval are a+1 to b, and y <= b */
+  a = lo + NF;
+  b = hi + NF;
+  yi = ylimbs + NF;
+  if (frac_is (lo, 0) && incl)
+    mpn_sub_1 (a, a, NI, 1);
+  if (frac_is (hi, 0) && ! incl)
+    mpn_sub_1 (b, b, NI, 1);
+  MPFR_ASSERTD (mpn_cmp (a, b, NI) < 0);
+
+  /* Remove the last digits of a and b while they differ in the other
+     digits; r is the last removed digit of y (-1 if none), and z = 1 iff
+     the part of y below r is zero (up to the error on y). */
+  n = NI;
+  MPN_NORMALIZE (b, n);
+  t = 0;
+  r = -1;
+  z = exact ? frac_is (ylimbs, 0) : FRAC32 (ylimbs) == 0;
+  for (;;)
+    {
+      mp_limb_t ry;
+
+      if (n == 1)
+        {
+          if (a[0] / 10 == b[0] / 10)
+            break;
+          a[0] /= 10;
+          b[0] /= 10;
+          ry = yi[0] % 10;
+          yi[0] /= 10;
+        }
+      else
+        {
+          mp_limb_t rb;
+
+          mpn_divrem_1 (t1, 0, a, n, 10);
+          rb = mpn_divrem_1 (b, 0, b, n, 10);
+          if (mpn_cmp (t1, b, n) == 0)
+            {
+              mpn_mul_1 (b, b, n, 10);
+              mpn_add_1 (b, b, n, rb);
+              break;
+            }
+          MPN_COPY (a, t1, n);
+          ry = mpn_divrem_1 (yi, 0, yi, n, 10);
+          MPN_NORMALIZE (b, n);
+        }
+      if (r >= 0)
+        z = z && r == 0;
+      r = (int) ry;
+      t++;
+    }
+
+  /* round y/10^t to nearest, ties to even (the ties can be detected only
+     if exact is true) */
+  if (r < 0)
+    {
+      unsigned long fr = FRAC32 (ylimbs);
+
+      up = fr >= 0x80000000UL;
+      ambiguous = exact ? 0 : fr == 0x7fffffffUL || fr == 0x80000000UL;
+      if (exact && frac_is (ylimbs, 1))
+        up = yi[0] & 1;
+      inex = ! (exact && frac_is (ylimbs, 0));
+    }
+  else
+    {
+      up = r > 5 || (r == 5 && ! z);
+      ambiguous = exact ? 0 : (r == 5 && z) ||
+        (r == 4 && FRAC32 (ylimbs) == 0xffffffffUL);
+      if (exact && r == 5 && z)
+        up = yi[0] & 1;
+      inex = ! (exact && r == 0 && z);
+    }
+  if (ambiguous)
+    return 0;
+  if (up)
+    mpn_add_1 (yi, yi, n, 1);
+  /* the nearest integer to y/10^t may be outside the interval */
+  if (mpn_cmp (yi, a, n) <= 0)
+    {
+      mpn_add_1 (yi, a, n, 1);
+      inex = 1;
+    }
+  else if (mpn_cmp (yi, b, n) > 0)
+    {
+      MPN_COPY (yi, b, n);
+      inex = 1;
+    }
+
+  MPN_NORMALIZE (yi, n);
+  if (! exact)
+    inex = ! shortest_exact_p (yi, n, t - s10, x);
+  nd = mpn_get_str (digits, 10, yi, n);
+  MPFR_ASSERTD (digits[nd - 1] != 0);
+  for (k = 0; k < nd; k++)
+    s[k] = '0' + digits[k];
+  *e = (mpfr_exp_t) nd + t - s10;
+  *inexp = inex;
+  return nd;
+}
+
+#else
+
+void
+mpfr_get_str_shortest_freecache (void)
+{
+}
+
+#endif
+
+/* Return non-zero iff the n-digit number nearest to x > 0 in base b
+   (or the next one above x if up is non-zero) reads back as x. The
+   digits are written to s, and the exponent to *e. */
+static int
+shortest_try (char *s, mpfr_exp_t *e, int b, size_t n, mpfr_srcptr x,
+              int up, mpfr_ptr y, char *buf)
+{
+  mpfr_get_str (s, e, b, n, x, up ? MPFR_RNDU : MPFR_RNDN);
+  sprintf (buf, "0.%s@%" MPFR_EXP_FSPEC "d", s, (mpfr_eexp_t) *e);
+  mpfr_strtofr (y, buf, NULL, b < 0 ? -b : b, MPFR_RNDN);
+  return mpfr_equal_p (y, x);
+}
+
+char *
+mpfr_get_str_shortest (char *s, mpfr_exp_t *e, int b, mpfr_srcptr x)
+{
+  char *s0, *t, *buf;
+  char tfast[SHORTEST_MAXDIGITS];
+  mpfr_t ax, y;
+  size_t m, n, nlo, nhi;
+  int neg, up, inex = 0;
+  MPFR_SAVE_EXPO_DECL (expo);
+  MPFR_TMP_DECL (marker);
+
+  MPFR_LOG_FUNC
+    (("b=%d x[%Pd]=%.*Rg", b, mpfr_get_prec (x), mpfr_log_prec, x),
+     ("flags=%lx", (unsigned long) __gmpfr_flags));
+
+  /* Is the base argument valid? Valid values are -36 to -2 and 2 to 62. */
+  if (b < -36 || (-2 < b && b < 2) || 62 < b)
+    return NULL;
+
+  if (MPFR_IS_SINGULAR (x))
+    {
+      const char *r = MPFR_IS_NAN (x) ? "@NaN@" : MPFR_IS_INF (x) ?
+        (MPFR_IS_NEG (x) ? "-@Inf@" : "@Inf@") :
+        (MPFR_IS_NEG (x) ? "-0" : "0");
+
+      if (s == NULL)
+        s = (char *) mpfr_allocate_func (strlen (r) + 1);
+      strcpy (s, r);
+      if (MPFR_IS_NAN (x))
+        __gmpfr_flags |= MPFR_FLAGS_NAN;
+      else if (MPFR_IS_ZERO (x))
+        *e = 0;
+      return s;
+    }
+
+  neg = MPFR_IS_NEG (x);
+  MPFR_ALIAS (ax, x, MPFR_SIGN_POS, MPFR_GET_EXP (x));
+  MPFR_SAVE_EXPO_MARK (expo);
+  MPFR_TMP_MARK (marker);
+
+  n = 0;
+  t = tfast;
+#ifdef MPFR_POW10_TAB
+  if ((b == 10 || b == -10) && SHORTEST_MINPREC <= MPFR_PREC (x) &&
+      MPFR_PREC (x) <= SHORTEST_MAXPREC)
+    {
+      n = shortest_fast (t, e, ax, &inex);
+      t[n] = '\0';
+    }
+#endif
+  if (n == 0)
+    {
+      /* binary search of the smallest number of digits n, nlo <= n <= nhi */
+      m = mpfr_get_str_ndigits (b < 0 ? -b : b, MPFR_PREC (x));
+      t = (char *) MPFR_TMP_ALLOC (m + 1);
+      buf = (char *) MPFR_TMP_ALLOC (m + 32);
+      mpfr_init2 (y, MPFR_PREC (x));
+      up = 0;
+      nlo = 1;
+      nhi = m;
+      while (nlo < nhi)
+        {
+          n = (nlo + nhi) / 2;
+          if (shortest_try (t, e, b, n, ax, 0, y, buf) ||
+              (mpfr_powerof2_raw (ax) && shortest_try (t, e, b, n, ax, 1,
+                                                       y, buf)))
+            nhi = n;
+          else
+            nlo = n + 1;
+        }
+      n = nhi;
+      mpfr_clear_flags ();
+      if (! shortest_try (t, e, b, n, ax, 0, y, buf))
+        {
+          mpfr_clear_flags ();
+          up = shortest_try (t, e, b, n, ax, 1, y, buf);
+          MPFR_ASSERTN (up);
+        }
+      inex = mpfr_inexflag_p ();
+      mpfr_clear (y);
+    }
+
+  MPFR_LOG_MSG (("n=%zu e=%" MPFR_EXP_FSPEC "d\n", n, (mpfr_eexp_t) *e));
+  if (s == NULL)
+    s = (char *) mpfr_allocate_func (neg + n + 1);
+  s0 = s;
+  if (neg)
+    *s++ = '-';
+  memcpy (s, t, n + 1);
+  MPFR_TMP_FREE (marker);
+  if (inex)
+    MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, MPFR_FLAGS_INEXACT);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return s0;
+}
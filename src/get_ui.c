@@ -27,6 +27,7 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
   mpfr_prec_t prec;
   unsigned long s;
   mpfr_t x;
+  mp_limb_t xm[(sizeof (unsigned long) - 1) / MPFR_BYTES_PER_MP_LIMB + 1];
   mp_size_t n;
   mpfr_exp_t exp;
   MPFR_SAVE_EXPO_DECL (expo);
@@ -47,7 +48,7 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* first round to prec bits */
-  mpfr_init2 (x, prec);
+  MPFR_TMP_INIT1 (xm, x, prec);
   mpfr_rint (x, f, rnd);
 
   /* The flags from mpfr_rint are the wanted ones. In particular,
@@ -75,8 +76,6 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
       s += MPFR_MANT(x)[n - 1] >> (GMP_NUMB_BITS - exp);
     }
 
-  mpfr_clear (x);
-
   MPFR_SAVE_EXPO_FREE (expo);
 
   return s;
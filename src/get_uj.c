@@ -30,6 +30,7 @@ mpfr_get_uj (mpfr_srcptr f, mpfr_rnd_t rnd)
   uintmax_t r;
   mpfr_prec_t prec;
   mpfr_t x;
+  mp_limb_t xm[(sizeof (uintmax_t) - 1) / MPFR_BYTES_PER_MP_LIMB + 1];
   MPFR_SAVE_EXPO_DECL (expo);
 
   if (MPFR_UNLIKELY (!mpfr_fits_uintmax_p (f, rnd)))
@@ -50,7 +51,7 @@ mpfr_get_uj (mpfr_srcptr f, mpfr_rnd_t rnd)
 
   MPFR_SAVE_EXPO_MARK (expo);
 
-  mpfr_init2 (x, prec);
+  MPFR_TMP_INIT1 (xm, x, prec);
   mpfr_rint (x, f, rnd);
   MPFR_ASSERTN (MPFR_IS_FP (x));
 
@@ -76,8 +77,6 @@ mpfr_get_uj (mpfr_srcptr f, mpfr_rnd_t rnd)
         }
     }
 
-  mpfr_clear (x);
-
   MPFR_SAVE_EXPO_FREE (expo);
 
   return r;
@@ -120,3 +120,79 @@ mpfr_inp_str (mpfr_ptr rop, FILE *stream, int base, mpfr_rnd_t rnd_mode)
   else
     return str_size;
 }
+
+/* With the POSIX functions flockfile and getc_unlocked, the stream is locked
+   once for the whole array instead of once per character read. */
+#if defined(HAVE_FLOCKFILE) && defined(HAVE_FUNLOCKFILE) && \
+  defined(HAVE_GETC_UNLOCKED)
+# define INP_STR_LOCK(f) flockfile (f)
+# define INP_STR_UNLOCK(f) funlockfile (f)
+# define INP_STR_GETC(f) getc_unlocked (f)
+#else
+# define INP_STR_LOCK(f) ((void) 0)
+# define INP_STR_UNLOCK(f) ((void) 0)
+# define INP_STR_GETC(f) getc (f)
+#endif
+
+/* Read up to n words from stream and parse them with mpfr_set_str into
+   tab[0], tab[1], ..., stopping at the first invalid word or at the end of
+   the stream. The words are read into the same buffer, whose size is only
+   increased when needed, and the whitespace separating two words is not
+   pushed back to the stream. */
+size_t
+mpfr_inp_str_array (mpfr_ptr *tab, size_t n, FILE *stream, int base,
+                    mpfr_rnd_t rnd_mode)
+{
+  unsigned char *str;
+  size_t alloc_size, str_size, i;
+  int c = EOF;
+
+  alloc_size = 256;
+  str = (unsigned char *) mpfr_allocate_func (alloc_size);
+  INP_STR_LOCK (stream);
+
+  for (i = 0; i < n; i++)
+    {
+      do
+        c = INP_STR_GETC (stream);
+      while (isspace (c));
+
+      str_size = 0;
+      while (c != EOF && ! isspace (c))
+        {
+          /* keep room for the terminating null character */
+          if (MPFR_UNLIKELY (str_size + 1 >= alloc_size))
+            {
+              size_t new_alloc_size = alloc_size / 2 * 3;
+              if (MPFR_UNLIKELY (new_alloc_size <= alloc_size))
+                {
+                  str_size = 0;  /* size_t overflow: error */
+                  break;
+                }
+              str = (unsigned char *)
+                mpfr_reallocate_func (str, alloc_size, new_alloc_size);
+              alloc_size = new_alloc_size;
+            }
+          str[str_size++] = (unsigned char) c;
+          /* see mpfr_inp_str */
+          if (MPFR_UNLIKELY (c == '\0'))
+            str[0] = '*';
+          c = INP_STR_GETC (stream);
+        }
+
+      if (MPFR_UNLIKELY (str_size == 0 || (c == EOF && ! feof (stream))))
+        break;  /* end of stream, size_t overflow or I/O error */
+      str[str_size] = '\0';
+      if (mpfr_set_str (tab[i], (char *) str, base, rnd_mode) != 0)
+        break;
+    }
+
+  /* As in mpfr_inp_str, push back the character that follows the last
+     word read (the ungetc is not done for EOF). */
+  if (c != EOF)
+    ungetc (c, stream);
+  INP_STR_UNLOCK (stream);
+
+  mpfr_free_func (str, alloc_size);
+  return i;
+}
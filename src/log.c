@@ -37,6 +37,79 @@ If not, see <https://www.gnu.org/licenses/>. */
      so the relative error 4/s^2 is < 4/2^p i.e. 4 ulps.
 */
 
+/* In very high precision (from MPFR_LOG_THRESHOLD bits), mpfr_exp is
+   faster than the AGM, and log(a) is obtained by a Newton-like iteration
+   of order 3 on exp: if y0 is an approximation of log(a) with about p/3
+   bits, computed recursively, then t = a*exp(-y0) - 1 is small and
+   log(a) = y0 + log(1+t) ~ y0 + t - t^2/2 with about p bits. Since y0 has
+   few bits, mpfr_exp (by binary splitting) is faster on -y0 than on a
+   full-precision number, so that the total cost is about the one of an
+   exponential in precision p.
+
+   Error analysis, where p is the working precision:
+   - y0 is rounded to nearest on p0 >= ea + p/3 + 9 bits, where
+     EXP(log(a)) <= ea, thus EXP(y0) <= ea + 1 and |y0 - log(a)| = |d| <=
+     2^(-p/3-9);
+   - e = exp(-y0) (1 + e1) and m = a*e (1 + e2) with |e1|, |e2| <= 2^(-p),
+     thus m = exp(d) + h with |h| < 2^(2-p), and t = m - 1 is exact by
+     Sterbenz's lemma;
+   - with s = exp(d) - 1 = t - h, one has d = log(1+s) = s - s^2/2 + R,
+     |R| <= |s|^3/2 < 2^(-p-25) since |s| < 2^(-p/3-8.9), and t - t^2/2 - (s - s^2/2) = h (1-(t+s)/2),
+     thus |t - t^2/2 - d| < 2^(2-p) (1 + 2^(-8)) + 2^(-p-25);
+   - the roundings of t^2 and of t - t^2/2 give less than 2^(-p-16), and
+     the last addition 1/2 ulp(y).
+   The total error is less than 2^(3-p) + 2^(EXP(y)-p-1), i.e., less than
+   2^(max(3,EXP(y))+1-p). */
+static int
+mpfr_log_newton (mpfr_ptr r, mpfr_srcptr a, mpfr_rnd_t rnd_mode)
+{
+  mpfr_prec_t p, p0, q = MPFR_PREC (r);
+  mpfr_exp_t exp_a = MPFR_GET_EXP (a), cancel;
+  mpfr_uexp_t ea;
+  mpfr_t y, y0, t, u;
+  int inexact;
+  MPFR_ZIV_DECL (loop);
+
+  /* |log(a)| < (|exp_a| + 1) log(2), thus EXP(log(a)) <= ea */
+  ea = exp_a < 0 ? - (mpfr_uexp_t) exp_a : (mpfr_uexp_t) exp_a;
+  ea = MPFR_INT_CEIL_LOG2 (ea + 1);
+
+  p = q + 2 * MPFR_INT_CEIL_LOG2 (q) + 10;
+  mpfr_init2 (y, p);
+  mpfr_init2 (y0, MPFR_PREC_MIN);
+  mpfr_init2 (t, p);
+  mpfr_init2 (u, p);
+  MPFR_ZIV_INIT (loop, p);
+  for (;;)
+    {
+      p0 = (p + 2) / 3 + 9 + (mpfr_prec_t) ea;
+      mpfr_set_prec (y0, p0);
+      mpfr_log (y0, a, MPFR_RNDN);
+      mpfr_neg (y0, y0, MPFR_RNDN);
+      mpfr_exp (t, y0, MPFR_RNDN);
+      mpfr_mul (t, t, a, MPFR_RNDN);
+      mpfr_sub (t, t, __gmpfr_one, MPFR_RNDN); /* exact */
+      mpfr_sqr (u, t, MPFR_RNDN);
+      mpfr_div_2ui (u, u, 1, MPFR_RNDN);
+      mpfr_sub (t, t, u, MPFR_RNDN);
+      mpfr_sub (y, t, y0, MPFR_RNDN);          /* y0 was negated */
+
+      /* the error is less than 2^(EXP(y)+cancel+1-p) */
+      cancel = MPFR_GET_EXP (y) < 3 ? 3 - MPFR_GET_EXP (y) : 0;
+      if (MPFR_LIKELY (MPFR_CAN_ROUND (y, p - cancel - 1, q, rnd_mode)))
+        break;
+      p += cancel + MPFR_INT_CEIL_LOG2 (p);
+      MPFR_ZIV_NEXT (loop, p);
+      mpfr_set_prec (y, p);
+      mpfr_set_prec (t, p);
+      mpfr_set_prec (u, p);
+    }
+  MPFR_ZIV_FREE (loop);
+  inexact = mpfr_set (r, y, rnd_mode);
+  mpfr_clears (y, y0, t, u, (mpfr_ptr) 0);
+  return inexact;
+}
+
 int
 mpfr_log (mpfr_ptr r, mpfr_srcptr a, mpfr_rnd_t rnd_mode)
 {
@@ -115,6 +188,27 @@ mpfr_log (mpfr_ptr r, mpfr_srcptr a, mpfr_rnd_t rnd_mode)
       p += GMP_NUMB_BITS - (p%GMP_NUMB_BITS); */
 
   MPFR_SAVE_EXPO_MARK (expo);
+
+#ifdef MPFR_FIXED_MAXPREC
+  /* table-driven kernel, 0 if it cannot round */
+  if (q <= MPFR_FIXED_MAXPREC &&
+      (inexact = mpfr_log_fixed (r, a, rnd_mode)) != 0)
+    {
+      MPFR_SAVE_EXPO_FREE (expo);
+      return mpfr_check_range (r, inexact, rnd_mode);
+    }
+#endif
+
+  /* The condition q >= 1024 ensures that the recursive calls done by
+     mpfr_log_newton are in a smaller precision (useful when tuning). */
+  if (MPFR_UNLIKELY (q >= MPFR_LOG_THRESHOLD && q >= 1024))
+    {
+      inexact = mpfr_log_newton (r, a, rnd_mode);
+      MPFR_SAVE_EXPO_FREE (expo);
+      return mpfr_check_range (r, inexact, rnd_mode);
+    }
+
+  MPFR_ZIV_ADAPT (loop, p);
   MPFR_GROUP_INIT_2 (group, p, tmp1, tmp2);
 
   MPFR_ZIV_INIT (loop, p);
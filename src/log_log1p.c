@@ -0,0 +1,131 @@
+/* mpfr_log_log1p -- natural logarithm of x and of 1+x
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* For x >= 2, log1p(x) = log(x) + log1p(1/x), where log1p(1/x) is much
+   cheaper than log(1+x) when 1/x is small enough for mpfr_log1p to use a
+   series (same test as in mpfr_log1p), so that both results are obtained
+   with a single logarithm. A result that cannot be rounded after two
+   iterations is computed separately.
+   Otherwise mpfr_log and mpfr_log1p are called separately. */
+
+int
+mpfr_log_log1p (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xc, l, u, s;
+  mpfr_prec_t N;
+  int inex_y = 0, inex_z = 0, ok_y = 0, ok_z = 0, copied = 0, iter;
+
+  MPFR_ASSERTN (y != z);
+
+  MPFR_LOG_FUNC
+    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
+     ("log[%Pd]=%.*Rg log1p[%Pd]=%.*Rg",
+      mpfr_get_prec (y), mpfr_log_prec, y,
+      mpfr_get_prec (z), mpfr_log_prec, z));
+
+  N = MAX (MPFR_PREC (y), MPFR_PREC (z));
+  N += MPFR_INT_CEIL_LOG2 (N) + 6;
+  /* Since 1/x < 2^(1-EXP(x)), the test below ensures that mpfr_log1p
+     uses the series for 1/x. */
+  if (MPFR_IS_SINGULAR (x) || MPFR_IS_NEG (x) || MPFR_GET_EXP (x) < 2 ||
+      MPFR_GET_EXP (x) - 2 < (mpfr_exp_t) (N / (1 + MPFR_INT_CEIL_LOG2 (N))))
+    {
+      /* Compute last the result that may overwrite x. */
+      if (z == x)
+        {
+          inex_y = mpfr_log (y, x, rnd_mode);
+          inex_z = mpfr_log1p (z, x, rnd_mode);
+        }
+      else
+        {
+          inex_z = mpfr_log1p (z, x, rnd_mode);
+          inex_y = mpfr_log (y, x, rnd_mode);
+        }
+      return INEX (inex_y, inex_z);
+    }
+
+  /* The fallbacks below need x after one of the results has been set. */
+  if (y == x || z == x)
+    {
+      mpfr_init2 (xc, MPFR_PREC (x));
+      mpfr_set (xc, x, MPFR_RNDN); /* exact */
+      x = xc;
+      copied = 1;
+    }
+
+  {
+    MPFR_ZIV_DECL (loop);
+    MPFR_SAVE_EXPO_DECL (expo);
+    MPFR_GROUP_DECL (group);
+
+    MPFR_SAVE_EXPO_MARK (expo);
+
+    MPFR_GROUP_INIT_3 (group, N, l, u, s);
+
+    MPFR_ZIV_INIT (loop, N);
+    for (iter = 0; ; iter++)
+      {
+        /* Since x >= 2, l >= log(2) and 0 < u <= 1/2, thus
+           0 < log1p(u) < l <= s. The error on l is at most 1/2 ulp(l),
+           the error on 1/x gives an error of at most 2^(-N-1) <= ulp(s)/2
+           on log1p(u), which has a rounding error of at most 1/2 ulp(s),
+           and the addition adds 1/2 ulp(s): the error on s is at most
+           2 ulp(s). */
+        mpfr_log (l, x, MPFR_RNDN);
+        mpfr_ui_div (u, 1, x, MPFR_RNDN);
+        mpfr_log1p (u, u, MPFR_RNDN);
+        mpfr_add (s, l, u, MPFR_RNDN);
+
+        ok_y = MPFR_CAN_ROUND (l, N - 1, MPFR_PREC (y), rnd_mode);
+        ok_z = MPFR_CAN_ROUND (s, N - 1, MPFR_PREC (z), rnd_mode);
+        if ((ok_y && ok_z) || iter == 1)
+          break;
+        MPFR_ZIV_NEXT (loop, N);
+        MPFR_GROUP_REPREC_3 (group, N, l, u, s);
+      }
+    MPFR_ZIV_FREE (loop);
+
+    if (ok_y)
+      inex_y = mpfr_set (y, l, rnd_mode);
+    if (ok_z)
+      inex_z = mpfr_set (z, s, rnd_mode);
+    MPFR_GROUP_CLEAR (group);
+    MPFR_SAVE_EXPO_FREE (expo);
+
+    if (ok_y)
+      inex_y = mpfr_check_range (y, inex_y, rnd_mode);
+    if (ok_z)
+      inex_z = mpfr_check_range (z, inex_z, rnd_mode);
+  }
+
+  if (! ok_y)
+    inex_y = mpfr_log (y, x, rnd_mode);
+  if (! ok_z)
+    inex_z = mpfr_log1p (z, x, rnd_mode);
+
+  if (copied)
+    mpfr_clear (xc);
+  return INEX (inex_y, inex_z);
+}
@@ -87,7 +87,7 @@ If not, see <https://www.gnu.org/licenses/>. */
    no longer used, as they sometimes gave incorrect information about
    the support of thread-local variables. A configure check is now done.
    Also defines macros related to thread locking. */
-#if defined(MPFR_WANT_SHARED_CACHE)
+#if defined(MPFR_WANT_SHARED_CACHE) || defined(MPFR_WANT_PARALLEL_BS)
 # define MPFR_NEED_THREAD_LOCK 1
 #endif
 #include "mpfr-thread.h"
@@ -192,6 +192,15 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_HOT_FUNCTION_ATTR
 #endif
 
+/* Force the inlining of a static function, e.g. when it has several
+   callers but is critical for the performance of one of them. This must
+   be put after "static". */
+#if __MPFR_GNUC(3,1)
+# define MPFR_ALWAYS_INLINE         __inline__ __attribute__ ((always_inline))
+#else
+# define MPFR_ALWAYS_INLINE
+#endif
+
 /* The cold attribute on functions is used to inform the compiler
    that the function is unlikely to be executed. */
 #if __MPFR_GNUC(4,3)
@@ -1189,10 +1198,11 @@ typedef uintmax_t mpfr_ueexp_t;
    PowerPC and Aarch64 (64-bit ARM), and with Clang on x86_64.
    VSIGN code based on mini-gmp's GMP_CMP macro; adapted for INEXPOS. */
 
-/* Macros for functions returning two inexact values in an 'int'
+/* Macros for functions returning two (or three) inexact values in an 'int'
    (exact = 0, positive = 1, negative = 2) */
 #define INEXPOS(y) (((y) != 0) + ((y) < 0))
 #define INEX(y,z) (INEXPOS(y) | (INEXPOS(z) << 2))
+#define INEX3(y,z,w) (INEX(y,z) | (INEXPOS(w) << 4))
 
 /* When returning the ternary inexact value, ALWAYS use one of the
    following two macros, unless the flag comes from another function
@@ -1391,6 +1401,32 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
    MPFR_EXP(y) = (e),                           \
    MPFR_MANT(y) = MPFR_MANT(x))
 
+/* Set y to the regular number x with the precision p, where
+   PREC(x) <= p <= 2 * GMP_NUMB_BITS, so that y can be given to the
+   special code for equal precisions (mpfr_add1sp, mpfr_sub1sp, ...).
+   If x has one limb and p needs two, the significand of y is built in
+   yp[0..1] (the low limb is zero); otherwise y shares the significand
+   of x, with the same warnings as for MPFR_ALIAS. This is always exact
+   and does not allocate memory. */
+#define MPFR_WIDEN_LE2(y,yp,x,p)                                \
+  do                                                            \
+    {                                                           \
+      MPFR_ASSERTD (MPFR_PREC (x) <= (p));                      \
+      MPFR_ASSERTD ((p) <= 2 * GMP_NUMB_BITS);                  \
+      MPFR_PREC (y) = (p);                                      \
+      MPFR_SIGN (y) = MPFR_SIGN (x);                            \
+      MPFR_EXP (y) = MPFR_EXP (x);                              \
+      if ((p) > GMP_NUMB_BITS && MPFR_PREC (x) <= GMP_NUMB_BITS) \
+        {                                                       \
+          (yp)[0] = MPFR_LIMB_ZERO;                             \
+          (yp)[1] = MPFR_MANT (x)[0];                           \
+          MPFR_MANT (y) = (yp);                                 \
+        }                                                       \
+      else                                                      \
+        MPFR_MANT (y) = MPFR_MANT (x);                          \
+    }                                                           \
+  while (0)
+
 #define MPFR_TMP_INIT_ABS(y,x) \
   MPFR_ALIAS (y, x, MPFR_SIGN_POS, MPFR_EXP (x))
 
@@ -2109,9 +2145,69 @@ typedef struct {
 
 #ifndef MPFR_USE_LOGGING
 
-#define MPFR_ZIV_DECL(_x) mpfr_prec_t _x
-#define MPFR_ZIV_INIT(_x, _p) (_x) = GMP_NUMB_BITS
-#define MPFR_ZIV_NEXT(_x, _p) (MPFR_INC_PREC (_p, _x), (_x) = (_p)/2)
+/* Each Ziv loop has per-thread statistics: the number of loops and the
+   number of loops whose first attempt failed, in total (as returned by
+   mpfr_get_ziv_stats) and in the current window of MPFR_ZIV_WINDOW loops
+   (wleft is the number of loops left in this window). At the first loop
+   in the thread, mpfr_ziv_update registers the statistics; at the end of
+   each window, it adjusts the number of extra bits of the initial precision
+   (0 unless the adaptive mode is enabled with mpfr_set_ziv_adapt). These
+   bits are added by MPFR_ZIV_ADAPT, which must be called before the working
+   variables are allocated, and only where a larger initial precision is
+   valid for the error analysis. The name of a loop is the function name if
+   __func__ is supported, otherwise the source file name. */
+typedef struct __gmpfr_ziv_stat_s {
+  const char *name;
+  unsigned long calls, fails;
+  unsigned long wleft, wfails;
+  mpfr_prec_t extra;
+  int registered;
+  struct __gmpfr_ziv_stat_s *next;
+} mpfr_ziv_stat_t;
+
+__MPFR_DECLSPEC void mpfr_ziv_update (mpfr_ziv_stat_t *);
+
+#if (defined (__STDC_VERSION__) && __STDC_VERSION__ >= 199901L) || \
+  (defined (__cplusplus) && __cplusplus >= 201103L)
+# define MPFR_ZIV_NAME __func__
+#else
+# define MPFR_ZIV_NAME __FILE__
+#endif
+
+#define MPFR_ZIV_WINDOW 64
+#define MPFR_ZIV_MAX_EXTRA (4 * GMP_NUMB_BITS)
+
+#define MPFR_ZIV_DECL(_x)                                               \
+  mpfr_prec_t _x;                                                       \
+  int _x ## _first;                                                     \
+  static MPFR_THREAD_ATTR mpfr_ziv_stat_t _x ## _stat =                 \
+    { MPFR_ZIV_NAME, 0, 0, 0, 0, 0, 0, NULL }
+
+#define MPFR_ZIV_ADAPT(_x, _p) MPFR_INC_PREC (_p, (_x ## _stat).extra)
+
+#define MPFR_ZIV_INIT(_x, _p)                                           \
+  do                                                                    \
+    {                                                                   \
+      (_x) = GMP_NUMB_BITS;                                             \
+      _x ## _first = 1;                                                 \
+      if (MPFR_UNLIKELY ((_x ## _stat).wleft == 0))                     \
+        mpfr_ziv_update (&(_x ## _stat));                               \
+      (_x ## _stat).wleft --;                                           \
+      (_x ## _stat).calls ++;                                           \
+    }                                                                   \
+  while (0)
+
+#define MPFR_ZIV_NEXT(_x, _p)                                           \
+  do                                                                    \
+    {                                                                   \
+      MPFR_INC_PREC (_p, _x);                                           \
+      (_x) = (_p) / 2;                                                  \
+      (_x ## _stat).fails += _x ## _first;                              \
+      (_x ## _stat).wfails += _x ## _first;                             \
+      _x ## _first = 0;                                                 \
+    }                                                                   \
+  while (0)
+
 #define MPFR_ZIV_FREE(x)
 
 #else
@@ -2178,6 +2274,9 @@ typedef struct {
                  __func__, _x ## _cpt);                                 \
   while (0)
 
+/* No statistics are recorded by mpfr_get_ziv_stats with logging. */
+#define MPFR_ZIV_ADAPT(_x, _p) ((void) 0)
+
 #endif
 
 
@@ -2453,6 +2552,25 @@ __MPFR_DECLSPEC int mpfr_add1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
                                  mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sub1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
                                  mpfr_rnd_t);
+/* Precisions for which mpfr_add1sp_mixed and mpfr_sub1sp_mixed can be
+   used, see addsub_mixed.c. */
+#define MPFR_PREC_LE2_P(a,b,c)                  \
+  (MPFR_PREC (a) <= 2 * GMP_NUMB_BITS &&        \
+   MPFR_PREC (b) <= 2 * GMP_NUMB_BITS &&        \
+   MPFR_PREC (c) <= 2 * GMP_NUMB_BITS)
+__MPFR_DECLSPEC int mpfr_add1sp_mixed (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                       mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sub1sp_mixed (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                       mpfr_rnd_t);
+/* Minimal precision for mpfr_div_newton and mpfr_sqrt_newton, so that the
+   recursive calls on about half the precision terminate. */
+#define MPFR_NEWTON_PREC_MIN (4 * GMP_NUMB_BITS)
+__MPFR_DECLSPEC int mpfr_div_newton (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                     mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_div_newton_r (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                       mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC mpfr_prec_t mpfr_div_newton_prec (mpfr_prec_t);
+__MPFR_DECLSPEC int mpfr_sqrt_newton (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_can_round_raw (const mp_limb_t *,
              mp_size_t, int, mpfr_exp_t, mpfr_rnd_t, mpfr_rnd_t, mpfr_prec_t);
 
@@ -2526,6 +2644,8 @@ __MPFR_DECLSPEC int  mpfr_cache (mpfr_ptr, mpfr_cache_t, mpfr_rnd_t);
 
 __MPFR_DECLSPEC void mpfr_mulhigh_n (mpfr_limb_ptr, mpfr_limb_srcptr,
                                      mpfr_limb_srcptr, mp_size_t);
+__MPFR_DECLSPEC void mpfr_mulhigh_nm (mpfr_limb_ptr, mpfr_limb_srcptr,
+                                      mp_size_t, mpfr_limb_srcptr, mp_size_t);
 __MPFR_DECLSPEC void mpfr_mullow_n  (mpfr_limb_ptr, mpfr_limb_srcptr,
                                      mpfr_limb_srcptr, mp_size_t);
 __MPFR_DECLSPEC void mpfr_sqrhigh_n (mpfr_limb_ptr, mpfr_limb_srcptr,
@@ -2547,9 +2667,51 @@ __MPFR_DECLSPEC void mpfr_rand_raw (mpfr_limb_ptr, gmp_randstate_t,
 __MPFR_DECLSPEC mpz_srcptr mpfr_bernoulli_cache (unsigned long);
 __MPFR_DECLSPEC void mpfr_bernoulli_freecache (void);
 
+__MPFR_DECLSPEC size_t mpfr_mpn_get_str (unsigned char *, int, mp_limb_t *,
+                                         mp_size_t);
+__MPFR_DECLSPEC mp_size_t mpfr_mpn_set_str (mp_limb_t *, const unsigned char *,
+                                            size_t, int);
+__MPFR_DECLSPEC void mpfr_mpn_get_str_freecache (void);
+__MPFR_DECLSPEC void mpfr_get_str_shortest_freecache (void);
+
+/* Per-thread table of powers of 10 on MPFR_POW10_PREC bits, for exponents
+   of absolute value at most MPFR_POW10_MAX (see get_str_shortest.c). */
+#if GMP_NUMB_BITS == 32 || GMP_NUMB_BITS == 64
+# define MPFR_POW10_TAB 1
+# define MPFR_POW10_PREC 192
+# define MPFR_POW10_MAX (32 * 160)
+__MPFR_DECLSPEC int mpfr_pow10_approx (mpfr_ptr, long);
+#endif
+
 __MPFR_DECLSPEC int mpfr_sincos_fast (mpfr_ptr, mpfr_ptr, mpfr_srcptr,
                                       mpfr_rnd_t);
 
+__MPFR_DECLSPEC void mpfr_trig_reduce (mpfr_ptr, int *, mpfr_srcptr);
+__MPFR_DECLSPEC void mpfr_trig_reduce_freecache (void);
+
+__MPFR_DECLSPEC void mpfr_atan_freecache (void);
+
+/* Table-driven kernels in fixed-point arithmetic for exp, log, sin and cos
+   in small precisions, up to MPFR_FIXED_MAXPREC bits (see fixed_kernels.c).
+   They return 0 when the result cannot be rounded. */
+#if GMP_NUMB_BITS == 32 || GMP_NUMB_BITS == 64
+# define MPFR_FIXED_MAXPREC 128
+__MPFR_DECLSPEC int mpfr_exp_fixed (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_log_fixed (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sincos_fixed (mpfr_ptr, mpfr_ptr, mpfr_srcptr,
+                                       mpfr_rnd_t);
+#endif
+__MPFR_DECLSPEC void mpfr_fixed_freecache (void);
+
+__MPFR_DECLSPEC mpfr_exp_t mpfr_poly_eval_approx (mpfr_ptr, const mpfr_ptr *,
+                                                  unsigned long, mpfr_srcptr);
+
+typedef void (*mpfr_bs_func_t) (void *);
+__MPFR_DECLSPEC void mpfr_bs_run2 (mpfr_bs_func_t, void *, mpfr_bs_func_t,
+                                   void *, unsigned long, unsigned long);
+__MPFR_DECLSPEC void mpfr_bs_run (mpfr_bs_func_t, void *, size_t,
+                                  unsigned long, unsigned long, unsigned long);
+
 __MPFR_DECLSPEC double mpfr_scale2 (double, int);
 
 __MPFR_DECLSPEC void mpfr_div_ui2 (mpfr_ptr, mpfr_srcptr, unsigned long,
@@ -274,6 +274,33 @@ typedef __mpfr_struct mpfr_t[1];
 typedef __mpfr_struct *mpfr_ptr;
 typedef const __mpfr_struct *mpfr_srcptr;
 
+/* Precomputed divisor (see mpfr_divisor_init). The fields are not in the
+   API and might change in further versions. */
+typedef struct {
+  __mpfr_struct _mpfr_v;    /* copy of the divisor */
+  __mpfr_struct _mpfr_r;    /* approximate reciprocal (large precisions) */
+  mp_limb_t     _mpfr_inv;  /* approximate inverse (1 or 2 limbs) */
+} __mpfr_divisor_struct;
+
+typedef __mpfr_divisor_struct mpfr_divisor_t[1];
+typedef __mpfr_divisor_struct *mpfr_divisor_ptr;
+typedef const __mpfr_divisor_struct *mpfr_divisor_srcptr;
+
+/* Compiled format string for the formatted output functions (see
+   mpfr_format_compile). The fields are not in the API and might change
+   in further versions. */
+typedef struct {
+  void   *_mpfr_items;    /* parsed format (start of the allocated block) */
+  char   *_mpfr_fmt;      /* copy of the format string */
+  size_t  _mpfr_nitems;   /* number of items of the parsed format */
+  size_t  _mpfr_size;     /* size of the allocated block, in bytes */
+  int     _mpfr_compiled; /* zero if the format string is interpreted */
+} __mpfr_format_struct;
+
+typedef __mpfr_format_struct mpfr_format_t[1];
+typedef __mpfr_format_struct *mpfr_format_ptr;
+typedef const __mpfr_format_struct *mpfr_format_srcptr;
+
 /* For those who need a direct and fast access to the sign field.
    However, it is not in the API, thus use it at your own risk: it
    might not be supported, or change name, in further versions!
@@ -573,6 +600,8 @@ __MPFR_DECLSPEC unsigned long mpfr_get_ui (mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC size_t mpfr_get_str_ndigits (int, mpfr_prec_t);
 __MPFR_DECLSPEC char * mpfr_get_str (char*, mpfr_exp_t*, int, size_t,
                                      mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC char * mpfr_get_str_shortest (char*, mpfr_exp_t*, int,
+                                              mpfr_srcptr);
 __MPFR_DECLSPEC int mpfr_get_z (mpz_ptr, mpfr_srcptr, mpfr_rnd_t);
 
 __MPFR_DECLSPEC void mpfr_free_str (char *);
@@ -596,6 +625,10 @@ __MPFR_DECLSPEC int mpfr_printf (const char*, ...);
 __MPFR_DECLSPEC int mpfr_asprintf (char**, const char*, ...);
 __MPFR_DECLSPEC int mpfr_sprintf (char*, const char*, ...);
 __MPFR_DECLSPEC int mpfr_snprintf (char*, size_t, const char*, ...);
+__MPFR_DECLSPEC int mpfr_format_compile (mpfr_format_ptr, const char*);
+__MPFR_DECLSPEC void mpfr_format_clear (mpfr_format_ptr);
+__MPFR_DECLSPEC int mpfr_format_apply (char*, size_t, mpfr_format_srcptr,
+                                       ...);
 #endif
 
 __MPFR_DECLSPEC int mpfr_pow (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
@@ -619,6 +652,10 @@ __MPFR_DECLSPEC int mpfr_add (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sub (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_mul (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_div (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_divisor_init (mpfr_divisor_ptr, mpfr_srcptr);
+__MPFR_DECLSPEC void mpfr_divisor_clear (mpfr_divisor_ptr);
+__MPFR_DECLSPEC int mpfr_div_by_precomp (mpfr_ptr, mpfr_srcptr,
+                                         mpfr_divisor_srcptr, mpfr_rnd_t);
 
 __MPFR_DECLSPEC int mpfr_add_ui (mpfr_ptr, mpfr_srcptr, unsigned long,
                                  mpfr_rnd_t);
@@ -660,6 +697,8 @@ __MPFR_DECLSPEC int mpfr_log (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log2 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log10 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log1p (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_log_log1p (mpfr_ptr, mpfr_ptr, mpfr_srcptr,
+                                    mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log2p1 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log10p1 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_log_ui (mpfr_ptr, unsigned long, mpfr_rnd_t);
@@ -668,6 +707,8 @@ __MPFR_DECLSPEC int mpfr_exp (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_exp2 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_exp10 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_expm1 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_exp_expm1 (mpfr_ptr, mpfr_ptr, mpfr_srcptr,
+                                    mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_exp2m1 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_exp10m1 (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_eint (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
@@ -767,6 +808,9 @@ __MPFR_DECLSPEC int mpfr_asin (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_atan (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sin (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sin_cos (mpfr_ptr, mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sin_cos_tan (mpfr_ptr, mpfr_ptr, mpfr_ptr,
+                                      mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_tan_sec (mpfr_ptr, mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_cos (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_tan (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_atan2 (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
@@ -845,12 +889,37 @@ __MPFR_DECLSPEC int mpfr_sum (mpfr_ptr, const mpfr_ptr *, unsigned long,
                               mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_dot (mpfr_ptr, const mpfr_ptr *, const mpfr_ptr *,
                               unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_poly_eval (mpfr_ptr, const mpfr_ptr *, unsigned long,
+                                    mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_exp_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                  unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_log_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                  unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sin_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                  unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_cos_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                  unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sin_cos_vec (int *, const mpfr_ptr *,
+                                      const mpfr_ptr *, const mpfr_ptr *,
+                                      unsigned long, mpfr_rnd_t);
 
 __MPFR_DECLSPEC void mpfr_free_cache (void);
 __MPFR_DECLSPEC void mpfr_free_cache2 (mpfr_free_cache_t);
 __MPFR_DECLSPEC void mpfr_free_pool (void);
 __MPFR_DECLSPEC int mpfr_mp_memory_cleanup (void);
 
+__MPFR_DECLSPEC int mpfr_set_bs_threads (unsigned long);
+__MPFR_DECLSPEC unsigned long mpfr_get_bs_threads (void);
+__MPFR_DECLSPEC void mpfr_set_bs_min_terms (unsigned long);
+__MPFR_DECLSPEC unsigned long mpfr_get_bs_min_terms (void);
+
+__MPFR_DECLSPEC void mpfr_set_ziv_adapt (int);
+__MPFR_DECLSPEC int mpfr_get_ziv_adapt (void);
+__MPFR_DECLSPEC const char * mpfr_get_ziv_stats (unsigned long,
+                                                 unsigned long *,
+                                                 unsigned long *);
+__MPFR_DECLSPEC void mpfr_reset_ziv_stats (void);
+
 __MPFR_DECLSPEC int mpfr_subnormalize (mpfr_ptr, int, mpfr_rnd_t);
 
 __MPFR_DECLSPEC int mpfr_strtofr (mpfr_ptr, const char *, char **, int,
@@ -868,9 +937,19 @@ __MPFR_DECLSPEC void mpfr_custom_move (mpfr_ptr, void *);
 __MPFR_DECLSPEC void mpfr_custom_init_set (mpfr_ptr, int, mpfr_exp_t,
                                            mpfr_prec_t, void *);
 __MPFR_DECLSPEC int mpfr_custom_get_kind (mpfr_srcptr);
+__MPFR_DECLSPEC size_t mpfr_custom_table_size (mpfr_prec_t, size_t);
+__MPFR_DECLSPEC void mpfr_custom_table_init (void *, mpfr_prec_t, size_t);
+__MPFR_DECLSPEC int mpfr_custom_table_set (void *, size_t, mpfr_srcptr,
+                                           mpfr_rnd_t);
+__MPFR_DECLSPEC size_t mpfr_custom_table_check (const void *, size_t);
+__MPFR_DECLSPEC void mpfr_custom_table_get (mpfr_ptr, const void *, size_t);
 
 __MPFR_DECLSPEC int mpfr_total_order_p (mpfr_srcptr, mpfr_srcptr);
 
+__MPFR_DECLSPEC size_t mpfr_fpif_size (mpfr_srcptr);
+__MPFR_DECLSPEC size_t mpfr_fpif_export_buf (void *, size_t, mpfr_srcptr);
+__MPFR_DECLSPEC size_t mpfr_fpif_import_buf (mpfr_ptr, const void *, size_t);
+
 #if defined (__cplusplus)
 }
 #endif
@@ -1235,6 +1314,13 @@ extern "C" {
 __MPFR_DECLSPEC size_t mpfr_inp_str (mpfr_ptr, FILE*, int, mpfr_rnd_t);
 __MPFR_DECLSPEC size_t mpfr_out_str (FILE*, int, size_t, mpfr_srcptr,
                                      mpfr_rnd_t);
+#define mpfr_inp_str_array __gmpfr_inp_str_array
+#define mpfr_out_str_array __gmpfr_out_str_array
+__MPFR_DECLSPEC size_t mpfr_inp_str_array (mpfr_ptr *, size_t, FILE*, int,
+                                           mpfr_rnd_t);
+__MPFR_DECLSPEC size_t mpfr_out_str_array (FILE*, int, size_t,
+                                           const mpfr_ptr *, size_t,
+                                           mpfr_rnd_t);
 #ifndef MPFR_USE_MINI_GMP
 #define mpfr_fprintf __gmpfr_fprintf
 __MPFR_DECLSPEC int mpfr_fprintf (FILE*, const char*, ...);
@@ -1243,6 +1329,10 @@ __MPFR_DECLSPEC int mpfr_fprintf (FILE*, const char*, ...);
 #define mpfr_fpif_import __gmpfr_fpif_import
 __MPFR_DECLSPEC int mpfr_fpif_export (FILE*, mpfr_srcptr);
 __MPFR_DECLSPEC int mpfr_fpif_import (mpfr_ptr, FILE*);
+#define mpfr_fpif_export_array __gmpfr_fpif_export_array
+#define mpfr_fpif_import_array __gmpfr_fpif_import_array
+__MPFR_DECLSPEC int mpfr_fpif_export_array (FILE*, const mpfr_ptr *, size_t);
+__MPFR_DECLSPEC size_t mpfr_fpif_import_array (mpfr_ptr *, size_t, FILE*);
 
 #if defined (__cplusplus)
 }
@@ -1265,10 +1355,13 @@ extern "C" {
 #define mpfr_vasprintf __gmpfr_vasprintf
 #define mpfr_vsprintf __gmpfr_vsprintf
 #define mpfr_vsnprintf __gmpfr_vsnprintf
+#define mpfr_format_vapply __gmpfr_format_vapply
 __MPFR_DECLSPEC int mpfr_vprintf (const char*, va_list);
 __MPFR_DECLSPEC int mpfr_vasprintf (char**, const char*, va_list);
 __MPFR_DECLSPEC int mpfr_vsprintf (char*, const char*, va_list);
 __MPFR_DECLSPEC int mpfr_vsnprintf (char*, size_t, const char*, va_list);
+__MPFR_DECLSPEC int mpfr_format_vapply (char*, size_t, mpfr_format_srcptr,
+                                        va_list);
 
 #if defined (__cplusplus)
 }
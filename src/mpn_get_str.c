@@ -0,0 +1,446 @@
+/* mpfr_mpn_get_str, mpfr_mpn_set_str -- radix conversions of natural
+   numbers, using a cache of the powers of the base
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* For large inputs, mpfr_mpn_get_str uses the same divide-and-conquer
+   algorithm as mpn_get_str: the input is divided by a power P of the base
+   having about half its size, then the quotient and the remainder (which
+   gives exactly log_b(P) digits) are converted recursively. As in GMP,
+   the power of 2 dividing P is handled by shifts, so that the division is
+   only done by the odd part O of P (which is smaller by about 30% in base
+   10). The difference is that the powers P_i = b^(d*2^i), where b^d is the
+   largest power of b that fits in a limb, and the approximate inverses of
+   their odd parts used for the divisions (with Barrett's algorithm, thus
+   with two multiplications only), are kept in a cache, so that they are
+   computed only once for all the conversions in a given base, instead of
+   at each call (and for the inverses, at each division). This cache is
+   local to the thread, and freed by mpfr_free_cache. */
+
+typedef struct {
+  mp_limb_t *p;    /* O_i * 2^shift, normalized, on n limbs */
+  mp_limb_t *inv;  /* floor(B^(n+pn) / p) on pn + 1 limbs, or NULL */
+  mp_size_t n;
+  mp_size_t pn;    /* number of limbs of P_i */
+  int shift;
+  size_t zbits;    /* P_i = O_i * 2^zbits */
+  size_t digits;   /* P_i = b^digits */
+} mpfr_powtab_t;
+
+/* P_i has at least 2^i bits, thus this is more than enough. */
+#define MPFR_POWTAB_SIZE GMP_NUMB_BITS
+
+static MPFR_THREAD_ATTR int powtab_base = 0;
+static MPFR_THREAD_ATTR int powtab_size = 0;
+static MPFR_THREAD_ATTR mpfr_powtab_t powtab[MPFR_POWTAB_SIZE];
+
+void
+mpfr_mpn_get_str_freecache (void)
+{
+  int i;
+
+  for (i = 0; i < powtab_size; i++)
+    {
+      mpfr_free_func (powtab[i].p, powtab[i].n * MPFR_BYTES_PER_MP_LIMB);
+      if (powtab[i].inv != NULL)
+        mpfr_free_func (powtab[i].inv,
+                        (powtab[i].pn + 1) * MPFR_BYTES_PER_MP_LIMB);
+    }
+  powtab_size = 0;
+  powtab_base = 0;
+}
+
+/* Add the next power of b to the table. */
+static void
+powtab_extend (int b)
+{
+  mpfr_powtab_t *pw = powtab + powtab_size;
+  size_t nbits;
+
+  MPFR_ASSERTN (powtab_size < MPFR_POWTAB_SIZE);
+  if (powtab_size == 0)
+    {
+      mp_limb_t big = b;
+      size_t d = 1;
+      int z;
+
+      while (big <= MPFR_LIMB_MAX / b)
+        {
+          big *= b;
+          d++;
+        }
+      count_trailing_zeros (z, big);
+      big >>= z;
+      pw->p = (mp_limb_t *) mpfr_allocate_func (MPFR_BYTES_PER_MP_LIMB);
+      count_leading_zeros (pw->shift, big);
+      pw->p[0] = big << pw->shift;
+      pw->n = 1;
+      pw->zbits = z;
+      pw->digits = d;
+    }
+  else
+    {
+      mpfr_powtab_t *pv = pw - 1;
+      mp_size_t n = pv->n;
+      mp_limb_t *t, *u;
+      MPFR_TMP_DECL (marker);
+
+      MPFR_TMP_MARK (marker);
+      t = MPFR_TMP_LIMBS_ALLOC (2 * n);
+      u = MPFR_TMP_LIMBS_ALLOC (n);
+      if (pv->shift != 0)
+        mpn_rshift (u, pv->p, n, pv->shift);
+      else
+        MPN_COPY (u, pv->p, n);
+      mpn_sqr (t, u, n);
+      n = 2 * n - (t[2 * n - 1] == 0);
+      pw->p = (mp_limb_t *) mpfr_allocate_func (n * MPFR_BYTES_PER_MP_LIMB);
+      count_leading_zeros (pw->shift, t[n - 1]);
+      if (pw->shift != 0)
+        mpn_lshift (pw->p, t, n, pw->shift);
+      else
+        MPN_COPY (pw->p, t, n);
+      pw->n = n;
+      pw->zbits = 2 * pv->zbits;
+      pw->digits = 2 * pv->digits;
+      MPFR_TMP_FREE (marker);
+    }
+  nbits = (size_t) pw->n * GMP_NUMB_BITS - pw->shift + pw->zbits;
+  pw->pn = (nbits - 1) / GMP_NUMB_BITS + 1;
+  pw->inv = NULL;
+  powtab_size++;
+}
+
+/* Compute the inverse of pw->p, needed by powtab_divrem. */
+static void
+powtab_invert (mpfr_powtab_t *pw)
+{
+  mp_size_t n = pw->n, pn = pw->pn;
+  mp_limb_t *a, *q, *r;
+  MPFR_TMP_DECL (marker);
+
+  MPFR_TMP_MARK (marker);
+  a = MPFR_TMP_LIMBS_ALLOC (n + pn + 1);
+  q = MPFR_TMP_LIMBS_ALLOC (pn + 2);
+  r = MPFR_TMP_LIMBS_ALLOC (n);
+  MPN_ZERO (a, n + pn);
+  a[n + pn] = 1;
+  mpn_tdiv_qr (q, r, 0, a, n + pn + 1, pw->p, n);
+  MPFR_ASSERTD (q[pn + 1] == 0);
+  pw->inv = (mp_limb_t *)
+    mpfr_allocate_func ((pn + 1) * MPFR_BYTES_PER_MP_LIMB);
+  MPN_COPY (pw->inv, q, pn + 1);
+  MPFR_TMP_FREE (marker);
+}
+
+/* Assuming pw->pn <= un and {up, un} < P^2 with P = P_i described by pw,
+   put in {qp, qn} the quotient of {up, un} by P, where qn <= pw->pn is
+   returned, and in {up, pw->pn} the remainder. */
+static mp_size_t
+powtab_divrem (mp_limb_t *qp, mp_limb_t *up, mp_size_t un,
+               const mpfr_powtab_t *pw)
+{
+  mp_size_t n = pw->n, pn = pw->pn, zl, an, k, qn;
+  int zr;
+  mp_limb_t *a, *t, *h;
+  MPFR_TMP_DECL (marker);
+
+  MPFR_ASSERTD (pn <= un && un <= 2 * pn);
+  zl = pw->zbits / GMP_NUMB_BITS;
+  zr = pw->zbits % GMP_NUMB_BITS;
+  MPFR_TMP_MARK (marker);
+  a = MPFR_TMP_LIMBS_ALLOC (MAX (un - zl, n) + 1);
+
+  /* A = floor({up, un} / 2^zbits) * 2^shift has an limbs, and the quotient
+     of A by p is the wanted quotient Q. Since {up, un} < P^2, we have
+     A < p * P < B^(n+pn). */
+  an = un - zl;
+  if (zr != 0)
+    mpn_rshift (a, up + zl, an, zr);
+  else
+    MPN_COPY (a, up + zl, an);
+  MPN_NORMALIZE (a, an);
+  if (pw->shift != 0 && an > 0)
+    {
+      mp_limb_t c = mpn_lshift (a, a, an, pw->shift);
+      if (c != 0)
+        a[an++] = c;
+    }
+  MPFR_ASSERTD (an <= n + pn);
+  if (an <= n)
+    {
+      /* A < B^n, thus Q <= 3 */
+      MPN_ZERO (a + an, n + 1 - an);
+      an = n;
+    }
+
+  /* Barrett's algorithm, with the inverse truncated to the size of the
+     quotient: with k = an - n, A1 = floor(A / B^(n-1)) < B^(k+1) and
+     inv_k = floor(inv / B^(pn-k)), the estimate Q0 = floor(A1 * inv_k /
+     B^(k+1)) satisfies Q - 3 <= Q0 <= Q. When possible, we use one more
+     limb of A and inv, so that the product can be replaced by a short
+     product, whose error is less than (k+2)/B in the unit of Q0: then
+     Q - 4 <= Q0 <= Q. */
+  k = an - n;
+  t = MPFR_TMP_LIMBS_ALLOC (MAX (2 * k + 4, n + k + 1));
+  if (n >= 2 && k < pn)
+    {
+      mpfr_mulhigh_n (t, a + n - 2, pw->inv + pn - k - 1, k + 2);
+      h = t + 2;
+    }
+  else
+    {
+      mpn_mul_n (t, a + n - 1, pw->inv + pn - k, k + 1);
+      h = t;
+    }
+  /* Q < P <= B^pn */
+  qn = MIN (k + 1, pn);
+  MPFR_ASSERTD (qn == k + 1 || h[2 * k + 1] == 0);
+  MPN_COPY (qp, h + k + 1, qn);
+
+  /* the remainder A - Q0 * p < 5p fits in n + 1 limbs */
+  if (qn <= n)
+    mpn_mul (t, pw->p, n, qp, qn);
+  else
+    mpn_mul (t, qp, qn, pw->p, n);
+  mpn_sub_n (a, a, t, n + 1);
+  while (a[n] != 0 || mpn_cmp (a, pw->p, n) >= 0)
+    {
+      mp_limb_t c;
+
+      a[n] -= mpn_sub_n (a, a, pw->p, n);
+      c = mpn_add_1 (qp, qp, qn, 1);
+      MPFR_ASSERTD (c == 0);
+    }
+
+  /* The remainder by P is R * 2^zbits + ({up, un} mod 2^zbits), where
+     R = A / 2^shift < O. */
+  if (pw->shift != 0)
+    mpn_rshift (a, a, n, pw->shift);
+  a[n] = 0;
+  if (zr != 0)
+    {
+      mp_limb_t low = up[zl] & ((MPFR_LIMB_ONE << zr) - 1);
+
+      mpn_lshift (a, a, n + 1, zr);
+      a[0] |= low;
+    }
+  MPFR_ASSERTD (zl + n + 1 <= pn || a[n] == 0);
+  MPN_COPY (up + zl, a, pn - zl);
+  MPFR_TMP_FREE (marker);
+  return qn;
+}
+
+/* Write the digits of {up, un} in base b at str, and return the address
+   following the last digit. If len is zero, leading zeros are omitted;
+   otherwise exactly len digits are written (with leading zeros), and
+   {up, un} must be less than b^len. Assume {up, un} < P_(i+1) = P_i^2.
+   The area {up, un} is destroyed. */
+static unsigned char *
+mpn_get_str_dc (unsigned char *str, size_t len, int b,
+                mp_limb_t *up, mp_size_t un, int i)
+{
+  const mpfr_powtab_t *pw;
+  mp_limb_t *qp;
+  mp_size_t qn;
+  MPFR_TMP_DECL (marker);
+
+  MPN_NORMALIZE (up, un);
+  if (i < 0 || un < MPFR_GET_STR_DC_THRESHOLD)
+    {
+      size_t k = un == 0 ? 0 : mpn_get_str (str, b, up, un);
+
+      if (k < len)
+        {
+          memmove (str + (len - k), str, k);
+          memset (str, 0, len - k);
+          k = len;
+        }
+      return str + k;
+    }
+
+  /* if {up, un} < P_i, go to the next level */
+  pw = powtab + i;
+  if (un < pw->pn || (len != 0 && len <= pw->digits))
+    return mpn_get_str_dc (str, len, b, up, un, i - 1);
+
+  if (pw->inv == NULL)
+    powtab_invert (powtab + i);
+  MPFR_TMP_MARK (marker);
+  qp = MPFR_TMP_LIMBS_ALLOC (pw->pn);
+  qn = powtab_divrem (qp, up, un, pw);
+  MPN_NORMALIZE (qp, qn);
+  if (len == 0 && qn == 0)
+    str = mpn_get_str_dc (str, 0, b, up, pw->pn, i - 1);
+  else
+    {
+      str = mpn_get_str_dc (str, len == 0 ? 0 : len - pw->digits, b,
+                            qp, qn, i - 1);
+      str = mpn_get_str_dc (str, pw->digits, b, up, pw->pn, i - 1);
+    }
+  MPFR_TMP_FREE (marker);
+  return str;
+}
+
+/* Same as mpn_get_str: write at str the digits of {up, un} in base b
+   (as values from 0 to b-1, without leading zeros), and return their
+   number. The most significant limb of {up, un} must be non-zero, str
+   must have room for one more digit than the result, and {up, un} is
+   destroyed. */
+size_t
+mpfr_mpn_get_str (unsigned char *str, int b, mp_limb_t *up, mp_size_t un)
+{
+  int i;
+
+  MPFR_ASSERTD (un > 0 && up[un - 1] != 0);
+  if (un < MPFR_GET_STR_DC_THRESHOLD)
+    return mpn_get_str (str, b, up, un);
+
+  if (b != powtab_base)
+    {
+      mpfr_mpn_get_str_freecache ();
+      powtab_base = b;
+    }
+  /* find the smallest i such that P_i > {up, un} */
+  for (i = 0; ; i++)
+    {
+      if (i == powtab_size)
+        powtab_extend (b);
+      if (powtab[i].pn > un)
+        break;
+    }
+  return mpn_get_str_dc (str, 0, b, up, un, i - 1) - str;
+}
+
+/* Upper bound on the number of limbs of a number of len digits in base b,
+   plus some margin for mpn_set_str_dc: since b^(d+1) > B where d is the
+   number of digits of P_0, a digit has less than GMP_NUMB_BITS/d bits. */
+#define SET_STR_LIMBS(len) ((mp_size_t) ((len) / powtab[0].digits) + 8)
+
+/* Put in {rp, rn} the value of the len digits at str in base b (possibly
+   with leading zeros), and return rn (0 if the value is zero). The area at
+   rp must have SET_STR_LIMBS(len) limbs. The powers P_j for j <= i must be
+   in the table, and len <= 2 * P_i.digits. */
+static mp_size_t
+mpn_set_str_dc (mp_limb_t *rp, const unsigned char *str, size_t len, int b,
+                int i)
+{
+  const mpfr_powtab_t *pw;
+  mp_limb_t *h, *t;
+  mp_size_t ln, hn, tn, n;
+  size_t hl;
+  long e;
+  MPFR_TMP_DECL (marker);
+
+  while (len > 0 && *str == 0)
+    {
+      str++;
+      len--;
+    }
+  if (len < MPFR_SET_STR_DC_THRESHOLD * powtab[0].digits)
+    i = -1;
+  else
+    while (i >= 0 && powtab[i].digits >= len)
+      i--;
+  if (i < 0)
+    return len == 0 ? 0 : mpn_set_str (rp, str, len, b);
+
+  /* split the digits as H * P_i + L, where L has P_i.digits digits */
+  pw = powtab + i;
+  n = pw->n;
+  hl = len - pw->digits;
+  MPFR_TMP_MARK (marker);
+  h = MPFR_TMP_LIMBS_ALLOC (SET_STR_LIMBS (hl));
+  hn = mpn_set_str_dc (h, str, hl, b, i - 1);
+  ln = mpn_set_str_dc (rp, str + hl, pw->digits, b, i - 1);
+  if (hn == 0)
+    {
+      MPFR_TMP_FREE (marker);
+      return ln;
+    }
+
+  /* H * P_i = H * p * 2^e with e = zbits - shift >= - shift */
+  t = MPFR_TMP_LIMBS_ALLOC (hn + n + 1);
+  if (hn >= n)
+    mpn_mul (t, h, hn, pw->p, n);
+  else
+    mpn_mul (t, pw->p, n, h, hn);
+  tn = hn + n;
+  e = (long) pw->zbits - pw->shift;
+  if (e < 0)
+    mpn_rshift (t, t, tn, -e);  /* exact */
+  else if (e % GMP_NUMB_BITS != 0)
+    {
+      t[tn] = mpn_lshift (t, t, tn, e % GMP_NUMB_BITS);
+      tn++;
+    }
+  MPN_NORMALIZE (t, tn);
+
+  /* add L < P_i */
+  e = e < 0 ? 0 : e / GMP_NUMB_BITS;
+  MPFR_ASSERTD (ln <= e + tn);
+  MPN_ZERO (rp + ln, e + tn - ln);
+  rp[e + tn] = mpn_add_n (rp + e, rp + e, t, tn);
+  tn += e + 1;
+  MPN_NORMALIZE (rp, tn);
+  MPFR_TMP_FREE (marker);
+  return tn;
+}
+
+/* Same as mpn_set_str: put in {rp, rn} the value of the len digits (as
+   values from 0 to b-1) at str in base b, and return rn. The first digit
+   must be non-zero, and rp must have room for rn + 1 limbs. */
+mp_size_t
+mpfr_mpn_set_str (mp_limb_t *rp, const unsigned char *str, size_t len, int b)
+{
+  mp_limb_t *t;
+  mp_size_t rn;
+  int i;
+  MPFR_TMP_DECL (marker);
+
+  MPFR_ASSERTD (len > 0 && str[0] != 0);
+  /* a limb has at least 10 digits for b <= 62, thus this avoids the
+     cache in most cases where it would not be used */
+  if (IS_POW2 (b) || len < MPFR_SET_STR_DC_THRESHOLD * 10)
+    return mpn_set_str (rp, str, len, b);
+
+  if (b != powtab_base)
+    {
+      mpfr_mpn_get_str_freecache ();
+      powtab_base = b;
+    }
+  /* find the largest i such that P_i has less than len digits */
+  for (i = 0; ; i++)
+    {
+      if (i == powtab_size)
+        powtab_extend (b);
+      if (2 * powtab[i].digits >= len)
+        break;
+    }
+  MPFR_TMP_MARK (marker);
+  t = MPFR_TMP_LIMBS_ALLOC (SET_STR_LIMBS (len));
+  rn = mpn_set_str_dc (t, str, len, b, i);
+  MPN_COPY (rp, t, rn);
+  MPFR_TMP_FREE (marker);
+  return rn;
+}
@@ -726,8 +726,55 @@ mpfr_mul_3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
     }
 }
 
+/* Special code when prec(a), prec(b), prec(c) are not all equal, with
+   either prec(a), prec(b), prec(c) <= GMP_NUMB_BITS, or
+   GMP_NUMB_BITS < prec(a) < 2*GMP_NUMB_BITS and prec(b), prec(c) <=
+   2*GMP_NUMB_BITS (see MPFR_MUL_LE2_P). When prec(a) <= GMP_NUMB_BITS and
+   b or c has 2 limbs, one could round the product to odd on
+   2*GMP_NUMB_BITS-1 bits with mpfr_mul_2, then round to prec(a) bits, but
+   this is slower than the generic code. */
+#define MPFR_MUL_LE2_P(aq,bq,cq)                                \
+  ((aq) < 2 * GMP_NUMB_BITS &&                                  \
+   (bq) <= 2 * GMP_NUMB_BITS && (cq) <= 2 * GMP_NUMB_BITS &&    \
+   ((aq) > GMP_NUMB_BITS ||                                     \
+    ((bq) <= GMP_NUMB_BITS && (cq) <= GMP_NUMB_BITS)))
+static int
+mpfr_mul_le2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
+{
+  mpfr_prec_t aq = MPFR_GET_PREC (a);
+  mpfr_t bb, cc;
+  mp_limb_t bp[2], cp[2];
+
+  MPFR_ASSERTD (MPFR_MUL_LE2_P (aq, MPFR_GET_PREC (b), MPFR_GET_PREC (c)));
+
+  /* mpfr_mul_1 and mpfr_mul_1n compute the full 2-limb product of the
+     1-limb significands of b and c, thus work for any prec(b), prec(c). */
+  if (aq < GMP_NUMB_BITS)
+    return mpfr_mul_1 (a, b, c, rnd_mode, aq);
+  if (aq == GMP_NUMB_BITS)
+    return mpfr_mul_1n (a, b, c, rnd_mode);
+
+  /* Likewise, mpfr_mul_2 computes the product of two 2-limb significands;
+     a 1-limb significand is extended with a zero low limb, which is exact. */
+  MPFR_WIDEN_LE2 (bb, bp, b, 2 * GMP_NUMB_BITS);
+  MPFR_WIDEN_LE2 (cc, cp, c, 2 * GMP_NUMB_BITS);
+  return mpfr_mul_2 (a, bb, cc, rnd_mode, aq);
+}
+
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
+/* Don't use MPFR_MULHIGH_NM_SIZE since it is handled by tuneup.
+   For a short operand of cn <= MPFR_MUL_THRESHOLD limbs, mulhigh_nm_tab[cn]
+   is the minimal number of low limbs of the long operand that must be
+   neglected for the unbalanced short product mpfr_mulhigh_nm to be used
+   (-1 means never). The last entry is used for larger values of cn. */
+#ifdef MPFR_MULHIGH_NM_TAB_SIZE
+static short mulhigh_nm_tab[MPFR_MULHIGH_NM_TAB_SIZE];
+#else
+static short mulhigh_nm_tab[] = {MPFR_MULHIGH_NM_TAB};
+#define MPFR_MULHIGH_NM_TAB_SIZE (numberof_const (mulhigh_nm_tab))
+#endif
+
 /* Note: mpfr_sqr will call mpfr_mul if bn > MPFR_SQR_THRESHOLD,
    in order to use Mulders' mulhigh, which is handled only here
    to avoid partial code duplication. There is some overhead due
@@ -742,7 +789,7 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
   mp_limb_t *tmp;
   mp_limb_t b1;
   mpfr_prec_t aq, bq, cq;
-  mp_size_t bn, cn, tn, k, threshold;
+  mp_size_t bn, cn, tn, k, threshold, d;
   MPFR_TMP_DECL (marker);
 
   MPFR_LOG_FUNC
@@ -817,6 +864,8 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       if (2 * GMP_NUMB_BITS < aq && aq < 3 * GMP_NUMB_BITS)
         return mpfr_mul_3 (a, b, c, rnd_mode, aq);
     }
+  else if (MPFR_MUL_LE2_P (aq, bq, cq))
+    return mpfr_mul_le2 (a, b, c, rnd_mode);
 #endif
 
   sign = MPFR_MULT_SIGN (MPFR_SIGN (b), MPFR_SIGN (c));
@@ -977,9 +1026,14 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
             if (MPFR_UNLIKELY (aq > p - 5 + GMP_NUMB_BITS
                                || bn <= threshold + 1))
               {
-                /* MulHigh can't produce a roundable result. */
+                /* MulHigh can't produce a roundable result. If this is
+                   because the result needs more limbs than c has (then
+                   n = cn), the unbalanced short product can still avoid
+                   computing the low cn x cn block of the product. */
                 MPFR_LOG_MSG (("mpfr_mulhigh can't be used (%lu VS %lu)\n",
                                aq, p));
+                if (n == cn && cn < bn)
+                  goto unbalanced_multiply;
                 goto full_multiply;
               }
             /* Add one extra limb to mantissa of b and c. */
@@ -1069,6 +1123,52 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
             goto full_multiply;
           }
       }
+    else if (MPFR_UNLIKELY
+             ((d = bn - MAX (MPFR_LIMB_SIZE (a) + 1, cn)) > 0 &&
+              (threshold = mulhigh_nm_tab[MIN (cn,
+                                     MPFR_MULHIGH_NM_TAB_SIZE - 1)]) > 0 &&
+              d >= threshold))
+      {
+        /* c is small, and at least d low limbs of b can be neglected:
+           use the unbalanced short product on the high limbs of b. */
+        mp_size_t n;
+        mpfr_prec_t p;
+
+      unbalanced_multiply:
+        n = MAX (MPFR_LIMB_SIZE (a) + 1, cn);
+        n = MIN (n, bn);
+        /* The neglected limbs of b contribute less than 1 ulp of tmp[k-n],
+           and mpfr_mulhigh_nm less than cn ulps. In both cases the
+           approximation is below the exact product. */
+        p = n * GMP_NUMB_BITS - MPFR_INT_CEIL_LOG2 (cn + 1);
+        MPFR_ASSERTD (cn <= n && n <= bn);
+        if (MPFR_UNLIKELY (aq > p - 5))
+          goto full_multiply;
+
+        MPFR_LOG_MSG (("Use mpfr_mulhigh_nm (%lu VS %lu)\n", aq, p));
+        mpfr_mulhigh_nm (tmp + k - n - cn, MPFR_MANT (b) + bn - n, n,
+                         MPFR_MANT (c), cn);
+        /* now tmp[k-n]..tmp[k-1] contains an approximation of the n upper
+           limbs of the product, with tmp[k-1] >= 2^(GMP_NUMB_BITS-2); the
+           limbs below are not significant, but since they are nonnegative,
+           the error bound still holds for {tmp, k} */
+        b1 = tmp[k-1] >> (GMP_NUMB_BITS - 1); /* msb from the product */
+        if (MPFR_UNLIKELY (b1 == 0))
+          mpn_lshift (tmp + k - n, tmp + k - n, n, 1);
+        tmp += k - tn;
+        MPFR_ASSERTD (MPFR_LIMB_MSB (tmp[tn-1]) != 0);
+
+        /* for RNDF, we simply use RNDZ as in the Mulders case above */
+        if (rnd_mode == MPFR_RNDF)
+          rnd_mode = MPFR_RNDZ;
+
+        if (MPFR_UNLIKELY (!mpfr_round_p (tmp, tn, p + b1 - 1,
+                                          aq + (rnd_mode == MPFR_RNDN))))
+          {
+            tmp -= k - tn;
+            goto full_multiply;
+          }
+      }
     else
       {
       full_multiply:
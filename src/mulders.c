@@ -97,6 +97,48 @@ mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
     }
 }
 
+/* Put in  rp[m..n+m-1] an approximation of the n high limbs
+   of {np, n} * {mp, m}, where n >= m >= 1. As for mpfr_mulhigh_n, the
+   error is less than m ulps of rp[m], and the approximation is always less
+   or equal to the truncated full product. Assume n+m limbs are allocated
+   at rp; rp[0..m-1] is not set.
+
+   The upper part {np + m, n - m} * {mp, m} is computed exactly, and only
+   the lower m x m block is replaced by a short product: this is the block
+   that contributes to rp[m..2m-1] only.
+*/
+void
+mpfr_mulhigh_nm (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mp_size_t n,
+                 mpfr_limb_srcptr mp, mp_size_t m)
+{
+  mpfr_limb_ptr tp;
+  mp_limb_t cy;
+  MPFR_TMP_DECL(marker);
+
+  MPFR_ASSERTD (n >= m && m >= 1);
+
+  if (n == m)
+    {
+      mpfr_mulhigh_n (rp, np, mp, n);
+      return;
+    }
+
+  /* mpn_mul requires its first operand to be the largest one */
+  if (n - m >= m)
+    mpn_mul (rp + m, np + m, n - m, mp, m);  /* fills rp[m..n+m-1] */
+  else
+    mpn_mul (rp + m, mp, m, np + m, n - m);
+
+  MPFR_TMP_MARK (marker);
+  tp = MPFR_TMP_LIMBS_ALLOC (2 * m);
+  mpfr_mulhigh_n (tp, np, mp, m);            /* error < m ulps of tp[m] */
+  cy = mpn_add_n (rp + m, rp + m, tp + m, m);
+  /* no carry out, since the approximation is less or equal to the
+     truncated full product */
+  mpn_add_1 (rp + 2 * m, rp + 2 * m, n - m, cy);
+  MPFR_TMP_FREE (marker);
+}
+
 #ifdef MPFR_SQRHIGH_TAB_SIZE
 static short sqrhigh_ktab[MPFR_SQRHIGH_TAB_SIZE];
 #else
@@ -0,0 +1,238 @@
+/* mpfr_div_newton, mpfr_div_newton_r, mpfr_sqrt_newton -- division and
+   square root for large precisions, using a Newton (Karp-Markstein) step
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The functions of this file compute an approximation t of the result on
+   w = p + 16 bits, where p is the target precision, from an approximation
+   of the reciprocal (resp. of the reciprocal square root) on h ~ w/2 bits.
+   Only products with at most w-bit results are needed, so that most of them
+   are short products (see mpfr_mulhigh_n and mpfr_mulhigh_nm). Then they
+   try to round t, and return 0 if this is not possible (in particular when
+   the result is exact), in which case the caller should use its classical
+   algorithm. Otherwise they return the (non-zero) ternary value.
+
+   The inputs are scaled so that their exponent is 0 (or 1 for the square
+   root), thus no overflow or underflow can occur during the computation.
+   The caller must check that the final exponent is in the current range,
+   and that the inputs are regular numbers (positive for the square root).
+   Since h < p for p >= MPFR_NEWTON_PREC_MIN, the recursive calls to
+   mpfr_ui_div (resp. mpfr_rec_sqrt) terminate. */
+
+#define NEWTON_W(p) ((p) + 16)
+#define NEWTON_H(w) (((w) + 1) / 2 + 4)
+
+/* Set y to x rounded to nearest on w bits if PREC(x) > w, otherwise
+   make y an alias of x. Return non-zero if y has been initialized. */
+static int
+newton_input (mpfr_ptr y, mpfr_srcptr x, mpfr_prec_t w)
+{
+  if (MPFR_GET_PREC (x) <= w)
+    {
+      MPFR_ALIAS (y, x, MPFR_SIGN (x), MPFR_GET_EXP (x));
+      return 0;
+    }
+  mpfr_init2 (y, w);
+  mpfr_set (y, x, MPFR_RNDN);
+  return 1;
+}
+
+/* Let x = u/v with |u|, |v| in [1/2, 1). With a relative error of at most
+   2^(-h) for each rounding on h bits (or 2^(-w) on w bits), we get:
+     r = 1/|v| (1 + a) with |a| <= 2^(-h)       (we need PREC(r) >= h)
+     q0 = o(u*r) = x (1 + c) with |c| <= 3 * 2^(-h)
+     t = o(v*q0) = u (1 + c) + d with |d| <= 1.02 |u| 2^(-w)
+     e = o(r * o(t - u)) = x (1 + a) (c + d/u) (1 + f), |f| <= 2^(1-h)
+     t = o(q0 - e)
+   thus the error on t is bounded by |x| (2^(4-2h) + 1.02 * 2^(-w) + 2^(-w))
+   (the rounding of u and v on w + 2 bits adds at most 2^(-w-1) |x|), which
+   is less than 2^(EXP(t)+2-w) since 2h >= w + 8. */
+static int
+div_newton_aux (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_srcptr r,
+                mpfr_rnd_t rnd_mode)
+{
+  mpfr_t ua, va, uu, vv, q0, e, t;
+  mpfr_prec_t w, h;
+  mpfr_exp_t ex;
+  int inex, iu, iv;
+
+  w = NEWTON_W (MPFR_GET_PREC (q));
+  h = NEWTON_H (w);
+  MPFR_ASSERTD (MPFR_GET_PREC (r) >= h);
+
+  /* For MPFR_RNDF, mpfr_set may return 0, which would mean a failure. */
+  if (rnd_mode == MPFR_RNDF)
+    rnd_mode = MPFR_RNDZ;
+
+  ex = MPFR_GET_EXP (u) - MPFR_GET_EXP (v);
+  MPFR_ALIAS (ua, u, MPFR_MULT_SIGN (MPFR_SIGN (u), MPFR_SIGN (v)), 0);
+  MPFR_ALIAS (va, v, MPFR_SIGN_POS, 0);
+  iu = newton_input (uu, ua, w + 2);
+  iv = newton_input (vv, va, w + 2);
+
+  mpfr_init2 (q0, h);
+  mpfr_init2 (e, h);
+  mpfr_init2 (t, w);
+  mpfr_mul (q0, uu, r, MPFR_RNDN);
+  mpfr_mul (t, vv, q0, MPFR_RNDN);
+  mpfr_sub (e, t, uu, MPFR_RNDN);
+  mpfr_mul (e, e, r, MPFR_RNDN);
+  mpfr_sub (t, q0, e, MPFR_RNDN);
+
+  if (MPFR_LIKELY (MPFR_CAN_ROUND (t, w - 3, MPFR_GET_PREC (q), rnd_mode)))
+    {
+      inex = mpfr_set (q, t, rnd_mode);
+      MPFR_ASSERTD (inex != 0);
+      MPFR_EXP (q) += ex;
+    }
+  else
+    inex = 0;
+
+  mpfr_clear (q0);
+  mpfr_clear (e);
+  mpfr_clear (t);
+  if (iu)
+    mpfr_clear (uu);
+  if (iv)
+    mpfr_clear (vv);
+  return inex;
+}
+
+/* Try to set q to u/v rounded in the direction rnd_mode, where r is an
+   approximation of 1/|v'| with v' = v * 2^(-EXP(v)), with a relative error
+   of at most 2^(-PREC(r)) (e.g. 1/|v'| rounded to nearest), and PREC(r)
+   is at least NEWTON_H (NEWTON_W (PREC(q))). Return 0 if this fails. */
+int
+mpfr_div_newton_r (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_srcptr r,
+                   mpfr_rnd_t rnd_mode)
+{
+  int inex;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  inex = div_newton_aux (q, u, v, r, rnd_mode);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return inex == 0 ? 0 : mpfr_check_range (q, inex, rnd_mode);
+}
+
+/* Return the precision needed by mpfr_div_newton_r for the reciprocal of
+   the divisor, for a quotient of precision p. */
+mpfr_prec_t
+mpfr_div_newton_prec (mpfr_prec_t p)
+{
+  return NEWTON_H (NEWTON_W (p));
+}
+
+/* Try to set q to u/v rounded in the direction rnd_mode, return 0 if this
+   fails. */
+int
+mpfr_div_newton (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v,
+                 mpfr_rnd_t rnd_mode)
+{
+  mpfr_t r, va;
+  int inex;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_LOG_FUNC
+    (("u[%Pd]=%.*Rg v[%Pd]=%.*Rg rnd=%d",
+      mpfr_get_prec (u), mpfr_log_prec, u,
+      mpfr_get_prec (v), mpfr_log_prec, v, rnd_mode),
+     ("q[%Pd]=%.*Rg inexact=%d",
+      mpfr_get_prec (q), mpfr_log_prec, q, inex));
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  mpfr_init2 (r, mpfr_div_newton_prec (MPFR_GET_PREC (q)));
+  MPFR_ALIAS (va, v, MPFR_SIGN_POS, 0);
+  mpfr_ui_div (r, 1, va, MPFR_RNDN);
+  inex = div_newton_aux (q, u, v, r, rnd_mode);
+  mpfr_clear (r);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return inex == 0 ? 0 : mpfr_check_range (q, inex, rnd_mode);
+}
+
+/* Try to set s to sqrt(u) rounded in the direction rnd_mode, return 0 if
+   this fails. With u' = u * 2^(-2k) in [1/4, 1), s' = sqrt(u'), and the
+   same notations as for the division:
+     x = 1/sqrt(u') (1 + a) with |a| <= 2^(-h)
+     s0 = o(u'*x) = s' (1 + c) with |c| <= 3 * 2^(-h)
+     t = o(s0^2) = u' (1 + c)^2 + d with |d| <= 1.02 u' 2^(-w)
+     e = o(x * o(t - u') / 2) = s' (1 + a) (c + c^2/2 + d/(2u')) (1 + f)
+     t = o(s0 - e)
+   thus the error on t is bounded by s' (2^(4-2h) + 2^(-w-1) + 2^(-w)),
+   which is less than 2^(EXP(t)+2-w) as for the division. */
+int
+mpfr_sqrt_newton (mpfr_ptr s, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t ua, uu, x, s0, e, t;
+  mpfr_prec_t w, h;
+  mpfr_exp_t e0, ex;
+  int inex, iu;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_LOG_FUNC
+    (("u[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (u), mpfr_log_prec, u, rnd_mode),
+     ("s[%Pd]=%.*Rg inexact=%d",
+      mpfr_get_prec (s), mpfr_log_prec, s, inex));
+
+  MPFR_ASSERTD (MPFR_IS_PURE_FP (u) && MPFR_IS_POS (u));
+
+  w = NEWTON_W (MPFR_GET_PREC (s));
+  h = NEWTON_H (w);
+  if (rnd_mode == MPFR_RNDF)
+    rnd_mode = MPFR_RNDZ;
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  e0 = MPFR_GET_EXP (u) & 1;
+  ex = (MPFR_GET_EXP (u) - e0) / 2;
+  MPFR_ALIAS (ua, u, MPFR_SIGN_POS, e0);
+  iu = newton_input (uu, ua, w + 2);
+
+  mpfr_init2 (x, h);
+  mpfr_init2 (s0, h);
+  mpfr_init2 (e, h);
+  mpfr_init2 (t, w);
+  mpfr_rec_sqrt (x, uu, MPFR_RNDN);
+  mpfr_mul (s0, uu, x, MPFR_RNDN);
+  mpfr_sqr (t, s0, MPFR_RNDN);
+  mpfr_sub (e, t, uu, MPFR_RNDN);
+  mpfr_mul (e, e, x, MPFR_RNDN);
+  mpfr_div_2ui (e, e, 1, MPFR_RNDN);
+  mpfr_sub (t, s0, e, MPFR_RNDN);
+
+  if (MPFR_LIKELY (MPFR_CAN_ROUND (t, w - 3, MPFR_GET_PREC (s), rnd_mode)))
+    {
+      inex = mpfr_set (s, t, rnd_mode);
+      MPFR_ASSERTD (inex != 0);
+      MPFR_EXP (s) += ex;
+    }
+  else
+    inex = 0;
+
+  mpfr_clear (x);
+  mpfr_clear (s0);
+  mpfr_clear (e);
+  mpfr_clear (t);
+  if (iu)
+    mpfr_clear (uu);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return inex == 0 ? 0 : mpfr_check_range (s, inex, rnd_mode);
+}
@@ -85,3 +85,129 @@ mpfr_out_str (FILE *stream, int base, size_t n_digits, mpfr_srcptr op,
 
   return l + r;
 }
+
+/* Size of the buffer in which mpfr_out_str_array formats the numbers before
+   writing them with fwrite. It is enlarged for numbers that do not fit. */
+#define OUT_STR_BUFSIZE 65536
+
+/* Upper bound on the number of characters of the exponent part, with its
+   prefix and sign, plus the decimal point, the newline and the terminating
+   null character written by mpfr_get_str. */
+#define OUT_STR_EXTRA (5 + sizeof (mpfr_eexp_t) * CHAR_BIT / 3 + 1)
+
+/* Write e in decimal at s (without a terminating null character) and
+   return the number of characters written. */
+static size_t
+out_str_exp (char *s, mpfr_eexp_t e)
+{
+  char t[sizeof (mpfr_eexp_t) * CHAR_BIT / 3 + 1];
+  mpfr_ueexp_t u;
+  size_t l = 0, i = 0;
+
+  if (e < 0)
+    {
+      s[l++] = '-';
+      u = - (mpfr_ueexp_t) e;
+    }
+  else
+    u = e;
+  do
+    {
+      t[i++] = '0' + (int) (u % 10);
+      u /= 10;
+    }
+  while (u != 0);
+  while (i > 0)
+    s[l++] = t[--i];
+  return l;
+}
+
+/* Output tab[0], ..., tab[k-1] in the format of mpfr_out_str, each one
+   followed by a newline. The numbers are formatted in a single buffer
+   (the digits directly by mpfr_get_str), which is written by blocks. */
+size_t
+mpfr_out_str_array (FILE *stream, int base, size_t n, const mpfr_ptr *tab,
+                    size_t k, mpfr_rnd_t rnd_mode)
+{
+  char *buf;
+  size_t size, pos, total, i, m = 0;
+  mpfr_prec_t p = 0;
+  int b, err = 0;
+
+  MPFR_ASSERTN ((base >= -36 && base <= -2) || (base >= 2 && base <= 62));
+  b = base < 0 ? - base : base;
+
+  size = OUT_STR_BUFSIZE;
+  buf = (char *) mpfr_allocate_func (size);
+  pos = total = 0;
+
+  for (i = 0; i < k; i++)
+    {
+      mpfr_srcptr x = tab[i];
+      size_t l, need;
+      char *s;
+
+      /* the number of digits only depends on the precision, which is
+         usually the same for all the numbers */
+      if (n == 0 && MPFR_PREC (x) != p)
+        {
+          p = MPFR_PREC (x);
+          m = mpfr_get_str_ndigits (b, p);
+        }
+      need = (n != 0 ? n : m) + OUT_STR_EXTRA;
+      if (MPFR_UNLIKELY (need > size - pos))
+        {
+          if (fwrite (buf, 1, pos, stream) != pos || total + pos < total)
+            {
+              err = 1;
+              break;
+            }
+          total += pos;
+          pos = 0;
+          if (need > size)
+            {
+              buf = (char *) mpfr_reallocate_func (buf, size, need);
+              size = need;
+            }
+        }
+
+      s = buf + pos;
+      if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+        {
+          const char *t =
+            MPFR_IS_NAN (x) ? "@NaN@" :
+            MPFR_IS_INF (x) ? (MPFR_IS_POS (x) ? "@Inf@" : "-@Inf@") :
+            MPFR_IS_POS (x) ? "0" : "-0";
+
+          l = strlen (t);
+          memcpy (s, t, l);
+        }
+      else
+        {
+          int neg = MPFR_IS_NEG (x);
+          mpfr_exp_t e;
+
+          /* The digits are written at s + 1, then the sign and the leading
+             digit are moved one position back to make room for the decimal
+             point: for x = -3.1416, s + 1 = "-31416" and s = "-3.1416". */
+          mpfr_get_str (s + 1, &e, base, n != 0 ? n : m, x, rnd_mode);
+          s[0] = s[1];
+          if (neg)
+            s[1] = s[2];
+          s[neg + 1] = (unsigned char) MPFR_DECIMAL_POINT;
+          l = neg + (n != 0 ? n : m) + 1;
+          s[l++] = b <= 10 ? 'e' : '@';
+          l += out_str_exp (s + l, (mpfr_eexp_t) e - 1);
+        }
+      s[l++] = '\n';
+      MPFR_ASSERTD (l < need);
+      pos += l;
+    }
+
+  if (! err && (fwrite (buf, 1, pos, stream) != pos || total + pos < total))
+    err = 1;
+  total += pos;
+  mpfr_free_func (buf, size);
+
+  return err ? 0 : total;
+}
@@ -0,0 +1,277 @@
+/* mpfr_poly_eval -- evaluate a polynomial
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* Paterson-Stockmeyer's algorithm is used from this number of coefficients,
+   when the coefficients are small enough (see mpfr_poly_eval_approx) */
+#ifndef MPFR_POLY_PS_THRESHOLD
+# define MPFR_POLY_PS_THRESHOLD 16
+#endif
+
+/* Error analysis: both algorithms below only perform additions and
+   multiplications of the coefficients and of x (with mpfr_set, mpfr_mul
+   and mpfr_fma) at the working precision w in rounding to nearest, so that
+   the computed value is sum(c[i]*x^i*prod(1+d[i,j]), j=1..D) where
+   |d[i,j]| <= u = 2^(-w) and D is the maximal number of roundings on the
+   path of any term. Thus if D*u <= 1/2, its error is at most
+   ((1+u)^D-1) S <= 2 D u S, where S = sum(|c[i]|*|x|^i), i.e., less than
+   2^(EXP(S')+ceil(log2(D))+1-w) for any upper bound S' of S. */
+
+/* Set y to an approximation of c[0] + c[1]*x + ... + c[n-1]*x^(n-1),
+   where n >= 1 and x and the c[i] are regular or zero, and return err
+   such that the error is less than 2^err (MPFR_EXP_MIN if the result is
+   exact). The working precision is the one of y. This function can be
+   used by the series evaluations of MPFR, and must be called in the
+   extended exponent range. Intermediate overflows and underflows are not
+   detected. */
+mpfr_exp_t
+mpfr_poly_eval_approx (mpfr_ptr y, const mpfr_ptr *c, unsigned long n,
+                       mpfr_srcptr x)
+{
+  mpfr_prec_t w = MPFR_PREC (y);
+  mpfr_uprec_t cprec = 0;
+  mpfr_exp_t e;
+  mpfr_t s, ax, ac, t;
+  unsigned long i, j, k, nb, b, d;
+
+  MPFR_ASSERTD (n >= 1);
+
+  /* S' = upper bound on sum(|c[i]|*|x|^i), by Horner's rule with rounding
+     upward on a few bits */
+  mpfr_init2 (s, 32);
+  MPFR_TMP_INIT_ABS (ax, x);
+  MPFR_TMP_INIT_ABS (ac, c[n - 1]);
+  mpfr_set (s, ac, MPFR_RNDU);
+  for (i = n - 1; i-- > 0; )
+    {
+      MPFR_TMP_INIT_ABS (ac, c[i]);
+      mpfr_mul (s, s, ax, MPFR_RNDU);
+      mpfr_add (s, s, ac, MPFR_RNDU);
+    }
+  if (MPFR_IS_ZERO (s))
+    {
+      /* all the terms are zero */
+      mpfr_clear (s);
+      MPFR_SET_ZERO (y);
+      MPFR_SET_POS (y);
+      return MPFR_EXP_MIN;
+    }
+
+  for (i = 0; i < n; i++)
+    cprec += MPFR_PREC (c[i]);
+
+  if (n < MPFR_POLY_PS_THRESHOLD || cprec / n > (mpfr_uprec_t) w / 4)
+    {
+      /* Horner's rule: y = (...(c[n-1]*x + c[n-2])*x + ...)*x + c[0],
+         with one rounding per coefficient, thus D = n */
+      mpfr_set (y, c[n - 1], MPFR_RNDN);
+      for (i = n - 1; i-- > 0; )
+        mpfr_fma (y, y, x, c[i], MPFR_RNDN);
+      d = n;
+    }
+  else
+    {
+      /* Paterson-Stockmeyer: the n coefficients are split into nb blocks of
+         k coefficients, each block B[b] = sum(c[b*k+i]*x^i, i=0..k-1) is
+         computed from the powers x^2, ..., x^k, then y is obtained by
+         Horner's rule in X = x^k on the blocks. This needs about
+         2*sqrt(n) multiplications in the working precision, the other
+         ones having one operand among the c[i], which is cheaper when the
+         coefficients are small (e.g., integers or coefficients of series).
+         The power x^i has at most i-1 roundings, each term of a block
+         gets at most 1 + (k-2) + (k-1) < 2k of them, and the Horner step
+         multiplying by X^b adds b*k more, thus D <= (nb+1)*k. */
+      mpfr_t *pw;
+      size_t sz;
+
+      k = __gmpfr_isqrt (n);
+      k += k * k < n;
+      nb = (n - 1) / k + 1;
+      sz = (k + 1) * sizeof (mpfr_t);
+      pw = (mpfr_t *) mpfr_allocate_func (sz);
+      for (j = 2; j <= k; j++)
+        {
+          mpfr_init2 (pw[j], w);
+          mpfr_mul (pw[j], j == 2 ? x : pw[j - 1], x, MPFR_RNDN);
+        }
+      mpfr_init2 (t, w);
+      for (b = nb; b-- > 0; )
+        {
+          unsigned long i0 = b * k, i1 = MIN (i0 + k, n);
+
+          /* t = B[b], the first terms being computed last so that the
+             larger powers are rounded fewer times */
+          mpfr_set (t, c[i1 - 1], MPFR_RNDN);
+          if (i1 - 1 > i0)
+            mpfr_mul (t, t, i1 - 1 - i0 == 1 ? x : pw[i1 - 1 - i0],
+                      MPFR_RNDN);
+          for (i = i1 - 1; i-- > i0; )
+            mpfr_fma (t, c[i], i == i0 ? __gmpfr_one
+                      : i - i0 == 1 ? x : pw[i - i0], t, MPFR_RNDN);
+          if (b == nb - 1)
+            mpfr_swap (y, t);
+          else
+            mpfr_fma (y, y, pw[k], t, MPFR_RNDN);
+        }
+      mpfr_clear (t);
+      for (j = 2; j <= k; j++)
+        mpfr_clear (pw[j]);
+      mpfr_free_func (pw, sz);
+      d = (nb + 1) * k;
+    }
+
+  MPFR_ASSERTN (MPFR_INT_CEIL_LOG2 (d) + 1 < w);
+  e = MPFR_GET_EXP (s);
+  mpfr_clear (s);
+  return e + MPFR_INT_CEIL_LOG2 (d) + 1 - w;
+}
+
+/* Set res to the exact value of the polynomial rounded, with exact terms
+   and mpfr_sum. This is used for singular inputs, and when the result
+   cannot be rounded after a few iterations of Ziv's loop (in particular
+   when it is exact). Must be called in the extended exponent range. */
+static int
+poly_eval_exact (mpfr_ptr res, const mpfr_ptr *c, unsigned long n,
+                 mpfr_srcptr x, mpfr_rnd_t rnd)
+{
+  mpfr_t *tm, p;
+  mpfr_ptr *tab;
+  unsigned long i;
+  int inex, reg = MPFR_IS_PURE_FP (x);
+
+  tm = (mpfr_t *) mpfr_allocate_func (n * sizeof (mpfr_t));
+  tab = (mpfr_ptr *) mpfr_allocate_func (n * sizeof (mpfr_ptr));
+  tab[0] = c[0];
+  mpfr_init2 (p, MPFR_PREC_MIN);
+  for (i = 1; i < n; i++)
+    {
+      /* p = x^i, then tm[i] = c[i]*p, exactly */
+      if (reg)
+        {
+          MPFR_ASSERTN (MPFR_PREC (x) <= (MPFR_PREC_MAX - MPFR_PREC (c[i]))
+                        / (mpfr_prec_t) i);
+          mpfr_set_prec (p, MPFR_PREC (x) * (mpfr_prec_t) i);
+        }
+      inex = mpfr_pow_ui (p, x, i, MPFR_RNDN);
+      MPFR_ASSERTN (inex == 0); /* failure in case of overflow/underflow */
+      mpfr_init2 (tm[i], reg && MPFR_IS_PURE_FP (c[i]) ?
+                  MPFR_PREC (c[i]) + MPFR_PREC (p) : MPFR_PREC_MIN);
+      inex = mpfr_mul (tm[i], c[i], p, MPFR_RNDN);
+      MPFR_ASSERTN (inex == 0);
+      tab[i] = tm[i];
+    }
+  mpfr_clear (p);
+  inex = mpfr_sum (res, tab, n, rnd);
+  for (i = 1; i < n; i++)
+    mpfr_clear (tm[i]);
+  mpfr_free_func (tm, n * sizeof (mpfr_t));
+  mpfr_free_func (tab, n * sizeof (mpfr_ptr));
+  return inex;
+}
+
+/* res <- c[0] + c[1]*x + ... + c[n-1]*x^(n-1) */
+int
+mpfr_poly_eval (mpfr_ptr res, const mpfr_ptr *c, unsigned long n,
+                mpfr_srcptr x, mpfr_rnd_t rnd)
+{
+  mpfr_prec_t prec, w, nexact;
+  mpfr_exp_t err;
+  mpfr_t y;
+  unsigned long i;
+  int inex, singular;
+  MPFR_ZIV_DECL (loop);
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_LOG_FUNC
+    (("n=%lu x[%Pd]=%.*Rg rnd=%d", n, mpfr_get_prec (x), mpfr_log_prec, x,
+      rnd),
+     ("res[%Pd]=%.*Rg inexact=%d", mpfr_get_prec (res), mpfr_log_prec, res,
+      inex));
+
+  if (MPFR_UNLIKELY (n == 0))
+    {
+      MPFR_SET_ZERO (res);
+      MPFR_SET_POS (res);
+      MPFR_RET (0);
+    }
+
+  /* nexact = total precision of the exact terms (at most MPFR_PREC_MAX) */
+  singular = ! MPFR_IS_PURE_FP (x);
+  nexact = 0;
+  for (i = 0; i < n; i++)
+    {
+      if (MPFR_IS_SINGULAR (c[i]) && ! MPFR_IS_ZERO (c[i]))
+        singular = 1;
+      if (nexact < MPFR_PREC_MAX)
+        nexact = MPFR_PREC (c[i]) <= MPFR_PREC_MAX - nexact &&
+          i < (unsigned long) ((MPFR_PREC_MAX - nexact - MPFR_PREC (c[i]))
+                               / MPFR_PREC (x)) ?
+          nexact + MPFR_PREC (c[i]) + (mpfr_prec_t) i * MPFR_PREC (x)
+          : MPFR_PREC_MAX;
+    }
+
+  MPFR_SAVE_EXPO_MARK (expo);
+
+  if (singular || n == 1)
+    goto exact;
+
+  prec = MPFR_PREC (res);
+  w = prec + 2 * MPFR_INT_CEIL_LOG2 (n) + MPFR_INT_CEIL_LOG2 (prec) + 10;
+  mpfr_init2 (y, w);
+  MPFR_ZIV_INIT (loop, w);
+  for (;;)
+    {
+      err = mpfr_poly_eval_approx (y, c, n, x);
+      if (MPFR_LIKELY (! MPFR_IS_ZERO (y) &&
+                       MPFR_CAN_ROUND (y, MPFR_GET_EXP (y) - err, prec, rnd)))
+        {
+          inex = mpfr_set (res, y, rnd);
+          break;
+        }
+      /* The result may be exact, or zero, then Ziv's loop would not end.
+         Thus once it costs about as much as an exact evaluation (with
+         a total precision nexact for the terms), the exact value is
+         computed and rounded. */
+      if (err == MPFR_EXP_MIN || w > nexact / (mpfr_prec_t) n)
+        {
+          MPFR_ZIV_FREE (loop);
+          mpfr_clear (y);
+          goto exact;
+        }
+      MPFR_ZIV_NEXT (loop, w);
+      mpfr_set_prec (y, w);
+    }
+  MPFR_ZIV_FREE (loop);
+  mpfr_clear (y);
+  if (0)
+    {
+    exact:
+      /* only the NaN flag can be raised here, when the result is NaN */
+      MPFR_CLEAR_FLAGS ();
+      inex = poly_eval_exact (res, c, n, x, rnd);
+      MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
+    }
+
+  MPFR_SAVE_EXPO_FREE (expo);
+  return mpfr_check_range (res, inex, rnd);
+}
@@ -38,111 +38,104 @@ If not, see <https://www.gnu.org/licenses/>. */
    - returns -1 and sets the erange flag if this number exceeds INT_MAX
      (in that case, also sets errno to EOVERFLOW on POSIX systems).
 
+   The functions that output to a stream first use a buffer on the stack,
+   of size MPFR_PRINTF_BUFSIZE, so that no memory allocation is needed
+   for the usual output: the allocated memory is only used if the output
+   does not fit in this buffer. The sprintf functions directly output to
+   the buffer given by the caller.
+
    Moreover, since the output may contain non-terminating null characters
    (if %c is used with the value 0), the mpfr_free_str function must not be
    used to free the allocated memory, because the size may matter with some
    custom allocation functions. Anyway, mpfr_free_func is more efficient
    here, as the size does not need to be recomputed. */
 
-#ifdef _MPFR_H_HAVE_FILE
-
-#define GET_STR_VA(sz, str, fmt, ap)            \
-  do                                            \
-    {                                           \
-      sz = mpfr_vasprintf (&(str), fmt, ap);    \
-      if (sz < 0)                               \
-        return -1;                              \
-    } while (0)
+#define MPFR_PRINTF_BUFSIZE 512
 
-#define GET_STR(sz, str, fmt)                   \
-  do                                            \
-    {                                           \
-      va_list ap;                               \
-      va_start(ap, fmt);                        \
-      sz = mpfr_vasprintf (&(str), fmt, ap);    \
-      va_end (ap);                              \
-      if (sz < 0)                               \
-        return -1;                              \
-    } while (0)
+#ifdef _MPFR_H_HAVE_FILE
 
-#define MPFR_FPRINTF_END(ret, str, fp)          \
+#define MPFR_FPRINTF_END(ret, str, buf, fp)     \
   do                                            \
     {                                           \
       int status;                               \
+      if ((ret) < 0)                            \
+        return -1;                              \
       status = fwrite ((str), (ret), 1, (fp));  \
-      mpfr_free_func ((str), (ret) + 1);        \
+      if ((str) != (buf))                       \
+        mpfr_free_func ((str), (ret) + 1);      \
       return status == 1 ? (ret) : -1;          \
     } while (0)
 
 int
 mpfr_printf (const char *fmt, ...)
 {
-  char *str;
+  char buf[MPFR_PRINTF_BUFSIZE], *str;
+  va_list ap;
   int ret;
 
-  GET_STR (ret, str, fmt);
-  MPFR_FPRINTF_END (ret, str, stdout);
+  va_start (ap, fmt);
+  ret = mpfr_vasnprintf_aux (&str, buf, sizeof (buf), fmt, ap);
+  va_end (ap);
+  MPFR_FPRINTF_END (ret, str, buf, stdout);
 }
 
 int
 mpfr_vprintf (const char *fmt, va_list ap)
 {
-  char *str;
+  char buf[MPFR_PRINTF_BUFSIZE], *str;
   int ret;
 
-  GET_STR_VA (ret, str, fmt, ap);
-  MPFR_FPRINTF_END (ret, str, stdout);
+  ret = mpfr_vasnprintf_aux (&str, buf, sizeof (buf), fmt, ap);
+  MPFR_FPRINTF_END (ret, str, buf, stdout);
 }
 
 
 int
 mpfr_fprintf (FILE *fp, const char *fmt, ...)
 {
-  char *str;
+  char buf[MPFR_PRINTF_BUFSIZE], *str;
+  va_list ap;
   int ret;
 
-  GET_STR (ret, str, fmt);
-  MPFR_FPRINTF_END (ret, str, fp);
+  va_start (ap, fmt);
+  ret = mpfr_vasnprintf_aux (&str, buf, sizeof (buf), fmt, ap);
+  va_end (ap);
+  MPFR_FPRINTF_END (ret, str, buf, fp);
 }
 
 int
 mpfr_vfprintf (FILE *fp, const char *fmt, va_list ap)
 {
-  char *str;
+  char buf[MPFR_PRINTF_BUFSIZE], *str;
   int ret;
 
-  GET_STR_VA (ret, str, fmt, ap);
-  MPFR_FPRINTF_END (ret, str, fp);
+  ret = mpfr_vasnprintf_aux (&str, buf, sizeof (buf), fmt, ap);
+  MPFR_FPRINTF_END (ret, str, buf, fp);
 }
 
 #endif /* _MPFR_H_HAVE_FILE */
 
-#define MPFR_SPRINTF_END(ret, buf, str)         \
-  do                                            \
-    {                                           \
-      memcpy ((buf), (str), (ret) + 1);         \
-      mpfr_free_func ((str), (ret) + 1);        \
-      return (ret);                             \
-    } while (0)
+/* Since the size of buf is unknown, it is regarded as INT_MAX + 1, i.e.
+   the maximum size of a valid output. */
+#define MPFR_SPRINTF_SIZE ((size_t) INT_MAX + 1)
 
 int
 mpfr_sprintf (char *buf, const char *fmt, ...)
 {
-  char *str;
   int ret;
+  va_list ap;
 
-  GET_STR (ret, str, fmt);
-  MPFR_SPRINTF_END (ret, buf, str);
+  va_start (ap, fmt);
+  ret = mpfr_vasnprintf_aux (NULL, buf, MPFR_SPRINTF_SIZE, fmt, ap);
+  va_end (ap);
+
+  return ret;
 }
 
 int
 mpfr_vsprintf (char *buf, const char *fmt, va_list ap)
 {
-  char *str;
-  int ret;
-
-  GET_STR_VA (ret, str, fmt, ap);
-  MPFR_SPRINTF_END (ret, buf, str);
+  return mpfr_vasnprintf_aux (NULL, buf, MPFR_SPRINTF_SIZE, fmt, ap);
 }
 
 int
@@ -168,8 +161,11 @@ int
 mpfr_asprintf (char **pp, const char *fmt, ...)
 {
   int ret;
+  va_list ap;
 
-  GET_STR (ret, *pp, fmt);
+  va_start (ap, fmt);
+  ret = mpfr_vasnprintf_aux (pp, NULL, 0, fmt, ap);
+  va_end (ap);
 
   return ret;
 }
@@ -180,6 +176,19 @@ mpfr_vasprintf (char **ptr, const char *fmt, va_list ap)
   return mpfr_vasnprintf_aux (ptr, NULL, 0, fmt, ap);
 }
 
+int
+mpfr_format_apply (char *buf, size_t size, mpfr_format_srcptr f, ...)
+{
+  int ret;
+  va_list ap;
+
+  va_start (ap, f);
+  ret = mpfr_format_vapply (buf, size, f, ap);
+  va_end (ap);
+
+  return ret;
+}
+
 #else /* HAVE_STDARG */
 
 /* Avoid an empty translation unit (see ISO C99, 6.9) */
@@ -32,6 +32,236 @@ mpfr_sin_fast (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   return (inex == 2) ? -1 : inex;
 }
 
+/* f <- 1 - r/3! + r^2/5! - ... + (-1)^l r^l/(2l+1)! + ...
+   Assumes |r| < 1/2, and f, r have the same precision (f = r is allowed).
+   Returns e such that the error on f is bounded by 2^e ulps.
+   This is mpfr_cos2_aux (see cos.c) with odd factorials instead of even
+   ones, and the same error analysis holds. */
+static int
+mpfr_sin2_aux (mpfr_ptr f, mpfr_srcptr r)
+{
+  mpz_t x, t, s;
+  mpfr_exp_t ex, l, m;
+  mpfr_prec_t p, q;
+  unsigned long i, maxi, imax;
+
+  MPFR_ASSERTD(mpfr_get_exp (r) <= -1);
+
+  /* compute minimal i such that i*(i+1) does not fit in an unsigned long,
+     assuming that there are no padding bits. */
+  maxi = 1UL << (sizeof(unsigned long) * CHAR_BIT / 2);
+  if (maxi * (maxi / 2) == 0) /* test checked at compile time */
+    {
+      /* can occur only when there are padding bits. */
+      /* maxi * (maxi-1) is representable iff maxi * (maxi / 2) != 0 */
+      do
+        maxi /= 2;
+      while (maxi * (maxi / 2) == 0);
+    }
+
+  mpz_init (x);
+  mpz_init (s);
+  mpz_init (t);
+  ex = mpfr_get_z_2exp (x, r); /* r = x*2^ex */
+
+  /* Remove trailing zeros. */
+  l = mpz_scan1 (x, 0);
+  ex += l;
+  mpz_fdiv_q_2exp (x, x, l);
+
+  p = mpfr_get_prec (f); /* same as r */
+  /* bound for number of iterations */
+  imax = p / (-mpfr_get_exp (r));
+  imax += (imax == 0);
+  q = 2 * MPFR_INT_CEIL_LOG2(imax) + 4; /* bound for (3l)^2 */
+
+  mpz_set_ui (s, 1); /* initialize sum with 1 */
+  mpz_mul_2exp (s, s, p + q); /* scale all values by 2^(p+q) */
+  mpz_set (t, s); /* invariant: t is previous term */
+  for (i = 1; (m = mpz_sizeinbase (t, 2)) >= q; i += 2)
+    {
+      /* adjust precision of x to that of t */
+      l = mpz_sizeinbase (x, 2);
+      if (l > m)
+        {
+          l -= m;
+          mpz_fdiv_q_2exp (x, x, l);
+          ex += l;
+        }
+      /* multiply t by r */
+      mpz_mul (t, t, x);
+      mpz_fdiv_q_2exp (t, t, -ex);
+      /* divide t by (i+1)*(i+2) */
+      if (i + 1 < maxi)
+        mpz_fdiv_q_ui (t, t, (i + 1) * (i + 2));
+      else
+        {
+          mpz_fdiv_q_ui (t, t, i + 1);
+          mpz_fdiv_q_ui (t, t, i + 2);
+        }
+      /* add or subtract to s */
+      if (i % 4 == 1)
+        mpz_sub (s, s, t);
+      else
+        mpz_add (s, s, t);
+    }
+
+  mpfr_set_z (f, s, MPFR_RNDN);
+  mpfr_div_2ui (f, f, p + q, MPFR_RNDN);
+
+  mpz_clear (x);
+  mpz_clear (s);
+  mpz_clear (t);
+
+  l = (i - 1) / 2; /* number of iterations */
+  return 2 * MPFR_INT_CEIL_LOG2 (l + 1) + 1; /* bound is 2l(l+1) */
+}
+
+/* Bound -T on the exponent of the argument of the Taylor series in
+   mpfr_sin_kernel for a working precision p: the series has about p/(2T)
+   terms and the reconstruction about 2T/3 steps. */
+#define MPFR_SIN_KERNEL_T(p) (__gmpfr_isqrt (p) / 2 + 1)
+
+/* Largest d such that 3^d fits in an unsigned long (at least 32 bits). */
+#define SIN_POW3_MAX 19
+
+/* s <- sin(y) for 0 < |y| <= Pi/4, where t is a temporary variable with
+   the same precision m as s, and PREC(y) is arbitrary. Returns E such that
+   the relative error on s is less than 2^(E-m).
+
+   We compute z = y/3^K, such that EXP(z) <= -MPFR_SIN_KERNEL_T, sin(z) by
+   the Taylor series z*(1 - z^2/3! + ...), then K times the triple-angle
+   formula sin(3a) = sin(a) (3 - 4 sin(a)^2). Contrary to the computation
+   of sin(x) from cos(x), there is no cancellation: if s = sin(a)(1+u),
+   then s(3-4s^2) = sin(3a)(1+v) with |v| <= |u| since
+   (3-12 sin(a)^2) / (3-4 sin(a)^2) is in [0, 1] for |a| <= Pi/12, and each
+   step only adds the rounding errors of 3 operations, less than 3 2^(-m)
+   in relative value (the one of s^2 is divided by about 10 since
+   |4s^2| < 0.27 for |3a| <= Pi/4). The division by 3^K
+   is done in n steps, each one with a relative error at most 2^(-m), which
+   are not amplified either since z sin'(z) / sin(z) <= 1.
+   Then the relative error on sin(z) is at most 2^(e+1-m) for the series
+   (with e returned by mpfr_sin2_aux, since 1/2 <= 1 - z^2/3! <= 1),
+   plus n+1 2^(-m) from the rounding of y and z, plus 2 2^(-m) for the
+   roundings of z^2 and z*f, and the total is less than
+   (2^(e+1) + 2n + 3K + 4) 2^(-m). */
+static int
+mpfr_sin_kernel (mpfr_ptr s, mpfr_srcptr y, mpfr_ptr t)
+{
+  mpfr_exp_t ey = MPFR_GET_EXP (y);
+  long T = MPFR_SIN_KERNEL_T (MPFR_PREC (s));
+  unsigned long K, k, d, p3, n;
+  int e;
+
+  MPFR_ASSERTD (MPFR_PREC (s) == MPFR_PREC (t));
+  MPFR_ASSERTD (ey <= 0);
+
+  /* since 3 > 2^(3/2), EXP(y/3^K) <= ey - floor(3K/2) <= -T */
+  K = T + ey > 0 ? (2 * (T + ey) + 2) / 3 : 0;
+
+  mpfr_set (s, y, MPFR_RNDN);
+  n = 0;
+  for (k = K; k > 0; k -= d)
+    {
+      d = MIN (k, SIN_POW3_MAX);
+      for (p3 = 1; d > 0; d--)
+        p3 *= 3;
+      d = MIN (k, SIN_POW3_MAX);
+      mpfr_div_ui (s, s, p3, MPFR_RNDN);
+      n++;
+    }
+  MPFR_ASSERTD (MPFR_GET_EXP (s) <= -1);
+
+  mpfr_sqr (t, s, MPFR_RNDN);
+  e = mpfr_sin2_aux (t, t);
+  mpfr_mul (s, s, t, MPFR_RNDN);
+
+  for (k = 0; k < K; k++)
+    {
+      mpfr_sqr (t, s, MPFR_RNDN);
+      mpfr_mul_2ui (t, t, 2, MPFR_RNDN);
+      mpfr_ui_sub (t, 3, t, MPFR_RNDN);
+      mpfr_mul (s, s, t, MPFR_RNDN);
+    }
+
+  return MPFR_INT_CEIL_LOG2 ((1UL << (e + 1)) + 2 * n + 3 * K + 4);
+}
+
+/* Compute sin(x) directly, with a reduction of x modulo Pi/2 and either
+   sin or cos of the reduced argument (so that no cancellation can occur,
+   except when x is very close to a multiple of Pi). Must be called in the
+   extended exponent range, for x regular. */
+static int
+mpfr_sin_direct (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xr, s, t;
+  mpfr_srcptr xx;
+  mpfr_prec_t precy = MPFR_PREC (y), m;
+  mpfr_exp_t expx = MPFR_GET_EXP (x), err;
+  int q, inexact, E;
+  MPFR_ZIV_DECL (loop);
+  MPFR_GROUP_DECL (group);
+
+  m = precy + MPFR_INT_CEIL_LOG2 (precy) + 8;
+  MPFR_GROUP_INIT_3 (group, m, xr, s, t);
+  MPFR_ZIV_INIT (loop, m);
+  for (;;)
+    {
+      /* no reduction is needed for |x| < 3/4 < Pi/4 */
+      if (expx > 0 || (expx == 0 && (mpfr_cmp_ui_2exp (x, 3, -2) >= 0 ||
+                                     mpfr_cmp_si_2exp (x, -3, -2) <= 0)))
+        {
+          /* |xr - (x - k Pi/2)| < 2^(-m), q = k mod 4 and |xr| <= Pi/4 */
+          mpfr_trig_reduce (xr, &q, x);
+          if (MPFR_IS_ZERO (xr))
+            goto next_step;
+          xx = xr;
+        }
+      else
+        {
+          q = 0;
+          xx = x;
+        }
+
+      if (q & 1)
+        {
+          /* sin(x) = +/- cos(xr), where cos(xr) >= 1/2: the error is at
+             most 1/2 ulp(s) + 2^(-m) <= 2^(1-m) */
+          mpfr_cos (s, xx, MPFR_RNDN);
+          err = MPFR_GET_EXP (s) + m - 1;
+        }
+      else
+        {
+          /* sin(x) = +/- sin(xr), with a relative error less than
+             2^(E-m), plus 2^(-m) in absolute value for the reduction */
+          E = mpfr_sin_kernel (s, xx, t);
+          err = m - E;
+          if (xx == xr)
+            err = MPFR_GET_EXP (s) + m - 1
+              - MAX (E + MPFR_GET_EXP (s), 0);
+        }
+      if (q & 2)
+        MPFR_CHANGE_SIGN (s);
+
+      if (MPFR_LIKELY (MPFR_CAN_ROUND (s, err, precy, rnd_mode)))
+        break;
+
+      /* if x is close to a multiple of Pi, sin(x) is small and the error
+         of the reduction is large compared to it */
+      if ((q & 1) == 0 && xx == xr && MPFR_GET_EXP (s) < 0)
+        m += - MPFR_GET_EXP (s);
+
+    next_step:
+      MPFR_ZIV_NEXT (loop, m);
+      MPFR_GROUP_REPREC_3 (group, m, xr, s, t);
+    }
+  MPFR_ZIV_FREE (loop);
+
+  inexact = mpfr_set (y, s, rnd_mode);
+  MPFR_GROUP_CLEAR (group);
+  return inexact;
+}
+
 int
 mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
@@ -75,12 +305,32 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   /* Compute initial precision */
   precy = MPFR_PREC (y);
 
+#ifdef MPFR_FIXED_MAXPREC
+  /* table-driven kernel, 0 if it cannot round */
+  if (precy <= MPFR_FIXED_MAXPREC &&
+      (inexact = mpfr_sincos_fixed (y, NULL, x, rnd_mode)) != 0)
+    {
+      inexact = inexact == 2 ? -1 : 1;
+      goto end;
+    }
+#endif
+
   if (precy >= MPFR_SINCOS_THRESHOLD)
     {
       inexact = mpfr_sin_fast (y, x, rnd_mode);
       goto end;
     }
 
+  if (precy < MPFR_SIN_DIRECT_THRESHOLD)
+    {
+      inexact = mpfr_sin_direct (y, x, rnd_mode);
+      goto end;
+    }
+
+  /* In medium precision, sin(x) is computed as sqrt(1-cos(x)^2), since
+     mpfr_cos is faster than mpfr_sin_kernel (its reconstruction steps
+     only need one squaring each). */
+
   /* for x large, since argument reduction is expensive, we want to avoid
      any failure in Ziv's strategy, thus we take into account expx too */
   m = precy + MPFR_INT_CEIL_LOG2 (MAX(precy,expx)) + 8;
@@ -97,10 +347,11 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       MPFR_ASSERTN (err1 <= MPFR_PREC_MAX - m);
       m += err1;
     }
+  MPFR_ZIV_ADAPT (loop, m);
 
   if (expx >= 2)
     {
-      mpfr_init2 (c, expx + m - 1);
+      mpfr_init2 (c, m + 1);
       mpfr_init2 (xr, m);
     }
   else
@@ -111,29 +362,19 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
     {
       /* first perform argument reduction modulo 2*Pi (if needed),
          also helps to determine the sign of sin(x) */
-      /* TODO: Perform range reduction in a way so that the sine can
-         be computed directly from the cosine with sin(x)=cos(pi/2-x),
-         without the need of sqrt(1 - x^2). */
       if (expx >= 2) /* If Pi < x < 4, we need to reduce too, to determine
                         the sign of sin(x). For 2 <= |x| < Pi, we could avoid
                         the reduction. */
         {
           reduce = 1;
-          /* As expx + m - 1 will silently be converted into mpfr_prec_t
-             in the mpfr_set_prec call, the assert below may be useful to
-             avoid undefined behavior. */
-          MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
-          mpfr_set_prec (c, expx + m - 1);
+          mpfr_set_prec (c, m + 1);
           mpfr_set_prec (xr, m);
+          /* |xr - x - 2kPi| < 2^(2-m) (see trig_reduce.c). Thus we can
+             decide the sign of sin(x) if xr is at distance at least
+             2^(2-m) of both 0 and +/-Pi. */
+          mpfr_trig_reduce (xr, NULL, x);
           mpfr_const_pi (c, MPFR_RNDN);
-          mpfr_mul_2ui (c, c, 1, MPFR_RNDN);
-          mpfr_remainder (xr, x, c, MPFR_RNDN);
-          /* The analysis is similar to that of cos.c:
-             |xr - x - 2kPi| <= 2^(2-m). Thus we can decide the sign
-             of sin(x) if xr is at distance at least 2^(2-m) of both
-             0 and +/-Pi. */
-          mpfr_div_2ui (c, c, 1, MPFR_RNDN);
-          /* Since c approximates Pi with an error <= 2^(2-expx-m) <= 2^(-m),
+          /* Since c approximates Pi with an error <= 2^(-m),
              it suffices to check that c - |xr| >= 2^(2-m). */
           if (MPFR_IS_POS (xr))
             mpfr_sub (c, c, xr, MPFR_RNDZ);
@@ -124,6 +124,17 @@ mpfr_sin_cos (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       m += 2 * (-expx);
     }
 
+#ifdef MPFR_FIXED_MAXPREC
+  /* table-driven kernel, 0 if it cannot round both results */
+  if (prec <= MPFR_FIXED_MAXPREC &&
+      (inexy = mpfr_sincos_fixed (y, z, x, rnd_mode)) != 0)
+    {
+      inexz = (inexy >> 2) == 2 ? -1 : 1;
+      inexy = (inexy & 3) == 2 ? -1 : 1;
+      goto end;
+    }
+#endif
+
   if (prec >= MPFR_SINCOS_THRESHOLD)
     {
       MPFR_SAVE_EXPO_FREE (expo);
@@ -140,13 +151,10 @@ mpfr_sin_cos (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       if (expx >= 2) /* reduce the argument */
         {
           reduce = 1;
-          MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
-          mpfr_set_prec (c, expx + m - 1);
+          mpfr_set_prec (c, m + 1);
           mpfr_set_prec (xr, m);
+          mpfr_trig_reduce (xr, NULL, x);
           mpfr_const_pi (c, MPFR_RNDN);
-          mpfr_mul_2ui (c, c, 1, MPFR_RNDN);
-          mpfr_remainder (xr, x, c, MPFR_RNDN);
-          mpfr_div_2ui (c, c, 1, MPFR_RNDN);
           if (MPFR_IS_POS (xr))
             mpfr_sub (c, c, xr, MPFR_RNDZ);
           else
@@ -454,6 +462,81 @@ sin_bs_aux (mpz_t Q0, mpz_t S0, mpz_t C0, mpz_srcptr p, mpfr_prec_t r,
   return m;
 }
 
+/* sin and cos of one part X = y/2^r of the argument of sincos_aux, with
+   sin(X) ~ S/(2^l*Q) and cos(X) ~ C/(2^l*Q). The parts are independent,
+   thus their binary splittings may be computed in parallel. */
+typedef struct
+{
+  mpz_t Q, S, C, y;
+  mpfr_prec_t r, prec, sh;
+  unsigned long l;
+} sin_bs_task_t;
+
+static void
+sin_bs_task (void *p)
+{
+  sin_bs_task_t *t = (sin_bs_task_t *) p;
+
+  t->l = sin_bs_aux (t->Q, t->S, t->C, t->y, t->r, t->prec);
+}
+
+static void
+sin_bs_task_init (sin_bs_task_t *t)
+{
+  mpz_init (t->Q);
+  mpz_init (t->S);
+  mpz_init (t->C);
+  mpz_init (t->y);
+}
+
+static void
+sin_bs_task_clear (sin_bs_task_t *t)
+{
+  mpz_clear (t->Q);
+  mpz_clear (t->S);
+  mpz_clear (t->C);
+  mpz_clear (t->y);
+}
+
+/* Add the part t to X, where S/(2^l*Q) ~ sin(X) and C/(2^l*Q) ~ cos(X)
+   (X = 0 if t is the first part, i.e., t->sh = 1). The values of t->Q,
+   t->S and t->C are destroyed, and y is used as a temporary. */
+static void
+sincos_fold (mpz_t Q, mpz_t S, mpz_t C, unsigned long *l, sin_bs_task_t *t,
+             mpz_t y, mpfr_prec_t prec_s)
+{
+  mpz_ptr Q2 = t->Q, S2 = t->S, C2 = t->C;
+
+  if (t->sh == 1) /* S=0, C=1 */
+    {
+      *l = t->l;
+      mpz_swap (Q, Q2);
+      mpz_swap (S, S2);
+      mpz_swap (C, C2);
+    }
+  else
+    {
+      /* s <- s*c2+c*s2, c <- c*c2-s*s2, using Karatsuba:
+         a = s+c, b = s2+c2, t = a*b, d = s*s2, e = c*c2,
+         s <- t - d - e, c <- e - d */
+      mpz_add (y, S, C); /* a */
+      mpz_mul (C, C, C2); /* e */
+      mpz_add (C2, C2, S2); /* b */
+      mpz_mul (S2, S, S2); /* d */
+      mpz_mul (y, y, C2); /* a*b */
+      mpz_sub (S, y, S2); /* t - d */
+      mpz_sub (S, S, C); /* t - d - e */
+      mpz_sub (C, C, S2); /* e - d */
+      mpz_mul (Q, Q, Q2);
+      /* after j loops, the error is <= (11j-2)*2^(prec_s) */
+      *l += t->l;
+      /* reduce Q to prec_s bits */
+      *l += reduce (Q, Q, prec_s);
+      /* reduce S,C to prec_s bits, error <= 11*j*2^(prec_s) */
+      *l -= reduce2 (S, C, prec_s);
+    }
+}
+
 /* Put in s and c approximations of sin(x) and cos(x) respectively.
    Assumes 0 < x < Pi/4 and PREC(s) = PREC(c) >= 10.
    Return err such that the relative error is bounded by 2^err ulps.
@@ -462,9 +545,11 @@ static int
 sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
   mpfr_prec_t prec_s, sh;
-  mpz_t Q, S, C, Q2, S2, C2, y;
+  mpz_t Q, S, C, y;
   mpfr_t x2;
-  unsigned long l, l2, j, err;
+  sin_bs_task_t tasks[KMAX], *t;
+  unsigned long l, j, err;
+  int i, n, nb, par;
 
   MPFR_ASSERTD(MPFR_PREC(s) == MPFR_PREC(c));
 
@@ -474,9 +559,6 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpz_init (Q);
   mpz_init (S);
   mpz_init (C);
-  mpz_init (Q2);
-  mpz_init (S2);
-  mpz_init (C2);
   mpz_init (y);
 
   mpfr_set (x2, x, MPFR_RNDN); /* exact */
@@ -485,20 +567,34 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpz_set_ui (S, 0); /* sin(0) = S/(2^l*Q), exact */
   mpz_set_ui (C, 1); /* cos(0) = C/(2^l*Q), exact */
 
-  /* Invariant: x = X + x2/2^(sh-1), where the part X was already treated,
-     S/(2^l*Q) ~ sin(X), C/(2^l*Q) ~ cos(X), and x2/2^(sh-1) < Pi/4.
+  /* With a single thread, each part is added as soon as it is computed,
+     reusing tasks[0], so that only one part is in memory at a time.
+     Otherwise the parts tasks[0], ..., tasks[n-1] are all computed first
+     (the binary splitting is needed for tasks[0], ..., tasks[nb-1] only,
+     nb = n or n - 1), then added in the same order. */
+  par = mpfr_get_bs_threads () >= 2;
+  if (! par)
+    sin_bs_task_init (&tasks[0]);
+
+  /* Invariant: x = X + x2/2^(sh-1), where the part X was already extracted,
+     and x2/2^(sh-1) < Pi/4.
      'sh-1' is the number of already shifted bits in x2.
   */
 
-  for (sh = 1, j = 0; mpfr_cmp_ui (x2, 0) != 0 && sh <= prec_s; sh <<= 1, j++)
+  for (sh = 1, j = 0, n = nb = 0; mpfr_cmp_ui (x2, 0) != 0 && sh <= prec_s;
+       sh <<= 1, j++)
     {
+      MPFR_ASSERTN (n < KMAX);
+      t = &tasks[n];
       if (sh > prec_s / 2) /* sin(x) = x + O(x^3), cos(x) = 1 + O(x^2) */
         {
-          l2 = -mpfr_get_z_2exp (S2, x2); /* S2/2^l2 = x2 */
-          l2 += sh - 1;
-          mpz_set_ui (Q2, 1);
-          mpz_set_ui (C2, 1);
-          mpz_mul_2exp (C2, C2, l2);
+          if (par)
+            sin_bs_task_init (t);
+          t->l = -mpfr_get_z_2exp (t->S, x2); /* S/2^l = x2 */
+          t->l += sh - 1;
+          mpz_set_ui (t->Q, 1);
+          mpz_set_ui (t->C, 1);
+          mpz_mul_2exp (t->C, t->C, t->l);
           mpfr_set_ui (x2, 0, MPFR_RNDN);
         }
       else
@@ -511,39 +607,37 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
           if (mpz_cmp_ui (y, 0) == 0)
             continue;
           mpfr_sub_z (x2, x2, y, MPFR_RNDN); /* should be exact */
-          l2 = sin_bs_aux (Q2, S2, C2, y, 2 * sh - 1, prec_s);
-          /* we now have |S2/Q2/2^l2 - sin(X)| <= 9*2^(prec_s)
-             and |C2/Q2/2^l2 - cos(X)| <= 6*2^(prec_s), with X=y/2^(2sh-1) */
-        }
-      if (sh == 1) /* S=0, C=1 */
-        {
-          l = l2;
-          mpz_swap (Q, Q2);
-          mpz_swap (S, S2);
-          mpz_swap (C, C2);
+          if (par)
+            sin_bs_task_init (t);
+          mpz_swap (t->y, y);
+          t->r = 2 * sh - 1;
+          t->prec = prec_s;
+          if (par)
+            nb = n + 1;
+          else
+            sin_bs_task (t);
+          /* we now have |S/Q/2^l - sin(X)| <= 9*2^(prec_s)
+             and |C/Q/2^l - cos(X)| <= 6*2^(prec_s), with X=y/2^(2sh-1) */
         }
+      t->sh = sh;
+      if (par)
+        n++;
       else
+        sincos_fold (Q, S, C, &l, t, y, prec_s);
+    }
+
+  if (par)
+    {
+      mpfr_bs_run (sin_bs_task, tasks, sizeof (sin_bs_task_t), nb,
+                   mpfr_get_bs_threads (), prec_s / GMP_NUMB_BITS);
+      for (i = 0; i < n; i++)
         {
-          /* s <- s*c2+c*s2, c <- c*c2-s*s2, using Karatsuba:
-             a = s+c, b = s2+c2, t = a*b, d = s*s2, e = c*c2,
-             s <- t - d - e, c <- e - d */
-          mpz_add (y, S, C); /* a */
-          mpz_mul (C, C, C2); /* e */
-          mpz_add (C2, C2, S2); /* b */
-          mpz_mul (S2, S, S2); /* d */
-          mpz_mul (y, y, C2); /* a*b */
-          mpz_sub (S, y, S2); /* t - d */
-          mpz_sub (S, S, C); /* t - d - e */
-          mpz_sub (C, C, S2); /* e - d */
-          mpz_mul (Q, Q, Q2);
-          /* after j loops, the error is <= (11j-2)*2^(prec_s) */
-          l += l2;
-          /* reduce Q to prec_s bits */
-          l += reduce (Q, Q, prec_s);
-          /* reduce S,C to prec_s bits, error <= 11*j*2^(prec_s) */
-          l -= reduce2 (S, C, prec_s);
+          sincos_fold (Q, S, C, &l, &tasks[i], y, prec_s);
+          sin_bs_task_clear (&tasks[i]);
         }
     }
+  else
+    sin_bs_task_clear (&tasks[0]);
 
   j = 11 * j;
   for (err = 0; j > 1; j = (j + 1) / 2, err ++);
@@ -559,9 +653,6 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpz_clear (Q);
   mpz_clear (S);
   mpz_clear (C);
-  mpz_clear (Q2);
-  mpz_clear (S2);
-  mpz_clear (C2);
   mpz_clear (y);
   mpfr_clear (x2);
   return err;
@@ -610,21 +701,19 @@ mpfr_sincos_fast (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd)
         }
       else /* argument reduction is needed */
         {
-          long q;
-          mpfr_t pi;
+          int q;
           int neg = 0;
 
           mpfr_init2 (x_red, w);
-          mpfr_init2 (pi, (MPFR_EXP(x) > 0) ? w + MPFR_EXP(x) : w);
-          mpfr_const_pi (pi, MPFR_RNDN);
-          mpfr_div_2ui (pi, pi, 1, MPFR_RNDN); /* Pi/2 */
-          mpfr_remquo (x_red, &q, x, pi, MPFR_RNDN);
-          /* x = q * (Pi/2 + eps1) + x_red + eps2,
-             where |eps1| <= 1/2*ulp(Pi/2) = 2^(-w-MAX(0,EXP(x))),
-             and eps2 <= 1/2*ulp(x_red) <= 1/2*ulp(Pi/2) = 2^(-w)
-             Since |q| <= x/(Pi/2) <= |x|, we have
-             q*|eps1| <= 2^(-w), thus
-             |x - q * Pi/2 - x_red| <= 2^(1-w) */
+          mpfr_trig_reduce (x_red, &q, x);
+          /* |x - k * Pi/2 - x_red| < 2^(-w) <= 2^(1-w), with q = k mod 4
+             (see trig_reduce.c) */
+          if (MPFR_UNLIKELY (MPFR_IS_ZERO (x_red)))
+            {
+              /* x is very close to a multiple of Pi/2 */
+              mpfr_clear (x_red);
+              goto next_w;
+            }
           /* now -Pi/4 <= x_red <= Pi/4: if x_red < 0, consider -x_red */
           if (MPFR_IS_NEG(x_red))
             {
@@ -646,7 +735,6 @@ mpfr_sincos_fast (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd)
               mpfr_swap (ts, tc);
             }
           mpfr_clear (x_red);
-          mpfr_clear (pi);
         }
       /* adjust errors with respect to absolute values */
       errs = err - MPFR_EXP(ts);
@@ -654,6 +742,7 @@ mpfr_sincos_fast (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd)
       if ((s == NULL || MPFR_CAN_ROUND (ts, w - errs, MPFR_PREC(s), rnd)) &&
           (c == NULL || MPFR_CAN_ROUND (tc, w - errc, MPFR_PREC(c), rnd)))
         break;
+    next_w:
       MPFR_ZIV_NEXT (loop, w);
       MPFR_GROUP_REPREC_2(group, w, ts, tc);
     }
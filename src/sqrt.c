@@ -573,6 +573,17 @@ mpfr_sqrt (mpfr_ptr r, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
   }
 #endif
 
+  /* For large precisions, first try a Newton step from an approximation
+     of 1/sqrt(u) on about half the precision (this can only fail in rare
+     cases, for instance when the square root is exact). */
+  if (MPFR_UNLIKELY (rq >= MPFR_SQRT_NEWTON_THRESHOLD) &&
+      rq >= MPFR_NEWTON_PREC_MIN)
+    {
+      inexact = mpfr_sqrt_newton (r, u, rnd_mode);
+      if (inexact != 0)
+        return inexact;
+    }
+
   MPFR_TMP_MARK (marker);
   MPFR_UNSIGNED_MINUS_MODULO (sh, rq);
   if (sh == 0 && rnd_mode == MPFR_RNDN)
@@ -102,3 +102,110 @@ mpfr_custom_get_kind (mpfr_srcptr x)
   return (int) MPFR_ZERO_KIND * MPFR_INT_SIGN (x);
 }
 
+
+/* A table of n numbers of precision p (see mpfr_custom_table_init) is an
+   array of limbs in native layout, made of:
+     * a header of MPFR_TABLE_HEADER limbs: MPFR_TABLE_MAGIC, GMP_NUMB_BITS,
+       sizeof(mpfr_exp_t), p and n, so that a table written on a platform
+       with another limb size, exponent size or endianness is rejected by
+       mpfr_custom_table_check;
+     * n entries of MPFR_TABLE_ENTRY(p) limbs: the kind (as returned by
+       mpfr_custom_get_kind) plus MPFR_REGULAR_KIND, the exponent (as
+       returned by mpfr_custom_get_exp) on MPFR_TABLE_EXP_LIMBS limbs,
+       then the significand.
+   Thus an entry can be used in place with mpfr_custom_init_set, and the
+   table can be read from a file with mmap: no decoding nor copy is needed,
+   and checking the table takes a constant time. */
+
+#define MPFR_TABLE_MAGIC 0x4d504654  /* "MPFT" */
+#define MPFR_TABLE_HEADER 5
+#define MPFR_TABLE_EXP_LIMBS                                            \
+  ((sizeof (mpfr_exp_t) + MPFR_BYTES_PER_MP_LIMB - 1) / MPFR_BYTES_PER_MP_LIMB)
+#define MPFR_TABLE_ENTRY(p) (1 + MPFR_TABLE_EXP_LIMBS + MPFR_PREC2LIMBS (p))
+
+size_t
+mpfr_custom_table_size (mpfr_prec_t prec, size_t n)
+{
+  MPFR_ASSERTN (MPFR_PREC_COND (prec));
+  /* the size must be representable in a size_t (SIZE_MAX = (size_t) -1) */
+  MPFR_ASSERTN (n <= ((size_t) -1 / MPFR_BYTES_PER_MP_LIMB - MPFR_TABLE_HEADER)
+                / MPFR_TABLE_ENTRY (prec));
+  return (MPFR_TABLE_HEADER + n * MPFR_TABLE_ENTRY (prec))
+    * MPFR_BYTES_PER_MP_LIMB;
+}
+
+void
+mpfr_custom_table_init (void *table, mpfr_prec_t prec, size_t n)
+{
+  mp_limb_t *t = (mp_limb_t *) table;
+  mp_size_t m;
+
+  MPFR_ASSERTN (MPFR_PREC_COND (prec));
+  MPFR_ASSERTN ((mpfr_uprec_t) prec <= MPFR_LIMB_MAX && n <= MPFR_LIMB_MAX);
+  t[0] = MPFR_TABLE_MAGIC;
+  t[1] = GMP_NUMB_BITS;
+  t[2] = sizeof (mpfr_exp_t);
+  t[3] = prec;
+  t[4] = n;
+  /* All the entries are NaN, with the other limbs set to 0. */
+  t += MPFR_TABLE_HEADER;
+  m = MPFR_TABLE_ENTRY (prec);
+  for (; n > 0; n--, t += m)
+    {
+      t[0] = MPFR_NAN_KIND + MPFR_REGULAR_KIND;
+      MPN_ZERO (t + 1, m - 1);
+    }
+}
+
+int
+mpfr_custom_table_set (void *table, size_t i, mpfr_srcptr x,
+                       mpfr_rnd_t rnd_mode)
+{
+  mp_limb_t *t = (mp_limb_t *) table;
+  mpfr_prec_t prec;
+  mpfr_exp_t e;
+  mpfr_t y;
+  int inex;
+
+  MPFR_ASSERTD (t[0] == MPFR_TABLE_MAGIC && i < t[4]);
+  prec = t[3];
+  t += MPFR_TABLE_HEADER + i * MPFR_TABLE_ENTRY (prec);
+  mpfr_custom_init_set (y, MPFR_NAN_KIND, 0, prec,
+                        t + 1 + MPFR_TABLE_EXP_LIMBS);
+  inex = mpfr_set (y, x, rnd_mode);
+  t[0] = mpfr_custom_get_kind (y) + MPFR_REGULAR_KIND;
+  e = mpfr_custom_get_exp (y);
+  memcpy (t + 1, &e, sizeof (mpfr_exp_t));
+  return inex;
+}
+
+size_t
+mpfr_custom_table_check (const void *table, size_t size)
+{
+  const mp_limb_t *t = (const mp_limb_t *) table;
+
+  if (size < MPFR_TABLE_HEADER * MPFR_BYTES_PER_MP_LIMB ||
+      t[0] != MPFR_TABLE_MAGIC || t[1] != GMP_NUMB_BITS ||
+      t[2] != sizeof (mpfr_exp_t) ||
+      t[3] < MPFR_PREC_MIN || t[3] > (mpfr_uprec_t) MPFR_PREC_MAX)
+    return 0;
+  size = size / MPFR_BYTES_PER_MP_LIMB - MPFR_TABLE_HEADER;
+  if (t[4] > size / MPFR_TABLE_ENTRY ((mpfr_prec_t) t[3]))
+    return 0;
+  return t[4];
+}
+
+void
+mpfr_custom_table_get (mpfr_ptr x, const void *table, size_t i)
+{
+  const mp_limb_t *t = (const mp_limb_t *) table;
+  mpfr_prec_t prec;
+  mpfr_exp_t e;
+
+  MPFR_ASSERTD (t[0] == MPFR_TABLE_MAGIC && i < t[4]);
+  prec = t[3];
+  t += MPFR_TABLE_HEADER + i * MPFR_TABLE_ENTRY (prec);
+  memcpy (&e, t + 1, sizeof (mpfr_exp_t));
+  mpfr_custom_init_set (x, (int) t[0] - MPFR_REGULAR_KIND, e, prec,
+                        (void *) (t + 1 + MPFR_TABLE_EXP_LIMBS));
+}
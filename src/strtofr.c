@@ -469,6 +469,77 @@ parse_string (mpfr_ptr x, struct parsed_string *pstr,
   return res;
 }
 
+/* Early exact-result check, for a base b = 2^t * c with c > 1 odd.
+   The number is V = M * b^E, where M is the integer formed by the pstr->prec
+   digits of pstr->mant and E = exp_base - pstr->prec. It is representable
+   on precx bits only if c^(-E) divides M when E < 0, and if its odd part,
+   which has about log2(M) - v2(M) + E * log2(c) bits, has at most precx
+   bits. The divisibility by a power of c and v2(M) (when t > 0) are checked
+   on the last digits of M, which give M mod b^J for b^J < B.
+   Return 0 if V is certainly not representable on precx bits. Otherwise,
+   return a working precision for which the loop of parsed_string_to_mpfr
+   converts all the digits and computes b^E exactly, so that it can detect
+   that the result is exact in a single iteration, instead of increasing
+   the precision until all the digits are taken into account. This is only
+   a heuristic (used after a failure of the rounding test): the precision
+   might also be too small, in which case the Ziv loop goes on as usual. */
+static mpfr_prec_t
+exact_prec (struct parsed_string *pstr, mpfr_prec_t precx)
+{
+  int b = pstr->base, t, v2;
+  mp_limb_t c, ck, bj, L;
+  mpfr_exp_t E, d, k, oddbits;
+  size_t j;
+
+  MPFR_ASSERTD (!IS_POW2 (b) && pstr->prec > 0);
+  if (pstr->prec > MPFR_PREC_MAX / (4 * GMP_NUMB_BITS)
+      || pstr->exp_base > MPFR_PREC_MAX / (4 * GMP_NUMB_BITS)
+      || pstr->exp_base < - (MPFR_PREC_MAX / (4 * GMP_NUMB_BITS)))
+    return 0;
+
+  count_trailing_zeros (t, (mp_limb_t) b);
+  c = (mp_limb_t) b >> t;
+  E = pstr->exp_base - (mpfr_exp_t) pstr->prec;
+
+  /* L = M mod b^j, and d is the number of digits of a limb, such that a
+     digit has between GMP_NUMB_BITS/(d+1) and GMP_NUMB_BITS/d bits */
+  L = 0;
+  bj = 1;
+  for (j = 0; bj <= MPFR_LIMB_MAX / b; j++)
+    {
+      if (j < pstr->prec)
+        L += bj * pstr->mant[pstr->prec - 1 - j];
+      bj *= b;
+    }
+  d = j;
+
+  /* c^min(-E,d) must divide L */
+  for (ck = 1, k = 0; k < -E && k < d; k++)
+    ck *= c;
+  if (L % ck != 0)
+    return 0;
+
+  /* lower bound on v2(M) (or none if t = 0), with L != 0 since the last
+     digit is not zero */
+  MPFR_ASSERTD (L != 0);
+  if (t == 0)
+    v2 = 0;
+  else
+    {
+      count_trailing_zeros (v2, L);
+      v2 = MIN (v2, t * d);
+    }
+
+  /* oddbits ~ (log2(M) - v2 + E * log2(c)) * d, with log2(b) ~ B/d */
+  oddbits = (mpfr_exp_t) pstr->prec * GMP_NUMB_BITS - (mpfr_exp_t) v2 * d
+    + E * (GMP_NUMB_BITS - t * d);
+  if (oddbits / d > precx + GMP_NUMB_BITS)
+    return 0;
+
+  k = MAX ((mpfr_exp_t) pstr->prec, E < 0 ? -E : E);
+  return (k / d + 2) * GMP_NUMB_BITS;
+}
+
 /* Transform a parsed string to a mpfr_t according to the rounding mode
    and the precision of x.
    Returns the ternary value. */
@@ -478,7 +549,7 @@ parsed_string_to_mpfr (mpfr_ptr x, struct parsed_string *pstr, mpfr_rnd_t rnd)
   mpfr_prec_t precx, prec, ysize_bits, pstr_size;
   mpfr_exp_t exp;
   mp_limb_t *result;
-  int count, exact;
+  int count, exact, first_failure = 1;
   mp_size_t ysize, real_ysize, diff_ysize;
   int res, err;
   const int extra_limbs = GMP_NUMB_BITS >= 12 ? 1 : 2; /* see below */
@@ -577,7 +648,7 @@ parsed_string_to_mpfr (mpfr_ptr x, struct parsed_string *pstr, mpfr_rnd_t rnd)
 
       /* Convert str (potentially truncated to pstr_size) into binary.
          Note that pstr->mant is big endian, thus no offset is needed. */
-      real_ysize = mpn_set_str (y, pstr->mant, pstr_size, pstr->base);
+      real_ysize = mpfr_mpn_set_str (y, pstr->mant, pstr_size, pstr->base);
 
       /* See above for the explanation of the following assertion. */
       MPFR_ASSERTD (real_ysize <= ysize + extra_limbs);
@@ -906,7 +977,22 @@ parsed_string_to_mpfr (mpfr_ptr x, struct parsed_string *pstr, mpfr_rnd_t rnd)
                                  precx + (rnd == MPFR_RNDN)))
         break;
 
-      /* update the prec for next loop */
+      /* update the prec for next loop; after the first failure, if the
+         result may be exact, directly take all the digits into account */
+      if (first_failure)
+        {
+          first_failure = 0;
+          if (! IS_POW2 (pstr->base))
+            {
+              mpfr_prec_t p = exact_prec (pstr, precx);
+              if (p > prec)
+                {
+                  MPFR_LOG_MSG (("early exact-result check: prec=%Pd\n", p));
+                  prec = p;
+                  continue;
+                }
+            }
+        }
       MPFR_ZIV_NEXT (loop, prec);
     } /* loop */
   MPFR_ZIV_FREE (loop);
@@ -961,6 +1047,162 @@ free_parsed_string (struct parsed_string *pstr)
   mpfr_free_func (pstr->mantissa, pstr->alloc);
 }
 
+#ifdef MPFR_POW10_TAB
+
+/* Maximal number of significant digits for the fast path below, so that
+   the integer they form fits in a limb. */
+#if GMP_NUMB_BITS == 64
+# define SHORT_MAXDIGITS 19
+#else
+# define SHORT_MAXDIGITS 9
+#endif
+#define SHORT_MAXCOUNT 100000  /* bound on the other digit counts */
+
+/* Fast path of mpfr_strtofr for a decimal string (base 0 or 10), giving a
+   number M*10^E, where the integer M has at most SHORT_MAXDIGITS digits,
+   |E| <= MPFR_POW10_MAX, and the precision of x is at most
+   MPFR_POW10_PREC - 64: if 10^E is exact on MPFR_POW10_PREC bits (E small
+   and non-negative), the correct rounding is directly given by mpfr_mul,
+   otherwise M*10^E is approximated on MPFR_POW10_PREC bits with the table
+   of powers of 10 and rounded if possible, which fails with a probability
+   of about 2^(-60); in the latter case, if 10^(-E) is exact, M/10^(-E) is
+   correctly rounded by mpfr_div.
+   Return 1 if the conversion is done, with the ternary value in *inex and
+   the end of the string in *string. Return 0 if this fast path cannot be
+   used (strings with a base prefix, too many digits, a large exponent,
+   '@' or special values, in which case parse_string is used), or if the
+   correct rounding cannot be decided. The string is scanned exactly like
+   in parse_string. */
+static int
+strtofr_short (mpfr_ptr x, const char **string, int base, mpfr_rnd_t rnd,
+               int *inex)
+{
+  const char *str = *string;
+  int decimal_point = (unsigned char) MPFR_DECIMAL_POINT;
+  int neg, point = 0, digits = 0, cnt, c, inexact;
+  mp_limb_t m = 0, mp[1];
+  mp_limb_t pp[MPFR_PREC2LIMBS (MPFR_POW10_PREC)];
+  mp_limb_t yp[MPFR_PREC2LIMBS (MPFR_POW10_PREC)];
+  long nd = 0, nz = 0, nf = 0, E;
+  mpfr_t v, pw, y;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  if (MPFR_GET_PREC (x) > MPFR_POW10_PREC - 64)
+    return 0;
+
+  while (*str != '\0' && isspace ((unsigned char) *str))
+    str++;
+  neg = *str == '-';
+  if (*str == '-' || *str == '+')
+    str++;
+  if (base == 0 && str[0] == '0' &&
+      (str[1] == 'x' || str[1] == 'X' || str[1] == 'b' || str[1] == 'B'))
+    return 0;
+
+  /* The significant digits give m, followed by nz zeros (not yet taken
+     into account in m), and nf digits follow the point. */
+  for (;; str++)
+    {
+      c = (unsigned char) *str;
+      if (c == '.' || c == decimal_point)
+        {
+          if (point)
+            break;
+          point = 1;
+          continue;
+        }
+      if (c < '0' || c > '9')
+        break;
+      digits = 1;
+      nf += point;
+      if (c == '0')
+        nz += m != 0;
+      else
+        {
+          nd += nz + 1;
+          if (nd > SHORT_MAXDIGITS)
+            return 0;
+          for (; nz > 0; nz--)
+            m *= 10;
+          m = 10 * m + (c - '0');
+        }
+      if (nf > SHORT_MAXCOUNT || nz > SHORT_MAXCOUNT)
+        return 0;
+    }
+  if (! digits)
+    return 0;
+  E = nz - nf;
+
+  /* an optional exponent, read like strtol in parse_string */
+  if ((c == 'e' || c == 'E') && ! isspace ((unsigned char) str[1]))
+    {
+      const char *p = str + 1;
+      int eneg = *p == '-';
+      long ee = 0;
+
+      if (*p == '-' || *p == '+')
+        p++;
+      if (*p < '0' || *p > '9')
+        return 0;
+      for (; *p >= '0' && *p <= '9'; p++)
+        {
+          ee = 10 * ee + (*p - '0');
+          if (ee > SHORT_MAXCOUNT)
+            return 0;
+        }
+      E += eneg ? -ee : ee;
+      str = p;
+    }
+  else if (c == '@')
+    return 0;
+
+  if (m == 0)
+    {
+      /* x has already been set to +0 */
+      if (neg)
+        MPFR_SET_NEG (x);
+      *inex = 0;
+      *string = str;
+      return 1;
+    }
+  if (E < -MPFR_POW10_MAX || E > MPFR_POW10_MAX)
+    return 0;
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  MPFR_TMP_INIT1 (mp, v, GMP_NUMB_BITS);
+  count_leading_zeros (cnt, m);
+  mp[0] = m << cnt;
+  MPFR_SET_EXP (v, GMP_NUMB_BITS - cnt);
+  if (neg)
+    MPFR_SET_NEG (v);
+  MPFR_TMP_INIT1 (pp, pw, MPFR_POW10_PREC);
+  if (mpfr_pow10_approx (pw, E) == 0)
+    inexact = mpfr_mul (x, v, pw, rnd);
+  else
+    {
+      /* y = M*10^E with a relative error less than 4*2^(-MPFR_POW10_PREC),
+         thus an error less than 2^(EXP(y)-MPFR_POW10_PREC+3) */
+      MPFR_TMP_INIT1 (yp, y, MPFR_POW10_PREC);
+      mpfr_mul (y, v, pw, MPFR_RNDN);
+      if (MPFR_LIKELY (MPFR_CAN_ROUND (y, MPFR_POW10_PREC - 3,
+                                       MPFR_GET_PREC (x), rnd)))
+        inexact = mpfr_set (x, y, rnd);
+      else if (E < 0 && mpfr_pow10_approx (pw, -E) == 0)
+        inexact = mpfr_div (x, v, pw, rnd);
+      else
+        {
+          MPFR_SAVE_EXPO_FREE (expo);
+          return 0;
+        }
+    }
+  MPFR_SAVE_EXPO_FREE (expo);
+  *inex = mpfr_check_range (x, inexact, rnd);
+  *string = str;
+  return 1;
+}
+
+#endif
+
 int
 mpfr_strtofr (mpfr_ptr x, const char *string, char **end, int base,
               mpfr_rnd_t rnd)
@@ -975,6 +1217,15 @@ mpfr_strtofr (mpfr_ptr x, const char *string, char **end, int base,
   MPFR_SET_ZERO (x);
   MPFR_SET_POS (x);
 
+#ifdef MPFR_POW10_TAB
+  if ((base == 0 || base == 10) && strtofr_short (x, &string, base, rnd, &res))
+    {
+      if (end != NULL)
+        *end = (char *) string;
+      return res;
+    }
+#endif
+
   MPFR_STAT_STATIC_ASSERT (MPFR_MAX_BASE >= 62);
   res = parse_string (x, &pstr, &string, base);
   /* If res == 0, then it was exact (NAN or INF),
@@ -64,6 +64,7 @@ mpfr_tan (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   precy = MPFR_PREC (y);
   m = precy + MPFR_INT_CEIL_LOG2 (precy) + 13;
   MPFR_ASSERTD (m >= 2); /* needed for the error analysis in algorithms.tex */
+  MPFR_ZIV_ADAPT (loop, m);
 
   MPFR_GROUP_INIT_2 (group, m, s, c);
   MPFR_ZIV_INIT (loop, m);
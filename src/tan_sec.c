@@ -0,0 +1,236 @@
+/* mpfr_tan_sec, mpfr_sin_cos_tan -- tangent and secant, sine, cosine and tangent
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* The results are computed from a single call to mpfr_sin_cos, with
+   tan(x) = sin(x)/cos(x) and sec(x) = 1/cos(x). For tiny x, they are very
+   close to x or 1, thus cannot be rounded at a reasonable precision, and
+   the fast paths of the separate functions are used instead. A result that
+   cannot be rounded after two iterations is also computed separately. */
+
+int
+mpfr_tan_sec (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xc, s, c, t;
+  mpfr_prec_t N;
+  int inex_y = 0, inex_z = 0, ok_y = 0, ok_z = 0, copied = 0, iter;
+
+  MPFR_ASSERTN (y != z);
+
+  MPFR_LOG_FUNC
+    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
+     ("tan[%Pd]=%.*Rg sec[%Pd]=%.*Rg",
+      mpfr_get_prec (y), mpfr_log_prec, y,
+      mpfr_get_prec (z), mpfr_log_prec, z));
+
+  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+    {
+      if (MPFR_IS_NAN (x) || MPFR_IS_INF (x))
+        {
+          MPFR_SET_NAN (y);
+          MPFR_SET_NAN (z);
+          MPFR_RET_NAN;
+        }
+      else /* x is zero: tan(x) = x, sec(x) = 1 */
+        {
+          MPFR_ASSERTD (MPFR_IS_ZERO (x));
+          MPFR_SET_ZERO (y);
+          MPFR_SET_SAME_SIGN (y, x);
+          inex_z = mpfr_set_ui (z, 1, rnd_mode);
+          return INEX (0, inex_z);
+        }
+    }
+
+  /* The fallbacks below need x after one of the results has been set. */
+  if (y == x || z == x)
+    {
+      mpfr_init2 (xc, MPFR_PREC (x));
+      mpfr_set (xc, x, MPFR_RNDN); /* exact */
+      x = xc;
+      copied = 1;
+    }
+
+  N = MAX (MPFR_PREC (y), MPFR_PREC (z));
+  if (MPFR_GET_EXP (x) >= - (mpfr_exp_t) (N / 2))
+    {
+      MPFR_ZIV_DECL (loop);
+      MPFR_SAVE_EXPO_DECL (expo);
+      MPFR_GROUP_DECL (group);
+
+      MPFR_SAVE_EXPO_MARK (expo);
+
+      N += MPFR_INT_CEIL_LOG2 (N) + 13;
+      MPFR_GROUP_INIT_3 (group, N, s, c, t);
+
+      MPFR_ZIV_INIT (loop, N);
+      for (iter = 0; ; iter++)
+        {
+          /* As in mpfr_tan, the error on s/c is at most 4 ulps, and the
+             relative error on c being at most 2^(-N), the error on 1/c is
+             at most 2 ulps. */
+          mpfr_sin_cos (s, c, x, MPFR_RNDN);
+          mpfr_div (t, s, c, MPFR_RNDN);
+          mpfr_ui_div (c, 1, c, MPFR_RNDN);
+          MPFR_ASSERTD (! MPFR_IS_SINGULAR (t) && ! MPFR_IS_SINGULAR (c));
+
+          ok_y = MPFR_CAN_ROUND (t, N - 2, MPFR_PREC (y), rnd_mode);
+          ok_z = MPFR_CAN_ROUND (c, N - 2, MPFR_PREC (z), rnd_mode);
+          if ((ok_y && ok_z) || iter == 1)
+            break;
+          MPFR_ZIV_NEXT (loop, N);
+          MPFR_GROUP_REPREC_3 (group, N, s, c, t);
+        }
+      MPFR_ZIV_FREE (loop);
+
+      if (ok_y)
+        inex_y = mpfr_set (y, t, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_set (z, c, rnd_mode);
+      MPFR_GROUP_CLEAR (group);
+      MPFR_SAVE_EXPO_FREE (expo);
+
+      if (ok_y)
+        inex_y = mpfr_check_range (y, inex_y, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_check_range (z, inex_z, rnd_mode);
+    }
+
+  if (! ok_y)
+    inex_y = mpfr_tan (y, x, rnd_mode);
+  if (! ok_z)
+    inex_z = mpfr_sec (z, x, rnd_mode);
+
+  if (copied)
+    mpfr_clear (xc);
+  return INEX (inex_y, inex_z);
+}
+
+int
+mpfr_sin_cos_tan (mpfr_ptr y, mpfr_ptr z, mpfr_ptr w, mpfr_srcptr x,
+                  mpfr_rnd_t rnd_mode)
+{
+  mpfr_t xc, s, c, t;
+  mpfr_prec_t N;
+  int inex_y = 0, inex_z = 0, inex_w = 0, ok_y = 0, ok_z = 0, ok_w = 0;
+  int copied = 0, iter;
+
+  MPFR_ASSERTN (y != z && y != w && z != w);
+
+  MPFR_LOG_FUNC
+    (("x[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (x), mpfr_log_prec, x, rnd_mode),
+     ("sin[%Pd]=%.*Rg cos[%Pd]=%.*Rg tan[%Pd]=%.*Rg",
+      mpfr_get_prec (y), mpfr_log_prec, y,
+      mpfr_get_prec (z), mpfr_log_prec, z,
+      mpfr_get_prec (w), mpfr_log_prec, w));
+
+  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+    {
+      if (MPFR_IS_NAN (x) || MPFR_IS_INF (x))
+        {
+          MPFR_SET_NAN (y);
+          MPFR_SET_NAN (z);
+          MPFR_SET_NAN (w);
+          MPFR_RET_NAN;
+        }
+      else /* x is zero: sin(x) = tan(x) = x, cos(x) = 1 */
+        {
+          MPFR_ASSERTD (MPFR_IS_ZERO (x));
+          MPFR_SET_ZERO (y);
+          MPFR_SET_SAME_SIGN (y, x);
+          MPFR_SET_ZERO (w);
+          MPFR_SET_SAME_SIGN (w, x);
+          inex_z = mpfr_set_ui (z, 1, rnd_mode);
+          return INEX3 (0, inex_z, 0);
+        }
+    }
+
+  /* The fallbacks below need x after one of the results has been set. */
+  if (y == x || z == x || w == x)
+    {
+      mpfr_init2 (xc, MPFR_PREC (x));
+      mpfr_set (xc, x, MPFR_RNDN); /* exact */
+      x = xc;
+      copied = 1;
+    }
+
+  N = MAX (MPFR_PREC (y), MPFR_PREC (z));
+  N = MAX (N, MPFR_PREC (w));
+  if (MPFR_GET_EXP (x) >= - (mpfr_exp_t) (N / 2))
+    {
+      MPFR_ZIV_DECL (loop);
+      MPFR_SAVE_EXPO_DECL (expo);
+      MPFR_GROUP_DECL (group);
+
+      MPFR_SAVE_EXPO_MARK (expo);
+
+      N += MPFR_INT_CEIL_LOG2 (N) + 13;
+      MPFR_GROUP_INIT_3 (group, N, s, c, t);
+
+      MPFR_ZIV_INIT (loop, N);
+      for (iter = 0; ; iter++)
+        {
+          /* The error on s and c is at most 1/2 ulp, and the error on s/c
+             is at most 4 ulps (see mpfr_tan). */
+          mpfr_sin_cos (s, c, x, MPFR_RNDN);
+          mpfr_div (t, s, c, MPFR_RNDN);
+          MPFR_ASSERTD (! MPFR_IS_SINGULAR (t));
+
+          ok_y = MPFR_CAN_ROUND (s, N - 1, MPFR_PREC (y), rnd_mode);
+          ok_z = MPFR_CAN_ROUND (c, N - 1, MPFR_PREC (z), rnd_mode);
+          ok_w = MPFR_CAN_ROUND (t, N - 2, MPFR_PREC (w), rnd_mode);
+          if ((ok_y && ok_z && ok_w) || iter == 1)
+            break;
+          MPFR_ZIV_NEXT (loop, N);
+          MPFR_GROUP_REPREC_3 (group, N, s, c, t);
+        }
+      MPFR_ZIV_FREE (loop);
+
+      if (ok_y)
+        inex_y = mpfr_set (y, s, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_set (z, c, rnd_mode);
+      if (ok_w)
+        inex_w = mpfr_set (w, t, rnd_mode);
+      MPFR_GROUP_CLEAR (group);
+      MPFR_SAVE_EXPO_FREE (expo);
+
+      if (ok_y)
+        inex_y = mpfr_check_range (y, inex_y, rnd_mode);
+      if (ok_z)
+        inex_z = mpfr_check_range (z, inex_z, rnd_mode);
+      if (ok_w)
+        inex_w = mpfr_check_range (w, inex_w, rnd_mode);
+    }
+
+  if (! ok_y)
+    inex_y = mpfr_sin (y, x, rnd_mode);
+  if (! ok_z)
+    inex_z = mpfr_cos (z, x, rnd_mode);
+  if (! ok_w)
+    inex_w = mpfr_tan (w, x, rnd_mode);
+
+  if (copied)
+    mpfr_clear (xc);
+  return INEX3 (inex_y, inex_z, inex_w);
+}
@@ -0,0 +1,195 @@
+/* mpfr_trig_reduce -- argument reduction for the trigonometric functions,
+   with a cached table of the bits of 2/Pi
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* Write |x| = X*2^e, where X is the significand of x seen as an integer.
+   Since X is an integer, X*2^e*2/Pi mod 4 only depends on the bits of 2/Pi
+   of weight 2^(1-e) and less, and up to an error 2^(-m), only on those of
+   weight larger than about 2^(-EXP(x)-m). Thus x is reduced by multiplying
+   X by this window of bits of 2/Pi (Payne-Hanek reduction), in a time that
+   does not depend on EXP(x), instead of computing a remainder by Pi on
+   EXP(x)+m bits.
+
+   The bits of 2/Pi are taken from a per-thread table, which is extended
+   when a larger exponent is met (at least doubling its size) and freed by
+   mpfr_free_cache. It contains an approximation T of 2/Pi, with
+   |T - 2/Pi| < 2^(-GMP_NUMB_BITS*twoopi_size), where twoopi_tab[0] is the
+   least significant limb and twoopi_tab[twoopi_size-1] the first limb
+   after the binary point (as the significand of a number in [1/2,1)). */
+
+static MPFR_THREAD_ATTR mp_limb_t *twoopi_tab = NULL;
+static MPFR_THREAD_ATTR mp_size_t twoopi_size = 0;
+
+#define TWOOPI_MIN_SIZE MPFR_PREC2LIMBS (256)
+
+void
+mpfr_trig_reduce_freecache (void)
+{
+  if (twoopi_tab != NULL)
+    {
+      mpfr_free_func (twoopi_tab, twoopi_size * MPFR_BYTES_PER_MP_LIMB);
+      twoopi_tab = NULL;
+      twoopi_size = 0;
+    }
+}
+
+/* Make sure that the table of 2/Pi has at least n limbs.
+   Must be called in the extended exponent range. */
+static void
+twoopi_extend (mp_size_t n)
+{
+  mp_size_t nmax = (MPFR_PREC_MAX - 2) / GMP_NUMB_BITS;
+  mp_limb_t *tab;
+  mpfr_t pi, t;
+
+  if (n <= twoopi_size)
+    return;
+  MPFR_ASSERTN (n <= nmax);
+  n = MAX (n, TWOOPI_MIN_SIZE);
+  if (twoopi_size <= nmax / 2)
+    n = MAX (n, 2 * twoopi_size);
+
+  /* pi = Pi (1 + theta) with |theta| <= 2^(-GMP_NUMB_BITS*n-3), thus
+     |2/pi - 2/Pi| < 2^(-GMP_NUMB_BITS*n-3), and the final rounding
+     to nearest adds at most 1/2 ulp = 2^(-GMP_NUMB_BITS*n-1). */
+  tab = (mp_limb_t *) mpfr_allocate_func (n * MPFR_BYTES_PER_MP_LIMB);
+  mpfr_init2 (pi, (mpfr_prec_t) n * GMP_NUMB_BITS + 2);
+  mpfr_const_pi (pi, MPFR_RNDN);
+  MPFR_TMP_INIT1 (tab, t, (mpfr_prec_t) n * GMP_NUMB_BITS);
+  mpfr_ui_div (t, 2, pi, MPFR_RNDN);
+  MPFR_ASSERTD (MPFR_GET_EXP (t) == 0);
+  mpfr_clear (pi);
+
+  mpfr_trig_reduce_freecache ();
+  twoopi_tab = tab;
+  twoopi_size = n;
+}
+
+/* Let m = PREC(xr) and x be a regular number with EXP(x) >= 0.
+   If q is NULL, set xr to x - 2k*Pi rounded to nearest for some integer k,
+   with |xr| <= Pi (up to the error), and |xr - (x - 2k*Pi)| < 2^(2-m).
+   Otherwise, set xr to x - k*Pi/2 rounded to nearest for some integer k,
+   with |xr| <= Pi/4 (up to the error), |xr - (x - k*Pi/2)| < 2^(-m), and
+   set *q to k mod 4 (in 0..3).
+   In both cases, xr may be zero. */
+void
+mpfr_trig_reduce (mpfr_ptr xr, int *q, mpfr_srcptr x)
+{
+  mpfr_prec_t m = MPFR_PREC (xr);
+  mpfr_exp_t expx = MPFR_GET_EXP (x), e, s;
+  mp_size_t nx = MPFR_LIMB_SIZE (x), j0, nw, nv, nf;
+  mp_limb_t *vp, *wp, *pp;
+  mpfr_t f, pi;
+  int cnt;
+  long k;
+  MPFR_TMP_DECL (marker);
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_ASSERTD (MPFR_IS_PURE_FP (x));
+  MPFR_ASSERTD (expx >= 0);
+  MPFR_ASSERTN (expx <= MPFR_PREC_MAX - m - 6 - GMP_NUMB_BITS);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  MPFR_TMP_MARK (marker);
+
+  /* |x| = X*2^e. The first j0 limbs of 2/Pi contribute multiples of 4
+     to X*2^e*2/Pi, thus they are ignored. The window ends at the weight
+     2^(-GMP_NUMB_BITS*(j0+nw)) <= 2^(-expx-m-6) of 2/Pi. */
+  e = expx - (mpfr_exp_t) nx * GMP_NUMB_BITS;
+  j0 = e >= 2 ? (e - 2) / GMP_NUMB_BITS : 0;
+  nw = (expx + m + 5) / GMP_NUMB_BITS + 1 - j0;
+  twoopi_extend (j0 + nw);
+  wp = twoopi_tab + (twoopi_size - j0 - nw);
+
+  /* {vp, nv} = X * W, where W is the window, so that X*2^e*2/Pi is
+     {vp, nv} / 2^s modulo 4. The error on X*2^e*2/Pi due to the bits
+     after the window is less than X*2^(e-GMP_NUMB_BITS*(j0+nw)) <
+     2^(expx-GMP_NUMB_BITS*(j0+nw)) <= 2^(-m-6), and the one due to the
+     error of the table is less than X*2^e*2^(-GMP_NUMB_BITS*twoopi_size)
+     <= 2^(-m-6) too. The extra high limb is needed when e < 2. */
+  nv = nx + nw + 1;
+  vp = MPFR_TMP_LIMBS_ALLOC (nv);
+  if (nw >= nx)
+    mpn_mul (vp, wp, nw, MPFR_MANT (x), nx);
+  else
+    mpn_mul (vp, MPFR_MANT (x), nx, wp, nw);
+  vp[nv - 1] = 0;
+  s = (mpfr_exp_t) (j0 + nw) * GMP_NUMB_BITS - e;
+
+  /* keep the bits of weight less than 2^2, i.e., the value mod 4 */
+  nf = (s + 1) / GMP_NUMB_BITS + 1;
+  MPFR_ASSERTD (nf <= nv);
+  if ((s + 2) % GMP_NUMB_BITS != 0)
+    vp[nf - 1] &= MPFR_LIMB_MASK ((s + 2) % GMP_NUMB_BITS);
+  while (nf > 0 && vp[nf - 1] == 0)
+    nf--;
+
+  /* f = {vp, nf} / 2^s = |x|*2/Pi mod 4, with an error < 2^(-m-5),
+     exactly representable on GMP_NUMB_BITS*nf bits */
+  if (nf == 0)
+    {
+      MPFR_SET_ZERO (xr);
+      MPFR_SET_POS (xr);
+      if (q != NULL)
+        *q = 0;
+      goto end;
+    }
+  count_leading_zeros (cnt, vp[nf - 1]);
+  if (cnt != 0)
+    mpn_lshift (vp, vp, nf, cnt);
+  MPFR_TMP_INIT1 (vp, f, (mpfr_prec_t) nf * GMP_NUMB_BITS);
+  MPFR_SET_EXP (f, (mpfr_exp_t) nf * GMP_NUMB_BITS - cnt - s);
+
+  /* The subtractions below are exact, since f is a multiple of 2^(-s)
+     less than 4 in absolute value, and nf * GMP_NUMB_BITS >= s + 2. */
+  if (q == NULL)
+    {
+      /* -2 <= f < 2, i.e., -Pi <= f*Pi/2 < Pi */
+      if (mpfr_cmp_ui (f, 2) >= 0)
+        mpfr_sub_ui (f, f, 4, MPFR_RNDN);
+    }
+  else
+    {
+      /* -1/2 <= f <= 1/2 and k = nearest integer (0 to 4) */
+      k = mpfr_get_si (f, MPFR_RNDN);
+      mpfr_sub_si (f, f, k, MPFR_RNDN);
+      *q = (int) (MPFR_IS_NEG (x) ? - k : k) & 3;
+    }
+  if (MPFR_IS_NEG (x))
+    MPFR_CHANGE_SIGN (f);
+
+  /* xr = f * pi / 2, where pi is Pi rounded to m+3 bits: the error on
+     xr is at most 1/2 ulp(xr), plus 2^(-m-2) |f|/2 for the error on pi,
+     plus (Pi/2) 2^(-m-5) for the error on f, i.e., less than
+     2^(1-m) + 2^(-m-2) + 2^(-m-4) < 2^(2-m) if q = NULL (|xr| < 4), and
+     2^(-m-1) + 2^(-m-4) + 2^(-m-4) < 2^(-m) otherwise (|xr| < 1). */
+  MPFR_TMP_INIT (pp, pi, m + 3, MPFR_PREC2LIMBS (m + 3));
+  mpfr_const_pi (pi, MPFR_RNDN);
+  mpfr_mul (xr, f, pi, MPFR_RNDN);
+  mpfr_div_2ui (xr, xr, 1, MPFR_RNDN);
+
+ end:
+  MPFR_TMP_FREE (marker);
+  MPFR_SAVE_EXPO_FREE (expo);
+}
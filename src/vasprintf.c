@@ -48,23 +48,19 @@ If not, see <https://www.gnu.org/licenses/>. */
    but the requirement is the same). Here, MPFR just follows ISO C.
 */
 
-/* FIXME: For the native types, the gmp_asprintf and gmp_vasprintf functions
-   are currently used, thus a full output is generated before being truncated
-   in case of mpfr_snprintf(). This is potentially very inefficient and could
-   unnecessarily exhaust the memory and/or crash.
-   (Not tested yet.)
-
-   A solution could be the use of gmp_snprintf / gmp_vsnprintf, but
-   note that as a consequence, the case n > buffer size might not be
-   supported everywhere. This would affect the snprintf_size() test
-   in "tests/tsprintf.c". See discussion
+/* Note: For the native types, gmp_vsnprintf is used to output the data
+   directly to the buffer (see buffer_vprintf), so that with
+   mpfr_snprintf(), the output is not generated in full before being
+   truncated. The size given to gmp_vsnprintf is limited to INT_MAX since
+   the case n > INT_MAX might not be supported everywhere (this is tested
+   by the snprintf_size() test in "tests/tsprintf.c"). See discussion
      https://sourceware.org/pipermail/libc-alpha/2023-March/146343.html
    and about MPFR:
      https://sourceware.org/pipermail/libc-alpha/2023-March/146515.html
 
-   This should be better, though the implementation of the standard
-   formatted output functions may be inefficient, but this would be
-   the best we can do. For instance, for the GNU C Library (glibc):
+   The implementation of the standard formatted output functions may be
+   inefficient, but this is the best we can do. For instance, for the GNU
+   C Library (glibc):
      https://sourceware.org/bugzilla/show_bug.cgi?id=17829
      https://sourceware.org/bugzilla/show_bug.cgi?id=21127
 */
@@ -167,23 +163,30 @@ static const char num_to_text[] = "0123456789abcdef";
         ++(format);                                                     \
       }                                                                 \
     else                                                                \
-      for ( ; *(format) >= '0' && *(format) <= '9' ; ++(format))        \
-        if (!(overflow))                                                \
-          {                                                             \
-            if ((var) > MPFR_INTMAX_MAX / 10)                           \
-              (overflow) = 1;                                           \
-            else                                                        \
-              {                                                         \
-                int _i;                                                 \
-                (var) *= 10;                                            \
-                _i = *(format) - '0';                                   \
-                MPFR_ASSERTN (_i >= 0 && _i <= 9);                      \
-                if ((var) > MPFR_INTMAX_MAX - _i)                       \
-                  (overflow) = 1;                                       \
-                else                                                    \
-                  (var) += _i;                                          \
-              }                                                         \
-          }                                                             \
+      READ_DIGITS (format, var);                                        \
+  } while (0)
+
+/* Read the decimal digits of an integer var, as done by READ_INT when
+   there is no '*'. */
+#define READ_DIGITS(format, var)                                        \
+  do {                                                                  \
+    for ( ; *(format) >= '0' && *(format) <= '9' ; ++(format))          \
+      if (!(overflow))                                                  \
+        {                                                               \
+          if ((var) > MPFR_INTMAX_MAX / 10)                             \
+            (overflow) = 1;                                             \
+          else                                                          \
+            {                                                           \
+              int _i;                                                   \
+              (var) *= 10;                                              \
+              _i = *(format) - '0';                                     \
+              MPFR_ASSERTN (_i >= 0 && _i <= 9);                        \
+              if ((var) > MPFR_INTMAX_MAX - _i)                         \
+                (overflow) = 1;                                         \
+              else                                                      \
+                (var) += _i;                                            \
+            }                                                           \
+        }                                                               \
   } while (0)
 
 /* arg_t contains all the types described by the 'type' field of the
@@ -409,6 +412,57 @@ parse_arg_type (const char *format, struct printf_spec *specinfo)
   return format;
 }
 
+/* Parse the optional rounding mode after the 'R' type, except '*', which
+   is handled by the callers. */
+MPFR_RETURNS_NONNULL static const char *
+parse_rnd_mode (const char *format, struct printf_spec *specinfo)
+{
+  switch (*format)
+    {
+    case 'D':
+      ++format;
+      specinfo->rnd_mode = MPFR_RNDD;
+      break;
+    case 'U':
+      ++format;
+      specinfo->rnd_mode = MPFR_RNDU;
+      break;
+    case 'Y':
+      ++format;
+      specinfo->rnd_mode = MPFR_RNDA;
+      break;
+    case 'Z':
+      ++format;
+      specinfo->rnd_mode = MPFR_RNDZ;
+      break;
+    case 'N':
+      ++format;
+      MPFR_FALLTHROUGH;
+    default:
+      specinfo->rnd_mode = MPFR_RNDN;
+    }
+  return format;
+}
+
+/* Size of the format string for gmp_printf built by prec_format. */
+#define PREC_FORMAT_SIZE (MPFR_PREC_FORMAT_SIZE + 12) /* e.g. "%0#+ -'*.*ld" */
+
+/* Construct the format string for gmp_printf used to output a mpfr_prec_t
+   value (MPFR_PREC_ARG), like "%*.*hd" "%*.*d" or "%*.*ld", where the width
+   and the precision are given as arguments. */
+static void
+prec_format (char *format, const struct printf_spec spec)
+{
+  sprintf (format, "%%%s%s%s%s%s%s*.*" MPFR_PREC_FORMAT_TYPE "%c",
+           spec.pad == '0' ? "0" : "",
+           spec.alt ? "#" : "",
+           spec.showsign ? "+" : "",
+           spec.space ? " " : "",
+           spec.left ? "-" : "",
+           spec.group ? "'" : "",
+           spec.spec);
+}
+
 
 /* some macros and functions filling the buffer */
 
@@ -533,18 +587,10 @@ typedef wint_t mpfr_va_wint;
   } while (0)
 
 /* Process the format part that does not deal with mpfr types,
-   from start to end (not included).
-   Jump to external label 'error' if gmp_asprintf return -1.
+   from start to end (not included), with buffer_vprintf.
+   Jump to external label 'error' if it returns -1.
    Note: start and end are pointers to the format string, so that
    size_t is the best type to express the difference.
-   Warning! Since the output from gmp_vasprintf may contain non-terminating
-   null characters (if %c is used with the value 0), the mpfr_free_str
-   function must not be used to free the allocated memory, because the size
-   may matter with some custom allocation functions. Anyway, mpfr_free_func
-   is more efficient here, as the size does not need to be recomputed.
-   FIXME: If buf.size = 0 or size != 0, gmp_vsnprintf should be called
-   instead of gmp_vasprintf, outputting data directly to the buffer
-   when applicable.
 */
 #define FLUSH(flag, start, end, ap, buf_ptr)                            \
   do {                                                                  \
@@ -553,29 +599,36 @@ typedef wint_t mpfr_va_wint;
       /* previous specifiers are understood by gmp_printf */            \
       {                                                                 \
         MPFR_TMP_DECL (marker);                                         \
-        char *fmt_copy, *s;                                             \
+        char *fmt_copy;                                                 \
         int length;                                                     \
                                                                         \
         MPFR_TMP_MARK (marker);                                         \
         fmt_copy = (char *) MPFR_TMP_ALLOC (n + 1);                     \
         memcpy (fmt_copy, (start), n);                                  \
         fmt_copy[n] = '\0';                                             \
-        length = gmp_vasprintf (&s, fmt_copy, (ap));                    \
+        length = buffer_vprintf ((buf_ptr), fmt_copy, (ap));            \
+        MPFR_TMP_FREE (marker);                                         \
         if (length < 0)                                                 \
-          {                                                             \
-            MPFR_TMP_FREE (marker);                                     \
-            goto error;                                                 \
-          }                                                             \
-        buffer_cat ((buf_ptr), s, length);                              \
-        mpfr_free_func (s, length + 1);                                 \
+          goto error;                                                   \
         (flag) = 0;                                                     \
-        MPFR_TMP_FREE (marker);                                         \
       }                                                                 \
     else if ((start) != (end))                                          \
       /* no conversion specification, just simple characters */         \
       buffer_cat ((buf_ptr), (start), n);                               \
   } while (0)
 
+/* Storage of a string_buffer. The buffer given by the caller of
+   mpfr_vasnprintf_aux is used directly, so that the usual output does
+   not need any memory allocation. */
+enum buffer_t
+  {
+    BUF_ALLOCATED, /* allocated buffer, reallocated when needed */
+    BUF_FIXED,     /* caller's buffer, the output is truncated to its size
+                      (mpfr_vsnprintf) */
+    BUF_INITIAL    /* caller's buffer, replaced by an allocated buffer if
+                      it is too small */
+  };
+
 /* Note: in case some form of %n is used in the format string,
    we may need the maximum signed integer type for len. */
 struct string_buffer
@@ -584,6 +637,7 @@ struct string_buffer
   char *curr;                   /* null terminating character */
   size_t size;                  /* buffer capacity */
   mpfr_intmax_t len;            /* string length or -1 if overflow */
+  enum buffer_t type;           /* storage of the buffer */
 };
 
 static void
@@ -597,6 +651,22 @@ buffer_init (struct string_buffer *b, size_t s)
     }
   b->size = s;
   b->len = 0;
+  b->type = BUF_ALLOCATED;
+}
+
+/* Initialize b with the buffer buf of s > 0 characters given by the caller,
+   where type is BUF_FIXED or BUF_INITIAL. */
+static void
+buffer_init_caller (struct string_buffer *b, char *buf, size_t s,
+                    enum buffer_t type)
+{
+  MPFR_ASSERTD (s != 0 && type != BUF_ALLOCATED);
+  b->start = buf;
+  b->start[0] = '\0';
+  b->curr = b->start;
+  b->size = s;
+  b->len = 0;
+  b->type = type;
 }
 
 /* Increase the len field of the buffer. Return non-zero iff overflow. */
@@ -630,7 +700,8 @@ buffer_incr_len (struct string_buffer *b, mpfr_intmax_t len)
 }
 
 /* Increase buffer size by a number of character being the least multiple of
-   4096 greater than len+1. */
+   4096 greater than len+1. A caller's buffer (BUF_INITIAL) is replaced by
+   an allocated one. */
 static void
 buffer_widen (struct string_buffer *b, size_t len)
 {
@@ -642,12 +713,23 @@ buffer_widen (struct string_buffer *b, size_t len)
 
   MPFR_ASSERTN (n >= 0x1000 && n >= len);
 
+  MPFR_ASSERTD (b->type != BUF_FIXED);
   MPFR_ASSERTD (*b->curr == '\0');
   MPFR_ASSERTD (pos < b->size);
 
   MPFR_ASSERTN (b->size < ((size_t) -1) - n);
 
-  b->start = (char *) mpfr_reallocate_func (b->start, b->size, b->size + n);
+  if (b->type == BUF_INITIAL)
+    {
+      char *s = (char *) mpfr_allocate_func (b->size + n);
+
+      memcpy (s, b->start, pos + 1);
+      b->start = s;
+      b->type = BUF_ALLOCATED;
+    }
+  else
+    b->start = (char *) mpfr_reallocate_func (b->start, b->size,
+                                              b->size + n);
   b->size += n;
   b->curr = b->start + pos;
 
@@ -655,6 +737,25 @@ buffer_widen (struct string_buffer *b, size_t len)
   MPFR_ASSERTD (*b->curr == '\0');
 }
 
+/* Make room for len more characters (and the terminating null character)
+   in the buffer b, which must have a non-zero size. Return the number of
+   characters that can be written, i.e. len, except for a BUF_FIXED buffer
+   whose content is truncated. */
+static size_t
+buffer_room (struct string_buffer *b, size_t len)
+{
+  if (b->type == BUF_FIXED)
+    {
+      const size_t room = b->size - 1 - (b->curr - b->start);
+      return len < room ? len : room;
+    }
+
+  MPFR_ASSERTN (b->size < ((size_t) -1) - len);
+  if (MPFR_UNLIKELY (b->curr + len >= b->start + b->size))
+    buffer_widen (b, len);
+  return len;
+}
+
 /* Concatenate the first len characters of the array s to the buffer b,
    and expand it if needed. Return non-zero if overflow.
    Warning! The array s may contain null characters in addition to the
@@ -676,26 +777,96 @@ buffer_cat (struct string_buffer *b, const char *s, size_t len)
   if (b->size != 0)
     {
       MPFR_ASSERTD (*b->curr == '\0');
-      MPFR_ASSERTN (b->size < ((size_t) -1) - len);
-      if (MPFR_UNLIKELY (b->curr + len >= b->start + b->size))
-        buffer_widen (b, len);
+      len = buffer_room (b, len);
 
       MPFR_ASSERTD (*b->curr == '\0');
       memcpy (b->curr, s, len);
       b->curr += len;
-      MPFR_ASSERTD (b->curr < b->start + b->size);
+      MPFR_ASSERTD (b->curr - b->start < b->size);
       *b->curr = '\0';
     }
 
   return 0;
 }
 
+/* Output to the buffer b the arguments of ap according to the format fmt,
+   which is understood by gmp_printf. Return the number of characters of
+   the output, or -1 if gmp_vsnprintf fails.
+   When the output does not fit in the current buffer, it is formatted
+   again after the buffer has been widened (except for a BUF_FIXED buffer,
+   where it is truncated), so that no intermediate string is needed.
+   Warning! The output may contain non-terminating null characters (if %c
+   is used with the value 0). */
+static int
+buffer_vprintf (struct string_buffer *b, const char *fmt, va_list ap)
+{
+  size_t room, n;
+  int length;
+
+  if (b->size == 0)  /* no output */
+    {
+      length = gmp_vsnprintf (NULL, 0, fmt, ap);
+      if (length >= 0)
+        buffer_incr_len (b, length);
+      return length;
+    }
+
+  MPFR_ASSERTD (*b->curr == '\0');
+  room = b->size - 1 - (b->curr - b->start);
+  /* The size argument of gmp_vsnprintf is limited to INT_MAX since the
+     output is then too large anyway. */
+  n = room < INT_MAX ? room + 1 : INT_MAX;
+
+  if (b->type == BUF_FIXED)
+    length = gmp_vsnprintf (b->curr, n, fmt, ap);
+  else
+    {
+      va_list aq;
+
+      va_copy (aq, ap);
+      length = gmp_vsnprintf (b->curr, n, fmt, aq);
+      va_end (aq);
+      if (length >= 0 && (size_t) length >= n)
+        {
+          buffer_room (b, length);
+          n = (size_t) length + 1;
+          length = gmp_vsnprintf (b->curr, n, fmt, ap);
+        }
+    }
+
+  if (length < 0 || buffer_incr_len (b, length))
+    *b->curr = '\0';
+  else
+    {
+      /* the number of written characters is at most n - 1 */
+      b->curr += (size_t) length < n ? (size_t) length : n - 1;
+      MPFR_ASSERTD (b->curr - b->start < b->size);
+      MPFR_ASSERTD (*b->curr == '\0');
+    }
+  return length;
+}
+
+/* Same as buffer_vprintf, with a variable number of arguments. */
+static int
+buffer_printf (struct string_buffer *b, const char *fmt, ...)
+{
+  va_list ap;
+  int length;
+
+  va_start (ap, fmt);
+  length = buffer_vprintf (b, fmt, ap);
+  va_end (ap);
+  return length;
+}
+
 /* Add n characters c to the end of buffer b. Return non-zero if overflow.
    Note: this function is called only when there is output (b->size != 0),
    since it is needed only by sprnt_fp(). */
 static int
 buffer_pad (struct string_buffer *b, const char c, const mpfr_intmax_t n)
 {
+  size_t m;
+
   MPFR_ASSERTD (b->size != 0);
   MPFR_ASSERTD (n > 0);
 
@@ -704,24 +875,23 @@ buffer_pad (struct string_buffer *b, const char c, const mpfr_intmax_t n)
 
   MPFR_ASSERTD (*b->curr == '\0');
 
-  if (n > (size_t) -1 || b->size > ((size_t) -1) - n)
+  if (n > (size_t) -1 ||
+      (b->type != BUF_FIXED && b->size > ((size_t) -1) - n))
     {
       /* Reallocation will not be possible. Regard this as an overflow. */
       b->len = -1;
       return 1;
     }
 
-  if (MPFR_UNLIKELY (b->curr + n >= b->start + b->size))
-    buffer_widen (b, n);
-
-  if (n == 1)
+  m = buffer_room (b, n);
+  if (m == 1)
     *b->curr = c;
   else
-    memset (b->curr, c, n);
-  b->curr += n;
+    memset (b->curr, c, m);
+  b->curr += m;
   *b->curr = '\0';
 
-  MPFR_ASSERTD (b->curr < b->start + b->size);
+  MPFR_ASSERTD (b->curr - b->start < b->size);
 
   return 0;
 }
@@ -737,8 +907,7 @@ buffer_sandwich (struct string_buffer *b, char *str, size_t len,
                  const size_t tz, const char c)
 {
   const size_t step = 3;
-  size_t size, q, r, fullsize, i;
-  char *oldcurr;
+  size_t size, q, fullsize, room, i;
 
   MPFR_ASSERTD (b->size != 0);
   MPFR_ASSERTD (tz == 0 || tz == 1);
@@ -759,8 +928,6 @@ buffer_sandwich (struct string_buffer *b, char *str, size_t len,
   MPFR_ASSERTD (size > 0);
 
   q = (size - 1) / step;        /* number of separators C */
-  r = ((size - 1) % step) + 1;  /* number of digits in the leftmost block */
-  MPFR_ASSERTD (r >= 1 && r <= step);
 
   /* check that size + q does not overflow */
   if (size > (size_t) -1 - q)
@@ -772,78 +939,40 @@ buffer_sandwich (struct string_buffer *b, char *str, size_t len,
     return 1;
 
   MPFR_ASSERTD (*b->curr == '\0');
-  MPFR_ASSERTN (b->size < ((size_t) -1) - fullsize);
-  if (MPFR_UNLIKELY (b->curr + fullsize >= b->start + b->size))
-    buffer_widen (b, fullsize);
-
-  MPFR_DBGRES (oldcurr = b->curr);
-
-  /* first r significant digits (leftmost block) */
-  if (r <= len)
-    {
-      memcpy (b->curr, str, r);
-      str += r;
-      len -= r;
-    }
-  else
-    {
-      MPFR_ASSERTD (r > len);
-      MPFR_ASSERTD (len < step);    /* as a consequence */
-      MPFR_ASSERTD (size <= step);  /* as a consequence */
-      MPFR_ASSERTD (q == 0);        /* as a consequence */
-      MPFR_ASSERTD (r == size);     /* as a consequence */
-      MPFR_ASSERTD (tz == 1);       /* as a consequence */
-      memcpy (b->curr, str, len);
-      *(b->curr + len) = '0';  /* trailing zero */
-      /* We do not need to set len to 0 since it will not be read again
-         (q = 0, so that the loop below will have 0 iterations). */
-    }
-  b->curr += r;
+  room = buffer_room (b, fullsize);
 
-  for (i = 0; i < q; ++i)
+  /* the i-th digit (a trailing zero if i >= len) is preceded by a
+     separator if it starts a block, i.e. if size - i is a multiple of
+     step; stop when the room is exhausted (truncated output) */
+  for (i = 0; i < size && room != 0; i++)
     {
-      *b->curr++ = c;
-      if (MPFR_LIKELY (len >= step))
+      if (i != 0 && (size - i) % step == 0)
         {
-          memcpy (b->curr, str, step);
-          len -= step;
-          str += step;
+          *b->curr++ = c;
+          if (--room == 0)
+            break;
         }
-      else
-        {
-          /* last digits */
-          MPFR_ASSERTD (i == q - 1 && step - len == 1);
-          memcpy (b->curr, str, len);
-          *(b->curr + len) = '0';  /* trailing zero */
-        }
-      b->curr += step;
+      *b->curr++ = i < len ? str[i] : '0';
+      room--;
     }
 
-  MPFR_ASSERTD (b->curr - oldcurr == fullsize);
-
   *b->curr = '\0';
 
-  MPFR_ASSERTD (b->curr < b->start + b->size);
+  MPFR_ASSERTD (b->curr - b->start < b->size);
 
   return 0;
 }
 
 /* Helper struct and functions for temporary strings management */
-/* struct for easy string clearing */
+/* struct for easy string clearing (for allocated strings only, see
+   np_alloc below) */
 struct string_list
 {
   char *string;
+  size_t size;              /* allocated size of string */
   struct string_list *next; /* NULL in last node */
 };
 
-/* initialization */
-static void
-init_string_list (struct string_list *sl)
-{
-  sl->string = NULL;
-  sl->next = NULL;
-}
-
 /* clear all strings in the list */
 static void
 clear_string_list (struct string_list *sl)
@@ -852,30 +981,31 @@ clear_string_list (struct string_list *sl)
 
   while (sl)
     {
-      if (sl->string)
-        mpfr_free_str (sl->string);
+      mpfr_free_func (sl->string, sl->size);
       n = sl->next;
       mpfr_free_func (sl, sizeof(struct string_list));
       sl = n;
     }
 }
 
-/* add a string in the list */
+/* add a string of allocated size size in front of the list *slp */
 static char *
-register_string (struct string_list *sl, char *new_string)
+register_string (struct string_list **slp, char *new_string, size_t size)
 {
-  /* look for the last node */
-  while (sl->next)
-    sl = sl->next;
-
-  sl->next = (struct string_list *)
+  struct string_list *sl = (struct string_list *)
     mpfr_allocate_func (sizeof (struct string_list));
 
-  sl = sl->next;
-  sl->next = NULL;
-  return sl->string = new_string;
+  sl->string = new_string;
+  sl->size = size;
+  sl->next = *slp;
+  *slp = sl;
+  return new_string;
 }
 
+/* Size of the scratch area of struct number_parts, enough for the digits
+   of a number with a precision of a few hundred bits. */
+#define NP_SCRATCH_SIZE 512
+
 /* padding type: where are the padding characters */
 enum pad_t
   {
@@ -918,11 +1048,48 @@ struct number_parts
   char *exp_ptr;          /* Pointer to exponent part */
   size_t exp_size;        /* Number of characters in exp_ptr */
 
-  struct string_list *sl; /* List of string buffers in use: we need such a
-                             mechanism because fp_ptr may point into the same
-                             string as ip_ptr */
+  struct string_list *sl; /* List of allocated string buffers in use: we
+                             need such a mechanism because fp_ptr may point
+                             into the same string as ip_ptr */
+
+  /* The strings are taken from the scratch area when they fit in it, so
+     that no memory allocation is needed for usual precisions. */
+  char scratch[NP_SCRATCH_SIZE];
+  size_t scratch_used;    /* Number of characters used in scratch */
 };
 
+/* Return a block of n characters for a string of np, taken from the
+   scratch area of np if there is enough room, otherwise allocated. */
+static char *
+np_alloc (struct number_parts *np, size_t n)
+{
+  if (n <= NP_SCRATCH_SIZE - np->scratch_used)
+    {
+      char *s = np->scratch + np->scratch_used;
+
+      np->scratch_used += n;
+      return s;
+    }
+  return register_string (&np->sl, (char *) mpfr_allocate_func (n), n);
+}
+
+/* Same as mpfr_get_str (NULL, exp, base, n, op, rnd), but the string is
+   obtained with np_alloc. */
+static char *
+np_get_str (struct number_parts *np, mpfr_exp_t *exp, int base, size_t n,
+            mpfr_srcptr op, mpfr_rnd_t rnd)
+{
+  size_t m = n != 0 ? n : mpfr_get_str_ndigits (base, MPFR_GET_PREC (op));
+  char *str;
+
+  if (m < NP_SCRATCH_SIZE && m + 2 <= NP_SCRATCH_SIZE - np->scratch_used)
+    return mpfr_get_str (np_alloc (np, m + 2), exp, base, n, op, rnd);
+
+  /* The size may be huge, let mpfr_get_str deal with it. */
+  str = mpfr_get_str (NULL, exp, base, n, op, rnd);
+  return register_string (&np->sl, str, strlen (str) + 1);
+}
+
 /* For a real non zero number x, what is the base exponent f when rounding x
    with rounding mode r to r(x) = m*b^f, where m is a digit and 1 <= m < b ?
    Return non zero value if x is rounded up to b^f, return zero otherwise */
@@ -972,20 +1139,65 @@ struct decimal_info
   char *str;
 };
 
+#ifdef MPFR_POW10_TAB
+/* Return the sign of |x| - 10^k for a real non zero number x whose
+   precision is at most MPFR_POW10_PREC, or 2 if this cannot be decided
+   quickly. This avoids mpfr_ui_pow and mpfr_exp10, which allocate memory.
+   The value t from the table satisfies |t - 10^k| < 6 ulp(t), thus |x| - t
+   gives the result if it is exact or at least 8 ulp(t) in absolute value.
+   Must be called in the extended exponent range. */
+static int
+cmpabs_pow10 (mpfr_srcptr x, mpfr_exp_t k)
+{
+  mp_limb_t tp[(MPFR_POW10_PREC - 1) / GMP_NUMB_BITS + 1];
+  mpfr_t t, ax;
+  mpfr_exp_t e;
+
+  MPFR_ASSERTD (MPFR_PREC (x) <= MPFR_POW10_PREC);
+  if (k < -MPFR_POW10_MAX || k > MPFR_POW10_MAX)
+    return 2;
+  MPFR_TMP_INIT1 (tp, t, MPFR_POW10_PREC);
+  MPFR_TMP_INIT_ABS (ax, x);
+  if (mpfr_pow10_approx (t, (long) k) == 0)
+    return mpfr_cmp (ax, t);
+  e = MPFR_GET_EXP (t);
+  mpfr_sub (t, ax, t, MPFR_RNDZ);
+  return MPFR_NOTZERO (t) && MPFR_GET_EXP (t) >= e - (MPFR_POW10_PREC - 4) ?
+    MPFR_SIGN (t) : 2;
+}
+#endif
+
 /* For a real non zero number x, what is the exponent f so that
    10^f <= x < 10^(f+1). */
 static mpfr_exp_t
 floor_log10 (mpfr_srcptr x)
 {
   mpfr_t y;
+  mp_limb_t *yp;
   mpfr_exp_t exp;
-
-  /* make sure first that y can represent a mpfr_exp_t exactly
-     and can compare with x */
-  mpfr_prec_t prec = sizeof (mpfr_exp_t) * CHAR_BIT;
-  mpfr_init2 (y, MAX (prec, MPFR_PREC (x)));
+  MPFR_TMP_DECL (marker);
 
   exp = mpfr_ceil_mul (MPFR_GET_EXP (x), 10, 1) - 1;
+
+#ifdef MPFR_POW10_TAB
+  if (MPFR_PREC (x) <= MPFR_POW10_PREC)
+    {
+      int c = cmpabs_pow10 (x, exp);
+
+      if (c != 2)
+        return c < 0 ? exp - 1 : exp;
+    }
+#endif
+
+  {
+    /* make sure first that y can represent a mpfr_exp_t exactly
+       and can compare with x */
+    mpfr_prec_t prec = sizeof (mpfr_exp_t) * CHAR_BIT;
+    prec = MAX (prec, MPFR_PREC (x));
+    MPFR_TMP_MARK (marker);
+    MPFR_TMP_INIT (yp, y, prec, MPFR_PREC2LIMBS (prec));
+  }
+
   mpfr_set_exp_t (y, exp, MPFR_RNDU);
   /* The following call to mpfr_ui_pow should be fast: y is an integer
      (not too large), so that mpfr_pow_z will be used internally. */
@@ -993,21 +1205,21 @@ floor_log10 (mpfr_srcptr x)
   if (mpfr_cmpabs (x, y) < 0)
     exp--;
 
-  mpfr_clear (y);
+  MPFR_TMP_FREE (marker);
   return exp;
 }
 
 #define NDIGITS 8
 
-/* If output is needed (spec.size != 0), this is mpfr_get_str.
-   Otherwise...
+/* If output is needed (spec.size != 0), this is np_get_str.
+   Otherwise... (the string is also registered in np)
    TODO: Explain the meaning of the returned string. Is it really used?
    Note that this wrapper is not used for %Rg, since trailing zeros may
    need to be removed.
 */
 MPFR_RETURNS_NONNULL static char *
-mpfr_get_str_wrapper (mpfr_exp_t *exp, int base, size_t n, mpfr_srcptr op,
-                      const struct printf_spec spec)
+mpfr_get_str_wrapper (struct number_parts *np, mpfr_exp_t *exp, int base,
+                      size_t n, mpfr_srcptr op, const struct printf_spec spec)
 {
   size_t ndigits;
   char *str, *s, nine;
@@ -1017,7 +1229,7 @@ mpfr_get_str_wrapper (mpfr_exp_t *exp, int base, size_t n, mpfr_srcptr op,
   MPFR_ASSERTD (base == 2 || base == 10 || base == 16);
 
   if (spec.size != 0)
-    return mpfr_get_str (NULL, exp, base, n, op, spec.rnd_mode);
+    return np_get_str (np, exp, base, n, op, spec.rnd_mode);
 
   /* Special case size = 0, i.e., xxx_snprintf with size = 0: we only want
      to compute the number of printed characters. Try to deduce it from
@@ -1057,7 +1269,7 @@ mpfr_get_str_wrapper (mpfr_exp_t *exp, int base, size_t n, mpfr_srcptr op,
       MPFR_ASSERTN (ndigits <= ((size_t) -1) / 2);
       /* to make sure that the product by 2 is representable. */
     }
-  return str;
+  return register_string (&np->sl, str, strlen (str) + 1);
 }
 
 /* Determine the different parts of the string representation of the regular
@@ -1101,11 +1313,11 @@ regular_ab (struct number_parts *np, mpfr_srcptr p,
     /* prefix part */
     {
       np->prefix_size = 2;
-      str = (char *) mpfr_allocate_func (1 + np->prefix_size);
+      str = np_alloc (np, 1 + np->prefix_size);
       str[0] = '0';
       str[1] = uppercase ? 'X' : 'x';
       str[2] = '\0';
-      np->prefix_ptr = register_string (np->sl, str);
+      np->prefix_ptr = str;
     }
 
   /* integral part */
@@ -1130,8 +1342,7 @@ regular_ab (struct number_parts *np, mpfr_srcptr p,
           nsd = (size_t) spec.prec + 1;
           MPFR_ASSERTD (nsd > 1);
         }
-      str = mpfr_get_str_wrapper (&exp, base, nsd, p, spec);
-      register_string (np->sl, str);
+      str = mpfr_get_str_wrapper (np, &exp, base, nsd, p, spec);
       if (MPFR_IS_NEG (p))
         str++;  /* skip sign */
 
@@ -1158,8 +1369,7 @@ regular_ab (struct number_parts *np, mpfr_srcptr p,
   else
     {
       exp = MPFR_GET_EXP (p);
-      str = (char *) mpfr_allocate_func (2);
-      register_string (np->sl, str);
+      str = np_alloc (np, 2);
       if (next_base_power_p (p, base, spec.rnd_mode))
         {
           str[0] = '1';
@@ -1293,8 +1503,8 @@ regular_ab (struct number_parts *np, mpfr_srcptr p,
         x /= 10;
       }
   }
-  str = (char *) mpfr_allocate_func (1 + np->exp_size);
-  np->exp_ptr = register_string (np->sl, str);
+  str = np_alloc (np, 1 + np->exp_size);
+  np->exp_ptr = str;
   {
     char exp_fmt[8];  /* contains at most 7 characters like in "p%+.1i",
                          or "P%+.2li" */
@@ -1352,8 +1562,7 @@ regular_eg (struct number_parts *np, mpfr_srcptr p,
             return -1;
           nsd = (size_t) spec.prec + 1;
         }
-      str = mpfr_get_str_wrapper (&exp, 10, nsd, p, spec);
-      register_string (np->sl, str);
+      str = mpfr_get_str_wrapper (np, &exp, 10, nsd, p, spec);
     }
   else
     {
@@ -1449,8 +1658,8 @@ regular_eg (struct number_parts *np, mpfr_srcptr p,
   if (np->exp_size < 4)
     np->exp_size = 4;
 
-  str = (char *) mpfr_allocate_func (1 + np->exp_size);
-  np->exp_ptr = register_string (np->sl, str);
+  str = np_alloc (np, 1 + np->exp_size);
+  np->exp_ptr = str;
 
   {
     char exp_fmt[8];  /* e.g. "e%+.2i", or "E%+.2li" */
@@ -1489,10 +1698,10 @@ regular_fg (struct number_parts *np, mpfr_srcptr p,
     {
       /* Most of the time, integral part is 0 */
       np->ip_size = 1;
-      str = (char *) mpfr_allocate_func (1 + np->ip_size);
+      str = np_alloc (np, 1 + np->ip_size);
       str[0] = '0';
       str[1] = '\0';
-      np->ip_ptr = register_string (np->sl, str);
+      np->ip_ptr = str;
 
       if (spec.prec == 0)
         /* only two possibilities: either 1 or 0. */
@@ -1547,6 +1756,22 @@ regular_fg (struct number_parts *np, mpfr_srcptr p,
                     int cmp;
 
                     MPFR_ASSERTN (spec.rnd_mode == MPFR_RNDN);
+#ifdef MPFR_POW10_TAB
+                    if (MPFR_PREC (p) <= MPFR_POW10_PREC
+                        && spec.prec <= MPFR_POW10_MAX)
+                      {
+                        mpfr_t p2;  /* 2|p|, to be compared to 10^(-prec) */
+
+                        MPFR_ALIAS (p2, p, MPFR_SIGN_POS,
+                                    MPFR_GET_EXP (p) + 1);
+                        cmp = cmpabs_pow10 (p2, (mpfr_exp_t) - spec.prec);
+                        if (cmp != 2 && cmp != 0)
+                          {
+                            round_away = cmp > 0;
+                            break;
+                          }
+                      }
+#endif
                     mpfr_init2 (y, e + 8);
 
                     do
@@ -1574,10 +1799,10 @@ regular_fg (struct number_parts *np, mpfr_srcptr p,
                   np->fp_leading_zeros = spec.prec - 1;
 
                   np->fp_size = 1;
-                  str = (char *) mpfr_allocate_func (1 + np->fp_size);
+                  str = np_alloc (np, 1 + np->fp_size);
                   str[0] = '1';
                   str[1] = '\0';
-                  np->fp_ptr = register_string (np->sl, str);
+                  np->fp_ptr = str;
                 }
               else
                 /* only zeros in the fractional part */
@@ -1612,8 +1837,7 @@ regular_fg (struct number_parts *np, mpfr_srcptr p,
                      base ten (undocumented feature, see comments in
                      get_str.c) */
 
-                  str = mpfr_get_str_wrapper (&exp, 10, nsd, p, spec);
-                  register_string (np->sl, str);
+                  str = mpfr_get_str_wrapper (np, &exp, 10, nsd, p, spec);
                 }
               else
                 {
@@ -1704,8 +1928,7 @@ regular_fg (struct number_parts *np, mpfr_srcptr p,
           n = (mpfr_uintmax_t) spec.prec + (exp + 1);
           if (MPFR_UNLIKELY (n > (size_t) -1))
             return -1;
-          str = mpfr_get_str_wrapper (&exp, 10, n, p, spec);
-          register_string (np->sl, str);
+          str = mpfr_get_str_wrapper (np, &exp, 10, n, p, spec);
         }
       else
         {
@@ -1807,9 +2030,8 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
   np->fp_trailing_zeros = 0;
   np->exp_ptr = NULL;
   np->exp_size = 0;
-  np->sl = (struct string_list *)
-    mpfr_allocate_func (sizeof (struct string_list));
-  init_string_list (np->sl);
+  np->sl = NULL;
+  np->scratch_used = 0;
 
   uppercase = spec.spec == 'A' || spec.spec == 'E' || spec.spec == 'F'
     || spec.spec == 'G';
@@ -1830,9 +2052,9 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
             np->pad_type = LEFT;
 
           np->ip_size = MPFR_NAN_STRING_LENGTH;
-          str = (char *) mpfr_allocate_func (1 + np->ip_size);
+          str = np_alloc (np, 1 + np->ip_size);
           strcpy (str, uppercase ? MPFR_NAN_STRING_UC : MPFR_NAN_STRING_LC);
-          np->ip_ptr = register_string (np->sl, str);
+          np->ip_ptr = str;
         }
       else if (MPFR_IS_INF (p))
         {
@@ -1842,9 +2064,9 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
             np->pad_type = LEFT;
 
           np->ip_size = MPFR_INF_STRING_LENGTH;
-          str = (char *) mpfr_allocate_func (1 + np->ip_size);
+          str = np_alloc (np, 1 + np->ip_size);
           strcpy (str, uppercase ? MPFR_INF_STRING_UC : MPFR_INF_STRING_LC);
-          np->ip_ptr = register_string (np->sl, str);
+          np->ip_ptr = str;
         }
       else
         {
@@ -1857,19 +2079,19 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
             /* prefix part */
             {
               np->prefix_size = 2;
-              str = (char *) mpfr_allocate_func (1 + np->prefix_size);
+              str = np_alloc (np, 1 + np->prefix_size);
               str[0] = '0';
               str[1] = uppercase ? 'X' : 'x';
               str[2] = '\0';
-              np->prefix_ptr = register_string (np->sl, str);
+              np->prefix_ptr = str;
             }
 
           /* integral part */
           np->ip_size = 1;
-          str = (char *) mpfr_allocate_func (1 + np->ip_size);
+          str = np_alloc (np, 1 + np->ip_size);
           str[0] = '0';
           str[1] = '\0';
-          np->ip_ptr = register_string (np->sl, str);
+          np->ip_ptr = str;
 
           if (spec.prec < 0)  /* empty precision field */
             {
@@ -1897,12 +2119,12 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
             /* exponent part */
             {
               np->exp_size = (spec.spec == 'e' || spec.spec == 'E') ? 4 : 3;
-              str = (char *) mpfr_allocate_func (1 + np->exp_size);
+              str = np_alloc (np, 1 + np->exp_size);
               if (spec.spec == 'e' || spec.spec == 'E')
                 strcpy (str, uppercase ? "E+00" : "e+00");
               else
                 strcpy (str, uppercase ? "P+0" : "p+0");
-              np->exp_ptr = register_string (np->sl, str);
+              np->exp_ptr = str;
             }
         }
     }
@@ -1916,9 +2138,9 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
         np->pad_type = LEFT;
 
       np->ip_size = 3;
-      str = (char *) mpfr_allocate_func (1 + np->ip_size);
+      str = np_alloc (np, 1 + np->ip_size);
       strcpy (str, uppercase ? "UBF" : "ubf");
-      np->ip_ptr = register_string (np->sl, str);
+      np->ip_ptr = str;
       /* TODO: output more information (e.g. the exponent) if need be. */
     }
   else
@@ -2000,9 +2222,8 @@ partition_number (struct number_parts *np, mpfr_srcptr p,
           if (e > (size_t) -1)
             goto error;
 
-          dec_info.str = mpfr_get_str (NULL, &dec_info.exp, 10,
-                                       e, p, spec.rnd_mode);
-          register_string (np->sl, dec_info.str);
+          dec_info.str = np_get_str (np, &dec_info.exp, 10,
+                                     e, p, spec.rnd_mode);
           /* mpfr_get_str corresponds to a significand between 0.1 and 1,
              whereas here we want a significand between 1 and 10. */
           x = dec_info.exp - 1;
@@ -2175,9 +2396,14 @@ sprnt_fp (struct string_buffer *buf, mpfr_srcptr p,
 
 /* The following internal function implements both mpfr_vasprintf and
    mpfr_vsnprintf:
-   (a) either ptr <> NULL, and then Buf and size are not used, and it
+   (a) either ptr <> NULL and Buf = NULL, and then size is not used, and it
        implements mpfr_vasprintf (ptr, fmt, ap)
-   (b) or ptr = NULL, and it implements mpfr_vsnprintf (Buf, size, fmt, ap)
+   (b) or ptr = NULL, and it implements mpfr_vsnprintf (Buf, size, fmt, ap),
+       where the output is written directly to Buf
+   (c) or ptr <> NULL and Buf <> NULL with size <> 0: the output is written
+       to Buf if it fits in it, and *ptr is set to Buf; otherwise *ptr is
+       set to allocated memory, like with mpfr_vasprintf (this is used by
+       the functions of printf.c, with a buffer on the stack).
    It returns the number of characters that would have been written had 'size'
    been sufficiently large, not counting the terminating null character, or -1
    if this number is too large for the return type 'int' (overflow), in which
@@ -2199,7 +2425,7 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
   int xgmp_fmt_flag;
   /* beginning and end of the previous unprocessed part of fmt */
   const char *start, *end;
-  /* pointer to arguments for gmp_vasprintf */
+  /* pointer to arguments for gmp_vsnprintf */
   va_list ap2;
   MPFR_SAVE_EXPO_DECL (expo);
 
@@ -2214,7 +2440,11 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
      the strings (potentially huge), just compute the lengths. */
 
   spec.size = ptr != NULL || size != 0;  /* true iff do output */
-  buffer_init (&buf, spec.size ? 4096 : 0);
+  if (Buf != NULL && size != 0)
+    buffer_init_caller (&buf, Buf, size,
+                        ptr != NULL ? BUF_INITIAL : BUF_FIXED);
+  else
+    buffer_init (&buf, spec.size ? 4096 : 0);
   xgmp_fmt_flag = 0;
   va_copy (ap2, ap);
   start = fmt;
@@ -2299,36 +2529,13 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
         continue;
       else if (spec.arg_type == MPFR_ARG)
         {
-          switch (*fmt)
+          if (*fmt == '*')
             {
-            case '\0':
-              break;
-            case '*':
               ++fmt;
               spec.rnd_mode = (mpfr_rnd_t) va_arg (ap, int);
-              break;
-            case 'D':
-              ++fmt;
-              spec.rnd_mode = MPFR_RNDD;
-              break;
-            case 'U':
-              ++fmt;
-              spec.rnd_mode = MPFR_RNDU;
-              break;
-            case 'Y':
-              ++fmt;
-              spec.rnd_mode = MPFR_RNDA;
-              break;
-            case 'Z':
-              ++fmt;
-              spec.rnd_mode = MPFR_RNDZ;
-              break;
-            case 'N':
-              ++fmt;
-              MPFR_FALLTHROUGH;
-            default:
-              spec.rnd_mode = MPFR_RNDN;
             }
+          else
+            fmt = parse_rnd_mode (fmt, &spec);
         }
 
       spec.spec = *fmt;
@@ -2432,19 +2639,15 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
       else if (spec.arg_type == MPFR_PREC_ARG)
         /* output mpfr_prec_t variable */
         {
-          char *s;
-          char format[MPFR_PREC_FORMAT_SIZE + 12]; /* e.g. "%0#+ -'*.*ld\0" */
-          size_t length;
+          char format[PREC_FORMAT_SIZE];
+          int length;
           mpfr_prec_t prec;
 
-          /* FIXME: With buf.size = 0 and a huge width or precision, this
-             can uselessly take much memory. And even with buf.size != 0,
-             this would take more memory than necessary and need a large
-             buffer_cat. A solution: compute a bound on the maximum
-             number of significant digits, and handle the additional
-             characters separately. Moreover, if buf.size = 0 or size != 0,
-             gmp_snprintf should be called instead of gmp_asprintf,
-             outputting data directly to the buffer when applicable.
+          /* FIXME: With a huge width or precision, this can uselessly take
+             much memory in the buffer (or in GMP when buf.size = 0).
+             A solution: compute a bound on the maximum number of
+             significant digits, and handle the additional characters
+             separately.
              See also: https://sourceware.org/bugzilla/show_bug.cgi?id=23432
              Add testcases. */
 
@@ -2464,7 +2667,7 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
              larger than int may not be set. This is not a bug, as there
              are no strong guarantees for such variables in case of error.
              FIXME: If size = 0 and max(spec.width,spec.prec) is large
-             enough, there is no need to call gmp_asprintf since we are
+             enough, there is no need to call gmp_vsnprintf since we are
              just interested in the length, which should be this maximum;
              in particular, this should avoid the overflow issue. */
           if (overflow || spec.width > INT_MAX || spec.prec > INT_MAX)
@@ -2477,25 +2680,15 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
           MPFR_ASSERTD (spec.width >= 0);
           MPFR_ASSERTD (spec.prec >= -1);
 
-          /* construct format string, like "%*.*hd" "%*.*d" or "%*.*ld" */
-          sprintf (format, "%%%s%s%s%s%s%s*.*" MPFR_PREC_FORMAT_TYPE "%c",
-                   spec.pad == '0' ? "0" : "",
-                   spec.alt ? "#" : "",
-                   spec.showsign ? "+" : "",
-                   spec.space ? " " : "",
-                   spec.left ? "-" : "",
-                   spec.group ? "'" : "",
-                   spec.spec);
-          MPFR_LOG_MSG (("MPFR_PREC_ARG: format for gmp_asprintf: \"%s\"\n",
+          prec_format (format, spec);
+          MPFR_LOG_MSG (("MPFR_PREC_ARG: format for gmp_printf: \"%s\"\n",
                          format));
           MPFR_LOG_MSG (("MPFR_PREC_ARG: width = %d, prec = %d, value = %"
                          MPFR_PREC_FORMAT_TYPE "d\n",
                          (int) spec.width, (int) spec.prec, prec));
-          length = gmp_asprintf (&s, format,
-                                 (int) spec.width, (int) spec.prec, prec);
+          length = buffer_printf (&buf, format,
+                                  (int) spec.width, (int) spec.prec, prec);
           MPFR_ASSERTN (length >= 0);  /* guaranteed by GMP 6 */
-          buffer_cat (&buf, s, length);
-          mpfr_free_str (s);
         }
       else if (spec.arg_type == MPFR_ARG)
         /* output a mpfr_t variable */
@@ -2552,17 +2745,11 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
 
   if (ptr != NULL)  /* implement mpfr_vasprintf */
     {
-      *ptr = (char *) mpfr_reallocate_func (buf.start, buf.size, nbchar + 1);
-    }
-  else if (size != 0)  /* implement mpfr_vsnprintf */
-    {
-      /* The size is limited to int (see above). */
-      int len = nbchar < size ? nbchar : size - 1;
-
-      memcpy (Buf, buf.start, len);
-      Buf[len] = '\0';
-      mpfr_free_func (buf.start, buf.size);
+      *ptr = buf.type == BUF_ALLOCATED ?
+        (char *) mpfr_reallocate_func (buf.start, buf.size, nbchar + 1) :
+        buf.start;
     }
+  /* For mpfr_vsnprintf, the output has been written to Buf. */
 
   MPFR_SAVE_EXPO_FREE (expo);
   return nbchar; /* return the number of characters that would have
@@ -2585,12 +2772,520 @@ mpfr_vasnprintf_aux (char **ptr, char *Buf, size_t size, const char *fmt,
   MPFR_SAVE_EXPO_FREE (expo);
   if (ptr != NULL)  /* implement mpfr_vasprintf */
     *ptr = NULL;
-  if (ptr != NULL || size != 0)
+  if (buf.type == BUF_ALLOCATED && buf.size != 0)
     mpfr_free_func (buf.start, buf.size);
 
   return -1;
 }
 
+/* Compiled format strings (mpfr_format_compile and mpfr_format_vapply).
+
+   The format string is parsed once and split into items: text without
+   conversion specifications, parts of the format string to be processed
+   by gmp_vsnprintf (FLUSH in mpfr_vasnprintf_aux), and the conversion
+   specifications for the mpfr_prec_t and mpfr_t types, with their parsed
+   printf_spec structure. A field width, a precision or a rounding mode
+   given by '*' is read from the va_list when the format is applied.
+   Everything is stored in a single memory block: the array of the items,
+   then the array of the native arguments of the FMT_GMP items, then the
+   strings (starting with a copy of the format string). */
+
+enum format_item_t
+  {
+    FMT_TEXT,   /* text, output as is */
+    FMT_GMP,    /* format string for gmp_vsnprintf */
+    FMT_NATIVE, /* simple %d, %i, %u, %c or %s (see native_simple_p) */
+    FMT_PREC,   /* mpfr_prec_t argument (MPFR_PREC_ARG) */
+    FMT_MPFR    /* mpfr_t argument (MPFR_ARG) */
+  };
+
+/* '*' fields of a FMT_PREC or FMT_MPFR item */
+#define STAR_WIDTH 1
+#define STAR_PREC  2
+#define STAR_RND   4
+
+/* Native argument of a FMT_GMP item, to be skipped in the va_list after
+   the call to gmp_vsnprintf: the fields used by CONSUME_VA_ARG and the
+   number of int arguments read by '*' before it. */
+struct format_arg
+{
+  enum arg_t arg_type;
+  char spec;
+  unsigned char stars;
+};
+
+struct format_item
+{
+  enum format_item_t type;
+  unsigned int stars;             /* FMT_PREC, FMT_MPFR: STAR_* flags */
+  const char *str;                /* FMT_TEXT: characters; FMT_GMP and
+                                     FMT_PREC: format for gmp_vsnprintf */
+  size_t len;                     /* FMT_TEXT: number of characters */
+  const struct format_arg *args;  /* FMT_GMP: native arguments */
+  size_t nargs;                   /* FMT_GMP: number of native arguments */
+  struct printf_spec spec;        /* FMT_NATIVE, FMT_PREC, FMT_MPFR */
+};
+
+/* Return non-zero iff the native conversion specification spec (without
+   '*') is simple enough to be output directly by native_output instead of
+   gmp_vsnprintf, which would need to parse it again for each call: %d, %i
+   and %u for int and long without precision and without the '#' and '\''
+   flags, and %c and %s without flags other than '-'. */
+static int
+native_simple_p (const struct printf_spec spec)
+{
+  if (spec.alt || spec.group)
+    return 0;
+  if (spec.spec == 'd' || spec.spec == 'i' || spec.spec == 'u')
+    return (spec.arg_type == NONE || spec.arg_type == LONG_ARG)
+      && spec.prec < 0;
+  if (spec.spec == 'c' || spec.spec == 's')
+    return spec.arg_type == NONE && spec.pad == ' '
+      && !spec.showsign && !spec.space && (spec.spec == 's' || spec.prec < 0);
+  return 0;
+}
+
+#define NATIVE_DIGITS (sizeof (unsigned long) * CHAR_BIT / 3 + 1)
+
+/* Output the len characters of str, preceded by the character sign if it
+   is not null, as specified by spec for a FMT_NATIVE item. Return non-zero
+   if overflow. */
+static int
+native_output (struct string_buffer *b, const struct printf_spec spec,
+               const char *str, size_t len, char sign)
+{
+  size_t total, pad;
+
+  total = len + (sign != '\0');
+  pad = (mpfr_uintmax_t) spec.width > total ? spec.width - total : 0;
+  if (b->size == 0)
+    return buffer_incr_len (b, total + pad);
+
+  if (pad != 0 && !spec.left && spec.pad == ' ')
+    buffer_pad (b, ' ', pad);
+  if (sign != '\0')
+    buffer_pad (b, sign, 1);
+  if (pad != 0 && !spec.left && spec.pad == '0')
+    buffer_pad (b, '0', pad);
+  buffer_cat (b, str, len);
+  if (pad != 0 && spec.left)
+    buffer_pad (b, ' ', pad);
+  return b->len == -1;
+}
+
+/* Add to *itp the item for the part of the format string from start to end
+   (not included), which contains native conversion specifications iff
+   gmp_flag is non-zero (otherwise, only text and "%%"), and whose native
+   arguments are args[0..nargs-1]. The strings are written to *strp. */
+static void
+format_flush (struct format_item **itp, const char *start, const char *end,
+              int gmp_flag, const struct format_arg *args, size_t nargs,
+              char **strp)
+{
+  struct format_item *it = *itp;
+  char *s = *strp;
+
+  if (start == end)
+    return;
+
+  it->str = s;
+  if (gmp_flag)
+    {
+      it->type = FMT_GMP;
+      memcpy (s, start, end - start);
+      s += end - start;
+      *s++ = '\0';
+      it->args = args;
+      it->nargs = nargs;
+    }
+  else
+    {
+      /* each '%' is the first character of "%%" */
+      it->type = FMT_TEXT;
+      while (start < end)
+        {
+          *s++ = *start;
+          start += *start == '%' ? 2 : 1;
+        }
+      it->len = s - it->str;
+    }
+  *strp = s;
+  *itp = it + 1;
+}
+
+/* Parse the format string fmt and store the result in f. Return 0 if the
+   format string has been compiled, and a non-zero value if it will be
+   interpreted by each call to mpfr_format_vapply, as by mpfr_vsnprintf
+   (this is the case with the 'n' conversion specifier and with invalid or
+   unsupported conversion specifications). */
+int
+mpfr_format_compile (mpfr_format_ptr f, const char *fmt)
+{
+  size_t len, m, maxitems, size;
+  const char *start, *end;
+  struct format_item *items, *it;
+  struct format_arg *args, *a, *args0;
+  char *str;
+  int gmp_flag;
+
+  /* at most m conversion specifications, thus at most 2m+1 items */
+  for (m = 0, len = 0; fmt[len] != '\0'; len++)
+    m += fmt[len] == '%';
+  maxitems = 2 * m + 1;
+  size = maxitems * sizeof (struct format_item)
+    + m * sizeof (struct format_arg)
+    + (len + 1) + (len + m + 1) + m * PREC_FORMAT_SIZE;
+
+  items = (struct format_item *) mpfr_allocate_func (size);
+  args = (struct format_arg *) (items + maxitems);
+  str = (char *) (args + m);
+  f->_mpfr_items = items;
+  f->_mpfr_fmt = str;
+  f->_mpfr_size = size;
+  memcpy (str, fmt, len + 1);
+  str += len + 1;
+
+  it = items;
+  a = args0 = args;
+  gmp_flag = 0;
+  start = fmt;
+  while (*fmt != '\0')
+    {
+      struct printf_spec spec;
+      unsigned int stars = 0;
+      int overflow = 0;
+
+      while (*fmt != '\0' && *fmt != '%')
+        ++fmt;
+
+      if (*fmt == '\0')
+        break;
+
+      if (*++fmt == '%')
+        {
+          ++fmt;
+          continue;
+        }
+
+      end = fmt - 1;
+
+      spec.alt = 0;
+      spec.space = 0;
+      spec.left = 0;
+      spec.showsign = 0;
+      spec.group = 0;
+      spec.width = 0;
+      spec.prec = 0;
+      spec.arg_type = NONE;
+      spec.rnd_mode = MPFR_RNDN;
+      spec.spec = '\0';
+      spec.pad = ' ';
+
+      fmt = parse_flags (fmt, &spec);
+
+      if (*fmt == '*')
+        {
+          ++fmt;
+          stars |= STAR_WIDTH;
+        }
+      else
+        READ_DIGITS (fmt, spec.width);
+
+      if (*fmt == '.')
+        {
+          ++fmt;
+          if (*fmt == '*')
+            {
+              ++fmt;
+              stars |= STAR_PREC;
+            }
+          else
+            READ_DIGITS (fmt, spec.prec);
+        }
+      else
+        spec.prec = -1;
+
+      fmt = parse_arg_type (fmt, &spec);
+      if (spec.arg_type == UNSUPPORTED)
+        goto interpreted;
+      else if (spec.arg_type == MPFR_ARG)
+        {
+          if (*fmt == '*')
+            {
+              ++fmt;
+              stars |= STAR_RND;
+            }
+          else
+            fmt = parse_rnd_mode (fmt, &spec);
+        }
+
+      spec.spec = *fmt;
+      /* In these cases, the output of mpfr_vasnprintf_aux (in particular
+         the length, for 'n') depends on the arguments. */
+      if (spec.spec == '\0' || spec.spec == 'n' || overflow
+          || specinfo_is_valid (spec) <= 0)
+        goto interpreted;
+      fmt++;
+
+      if (spec.arg_type == MPFR_ARG || spec.arg_type == MPFR_PREC_ARG)
+        {
+          if (spec.arg_type == MPFR_ARG
+              && spec.spec != 'a' && spec.spec != 'A'
+              && spec.spec != 'b'
+              && spec.spec != 'e' && spec.spec != 'E'
+              && spec.spec != 'f' && spec.spec != 'F'
+              && spec.spec != 'g' && spec.spec != 'G')
+            goto interpreted;
+
+          format_flush (&it, start, end, gmp_flag, args0, a - args0, &str);
+          gmp_flag = 0;
+          args0 = a;
+          start = fmt;
+
+          it->stars = stars;
+          it->spec = spec;
+          if (spec.arg_type == MPFR_ARG)
+            it->type = FMT_MPFR;
+          else
+            {
+              it->type = FMT_PREC;
+              prec_format (str, spec);
+              it->str = str;
+              str += strlen (str) + 1;
+            }
+          it++;
+        }
+      else if (stars == 0 && native_simple_p (spec))
+        {
+          format_flush (&it, start, end, gmp_flag, args0, a - args0, &str);
+          gmp_flag = 0;
+          args0 = a;
+          start = fmt;
+          it->type = FMT_NATIVE;
+          it->spec = spec;
+          it++;
+        }
+      else
+        {
+          a->arg_type = spec.arg_type;
+          a->spec = spec.spec;
+          a->stars = (stars & STAR_WIDTH) + ((stars & STAR_PREC) != 0);
+          a++;
+          gmp_flag = 1;
+        }
+    }
+
+  format_flush (&it, start, fmt, gmp_flag, args0, a - args0, &str);
+  MPFR_ASSERTN (it - items <= maxitems);
+  MPFR_ASSERTN (str <= (char *) items + size);
+  f->_mpfr_nitems = it - items;
+  f->_mpfr_compiled = 1;
+  return 0;
+
+ interpreted:
+  f->_mpfr_nitems = 0;
+  f->_mpfr_compiled = 0;
+  return 1;
+}
+
+void
+mpfr_format_clear (mpfr_format_ptr f)
+{
+  mpfr_free_func (f->_mpfr_items, f->_mpfr_size);
+}
+
+/* Same as mpfr_vsnprintf (Buf, size, fmt, ap), where fmt is the format
+   string compiled in f. */
+int
+mpfr_format_vapply (char *Buf, size_t size, mpfr_format_srcptr f,
+                    va_list ap)
+{
+  struct string_buffer buf;
+  const struct format_item *it, *last;
+  int nbchar;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  if (! f->_mpfr_compiled)
+    return mpfr_vasnprintf_aux (NULL, Buf, size, f->_mpfr_fmt, ap);
+
+  MPFR_LOG_FUNC
+    (("size=%zu", size),
+     ("nbchar=%d", nbchar));
+
+  MPFR_SAVE_EXPO_MARK (expo);
+
+  if (size != 0)
+    buffer_init_caller (&buf, Buf, size, BUF_FIXED);
+  else
+    buffer_init (&buf, 0);
+
+  it = (const struct format_item *) f->_mpfr_items;
+  for (last = it + f->_mpfr_nitems; it < last; it++)
+    {
+      if (it->type == FMT_TEXT)
+        buffer_cat (&buf, it->str, it->len);
+      else if (it->type == FMT_GMP)
+        {
+          va_list ap2;
+          size_t k;
+          int length, j;
+
+          va_copy (ap2, ap);
+          length = buffer_vprintf (&buf, it->str, ap2);
+          va_end (ap2);
+          if (length < 0)
+            goto error;
+          /* step forward in the va_list */
+          for (k = 0; k < it->nargs; k++)
+            {
+              for (j = 0; j < it->args[k].stars; j++)
+                (void) va_arg (ap, int);
+              CONSUME_VA_ARG (it->args[k], ap);
+            }
+        }
+      else if (it->type == FMT_NATIVE)
+        {
+          char digits[NATIVE_DIGITS], ch, sign = '\0';
+          const char *str;
+          size_t len;
+
+          if (it->spec.spec == 's')
+            {
+              str = va_arg (ap, const char *);
+              if (str == NULL)  /* undefined behavior, as with glibc */
+                str = "(null)";
+              if (it->spec.prec < 0)
+                len = strlen (str);
+              else
+                {
+                  const char *e =
+                    (const char *) memchr (str, '\0', it->spec.prec);
+                  len = e != NULL ? (size_t) (e - str)
+                    : (size_t) it->spec.prec;
+                }
+            }
+          else if (it->spec.spec == 'c')
+            {
+              ch = (char) va_arg (ap, int);
+              str = &ch;
+              len = 1;
+            }
+          else
+            {
+              unsigned long u;
+              char *d = digits + NATIVE_DIGITS;
+
+              if (it->spec.spec == 'u')
+                u = it->spec.arg_type == LONG_ARG ?
+                  va_arg (ap, unsigned long) : va_arg (ap, unsigned int);
+              else
+                {
+                  long l = it->spec.arg_type == LONG_ARG ?
+                    va_arg (ap, long) : va_arg (ap, int);
+
+                  /* the unsigned negation avoids an overflow for LONG_MIN */
+                  u = l < 0 ? - (unsigned long) l : (unsigned long) l;
+                  sign = l < 0 ? '-' : it->spec.showsign ? '+'
+                    : it->spec.space ? ' ' : '\0';
+                }
+              do
+                *--d = num_to_text[u % 10];
+              while ((u /= 10) != 0);
+              str = d;
+              len = digits + NATIVE_DIGITS - d;
+            }
+          native_output (&buf, it->spec, str, len, sign);
+        }
+      else
+        {
+          struct printf_spec spec = it->spec;
+          int overflow = 0;
+
+          spec.size = size != 0;
+          if (it->stars & STAR_WIDTH)
+            {
+              spec.width = va_arg (ap, int);
+              if (spec.width < 0)  /* as in mpfr_vasnprintf_aux */
+                {
+                  spec.left = 1;
+                  if (MPFR_UNLIKELY (INT_MIN < - MPFR_INTMAX_MAX &&
+                                     spec.width < - MPFR_INTMAX_MAX))
+                    overflow = 1;
+                  else
+                    spec.width = - spec.width;
+                }
+            }
+          if (it->stars & STAR_PREC)
+            {
+              spec.prec = va_arg (ap, int);
+              if (spec.prec < 0)
+                spec.prec = -1;
+            }
+
+          if (it->type == FMT_PREC)
+            {
+              char format[PREC_FORMAT_SIZE];
+              const char *fmt = it->str;
+              mpfr_prec_t prec;
+              int length;
+
+              prec = va_arg (ap, mpfr_prec_t);
+              if (overflow || spec.width > INT_MAX || spec.prec > INT_MAX)
+                {
+                  buf.len = -1;
+                  goto error;
+                }
+              if (spec.left != it->spec.left)  /* negative width by '*' */
+                {
+                  prec_format (format, spec);
+                  fmt = format;
+                }
+              length = buffer_printf (&buf, fmt,
+                                      (int) spec.width, (int) spec.prec,
+                                      prec);
+              MPFR_ASSERTN (length >= 0);  /* guaranteed by GMP 6 */
+            }
+          else
+            {
+              mpfr_srcptr p;
+
+              if (it->stars & STAR_RND)
+                spec.rnd_mode = (mpfr_rnd_t) va_arg (ap, int);
+              p = va_arg (ap, mpfr_srcptr);
+              if (overflow)
+                {
+                  buf.len = -1;
+                  goto error;
+                }
+              sprnt_fp (&buf, p, spec);
+            }
+        }
+    }
+
+  if (buf.len == -1 || buf.len > INT_MAX)  /* overflow */
+    goto overflow;
+
+  nbchar = buf.len;
+  MPFR_ASSERTD (nbchar >= 0);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return nbchar;
+
+ error:
+  if (buf.len == -1)  /* overflow */
+    {
+    overflow:
+      MPFR_LOG_MSG (("Overflow\n", 0));
+      MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, MPFR_FLAGS_ERANGE);
+#ifdef EOVERFLOW
+      MPFR_LOG_MSG (("Setting errno to EOVERFLOW\n", 0));
+      errno = EOVERFLOW;
+#endif
+    }
+
+  MPFR_SAVE_EXPO_FREE (expo);
+  return -1;
+}
+
 #else /* HAVE_STDARG */
 
 /* Avoid an empty translation unit (see ISO C99, 6.9) */
@@ -0,0 +1,191 @@
+/* mpfr_exp_vec, mpfr_log_vec, mpfr_sin_vec, mpfr_cos_vec, mpfr_sin_cos_vec
+   -- elementary functions on arrays
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* These functions set y[i] to f(x[i]) for 0 <= i < n, where the y[i] may
+   have different precisions, and t[i] to the corresponding ternary value
+   if t is not NULL. The return value is 0 if all the results are exact,
+   non-zero otherwise.
+
+   The exponent range is extended once for the whole array, each result
+   being checked in the saved exponent range just after its computation,
+   so that y[i] may be the same variable as x[i] (but not as x[j] for
+   j <> i). In small precision, for regular inputs, the table-driven
+   kernels of fixed_kernels.c are called directly, without the tests of
+   the special cases, the overflow and underflow detection and the saving
+   of the exponent range done by each call to the elementary function,
+   which is only called when the kernel cannot round. Since the same
+   functions are called otherwise, the algorithms and thresholds (from
+   mparam.h) are the same as for a loop on the scalar functions. */
+
+/* Kernel for the fast path: sets y to f(x) and returns the ternary value,
+   or returns 0 if it cannot round (f(x) is never exact in that case) */
+typedef int (*mpfr_vec_kernel_t) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+#ifdef MPFR_FIXED_MAXPREC
+
+static int
+exp_kernel (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  return MPFR_IS_SINGULAR (x) || MPFR_PREC (y) > MPFR_FIXED_MAXPREC ? 0
+    : mpfr_exp_fixed (y, x, rnd_mode);
+}
+
+static int
+log_kernel (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  /* x must be positive, and different from 1 */
+  return MPFR_IS_SINGULAR (x) || MPFR_IS_NEG (x) ||
+    MPFR_PREC (y) > MPFR_FIXED_MAXPREC ||
+    (MPFR_GET_EXP (x) == 1 && mpfr_powerof2_raw (x)) ? 0
+    : mpfr_log_fixed (y, x, rnd_mode);
+}
+
+static int
+sin_kernel (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  int inex;
+
+  if (MPFR_IS_SINGULAR (x) || MPFR_PREC (y) > MPFR_FIXED_MAXPREC)
+    return 0;
+  inex = mpfr_sincos_fixed (y, NULL, x, rnd_mode);
+  return inex == 0 ? 0 : inex == 2 ? -1 : 1;
+}
+
+static int
+cos_kernel (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  int inex;
+
+  if (MPFR_IS_SINGULAR (x) || MPFR_PREC (y) > MPFR_FIXED_MAXPREC)
+    return 0;
+  inex = mpfr_sincos_fixed (NULL, y, x, rnd_mode);
+  return inex == 0 ? 0 : (inex >> 2) == 2 ? -1 : 1;
+}
+
+#else
+
+# define exp_kernel NULL
+# define log_kernel NULL
+# define sin_kernel NULL
+# define cos_kernel NULL
+
+#endif
+
+static int
+vec_eval (int *t, const mpfr_ptr *y, const mpfr_ptr *x, unsigned long n,
+          mpfr_rnd_t rnd_mode, int (*f) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t),
+          mpfr_vec_kernel_t kernel)
+{
+  unsigned long i;
+  int inex, res = 0;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  for (i = 0; i < n; i++)
+    {
+      inex = kernel != NULL ? kernel (y[i], x[i], rnd_mode) : 0;
+      if (inex == 0)
+        inex = f (y[i], x[i], rnd_mode);
+      /* check the result in the saved exponent range, then extend it
+         again (the flags are merged at the end) */
+      __gmpfr_emin = expo.saved_emin;
+      __gmpfr_emax = expo.saved_emax;
+      inex = mpfr_check_range (y[i], inex, rnd_mode);
+      __gmpfr_emin = MPFR_EMIN_MIN;
+      __gmpfr_emax = MPFR_EMAX_MAX;
+      if (t != NULL)
+        t[i] = inex;
+      res |= inex;
+    }
+  MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return res;
+}
+
+int
+mpfr_exp_vec (int *t, const mpfr_ptr *y, const mpfr_ptr *x, unsigned long n,
+              mpfr_rnd_t rnd_mode)
+{
+  return vec_eval (t, y, x, n, rnd_mode, mpfr_exp, exp_kernel);
+}
+
+int
+mpfr_log_vec (int *t, const mpfr_ptr *y, const mpfr_ptr *x, unsigned long n,
+              mpfr_rnd_t rnd_mode)
+{
+  return vec_eval (t, y, x, n, rnd_mode, mpfr_log, log_kernel);
+}
+
+int
+mpfr_sin_vec (int *t, const mpfr_ptr *y, const mpfr_ptr *x, unsigned long n,
+              mpfr_rnd_t rnd_mode)
+{
+  return vec_eval (t, y, x, n, rnd_mode, mpfr_sin, sin_kernel);
+}
+
+int
+mpfr_cos_vec (int *t, const mpfr_ptr *y, const mpfr_ptr *x, unsigned long n,
+              mpfr_rnd_t rnd_mode)
+{
+  return vec_eval (t, y, x, n, rnd_mode, mpfr_cos, cos_kernel);
+}
+
+/* s[i] = sin(x[i]) and c[i] = cos(x[i]); t[i] is the value that
+   mpfr_sin_cos would return, i.e., INEX(inexs, inexc) */
+int
+mpfr_sin_cos_vec (int *t, const mpfr_ptr *s, const mpfr_ptr *c,
+                  const mpfr_ptr *x, unsigned long n, mpfr_rnd_t rnd_mode)
+{
+  unsigned long i;
+  int inex, inexs, inexc, res = 0;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  for (i = 0; i < n; i++)
+    {
+      inex = 0;
+#ifdef MPFR_FIXED_MAXPREC
+      if (! MPFR_IS_SINGULAR (x[i]) && MPFR_PREC (s[i]) <= MPFR_FIXED_MAXPREC
+          && MPFR_PREC (c[i]) <= MPFR_FIXED_MAXPREC)
+        inex = mpfr_sincos_fixed (s[i], c[i], x[i], rnd_mode);
+#endif
+      if (inex == 0)
+        inex = mpfr_sin_cos (s[i], c[i], x[i], rnd_mode);
+      inexs = (inex & 3) == 2 ? -1 : (inex & 3) != 0;
+      inexc = (inex >> 2) == 2 ? -1 : (inex >> 2) != 0;
+      __gmpfr_emin = expo.saved_emin;
+      __gmpfr_emax = expo.saved_emax;
+      inexs = mpfr_check_range (s[i], inexs, rnd_mode);
+      inexc = mpfr_check_range (c[i], inexc, rnd_mode);
+      __gmpfr_emin = MPFR_EMIN_MIN;
+      __gmpfr_emax = MPFR_EMAX_MAX;
+      inex = INEX (inexs, inexc);
+      if (t != NULL)
+        t[i] = inex;
+      res |= inex;
+    }
+  MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return res;
+}
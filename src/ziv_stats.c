@@ -0,0 +1,118 @@
+/* Statistics of the Ziv loops and adaptive initial precision.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The statistics are stored in static thread-local variables of the
+   functions (see MPFR_ZIV_DECL in mpfr-impl.h), linked in the list below
+   at their first use in the thread. Nothing is allocated. With logging,
+   the Ziv loops have their own statistics and are not registered. */
+#ifndef MPFR_USE_LOGGING
+static MPFR_THREAD_ATTR mpfr_ziv_stat_t *ziv_stats = NULL;
+#endif
+static MPFR_THREAD_ATTR int ziv_adapt = 0;
+
+void
+mpfr_set_ziv_adapt (int a)
+{
+#ifndef MPFR_USE_LOGGING
+  mpfr_ziv_stat_t *s;
+
+  if (a == 0)
+    for (s = ziv_stats; s != NULL; s = s->next)
+      s->extra = 0;
+#endif
+  ziv_adapt = a != 0;
+}
+
+int
+mpfr_get_ziv_adapt (void)
+{
+  return ziv_adapt;
+}
+
+/* Return the name of the i-th registered Ziv loop of the current thread
+   and set *calls and *fails to its statistics (if not NULL), or return
+   NULL if there are at most i registered loops. */
+const char *
+mpfr_get_ziv_stats (unsigned long i, unsigned long *calls,
+                    unsigned long *fails)
+{
+#ifndef MPFR_USE_LOGGING
+  mpfr_ziv_stat_t *s;
+
+  for (s = ziv_stats; s != NULL; s = s->next, i--)
+    if (i == 0)
+      {
+        if (calls != NULL)
+          *calls = s->calls;
+        if (fails != NULL)
+          *fails = s->fails;
+        return s->name;
+      }
+#endif
+  return NULL;
+}
+
+void
+mpfr_reset_ziv_stats (void)
+{
+#ifndef MPFR_USE_LOGGING
+  mpfr_ziv_stat_t *s;
+
+  for (s = ziv_stats; s != NULL; s = s->next)
+    {
+      s->calls = s->fails = 0;
+      s->wleft = MPFR_ZIV_WINDOW;
+      s->wfails = 0;
+      s->extra = 0;
+    }
+#endif
+}
+
+#ifndef MPFR_USE_LOGGING
+
+/* Called by MPFR_ZIV_INIT at the first loop in the thread, and then
+   every MPFR_ZIV_WINDOW loops. In the adaptive mode, if at least 1/8 of
+   the first attempts of the last window failed, the initial precision is
+   increased by one limb (as done by the first MPFR_ZIV_NEXT), up to
+   MPFR_ZIV_MAX_EXTRA bits; if none failed, the extra precision is halved,
+   so that it goes back to 0 when the hard inputs are gone. */
+void
+mpfr_ziv_update (mpfr_ziv_stat_t *s)
+{
+  if (! s->registered)
+    {
+      s->next = ziv_stats;
+      ziv_stats = s;
+      s->registered = 1;
+    }
+  else if (! ziv_adapt)
+    s->extra = 0;
+  else if (s->wfails >= MPFR_ZIV_WINDOW / 8)
+    s->extra = MIN (s->extra + GMP_NUMB_BITS, MPFR_ZIV_MAX_EXTRA);
+  else if (s->wfails == 0)
+    s->extra /= 2;
+  s->wleft = MPFR_ZIV_WINDOW;
+  s->wfails = 0;
+}
+
+#endif
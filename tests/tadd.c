@@ -1319,6 +1319,97 @@ test_rndf_exact (mp_size_t pmax)
     }
 }
 
+/* Check mpfr_add and mpfr_sub when the precisions are at most 2 limbs but
+   differ (special code in addsub_mixed.c), by comparing with the same
+   operation done on copies of b and c with 3 limbs (generic code). */
+static void
+check_mixed_le2 (void)
+{
+  mpfr_t a, a2, b, b3, c, c3;
+  mpfr_exp_t emin, emax;
+  mpfr_flags_t flags1, flags2;
+  int i, k, inex1, inex2, sub;
+  mpfr_rnd_t rnd;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  mpfr_inits2 (3 * GMP_NUMB_BITS + 1, b3, c3, (mpfr_ptr) 0);
+  mpfr_inits2 (MPFR_PREC_MIN, a, a2, b, c, (mpfr_ptr) 0);
+
+  for (i = 0; i < 20000; i++)
+    {
+      mpfr_set_prec (a, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_set_prec (a2, MPFR_GET_PREC (a));
+      mpfr_set_prec (b, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_set_prec (c, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_urandomb (b, RANDS);
+      k = randlimb () % 4;
+      if (k == 0)
+        mpfr_set (c, b, MPFR_RNDN); /* possible exact cancellation */
+      else if (k == 1)
+        {
+          mpfr_set (c, b, MPFR_RNDN);
+          mpfr_nextabove (c); /* partial cancellation */
+        }
+      else
+        mpfr_urandomb (c, RANDS);
+      if (randlimb () & 1)
+        mpfr_neg (b, b, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (c, c, MPFR_RNDN);
+      if (MPFR_IS_ZERO (b) || MPFR_IS_ZERO (c))
+        continue;
+      mpfr_set_exp (b, (mpfr_exp_t) (randlimb () % 9) - 4);
+      if (k >= 2)
+        mpfr_set_exp (c, (mpfr_exp_t) (randlimb () % (4 * GMP_NUMB_BITS))
+                      - 2 * GMP_NUMB_BITS);
+      /* sometimes test near the bounds of the exponent range */
+      k = randlimb () % 8;
+      if (k == 0)
+        set_emax (MPFR_GET_EXP (b) > MPFR_GET_EXP (c) ?
+                  MPFR_GET_EXP (b) : MPFR_GET_EXP (c));
+      else if (k == 1)
+        set_emin (MPFR_GET_EXP (b) < MPFR_GET_EXP (c) ?
+                  MPFR_GET_EXP (b) - 1 : MPFR_GET_EXP (c) - 1);
+      mpfr_set (b3, b, MPFR_RNDN);
+      mpfr_set (c3, c, MPFR_RNDN);
+      rnd = RND_RAND_NO_RNDF ();
+      for (sub = 0; sub < 2; sub++)
+        {
+          mpfr_clear_flags ();
+          inex1 = sub ? mpfr_sub (a, b, c, rnd) : mpfr_add (a, b, c, rnd);
+          flags1 = __gmpfr_flags;
+          mpfr_clear_flags ();
+          inex2 = sub ? mpfr_sub (a2, b3, c3, rnd)
+            : mpfr_add (a2, b3, c3, rnd);
+          flags2 = __gmpfr_flags;
+          if (! SAME_VAL (a, a2) || VSIGN (inex1) != VSIGN (inex2)
+              || flags1 != flags2)
+            {
+              printf ("Error in check_mixed_le2 for mpfr_%s, %s\n",
+                      sub ? "sub" : "add", mpfr_print_rnd_mode (rnd));
+              printf ("b = ");
+              mpfr_dump (b);
+              printf ("c = ");
+              mpfr_dump (c);
+              printf ("expected ");
+              mpfr_dump (a2);
+              printf ("got      ");
+              mpfr_dump (a);
+              printf ("expected inex = %d, flags =", inex2);
+              flags_out (flags2);
+              printf ("got      inex = %d, flags =", inex1);
+              flags_out (flags1);
+              exit (1);
+            }
+        }
+      set_emin (emin);
+      set_emax (emax);
+    }
+
+  mpfr_clears (a, a2, b, b3, c, c3, (mpfr_ptr) 0);
+}
+
 #define TEST_FUNCTION test_add
 #define TWO_ARGS
 #define RAND_FUNCTION(x) mpfr_random2(x, MPFR_LIMB_SIZE (x), randlimb () % 100, RANDS)
@@ -1340,6 +1431,7 @@ main (int argc, char *argv[])
   test_rndf_exact (200);
   testall_rndf (7);
   check_extreme ();
+  check_mixed_le2 ();
 
   test_generic (MPFR_PREC_MIN, 1000, 100);
 
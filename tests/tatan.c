@@ -613,6 +613,55 @@ reduced_expo_range (void)
   mpfr_clears (x, y, ex_y, (mpfr_ptr) 0);
 }
 
+/* Compare the results of the table-based algorithm, used below
+   MPFR_ATAN_TABLE_THRESHOLD, with those of the general algorithm,
+   including precisions where the cached table has to be extended. */
+static void
+check_table (void)
+{
+  mpfr_t x, y, z, t;
+  mpfr_prec_t p, q;
+  mpfr_rnd_t rnd;
+  int i, inex1, inex2;
+
+  q = MPFR_ATAN_TABLE_THRESHOLD + 64;
+  mpfr_inits2 (q, x, y, z, t, (mpfr_ptr) 0);
+  for (i = 0; i < 200; i++)
+    {
+      if (i == 100)
+        mpfr_free_cache ();
+      p = MPFR_PREC_MIN + randlimb () % (i < 150 ? 256 :
+                                         MPFR_ATAN_TABLE_THRESHOLD);
+      rnd = RND_RAND_NO_RNDF ();
+      mpfr_set_prec (x, MPFR_PREC_MIN + randlimb () % 1000);
+      mpfr_urandomb (x, RANDS);
+      if (MPFR_IS_ZERO (x))
+        continue;
+      mpfr_mul_2si (x, x, (long) (randlimb () % 100) - 50, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      mpfr_set_prec (y, p);
+      mpfr_set_prec (t, p);
+      inex1 = mpfr_atan (y, x, rnd);
+      mpfr_atan (z, x, MPFR_RNDN);
+      if (! mpfr_can_round (z, q - 1, MPFR_RNDN, MPFR_RNDZ,
+                            p + (rnd == MPFR_RNDN)))
+        continue;
+      inex2 = mpfr_set (t, z, rnd);
+      if (! mpfr_equal_p (y, t) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in check_table for p=%lu, rnd=%s\n",
+                  (unsigned long) p, mpfr_print_rnd_mode (rnd));
+          printf ("x = "); mpfr_dump (x);
+          printf ("expected "); mpfr_dump (t);
+          printf ("got      "); mpfr_dump (y);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+    }
+  mpfr_clears (x, y, z, t, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -625,6 +674,7 @@ main (int argc, char *argv[])
   atan2_bug_20071003 ();
   atan2_different_prec ();
   reduced_expo_range ();
+  check_table ();
 
   test_generic_atan  (MPFR_PREC_MIN, 200, 17);
   test_generic_atan2 (MPFR_PREC_MIN, 200, 17);
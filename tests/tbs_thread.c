@@ -0,0 +1,140 @@
+/* Test file for the parallel binary splitting.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static void
+check_settings (void)
+{
+  int r;
+
+  MPFR_ASSERTN (mpfr_get_bs_threads () == 1);
+  MPFR_ASSERTN (mpfr_set_bs_threads (0) != 0);
+  MPFR_ASSERTN (mpfr_get_bs_threads () == 1);
+  r = mpfr_set_bs_threads (4);
+  MPFR_ASSERTN (mpfr_get_bs_threads () == (r == 0 ? 4 : 1));
+  MPFR_ASSERTN (mpfr_set_bs_threads (1) == 0);
+  MPFR_ASSERTN (mpfr_get_bs_threads () == 1);
+
+  mpfr_set_bs_min_terms (17);
+  MPFR_ASSERTN (mpfr_get_bs_min_terms () == 17);
+}
+
+/* Compare the results of the binary splitting algorithms computed with
+   one thread and with nthreads threads, where each subtree is large enough
+   to be computed by another thread. */
+static void
+check_results (unsigned long nthreads)
+{
+  mpfr_t x, y1, y2, c1, c2;
+  mpfr_prec_t p;
+  mpfr_rnd_t rnd;
+  unsigned long min_terms;
+  int k, inex1, inex2;
+
+  min_terms = mpfr_get_bs_min_terms ();
+  mpfr_set_bs_min_terms (1);
+  p = 1000 + randlimb () % 4000;
+  mpfr_inits2 (p, x, y1, y2, c1, c2, (mpfr_ptr) 0);
+  rnd = RND_RAND_NO_RNDF ();
+
+  for (k = 0; k < 4; k++)
+    {
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2ui (x, x, 1, MPFR_RNDN);
+      if (mpfr_zero_p (x))
+        mpfr_set_ui (x, 1, MPFR_RNDN);
+
+      MPFR_ASSERTN (mpfr_set_bs_threads (1) == 0);
+      switch (k)
+        {
+        case 0:
+          inex1 = mpfr_const_euler_internal (y1, rnd);
+          break;
+        case 1:
+          inex1 = mpfr_const_catalan_internal (y1, rnd);
+          break;
+        case 2:
+          inex1 = mpfr_exp_3 (y1, x, rnd);
+          break;
+        default:
+          inex1 = mpfr_sincos_fast (y1, c1, x, rnd);
+        }
+
+      if (mpfr_set_bs_threads (nthreads) != 0)
+        break;  /* not supported */
+      switch (k)
+        {
+        case 0:
+          inex2 = mpfr_const_euler_internal (y2, rnd);
+          break;
+        case 1:
+          inex2 = mpfr_const_catalan_internal (y2, rnd);
+          break;
+        case 2:
+          inex2 = mpfr_exp_3 (y2, x, rnd);
+          break;
+        default:
+          inex2 = mpfr_sincos_fast (y2, c2, x, rnd);
+        }
+
+      if (! mpfr_equal_p (y1, y2) || inex1 != inex2 ||
+          (k == 3 && ! mpfr_equal_p (c1, c2)))
+        {
+          printf ("Error in check_results for k=%d, nthreads=%lu, p=%lu, "
+                  "rnd=%s\n", k, nthreads, (unsigned long) p,
+                  mpfr_print_rnd_mode (rnd));
+          printf ("x = "); mpfr_dump (x);
+          printf ("expected "); mpfr_dump (y1);
+          printf ("got      "); mpfr_dump (y2);
+          if (k == 3)
+            {
+              printf ("expected "); mpfr_dump (c1);
+              printf ("got      "); mpfr_dump (c2);
+            }
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+    }
+
+  MPFR_ASSERTN (mpfr_set_bs_threads (1) == 0);
+  mpfr_set_bs_min_terms (min_terms);
+  mpfr_clears (x, y1, y2, c1, c2, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  unsigned long min_terms;
+
+  tests_start_mpfr ();
+
+  min_terms = mpfr_get_bs_min_terms ();
+  check_settings ();
+  mpfr_set_bs_min_terms (min_terms);
+
+  check_results (2);
+  check_results (3);
+  check_results (8);
+
+  tests_end_mpfr ();
+  return 0;
+}
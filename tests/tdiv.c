@@ -1830,6 +1830,155 @@ coverage2 (void)
   mpfr_clear (w);
 }
 
+/* Check mpfr_div_newton against the classical division (the Newton step
+   is not used by mpfr_div for these precisions with the default threshold).
+   It may fail (return 0), but not too often, and must fail when the
+   quotient is exact. */
+static void
+check_newton (int n)
+{
+  mpfr_t u, v, q1, q2;
+  mpfr_prec_t p;
+  mpfr_rnd_t rnd;
+  int i, inex1, inex2, nfail = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      p = MPFR_NEWTON_PREC_MIN + randlimb () % 5000;
+      mpfr_inits2 (p, q1, q2, (mpfr_ptr) 0);
+      mpfr_init2 (u, p + (randlimb () % 256) - 128);
+      mpfr_init2 (v, p + (randlimb () % 256) - 128);
+      mpfr_urandomb (u, RANDS);
+      mpfr_urandomb (v, RANDS);
+      if (mpfr_zero_p (u) || mpfr_zero_p (v))
+        goto next;
+      if (RAND_BOOL ())
+        mpfr_neg (u, u, MPFR_RNDN);
+      if (RAND_BOOL ())
+        mpfr_neg (v, v, MPFR_RNDN);
+      mpfr_mul_2si (u, u, (long) (randlimb () % 64) - 32, MPFR_RNDN);
+      rnd = RND_RAND_NO_RNDF ();
+      inex1 = mpfr_div (q1, u, v, rnd);
+      inex2 = mpfr_div_newton (q2, u, v, rnd);
+      if (inex2 == 0)
+        nfail++;
+      else if (! mpfr_equal_p (q1, q2) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in mpfr_div_newton for p=%lu, rnd=%s\n",
+                  (unsigned long) p, mpfr_print_rnd_mode (rnd));
+          printf ("u = ");
+          mpfr_dump (u);
+          printf ("v = ");
+          mpfr_dump (v);
+          printf ("expected ");
+          mpfr_dump (q1);
+          printf ("got      ");
+          mpfr_dump (q2);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+
+      /* exact quotient: u = v*q1 (exact product), thus u/v = q1 */
+      mpfr_set_prec (u, mpfr_get_prec (v) + p);
+      inex1 = mpfr_mul (u, v, q1, MPFR_RNDN);
+      MPFR_ASSERTN (inex1 == 0);
+      inex2 = mpfr_div_newton (q2, u, v, rnd);
+      MPFR_ASSERTN (inex2 == 0);
+    next:
+      mpfr_clears (u, v, q1, q2, (mpfr_ptr) 0);
+    }
+
+  if (nfail > n / 10)
+    {
+      printf ("mpfr_div_newton failed %d times out of %d\n", nfail, n);
+      exit (1);
+    }
+}
+
+/* Check that mpfr_div_by_precomp gives the same results (value, ternary
+   value and flags) as mpfr_div, for n random divisors of precision up to
+   pmax, each one used for several quotients. */
+static void
+check_precomp (int n, mpfr_prec_t pmax)
+{
+  mpfr_t u, v, q1, q2;
+  mpfr_divisor_t d;
+  mpfr_prec_t p;
+  mpfr_rnd_t rnd;
+  mpfr_flags_t flags1, flags2;
+  int i, j, inex1, inex2;
+
+  for (i = 0; i < n; i++)
+    {
+      p = MPFR_PREC_MIN + randlimb () % pmax;
+      mpfr_init2 (v, p);
+      mpfr_urandomb (v, RANDS);
+      if (i % 16 == 15) /* singular divisors */
+        switch ((i / 16) % 3)
+          {
+          case 0:
+            mpfr_set_nan (v);
+            break;
+          case 1:
+            mpfr_set_zero (v, 1);
+            break;
+          default:
+            mpfr_set_inf (v, 1);
+          }
+      if (RAND_BOOL ())
+        mpfr_neg (v, v, MPFR_RNDN);
+      mpfr_divisor_init (d, v);
+
+      for (j = 0; j < 8; j++)
+        {
+          /* for the special code, the precisions must be the same */
+          mpfr_init2 (u, RAND_BOOL () ? p
+                      : MPFR_PREC_MIN + randlimb () % pmax);
+          mpfr_inits2 (j < 4 ? p : MPFR_PREC_MIN + randlimb () % pmax,
+                       q1, q2, (mpfr_ptr) 0);
+          if (j == 0)
+            mpfr_set_zero (u, 1);
+          else
+            mpfr_urandomb (u, RANDS);
+          if (RAND_BOOL ())
+            mpfr_neg (u, u, MPFR_RNDN);
+          if (j == 7)
+            mpfr_mul_2si (u, u, RAND_BOOL () ? mpfr_get_emax ()
+                          : mpfr_get_emin (), MPFR_RNDN);
+          rnd = RND_RAND_NO_RNDF ();
+
+          mpfr_clear_flags ();
+          inex1 = mpfr_div (q1, u, v, rnd);
+          flags1 = __gmpfr_flags;
+          mpfr_clear_flags ();
+          inex2 = mpfr_div_by_precomp (q2, u, d, rnd);
+          flags2 = __gmpfr_flags;
+          if (! SAME_VAL (q1, q2) || ! SAME_SIGN (inex1, inex2) ||
+              flags1 != flags2)
+            {
+              printf ("Error in mpfr_div_by_precomp for rnd=%s\n",
+                      mpfr_print_rnd_mode (rnd));
+              printf ("u = ");
+              mpfr_dump (u);
+              printf ("v = ");
+              mpfr_dump (v);
+              printf ("expected ");
+              mpfr_dump (q1);
+              printf ("got      ");
+              mpfr_dump (q2);
+              printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+              printf ("flags1 = %u, flags2 = %u\n",
+                      (unsigned int) flags1, (unsigned int) flags2);
+              exit (1);
+            }
+          mpfr_clears (u, q1, q2, (mpfr_ptr) 0);
+        }
+
+      mpfr_divisor_clear (d);
+      mpfr_clear (v);
+    }
+}
+
 /* perform K random tests of mpfr_divhigh_n_basecase for up to N limbs */
 static void
 check_divhigh_basecase (mpfr_prec_t N, int K)
@@ -1899,6 +2048,9 @@ main (int argc, char *argv[])
   bug20240506 ();
   bug20240423 ();
   check_divhigh_basecase (100, 1000);
+  check_newton (200);
+  check_precomp (1000, 256);
+  check_precomp (20, 60000);
   coverage (1024);
   coverage2 ();
   bug20180126 ();
@@ -991,6 +991,70 @@ bug20171223 (void)
   mpfr_clear (y);
 }
 
+#ifdef MPFR_FIXED_MAXPREC
+/* Check the table-driven kernel used up to MPFR_FIXED_MAXPREC bits against
+   the general algorithm, for random arguments and arguments close to
+   k*log(2) + j/2^8, i.e., close to the boundaries of the tables. */
+static void
+check_fixed (void)
+{
+  mpfr_prec_t p, p2 = 2 * MPFR_FIXED_MAXPREC + 64;
+  mpfr_t x, y, z, t;
+  int i, inex1, inex2;
+  mpfr_rnd_t rnd;
+
+  mpfr_init2 (t, p2);
+  for (p = MPFR_PREC_MIN; p <= MPFR_FIXED_MAXPREC; p++)
+    {
+      mpfr_inits2 (p, y, z, (mpfr_ptr) 0);
+      mpfr_init2 (x, MPFR_PREC_MIN + (randlimb () % (2 * p)));
+      for (i = 0; i < 20; i++)
+        {
+          if (i < 10)
+            {
+              /* 2^(e-1) <= |x| < 2^e with -20 <= e <= 30 */
+              mpfr_urandomb (x, RANDS);
+              if (mpfr_zero_p (x))
+                continue;
+              mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % 51) - 20);
+            }
+          else
+            {
+              mpfr_const_log2 (t, MPFR_RNDN);
+              mpfr_mul_ui (t, t, randlimb () % 1000, MPFR_RNDN);
+              mpfr_add_ui (t, t, randlimb () % 178, MPFR_RNDN);
+              mpfr_div_2ui (t, t, 8, MPFR_RNDN);
+              mpfr_set (x, t, MPFR_RNDN);
+              if (randlimb () & 1)
+                mpfr_nextabove (x);
+              if (mpfr_zero_p (x))
+                continue;
+            }
+          if (randlimb () & 1)
+            mpfr_neg (x, x, MPFR_RNDN);
+          rnd = RND_RAND_NO_RNDF ();
+          inex1 = mpfr_exp (y, x, rnd);
+          mpfr_exp (t, x, MPFR_RNDN);
+          if (! mpfr_can_round (t, p2 - 1, MPFR_RNDN, MPFR_RNDZ,
+                                p + (rnd == MPFR_RNDN)))
+            continue;
+          inex2 = mpfr_set (z, t, rnd);
+          if (! mpfr_equal_p (y, z) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_fixed for prec=%lu, rnd=%s\nx=",
+                      (unsigned long) p, mpfr_print_rnd_mode (rnd));
+              mpfr_dump (x);
+              printf ("expected "); mpfr_dump (z);
+              printf ("got      "); mpfr_dump (y);
+              exit (1);
+            }
+        }
+      mpfr_clears (x, y, z, (mpfr_ptr) 0);
+    }
+  mpfr_clear (t);
+}
+#endif
+
 int
 main (int argc, char *argv[])
 {
@@ -1007,6 +1071,9 @@ main (int argc, char *argv[])
   test_generic (MPFR_PREC_MIN, 100, 100);
 
   compare_exp2_exp3 (20, 1000);
+#ifdef MPFR_FIXED_MAXPREC
+  check_fixed ();
+#endif
   check_worst_cases();
   check3("0.0", MPFR_RNDU, "1.0");
   check3("-1e-170", MPFR_RNDU, "1.0");
@@ -0,0 +1,157 @@
+/* Test file for mpfr_exp_expm1.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include "mpfr-test.h"
+
+/* Check mpfr_exp_expm1 against mpfr_exp and mpfr_expm1 (values, ternary
+   values and flags) on x, with output precisions py and pz. If alias is 1
+   (resp. 2), the first (resp. second) output is x itself (thus has the
+   precision of x). */
+static void
+check (mpfr_srcptr x, mpfr_prec_t py, mpfr_prec_t pz, mpfr_rnd_t rnd,
+       int alias)
+{
+  mpfr_t y1, z1, y2, z2;
+  int inex1, inex2, inex_y, inex_z;
+  mpfr_flags_t flags1, flags2;
+
+  if (alias == 1)
+    py = MPFR_PREC (x);
+  else if (alias == 2)
+    pz = MPFR_PREC (x);
+  mpfr_inits2 (py, y1, y2, (mpfr_ptr) 0);
+  mpfr_inits2 (pz, z1, z2, (mpfr_ptr) 0);
+
+  mpfr_clear_flags ();
+  inex_y = mpfr_exp (y1, x, rnd);
+  inex_z = mpfr_expm1 (z1, x, rnd);
+  inex1 = INEX (inex_y, inex_z);
+  flags1 = __gmpfr_flags;
+
+  if (alias == 1)
+    {
+      mpfr_set (y2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_exp_expm1 (y2, z2, y2, rnd);
+      flags2 = __gmpfr_flags;
+    }
+  else if (alias == 2)
+    {
+      mpfr_set (z2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_exp_expm1 (y2, z2, z2, rnd);
+      flags2 = __gmpfr_flags;
+    }
+  else
+    {
+      mpfr_clear_flags ();
+      inex2 = mpfr_exp_expm1 (y2, z2, x, rnd);
+      flags2 = __gmpfr_flags;
+    }
+
+  if (! (SAME_VAL (y1, y2) && SAME_VAL (z1, z2) && inex1 == inex2 &&
+         flags1 == flags2))
+    {
+      printf ("Error in mpfr_exp_expm1 for rnd=%s, alias=%d, x=\n",
+              mpfr_print_rnd_mode (rnd), alias);
+      mpfr_dump (x);
+      printf ("expected exp   "); mpfr_dump (y1);
+      printf ("got            "); mpfr_dump (y2);
+      printf ("expected expm1 "); mpfr_dump (z1);
+      printf ("got            "); mpfr_dump (z2);
+      printf ("expected inex = %d, flags =", inex1);
+      flags_out (flags1);
+      printf ("got      inex = %d, flags =", inex2);
+      flags_out (flags2);
+      exit (1);
+    }
+
+  mpfr_clears (y1, z1, y2, z2, (mpfr_ptr) 0);
+}
+
+static void
+check_special (void)
+{
+  mpfr_t x;
+  int rnd;
+
+  mpfr_init2 (x, 17);
+  RND_LOOP_NO_RNDF (rnd)
+    {
+      mpfr_set_nan (x);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_inf (x, 1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_inf (x, -1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_zero (x, 1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 1);
+      mpfr_set_zero (x, -1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 2);
+      /* overflow, and exp(x) underflows while expm1(x) rounds to -1 */
+      mpfr_set_ui_2exp (x, 1, 40, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_neg (x, x, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      /* tiny x, and x = -1 */
+      mpfr_set_si_2exp (x, 1, -100, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_neg (x, x, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_si (x, -1, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+    }
+  mpfr_clear (x);
+}
+
+static void
+check_random (int n)
+{
+  mpfr_t x;
+  int i;
+
+  mpfr_init (x);
+  for (i = 0; i < n; i++)
+    {
+      mpfr_set_prec (x, MPFR_PREC_MIN + randlimb () % 200);
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (long) (randlimb () % 40) - 30, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      check (x, MPFR_PREC_MIN + randlimb () % 200,
+             MPFR_PREC_MIN + randlimb () % 200, RND_RAND_NO_RNDF (),
+             randlimb () % 3);
+    }
+  mpfr_clear (x);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_special ();
+  check_random (1000);
+
+  tests_end_mpfr ();
+  return 0;
+}
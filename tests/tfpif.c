@@ -386,6 +386,375 @@ check_bad (void)
   mpfr_clear (x);
 }
 
+/* return non-zero if x and y have the same precision, sign bit and value
+   (NaN being equal to NaN) */
+static int
+same_fpif (mpfr_srcptr x, mpfr_srcptr y)
+{
+  return mpfr_get_prec (x) == mpfr_get_prec (y)
+    && mpfr_signbit (x) == mpfr_signbit (y)
+    && (mpfr_nan_p (x) ? mpfr_nan_p (y) : mpfr_equal_p (x, y));
+}
+
+/* check mpfr_fpif_import_buf on the numbers of the fixed file FILE_NAME_R,
+   compared with mpfr_fpif_import */
+static void
+check_buf_file (void)
+{
+  const char *data = FILE_NAME_R;
+  unsigned char *buf;
+  size_t size, pos, n;
+  FILE *fh;
+  mpfr_t x, y;
+
+  fh = src_fopen (data, "r");
+  if (fh == NULL)
+    {
+      perror ("check_buf_file");
+      fprintf (stderr, "Failed to open \"%s\" in srcdir for reading\n", data);
+      exit (1);
+    }
+  for (size = 0; getc (fh) != EOF; size++)
+    ;
+  rewind (fh);
+  buf = (unsigned char *) tests_allocate (size);
+  if (fread (buf, size, 1, fh) != 1)
+    {
+      perror ("check_buf_file");
+      fprintf (stderr, "Failed to read \"%s\"\n", data);
+      exit (1);
+    }
+  rewind (fh);
+
+  mpfr_init2 (x, 2);
+  mpfr_init2 (y, 2);
+  for (pos = 0; pos < size; pos += n)
+    {
+      if (mpfr_fpif_import (x, fh) != 0)
+        {
+          printf ("Error in check_buf_file: mpfr_fpif_import failed\n");
+          exit (1);
+        }
+      n = mpfr_fpif_import_buf (y, buf + pos, size - pos);
+      if (n == 0 || ftell (fh) != (long) (pos + n) || ! same_fpif (x, y))
+        {
+          printf ("Error in check_buf_file at offset %lu\n",
+                  (unsigned long) pos);
+          printf ("got n = %lu, y = ", (unsigned long) n);
+          mpfr_dump (y);
+          printf ("expected ");
+          mpfr_dump (x);
+          exit (1);
+        }
+    }
+  fclose (fh);
+  tests_free (buf, size);
+  mpfr_clear (x);
+  mpfr_clear (y);
+}
+
+#define NBUF 64
+
+/* check that mpfr_fpif_export_buf writes the same bytes as mpfr_fpif_export
+   when NBUF numbers are packed one after another, that they are read back
+   by mpfr_fpif_import_buf, and that truncated buffers are rejected */
+static void
+check_buf (void)
+{
+  const char *filename = FILE_NAME_RW;
+  mpfr_exp_t e[] = { 0, 47, -47, 48, -48, 1000, -100000 };
+  mpfr_t x[NBUF], y;
+  unsigned char *buf, *fbuf;
+  size_t size, pos, n, k;
+  FILE *fh;
+  int i;
+
+  for (i = 0; i < NBUF; i++)
+    {
+      mpfr_init2 (x[i], i < NBUF - 4 ? 1 + (randlimb () % 300) :
+                  1000 + (randlimb () % 10000));
+      if (i == 0)
+        mpfr_set_nan (x[i]);
+      else if (i == 1)
+        mpfr_set_inf (x[i], -1);
+      else if (i == 2)
+        mpfr_set_zero (x[i], -1);
+      else
+        {
+          mpfr_urandomb (x[i], RANDS);
+          if (mpfr_zero_p (x[i]))
+            mpfr_set_ui (x[i], 1, MPFR_RNDN);
+          if (i == 3)
+            mpfr_set_exp (x[i], mpfr_get_emax ());
+          else if (i == 4)
+            mpfr_set_exp (x[i], mpfr_get_emin ());
+          else
+            mpfr_set_exp (x[i], e[randlimb () % numberof (e)]);
+        }
+      if (randlimb () & 1)
+        mpfr_neg (x[i], x[i], MPFR_RNDN);
+    }
+
+  fh = fopen (filename, "w");
+  if (fh == NULL)
+    {
+      perror ("check_buf");
+      fprintf (stderr, "Failed to open \"%s\" for writing\n", filename);
+      exit (1);
+    }
+  for (i = 0, size = 0; i < NBUF; i++)
+    {
+      size += mpfr_fpif_size (x[i]);
+      if (mpfr_fpif_export (fh, x[i]) != 0)
+        {
+          printf ("Error in check_buf: mpfr_fpif_export failed\n");
+          exit (1);
+        }
+    }
+  fclose (fh);
+
+  buf = (unsigned char *) tests_allocate (size);
+  fbuf = (unsigned char *) tests_allocate (size);
+  for (i = 0, pos = 0; i < NBUF; i++)
+    {
+      k = mpfr_fpif_size (x[i]);
+      if (mpfr_fpif_export_buf (buf + pos, k - 1, x[i]) != 0)
+        {
+          printf ("Error in check_buf: mpfr_fpif_export_buf did not fail"
+                  " on a too small buffer\n");
+          exit (1);
+        }
+      n = mpfr_fpif_export_buf (buf + pos, size - pos, x[i]);
+      if (n != k)
+        {
+          printf ("Error in check_buf: mpfr_fpif_export_buf returned %lu"
+                  " instead of %lu\n", (unsigned long) n, (unsigned long) k);
+          exit (1);
+        }
+      pos += n;
+    }
+  MPFR_ASSERTN (pos == size);
+
+  fh = fopen (filename, "r");
+  if (fh == NULL)
+    {
+      perror ("check_buf");
+      fprintf (stderr, "Failed to open \"%s\" for reading\n", filename);
+      exit (1);
+    }
+  if (fread (fbuf, size, 1, fh) != 1 || getc (fh) != EOF)
+    {
+      printf ("Error in check_buf: wrong size of \"%s\"\n", filename);
+      exit (1);
+    }
+  fclose (fh);
+  remove (filename);
+  if (memcmp (buf, fbuf, size) != 0)
+    {
+      printf ("Error in check_buf: mpfr_fpif_export_buf and"
+              " mpfr_fpif_export differ\n");
+      exit (1);
+    }
+
+  mpfr_init2 (y, 2);
+  for (i = 0, pos = 0; i < NBUF; i++)
+    {
+      k = mpfr_fpif_size (x[i]);
+      /* a truncated number must be rejected */
+      for (n = 0; n < k; n = n < 20 ? n + 1 : k - 1 > n ? k - 1 : k)
+        if (mpfr_fpif_import_buf (y, buf + pos, n) != 0)
+          {
+            printf ("Error in check_buf: mpfr_fpif_import_buf did not fail"
+                    " on %lu bytes out of %lu\n", (unsigned long) n,
+                    (unsigned long) k);
+            exit (1);
+          }
+      n = mpfr_fpif_import_buf (y, buf + pos, size - pos);
+      if (n != k || ! same_fpif (x[i], y))
+        {
+          printf ("Error in check_buf for i = %d\n", i);
+          printf ("got n = %lu, y = ", (unsigned long) n);
+          mpfr_dump (y);
+          printf ("expected n = %lu, x = ", (unsigned long) k);
+          mpfr_dump (x[i]);
+          exit (1);
+        }
+      pos += n;
+    }
+
+  for (i = 0; i < NBUF; i++)
+    mpfr_clear (x[i]);
+  mpfr_clear (y);
+  tests_free (buf, size);
+  tests_free (fbuf, size);
+}
+
+#define NARRAY 3000
+
+/* check mpfr_fpif_export_array and mpfr_fpif_import_array on arrays with
+   runs of equal precisions (longer than the runs written by MPFR, and with
+   a significand larger than the internal buffers) and special values */
+static void
+check_array (void)
+{
+  const char *filename = FILE_NAME_RW;
+  mpfr_t *xt, *yt;
+  mpfr_ptr *x, *y;
+  unsigned char *data;
+  size_t size, cut[5];
+  long end;
+  mpfr_t z;
+  FILE *fh;
+  int i, j;
+
+  xt = (mpfr_t *) tests_allocate (NARRAY * sizeof (mpfr_t));
+  yt = (mpfr_t *) tests_allocate (NARRAY * sizeof (mpfr_t));
+  x = (mpfr_ptr *) tests_allocate (NARRAY * sizeof (mpfr_ptr));
+  y = (mpfr_ptr *) tests_allocate (NARRAY * sizeof (mpfr_ptr));
+  for (i = 0; i < NARRAY; i++)
+    {
+      x[i] = xt[i];
+      y[i] = yt[i];
+      mpfr_init2 (x[i], i < 1500 ? 53 : i == 2000 ? 600000 :
+                  i < 2500 ? 1 + (randlimb () % 300) : 128);
+      mpfr_init2 (y[i], 2);
+      if (i % 97 == 5)
+        mpfr_set_nan (x[i]);
+      else if (i % 97 == 6)
+        mpfr_set_inf (x[i], 1);
+      else if (i % 97 == 7)
+        mpfr_set_zero (x[i], -1);
+      else
+        {
+          mpfr_urandomb (x[i], RANDS);
+          if (mpfr_zero_p (x[i]))
+            mpfr_set_ui (x[i], 1, MPFR_RNDN);
+          mpfr_set_exp (x[i], (mpfr_exp_t) (randlimb () % 200000) - 100000);
+        }
+      if (randlimb () & 1)
+        MPFR_CHANGE_SIGN (x[i]);
+    }
+  mpfr_init2 (z, 17);
+  mpfr_set_ui (z, 17, MPFR_RNDN);
+
+  /* write an array, a single number, then a smaller array */
+  fh = fopen (filename, "w");
+  if (fh == NULL)
+    {
+      perror ("check_array");
+      fprintf (stderr, "Failed to open \"%s\" for writing\n", filename);
+      exit (1);
+    }
+  if (mpfr_fpif_export_array (fh, x, NARRAY) != 0 ||
+      mpfr_fpif_export (fh, z) != 0 ||
+      mpfr_fpif_export_array (fh, x + 1490, 20) != 0)
+    {
+      printf ("Error in check_array: export failed\n");
+      exit (1);
+    }
+  fclose (fh);
+
+  fh = fopen (filename, "r");
+  if (fh == NULL)
+    {
+      perror ("check_array");
+      fprintf (stderr, "Failed to open \"%s\" for reading\n", filename);
+      exit (1);
+    }
+  if (mpfr_fpif_import_array (y, NARRAY + 1, fh) != NARRAY)
+    {
+      printf ("Error in check_array: import failed\n");
+      exit (1);
+    }
+  for (i = 0; i < NARRAY; i++)
+    if (! same_fpif (x[i], y[i]))
+      {
+        printf ("Error in check_array for i = %d\n", i);
+        printf ("got      ");
+        mpfr_dump (y[i]);
+        printf ("expected ");
+        mpfr_dump (x[i]);
+        exit (1);
+      }
+  /* the import must not read beyond the end of the array */
+  end = ftell (fh);
+  mpfr_set_prec (z, 2);
+  if (mpfr_fpif_import (z, fh) != 0 || mpfr_cmp_ui (z, 17) != 0)
+    {
+      printf ("Error in check_array: wrong number after the array\n");
+      exit (1);
+    }
+  if (mpfr_fpif_import_array (y, 20, fh) != 20)
+    {
+      printf ("Error in check_array: import of the second array failed\n");
+      exit (1);
+    }
+  for (i = 0; i < 20; i++)
+    MPFR_ASSERTN (same_fpif (x[1490 + i], y[i]));
+  if (mpfr_fpif_import_array (y, 20, fh) != 0 || ! feof (fh))
+    {
+      printf ("Error in check_array: no end of file\n");
+      exit (1);
+    }
+
+  /* an array larger than n must be rejected */
+  rewind (fh);
+  if (mpfr_fpif_import_array (y, NARRAY - 1, fh) != 0)
+    {
+      printf ("Error in check_array: too large array not detected\n");
+      exit (1);
+    }
+
+  /* truncated arrays must be rejected */
+  rewind (fh);
+  for (size = 0; getc (fh) != EOF; size++)
+    ;
+  rewind (fh);
+  data = (unsigned char *) tests_allocate (size);
+  if (fread (data, size, 1, fh) != 1)
+    {
+      perror ("check_array");
+      fprintf (stderr, "Failed to read \"%s\"\n", filename);
+      exit (1);
+    }
+  fclose (fh);
+  cut[0] = 1;
+  cut[1] = 5;
+  cut[2] = 100;
+  cut[3] = size / 2;
+  cut[4] = end - 1;  /* cut the last byte of the first array */
+  for (j = 0; j < 5; j++)
+    {
+      fh = fopen (filename, "w");
+      MPFR_ASSERTN (fh != NULL);
+      MPFR_ASSERTN (fwrite (data, cut[j], 1, fh) == 1);
+      fclose (fh);
+      fh = fopen (filename, "r");
+      MPFR_ASSERTN (fh != NULL);
+      if (mpfr_fpif_import_array (y, NARRAY, fh) != 0)
+        {
+          printf ("Error in check_array: truncated array (%lu bytes out"
+                  " of %lu) not detected\n", (unsigned long) cut[j],
+                  (unsigned long) size);
+          exit (1);
+        }
+      fclose (fh);
+    }
+  remove (filename);
+  tests_free (data, size);
+
+  for (i = 0; i < NARRAY; i++)
+    {
+      mpfr_clear (x[i]);
+      mpfr_clear (y[i]);
+    }
+  mpfr_clear (z);
+  tests_free (xt, NARRAY * sizeof (mpfr_t));
+  tests_free (yt, NARRAY * sizeof (mpfr_t));
+  tests_free (x, NARRAY * sizeof (mpfr_ptr));
+  tests_free (y, NARRAY * sizeof (mpfr_ptr));
+}
+
 /* exercise error when precision > MPFR_PREC_MAX */
 static void
 extra (void)
@@ -427,6 +796,9 @@ main (int argc, char *argv[])
   doit (argc, argv, 130, 2048);
   doit (argc, argv, 1, 53);
   check_bad ();
+  check_buf_file ();
+  check_buf ();
+  check_array ();
 
   tests_end_mpfr ();
 
@@ -1464,6 +1464,233 @@ check_corner (void)
         }
 }
 
+/* compare mpfr_mpn_get_str (which uses a cache of powers of the base for
+   large sizes) with mpn_get_str on {xp, n} */
+static void
+check_mpn_get_str_aux (int b, mp_limb_t *xp, mp_size_t n)
+{
+  mp_limb_t *t;
+  unsigned char *s1, *s2;
+  size_t m, k1, k2;
+
+  m = n * GMP_NUMB_BITS + 2;  /* enough for b >= 2 */
+  t = (mp_limb_t *) tests_allocate (n * sizeof (mp_limb_t));
+  s1 = (unsigned char *) tests_allocate (m);
+  s2 = (unsigned char *) tests_allocate (m);
+  MPN_COPY (t, xp, n);
+  k1 = mpn_get_str (s1, b, t, n);
+  MPN_COPY (t, xp, n);
+  k2 = mpfr_mpn_get_str (s2, b, t, n);
+  if (k1 != k2 || memcmp (s1, s2, k1) != 0)
+    {
+      printf ("Error in mpfr_mpn_get_str for b=%d, n=%ld\n", b, (long) n);
+      exit (1);
+    }
+  tests_free (t, n * sizeof (mp_limb_t));
+  tests_free (s1, m);
+  tests_free (s2, m);
+}
+
+static void
+check_mpn_get_str (void)
+{
+  static int base[] = { 3, 10, 7, 10, 36, 62, 12 };
+  mpz_t z;
+  mpfr_t x, y;
+  char *s;
+  mpfr_exp_t e;
+  unsigned long k;
+  int i, j, l;
+
+  mpz_init (z);
+  for (i = 0; i < numberof (base); i++)
+    {
+      int b = base[i];
+      mp_size_t n = MPFR_GET_STR_DC_THRESHOLD + randlimb () % 5000;
+
+      /* random numbers */
+      mpz_urandomb (z, RANDS, n * GMP_NUMB_BITS);
+      mpz_setbit (z, n * GMP_NUMB_BITS - 1);
+      check_mpn_get_str_aux (b, z->_mp_d, n);
+      mpz_urandomb (z, RANDS, 5 * GMP_NUMB_BITS);
+      mpz_setbit (z, 5 * GMP_NUMB_BITS - 1);
+      check_mpn_get_str_aux (b, z->_mp_d, 5);
+      /* b^k - 1, b^k and b^k + 1, which have long runs of zeros or of
+         digits b-1 */
+      for (l = 1; (2 << l) <= b; l++)
+        ;
+      k = (MPFR_GET_STR_DC_THRESHOLD + 500 * i) * GMP_NUMB_BITS / l;
+      for (j = -1; j <= 1; j++)
+        {
+          mpz_ui_pow_ui (z, b, k);
+          if (j < 0)
+            mpz_sub_ui (z, z, 1);
+          else
+            mpz_add_ui (z, z, j);
+          check_mpn_get_str_aux (b, z->_mp_d, mpz_size (z));
+        }
+      if (i == 3)
+        mpfr_free_cache ();
+    }
+  mpz_clear (z);
+
+  /* mpfr_set_str o mpfr_get_str = Id for a large precision */
+  mpfr_init2 (x, 300000);
+  mpfr_init2 (y, 300000);
+  mpfr_urandomb (x, RANDS);
+  mpfr_mul_2si (x, x, 1000, MPFR_RNDN);
+  s = mpfr_get_str (NULL, &e, 10, 0, x, MPFR_RNDN);
+  /* x = s * 10^(e - strlen(s)) */
+  {
+    size_t m = strlen (s);
+    char *t = (char *) tests_allocate (m + 32);
+
+    sprintf (t, "%s@%ld", s, (long) (e - (mpfr_exp_t) m));
+    mpfr_set_str (y, t, 10, MPFR_RNDN);
+    if (! mpfr_equal_p (x, y))
+      {
+        printf ("mpfr_set_str o mpfr_get_str <> Id for p=300000\n");
+        exit (1);
+      }
+    tests_free (t, m + 32);
+  }
+  mpfr_clear (y);
+  mpfr_free_str (s);
+  mpfr_clear (x);
+}
+
+/* Check mpfr_get_str_shortest on x in base b against a linear search of
+   the smallest number of digits. */
+static void
+check_shortest_aux (int b, mpfr_srcptr x)
+{
+  mpfr_t ax, y;
+  mpfr_exp_t e1, e2;
+  char *s1, *s2, *buf;
+  size_t m, n;
+  int inex1, inex2, ok = 0;
+
+  m = mpfr_get_str_ndigits (b < 0 ? -b : b, mpfr_get_prec (x));
+  s1 = (char *) tests_allocate (m + 2);
+  buf = (char *) tests_allocate (m + 64);
+  mpfr_init2 (ax, mpfr_get_prec (x));
+  mpfr_init2 (y, mpfr_get_prec (x));
+  mpfr_abs (ax, x, MPFR_RNDN);
+  for (n = 1; ! ok; n++)
+    {
+      int up;
+
+      for (up = 0; up <= 1 && ! ok; up++)
+        {
+          mpfr_get_str (s1, &e1, b, n, ax, up ? MPFR_RNDU : MPFR_RNDN);
+          sprintf (buf, "0.%s@%ld", s1, (long) e1);
+          inex1 = mpfr_strtofr (y, buf, NULL, b < 0 ? -b : b, MPFR_RNDN);
+          ok = mpfr_equal_p (y, ax);
+        }
+      MPFR_ASSERTN (n <= m);
+    }
+  inex1 = inex1 != 0;
+
+  mpfr_clear_flags ();
+  s2 = mpfr_get_str_shortest (NULL, &e2, b, x);
+  inex2 = mpfr_inexflag_p () != 0;
+  if (strcmp (s2 + mpfr_signbit (x), s1) != 0 || e1 != e2 ||
+      (mpfr_signbit (x) && s2[0] != '-') || inex1 != inex2)
+    {
+      printf ("Error in mpfr_get_str_shortest for b=%d, x=", b);
+      mpfr_dump (x);
+      printf ("expected %s@%ld (inex=%d)\n", s1, (long) e1, inex1);
+      printf ("got      %s@%ld (inex=%d)\n", s2, (long) e2, inex2);
+      exit (1);
+    }
+  mpfr_free_str (s2);
+  /* with a given buffer */
+  s2 = mpfr_get_str_shortest (buf, &e2, b, x);
+  MPFR_ASSERTN (s2 == buf && strcmp (buf + mpfr_signbit (x), s1) == 0);
+
+  mpfr_clear (ax);
+  mpfr_clear (y);
+  tests_free (s1, m + 2);
+  tests_free (buf, m + 64);
+}
+
+static void
+check_shortest (void)
+{
+  static mpfr_prec_t prec[] = { 24, 53, 64, 113, 128, 2, 129, 200 };
+  static int base[] = { 10, 10, 10, 2, 3, 16, 36, -36 };
+  static long emax[] = { 4, 64, 1100, 16400, 20000 };
+  mpfr_t x;
+  mpfr_exp_t e;
+  char *s;
+  int i, j, k, l;
+
+  /* special values */
+  mpfr_init2 (x, 53);
+  mpfr_set_nan (x);
+  mpfr_clear_flags ();
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "@NaN@") == 0 && mpfr_nanflag_p ());
+  mpfr_free_str (s);
+  mpfr_set_inf (x, -1);
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "-@Inf@") == 0);
+  mpfr_free_str (s);
+  mpfr_set_zero (x, -1);
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "-0") == 0 && e == 0);
+  mpfr_free_str (s);
+  MPFR_ASSERTN (mpfr_get_str_shortest (NULL, &e, 1, x) == NULL);
+
+  /* 0.1, 1/3 and 10^23 in double precision */
+  mpfr_set_str (x, "0.1", 10, MPFR_RNDN);
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "1") == 0 && e == 0);
+  mpfr_free_str (s);
+  mpfr_set_ui (x, 1, MPFR_RNDN);
+  mpfr_div_ui (x, x, 3, MPFR_RNDN);
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "3333333333333333") == 0 && e == 0);
+  mpfr_free_str (s);
+  mpfr_set_str (x, "1e23", 10, MPFR_RNDN);
+  s = mpfr_get_str_shortest (NULL, &e, 10, x);
+  MPFR_ASSERTN (strcmp (s, "1") == 0 && e == 24);
+  mpfr_free_str (s);
+
+  for (i = 0; i < numberof (prec); i++)
+    {
+      mpfr_set_prec (x, prec[i]);
+      for (j = 0; j < numberof (base); j++)
+        for (k = 0; k < numberof (emax); k++)
+          for (l = 0; l < (j == 0 ? 100 : 4); l++)
+            {
+              mpfr_urandomb (x, RANDS);
+              if (randlimb () % 2)
+                mpfr_neg (x, x, MPFR_RNDN);
+              mpfr_mul_2si (x, x, (long) (randlimb () % (2 * emax[k] + 1))
+                            - emax[k], MPFR_RNDN);
+              if (mpfr_zero_p (x))
+                continue;
+              check_shortest_aux (base[j], x);
+              /* integers, powers of 2 and their neighbors */
+              if (l % 4 == 0)
+                {
+                  mpfr_rint (x, x, MPFR_RNDN);
+                  if (! mpfr_zero_p (x))
+                    check_shortest_aux (base[j], x);
+                  mpfr_set_si_2exp (x, 1, (long) (randlimb () %
+                                                  (2 * emax[k] + 1))
+                                    - emax[k], MPFR_RNDN);
+                  check_shortest_aux (base[j], x);
+                  mpfr_nextbelow (x);
+                  check_shortest_aux (base[j], x);
+                }
+            }
+    }
+
+  mpfr_clear (x);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1480,6 +1707,8 @@ main (int argc, char *argv[])
 
   check_corner ();
   test_ndigits ();
+  check_mpn_get_str ();
+  check_shortest ();
   coverage ();
   check_small ();
 
@@ -27,6 +27,106 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <locale.h>
 #endif
 
+/* Check mpfr_inp_str_array on the numbers written by mpfr_out_str_array
+   (thus read back exactly), separated by various whitespace, then on the
+   first lines of inp_str.dat, where it must stop at the invalid word. */
+static void
+check_array (void)
+{
+  const char *fname = "tinp_str_array.txt";
+  mpfr_ptr tab[1000], tab2[1000];
+  FILE *f;
+  size_t i, r;
+  int c;
+
+  f = fopen (fname, "w+");
+  if (f == NULL)
+    {
+      printf ("Failed to open \"%s\"\n", fname);
+      exit (1);
+    }
+
+  for (i = 0; i < numberof_const (tab); i++)
+    {
+      tab[i] = (mpfr_ptr) tests_allocate (sizeof (mpfr_t));
+      tab2[i] = (mpfr_ptr) tests_allocate (sizeof (mpfr_t));
+      mpfr_init2 (tab[i], MPFR_PREC_MIN + randlimb () % 300);
+      mpfr_init2 (tab2[i], mpfr_get_prec (tab[i]));
+      if (i % 50 == 0)
+        mpfr_set_inf (tab[i], i % 100 == 0 ? 1 : -1);
+      else if (i % 50 == 1)
+        mpfr_set_zero (tab[i], i % 100 == 1 ? 1 : -1);
+      else
+        {
+          mpfr_urandomb (tab[i], RANDS);
+          mpfr_mul_2si (tab[i], tab[i], (long) (randlimb () % 2001) - 1000,
+                        MPFR_RNDN);
+          if (randlimb () % 2)
+            mpfr_neg (tab[i], tab[i], MPFR_RNDN);
+        }
+    }
+
+  /* written in 2 parts, followed by some separators and a word after the
+     array, which must not be consumed */
+  mpfr_out_str_array (f, 10, 0, tab, 400, MPFR_RNDN);
+  fputs (" \t ", f);
+  mpfr_out_str_array (f, 10, 0, tab + 400, numberof_const (tab) - 400,
+                      MPFR_RNDN);
+  fputs ("\n\n foo", f);
+  rewind (f);
+  r = mpfr_inp_str_array (tab2, numberof_const (tab2), f, 10, MPFR_RNDN);
+  if (r != numberof_const (tab))
+    {
+      printf ("Error in mpfr_inp_str_array: %lu numbers read instead "
+              "of %lu\n", (unsigned long) r,
+              (unsigned long) numberof_const (tab));
+      exit (1);
+    }
+  for (i = 0; i < numberof_const (tab); i++)
+    if (! mpfr_equal_p (tab[i], tab2[i]) ||
+        MPFR_IS_NEG (tab[i]) != MPFR_IS_NEG (tab2[i]))
+      {
+        printf ("Error in mpfr_inp_str_array for number %lu\n",
+                (unsigned long) i);
+        printf ("expected "); mpfr_dump (tab[i]);
+        printf ("got      "); mpfr_dump (tab2[i]);
+        exit (1);
+      }
+  c = getc (f);
+  if (c != '\n' || mpfr_inp_str_array (tab2, 1, f, 10, MPFR_RNDN) != 0
+      || getc (f) != EOF)
+    {
+      printf ("Error in mpfr_inp_str_array after the last number\n");
+      exit (1);
+    }
+  fclose (f);
+  remove (fname);
+
+  f = src_fopen ("inp_str.dat", "r");
+  if (f == NULL)
+    {
+      printf ("Error, can't open inp_str.dat\n");
+      exit (1);
+    }
+  r = mpfr_inp_str_array (tab2, 5, f, 10, MPFR_RNDN);
+  if (r != 3 || mpfr_cmp_si (tab2[0], -1700) || mpfr_cmp_ui (tab2[1], 31415)
+      || mpfr_cmp_ui (tab2[2], 31416))
+    {
+      printf ("Error in mpfr_inp_str_array on inp_str.dat (%lu)\n",
+              (unsigned long) r);
+      exit (1);
+    }
+  fclose (f);
+
+  for (i = 0; i < numberof_const (tab); i++)
+    {
+      mpfr_clear (tab[i]);
+      mpfr_clear (tab2[i]);
+      tests_free (tab[i], sizeof (mpfr_t));
+      tests_free (tab2[i], sizeof (mpfr_t));
+    }
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -123,6 +223,8 @@ main (int argc, char *argv[])
   mpfr_clear (x);
   mpfr_clear (y);
 
+  check_array ();
+
   tests_end_mpfr ();
   return 0;
 }
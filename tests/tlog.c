@@ -276,6 +276,104 @@ x_near_one (void)
   mpfr_clears (x, y, (mpfr_ptr) 0);
 }
 
+#ifdef MPFR_FIXED_MAXPREC
+/* Check the table-driven kernel used up to MPFR_FIXED_MAXPREC bits against
+   the general algorithm, for random arguments and arguments close to
+   2^e (1 + j/2^8), i.e., close to the boundaries of the tables (j = 0 and
+   e = 0 give arguments close to 1, where the kernel cannot round). */
+static void
+check_fixed (void)
+{
+  mpfr_prec_t p, p2 = 2 * MPFR_FIXED_MAXPREC + 64;
+  mpfr_t x, y, z, t;
+  int i, inex1, inex2;
+  mpfr_rnd_t rnd;
+
+  mpfr_init2 (t, p2);
+  for (p = MPFR_PREC_MIN; p <= MPFR_FIXED_MAXPREC; p++)
+    {
+      mpfr_inits2 (p, y, z, (mpfr_ptr) 0);
+      mpfr_init2 (x, MPFR_PREC_MIN + 8 + (randlimb () % (2 * p)));
+      for (i = 0; i < 20; i++)
+        {
+          if (i < 10)
+            {
+              /* 2^(e-1) <= x < 2^e with -31 <= e <= 33 */
+              mpfr_urandomb (x, RANDS);
+              if (mpfr_zero_p (x))
+                continue;
+              mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % 65) - 31);
+            }
+          else
+            {
+              mpfr_set_ui (x, 256 + randlimb () % 256, MPFR_RNDN);
+              if (randlimb () & 1)
+                mpfr_nextabove (x);
+              else
+                mpfr_nextbelow (x);
+              mpfr_mul_2si (x, x, (long) (randlimb () % 63) - 39, MPFR_RNDN);
+            }
+          rnd = RND_RAND_NO_RNDF ();
+          inex1 = mpfr_log (y, x, rnd);
+          mpfr_log (t, x, MPFR_RNDN);
+          if (! mpfr_can_round (t, p2 - 1, MPFR_RNDN, MPFR_RNDZ,
+                                p + (rnd == MPFR_RNDN)))
+            continue;
+          inex2 = mpfr_set (z, t, rnd);
+          if (! mpfr_equal_p (y, z) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_fixed for prec=%lu, rnd=%s\nx=",
+                      (unsigned long) p, mpfr_print_rnd_mode (rnd));
+              mpfr_dump (x);
+              printf ("expected "); mpfr_dump (z);
+              printf ("got      "); mpfr_dump (y);
+              exit (1);
+            }
+        }
+      mpfr_clears (x, y, z, (mpfr_ptr) 0);
+    }
+  mpfr_clear (t);
+}
+#endif
+
+/* Check the Newton iteration used from MPFR_LOG_THRESHOLD bits against
+   the AGM: with rounding toward zero, the result in precision p rounded
+   to p-1 bits must be the result in precision p-1 bits. */
+static void
+check_newton (void)
+{
+  mpfr_prec_t p = MPFR_LOG_THRESHOLD;
+  mpfr_t x, y, z;
+  int i = randlimb () % 3;
+
+  /* skip the test if the threshold is too large */
+  if (p > 1000000)
+    return;
+
+  mpfr_init2 (x, p);
+  mpfr_init2 (y, p);
+  mpfr_init2 (z, p - 1);
+  /* since this test is slow, a single argument is checked, chosen at
+     random among: x close to 1, x large, x small */
+  mpfr_urandomb (x, RANDS);
+  if (i == 0)
+    {
+      mpfr_div_2ui (x, x, 1000, MPFR_RNDN);
+      mpfr_add_ui (x, x, 1, MPFR_RNDN);
+    }
+  else
+    mpfr_mul_2si (x, x, i == 1 ? 1000 : -7, MPFR_RNDN);
+  mpfr_log (y, x, MPFR_RNDZ);
+  mpfr_log (z, x, MPFR_RNDZ);
+  mpfr_prec_round (y, p - 1, MPFR_RNDZ);
+  if (! mpfr_equal_p (y, z))
+    {
+      printf ("Error in check_newton for i=%d\n", i);
+      exit (1);
+    }
+  mpfr_clears (x, y, z, (mpfr_ptr) 0);
+}
+
 #define TEST_FUNCTION test_log
 #define TEST_RANDOM_POS 8
 #include "tgeneric.c"
@@ -294,6 +392,7 @@ main (int argc, char *argv[])
 
   special ();
   check_worst_cases();
+  check_newton ();
 
   check2("1.01979300812244555452", MPFR_RNDN, "1.95996734891603664741e-02");
   check2("10.0",MPFR_RNDU,"2.30258509299404590110e+00");
@@ -358,6 +457,9 @@ main (int argc, char *argv[])
   check2("6.09969788341579732815e+00",MPFR_RNDD,"1.80823924264386204363e+00");
 
   x_near_one ();
+#ifdef MPFR_FIXED_MAXPREC
+  check_fixed ();
+#endif
 
   test_generic (MPFR_PREC_MIN, 100, 40);
 
@@ -1295,6 +1295,154 @@ coverage2 (void)
   set_emin (emin); /* restore emin */
 }
 
+/* Check mpfr_mul when the precisions are at most 2 limbs but differ,
+   by comparing with the product of copies of b and c with 3 limbs. */
+static void
+check_mixed_le2 (void)
+{
+  mpfr_t a, a2, b, b3, c, c3;
+  mpfr_exp_t emin, emax, e;
+  mpfr_flags_t flags1, flags2;
+  int i, k, inex1, inex2;
+  mpfr_rnd_t rnd;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  mpfr_inits2 (3 * GMP_NUMB_BITS + 1, b3, c3, (mpfr_ptr) 0);
+  mpfr_inits2 (MPFR_PREC_MIN, a, a2, b, c, (mpfr_ptr) 0);
+
+  for (i = 0; i < 20000; i++)
+    {
+      mpfr_set_prec (a, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_set_prec (a2, MPFR_GET_PREC (a));
+      mpfr_set_prec (b, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_set_prec (c, MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS));
+      mpfr_urandomb (b, RANDS);
+      mpfr_urandomb (c, RANDS);
+      if (MPFR_IS_ZERO (b) || MPFR_IS_ZERO (c))
+        continue;
+      if (randlimb () & 1)
+        mpfr_neg (b, b, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (c, c, MPFR_RNDN);
+      mpfr_set_exp (b, (mpfr_exp_t) (randlimb () % 9) - 4);
+      mpfr_set_exp (c, (mpfr_exp_t) (randlimb () % 9) - 4);
+      /* sometimes test near the bounds of the exponent range */
+      e = MPFR_GET_EXP (b) + MPFR_GET_EXP (c);
+      k = randlimb () % 8;
+      if (k == 0 || k == 1)
+        set_emax (MAX (e - k, MAX (MPFR_GET_EXP (b), MPFR_GET_EXP (c))));
+      else if (k == 2 || k == 3)
+        set_emin (MIN (e - k + 2, MIN (MPFR_GET_EXP (b), MPFR_GET_EXP (c))));
+      mpfr_set (b3, b, MPFR_RNDN);
+      mpfr_set (c3, c, MPFR_RNDN);
+      rnd = RND_RAND_NO_RNDF ();
+      mpfr_clear_flags ();
+      inex1 = mpfr_mul (a, b, c, rnd);
+      flags1 = __gmpfr_flags;
+      mpfr_clear_flags ();
+      inex2 = mpfr_mul (a2, b3, c3, rnd);
+      flags2 = __gmpfr_flags;
+      if (! SAME_VAL (a, a2) || VSIGN (inex1) != VSIGN (inex2)
+          || flags1 != flags2)
+        {
+          printf ("Error in check_mixed_le2, %s\n",
+                  mpfr_print_rnd_mode (rnd));
+          printf ("b = ");
+          mpfr_dump (b);
+          printf ("c = ");
+          mpfr_dump (c);
+          printf ("expected ");
+          mpfr_dump (a2);
+          printf ("got      ");
+          mpfr_dump (a);
+          printf ("expected inex = %d, flags =", inex2);
+          flags_out (flags2);
+          printf ("got      inex = %d, flags =", inex1);
+          flags_out (flags1);
+          exit (1);
+        }
+      set_emin (emin);
+      set_emax (emax);
+    }
+
+  mpfr_clears (a, a2, b, b3, c, c3, (mpfr_ptr) 0);
+}
+
+/* Check products where one operand has many more limbs than the other one
+   and than the result, so that the unbalanced short product is used. The
+   expected result is obtained by rounding the exact product. */
+static void
+check_unbalanced (void)
+{
+  mpfr_t a, a2, b, c, t, u;
+  mpfr_flags_t flags1, flags2;
+  mpfr_prec_t pb, pc;
+  int i, inex1, inex2;
+  mpfr_rnd_t rnd;
+
+  mpfr_inits2 (MPFR_PREC_MIN, a, a2, b, c, t, u, (mpfr_ptr) 0);
+
+  for (i = 0; i < 2000; i++)
+    {
+      pc = MPFR_PREC_MIN + randlimb () % (40 * GMP_NUMB_BITS);
+      pb = pc + GMP_NUMB_BITS + randlimb () % (100 * GMP_NUMB_BITS);
+      mpfr_set_prec (b, pb);
+      mpfr_set_prec (c, pc);
+      mpfr_set_prec (a, MPFR_PREC_MIN +
+                     randlimb () % (pc + 10 * GMP_NUMB_BITS));
+      mpfr_set_prec (a2, MPFR_GET_PREC (a));
+      mpfr_set_prec (t, pb + pc);
+      if (randlimb () % 8 == 0)
+        {
+          /* b has trailing zero limbs */
+          mpfr_set_prec (u, MPFR_PREC_MIN + randlimb () % pc);
+          mpfr_urandomb (u, RANDS);
+          mpfr_set (b, u, MPFR_RNDN);
+        }
+      else
+        mpfr_urandomb (b, RANDS);
+      mpfr_urandomb (c, RANDS);
+      if (MPFR_IS_ZERO (b) || MPFR_IS_ZERO (c))
+        continue;
+      if (randlimb () & 1)
+        mpfr_neg (b, b, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (c, c, MPFR_RNDN);
+      inex2 = mpfr_mul (t, b, c, MPFR_RNDN);
+      MPFR_ASSERTN (inex2 == 0);
+      rnd = RND_RAND_NO_RNDF ();
+      mpfr_clear_flags ();
+      inex2 = mpfr_set (a2, t, rnd);
+      flags2 = __gmpfr_flags;
+      mpfr_clear_flags ();
+      inex1 = (randlimb () & 1) ? mpfr_mul (a, b, c, rnd)
+        : mpfr_mul (a, c, b, rnd);
+      flags1 = __gmpfr_flags;
+      if (! SAME_VAL (a, a2) || VSIGN (inex1) != VSIGN (inex2)
+          || flags1 != flags2)
+        {
+          printf ("Error in check_unbalanced, %s\n",
+                  mpfr_print_rnd_mode (rnd));
+          printf ("b = ");
+          mpfr_dump (b);
+          printf ("c = ");
+          mpfr_dump (c);
+          printf ("expected ");
+          mpfr_dump (a2);
+          printf ("got      ");
+          mpfr_dump (a);
+          printf ("expected inex = %d, flags =", inex2);
+          flags_out (flags2);
+          printf ("got      inex = %d, flags =", inex1);
+          flags_out (flags1);
+          exit (1);
+        }
+    }
+
+  mpfr_clears (a, a2, b, c, t, u, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1351,6 +1499,8 @@ main (int argc, char *argv[])
   bug20161209a ();
   bug20170602 ();
   test_underflow2 ();
+  check_mixed_le2 ();
+  check_unbalanced ();
 
   tests_end_mpfr ();
   return 0;
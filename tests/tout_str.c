@@ -103,6 +103,130 @@ special (void)
   mpfr_clear (x);
 }
 
+/* Compare the contents of the files f1 and f2 from their beginning. */
+static int
+same_contents (FILE *f1, FILE *f2)
+{
+  int c1, c2;
+
+  rewind (f1);
+  rewind (f2);
+  do
+    {
+      c1 = getc (f1);
+      c2 = getc (f2);
+    }
+  while (c1 == c2 && c1 != EOF);
+  return c1 == c2;
+}
+
+/* Check that mpfr_out_str_array gives the same output as mpfr_out_str
+   followed by a newline for each number, with numbers of various
+   precisions and special numbers. The array is large enough for the
+   output to be written by several blocks. */
+static void
+check_array (void)
+{
+  static const int bases[] = { 2, 3, 10, 16, 36, 62, -2, -10 };
+  const char *fname1 = "tout_str_array1.txt", *fname2 = "tout_str_array2.txt";
+  mpfr_ptr tab[3000], tab3[3];
+  mpfr_t big;
+  FILE *f1, *f2;
+  size_t i, n, r, l;
+  int j;
+
+  f1 = fopen (fname1, "w+");
+  f2 = fopen (fname2, "w+");
+  if (f1 == NULL || f2 == NULL)
+    {
+      printf ("Failed to open \"%s\" or \"%s\"\n", fname1, fname2);
+      exit (1);
+    }
+
+  for (i = 0; i < numberof_const (tab); i++)
+    {
+      tab[i] = (mpfr_ptr) tests_allocate (sizeof (mpfr_t));
+      /* mostly the same precision, as in real data */
+      mpfr_init2 (tab[i], randlimb () % 4 ? 53 : MPFR_PREC_MIN
+                  + randlimb () % 200);
+      if (i % 100 < 5)
+        {
+          if (i % 100 == 0)
+            mpfr_set_nan (tab[i]);
+          else if (i % 100 < 3)
+            mpfr_set_inf (tab[i], i % 100 == 1 ? 1 : -1);
+          else
+            mpfr_set_zero (tab[i], i % 100 == 3 ? 1 : -1);
+        }
+      else
+        {
+          mpfr_urandomb (tab[i], RANDS);
+          mpfr_mul_2si (tab[i], tab[i], (long) (randlimb () % 2001) - 1000,
+                        MPFR_RNDN);
+          if (randlimb () % 2)
+            mpfr_neg (tab[i], tab[i], MPFR_RNDN);
+        }
+    }
+
+  for (j = 0; j < numberof (bases); j++)
+    for (n = 0; n < 8; n += 7)
+      {
+        rewind (f1);
+        rewind (f2);
+        r = mpfr_out_str_array (f1, bases[j], n, tab, numberof_const (tab),
+                                MPFR_RNDZ);
+        l = 0;
+        for (i = 0; i < numberof_const (tab); i++)
+          {
+            l += mpfr_out_str (f2, bases[j], n, tab[i], MPFR_RNDZ);
+            putc ('\n', f2);
+            l++;
+          }
+        if (r != l || ! same_contents (f1, f2))
+          {
+            printf ("Error in mpfr_out_str_array for base %d, n = %lu\n"
+                    "(wrote %lu characters instead of %lu)\n", bases[j],
+                    (unsigned long) n, (unsigned long) r, (unsigned long) l);
+            exit (1);
+          }
+      }
+
+  /* a number that does not fit in the buffer */
+  mpfr_init2 (big, 300000);
+  mpfr_const_pi (big, MPFR_RNDN);
+  tab3[0] = tab[10];
+  tab3[1] = big;
+  tab3[2] = tab[11];
+  rewind (f1);
+  rewind (f2);
+  r = mpfr_out_str_array (f1, 10, 0, tab3, 3, MPFR_RNDN);
+  l = 0;
+  for (i = 0; i < 3; i++)
+    {
+      l += mpfr_out_str (f2, 10, 0, tab3[i], MPFR_RNDN);
+      putc ('\n', f2);
+      l++;
+    }
+  if (r != l || l < 90000 || ! same_contents (f1, f2))
+    {
+      printf ("Error in mpfr_out_str_array for a large number\n"
+              "(wrote %lu characters instead of %lu)\n",
+              (unsigned long) r, (unsigned long) l);
+      exit (1);
+    }
+  mpfr_clear (big);
+
+  for (i = 0; i < numberof_const (tab); i++)
+    {
+      mpfr_clear (tab[i]);
+      tests_free (tab[i], sizeof (mpfr_t));
+    }
+  fclose (f1);
+  fclose (f2);
+  remove (fname1);
+  remove (fname2);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -130,6 +254,7 @@ main (int argc, char *argv[])
     }
 
   special ();
+  check_array ();
 
   check (-1.37247529013405550000e+15, MPFR_RNDN, 7);
   check (-1.5674376729569697500e+15, MPFR_RNDN, 19);
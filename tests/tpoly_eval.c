@@ -0,0 +1,295 @@
+/* Test file for mpfr_poly_eval.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define NMAX 200
+
+/* Set r to c[0] + c[1]*x + ... + c[n-1]*x^(n-1) by Horner's rule in
+   a precision large enough for each step to be exact, then round it. */
+static int
+poly_eval_ref (mpfr_ptr r, mpfr_ptr *c, unsigned long n, mpfr_srcptr x,
+               mpfr_rnd_t rnd)
+{
+  mpfr_t y, z;
+  mpfr_prec_t p;
+  long i;
+  int inex;
+
+  p = MPFR_PREC_MIN;
+  for (i = 0; i < (long) n; i++)
+    p = MAX (p, mpfr_get_prec (c[i]));
+  /* the exponents of x and of the c[i] are small, see check_random */
+  p = p + (n - 1) * mpfr_get_prec (x) + 64 * n;
+  mpfr_init2 (y, p);
+  mpfr_init2 (z, p);
+  mpfr_set (y, c[n - 1], MPFR_RNDN);
+  for (i = n - 2; i >= 0; i--)
+    {
+      inex = mpfr_fma (z, y, x, c[i], MPFR_RNDN);
+      MPFR_ASSERTN (inex == 0);
+      mpfr_swap (y, z);
+    }
+  inex = mpfr_set (r, y, rnd);
+  mpfr_clears (y, z, (mpfr_ptr) 0);
+  return inex;
+}
+
+static void
+check_special (void)
+{
+  mpfr_t tab[3], x, r;
+  mpfr_ptr tabp[3];
+  int i, rnd;
+
+  mpfr_inits2 (53, tab[0], tab[1], tab[2], x, r, (mpfr_ptr) 0);
+  for (i = 0; i < 3; i++)
+    tabp[i] = tab[i];
+
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  RND_LOOP (rnd)
+    {
+      i = mpfr_poly_eval (r, tabp, 0, x, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || ! MPFR_IS_POS (r) || i != 0)
+        {
+          printf ("Special case n==0 failed for %s!\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+    }
+
+  /* 1 + 2x + 5x^2 at x = 3 */
+  mpfr_set_ui (tab[0], 1, MPFR_RNDN);
+  mpfr_set_ui (tab[1], 2, MPFR_RNDN);
+  mpfr_set_ui (tab[2], 5, MPFR_RNDN);
+  RND_LOOP (rnd)
+    {
+      i = mpfr_poly_eval (r, tabp, 3, x, (mpfr_rnd_t) rnd);
+      if (mpfr_cmp_ui (r, 52) != 0 || i != 0)
+        {
+          printf ("Special case 1+2x+5x^2 failed for %s!\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+    }
+
+  /* (x-1)^2 at x = 1 is an exact zero */
+  mpfr_set_ui (tab[0], 1, MPFR_RNDN);
+  mpfr_set_si (tab[1], -2, MPFR_RNDN);
+  mpfr_set_ui (tab[2], 1, MPFR_RNDN);
+  mpfr_set_ui (x, 1, MPFR_RNDN);
+  RND_LOOP (rnd)
+    {
+      i = mpfr_poly_eval (r, tabp, 3, x, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || i != 0 ||
+          (rnd == MPFR_RNDD ? MPFR_IS_POS (r) : MPFR_IS_NEG (r)))
+        {
+          printf ("Special case (x-1)^2 failed for %s!\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+    }
+
+  /* x = -0: the result is c[0] + (-0) + 0 = +0 for c[0] = -0 */
+  mpfr_set_zero (x, -1);
+  mpfr_set_zero (tab[0], -1);
+  i = mpfr_poly_eval (r, tabp, 3, x, MPFR_RNDN);
+  if (! MPFR_IS_ZERO (r) || ! MPFR_IS_POS (r) || i != 0)
+    {
+      printf ("Special case x=-0 failed!\n");
+      exit (1);
+    }
+  i = mpfr_poly_eval (r, tabp, 1, x, MPFR_RNDN);
+  if (! MPFR_IS_ZERO (r) || ! MPFR_IS_NEG (r) || i != 0)
+    {
+      printf ("Special case n=1, x=-0 failed!\n");
+      exit (1);
+    }
+
+  /* x = NaN */
+  mpfr_set_nan (x);
+  mpfr_clear_flags ();
+  i = mpfr_poly_eval (r, tabp, 3, x, MPFR_RNDN);
+  if (! MPFR_IS_NAN (r) || ! mpfr_nanflag_p ())
+    {
+      printf ("Special case x=NaN failed!\n");
+      exit (1);
+    }
+
+  /* x = -Inf: 1 - 2x + x^2 gives +Inf, 1 + 2x gives -Inf, and 1 + 2x + x^2
+     gives NaN (sum of the terms -Inf and +Inf) */
+  mpfr_set_inf (x, -1);
+  i = mpfr_poly_eval (r, tabp, 3, x, MPFR_RNDN);
+  if (! MPFR_IS_INF (r) || ! MPFR_IS_POS (r) || i != 0)
+    {
+      printf ("Special case x=-Inf failed!\n");
+      exit (1);
+    }
+  mpfr_set_si (tab[1], 2, MPFR_RNDN);
+  i = mpfr_poly_eval (r, tabp, 2, x, MPFR_RNDN);
+  if (! MPFR_IS_INF (r) || ! MPFR_IS_NEG (r) || i != 0)
+    {
+      printf ("Special case x=-Inf, n=2 failed!\n");
+      exit (1);
+    }
+  mpfr_clear_flags ();
+  i = mpfr_poly_eval (r, tabp, 3, x, MPFR_RNDN);
+  if (! MPFR_IS_NAN (r) || ! mpfr_nanflag_p ())
+    {
+      printf ("Special case x=-Inf, n=3 failed!\n");
+      exit (1);
+    }
+
+  /* Inf coefficient */
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  mpfr_set_inf (tab[1], -1);
+  i = mpfr_poly_eval (r, tabp, 3, x, MPFR_RNDN);
+  if (! MPFR_IS_INF (r) || ! MPFR_IS_NEG (r) || i != 0)
+    {
+      printf ("Special case c[1]=-Inf failed!\n");
+      exit (1);
+    }
+
+  mpfr_clears (tab[0], tab[1], tab[2], x, r, (mpfr_ptr) 0);
+}
+
+/* Compare mpfr_poly_eval with the reference on random polynomials of
+   degree less than nmax. If small is non-zero, the coefficients have small
+   precisions (as for series), so that Paterson-Stockmeyer's algorithm is
+   used for large degrees. */
+static void
+check_random (unsigned long nmax, int small, int ntests)
+{
+  mpfr_t tab[NMAX], x, r, s;
+  mpfr_ptr tabp[NMAX];
+  mpfr_prec_t p;
+  unsigned long n, i;
+  mpfr_rnd_t rnd;
+  int k, inex1, inex2;
+
+  for (k = 0; k < ntests; k++)
+    {
+      n = 1 + randlimb () % nmax;
+      p = MPFR_PREC_MIN + randlimb () % 300;
+      for (i = 0; i < n; i++)
+        {
+          mpfr_init2 (tab[i], small ? 1 + randlimb () % 16
+                      : MPFR_PREC_MIN + randlimb () % 200);
+          mpfr_urandomb (tab[i], RANDS);
+          mpfr_mul_2si (tab[i], tab[i], (long) (randlimb () % 17) - 8,
+                        MPFR_RNDN);
+          if (randlimb () & 1)
+            mpfr_neg (tab[i], tab[i], MPFR_RNDN);
+          tabp[i] = tab[i];
+        }
+      mpfr_init2 (x, MPFR_PREC_MIN + randlimb () % 200);
+      mpfr_init2 (r, p);
+      mpfr_init2 (s, p);
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (long) (randlimb () % 5) - 2, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      rnd = RND_RAND_NO_RNDF ();
+      inex1 = mpfr_poly_eval (r, tabp, n, x, rnd);
+      inex2 = poly_eval_ref (s, tabp, n, x, rnd);
+      if (! SAME_VAL (r, s) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in check_random for n=%lu, prec=%lu, rnd=%s\n",
+                  n, (unsigned long) p, mpfr_print_rnd_mode (rnd));
+          printf ("x = "); mpfr_dump (x);
+          printf ("expected "); mpfr_dump (s);
+          printf ("got      "); mpfr_dump (r);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+
+      /* reuse of x or of c[0] for the result */
+      if (MPFR_PREC (x) == p)
+        {
+          mpfr_poly_eval (x, tabp, n, x, rnd);
+          MPFR_ASSERTN (SAME_VAL (x, s));
+        }
+      else if (MPFR_PREC (tab[0]) == p)
+        {
+          mpfr_poly_eval (tab[0], tabp, n, x, rnd);
+          MPFR_ASSERTN (SAME_VAL (tab[0], s));
+        }
+
+      for (i = 0; i < n; i++)
+        mpfr_clear (tab[i]);
+      mpfr_clears (x, r, s, (mpfr_ptr) 0);
+    }
+}
+
+/* Check exact results that are not zero: (1 + x)^(n-1) at x = 1, whose
+   coefficients are binomial coefficients, is 2^(n-1). */
+static void
+check_exact (void)
+{
+  mpfr_t tab[NMAX], x, r;
+  mpfr_ptr tabp[NMAX];
+  mpz_t b;
+  unsigned long n = 40, i;
+  int inex, rnd;
+
+  mpz_init (b);
+  for (i = 0; i < n; i++)
+    {
+      mpfr_init2 (tab[i], 64);
+      mpz_bin_uiui (b, n - 1, i);
+      inex = mpfr_set_z (tab[i], b, MPFR_RNDN);
+      MPFR_ASSERTN (inex == 0);
+      tabp[i] = tab[i];
+    }
+  mpz_clear (b);
+  mpfr_inits2 (128, x, r, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 1, MPFR_RNDN);
+  RND_LOOP (rnd)
+    {
+      inex = mpfr_poly_eval (r, tabp, n, x, (mpfr_rnd_t) rnd);
+      if (mpfr_cmp_ui_2exp (r, 1, n - 1) != 0 || inex != 0)
+        {
+          printf ("Error in check_exact for %s\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          printf ("got "); mpfr_dump (r);
+          exit (1);
+        }
+    }
+  for (i = 0; i < n; i++)
+    mpfr_clear (tab[i]);
+  mpfr_clears (x, r, (mpfr_ptr) 0);
+}
+
+int
+main (int argc, char *argv[])
+{
+  tests_start_mpfr ();
+
+  check_special ();
+  check_exact ();
+  check_random (20, 0, 200);
+  check_random (NMAX, 1, 50);
+  check_random (NMAX, 0, 10);
+
+  tests_end_mpfr ();
+
+  return 0;
+}
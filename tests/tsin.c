@@ -354,6 +354,68 @@ check_212 (void)
   mpfr_clear (z);
 }
 
+/* Compare the direct computation of sin(x), used below
+   MPFR_SIN_DIRECT_THRESHOLD, with the one from cos(x) used above it,
+   for small arguments and arguments close to k*Pi/4. */
+static void
+check_direct (void)
+{
+  mpfr_prec_t p, p2;
+  mpfr_t x, y, z, t;
+  int i, k, inex1, inex2;
+  mpfr_rnd_t rnd;
+
+  p2 = MAX (MPFR_SIN_DIRECT_THRESHOLD, 2 * 200 + 64);
+  mpfr_init2 (t, p2);
+  for (p = MPFR_PREC_MIN; p <= 200; p += 1 + p / 4)
+    {
+      mpfr_init2 (x, p);
+      mpfr_init2 (y, p);
+      mpfr_init2 (z, p);
+      for (i = 0; i < 40; i++)
+        {
+          if (i < 16)
+            {
+              /* 2^(-i-1) <= |x| < 2^(-i) */
+              mpfr_urandomb (x, RANDS);
+              if (mpfr_zero_p (x))
+                continue;
+              mpfr_set_exp (x, -i);
+            }
+          else
+            {
+              /* x close to k*Pi/4 */
+              k = i - 20 + (i >= 20);
+              mpfr_const_pi (t, MPFR_RNDN);
+              mpfr_mul_si (t, t, k, MPFR_RNDN);
+              mpfr_div_2ui (t, t, 2, MPFR_RNDN);
+              mpfr_set (x, t, MPFR_RNDN);
+              if (randlimb () & 1)
+                mpfr_nextabove (x);
+            }
+          if (randlimb () & 1)
+            mpfr_neg (x, x, MPFR_RNDN);
+          rnd = RND_RAND_NO_RNDF ();
+          inex1 = mpfr_sin (y, x, rnd);
+          mpfr_sin (t, x, MPFR_RNDN);
+          inex2 = mpfr_set (z, t, rnd);
+          if (! mpfr_equal_p (y, z) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_direct for prec=%lu, rnd=%s\nx=",
+                      (unsigned long) p, mpfr_print_rnd_mode (rnd));
+              mpfr_dump (x);
+              printf ("expected "); mpfr_dump (z);
+              printf ("got      "); mpfr_dump (y);
+              exit (1);
+            }
+        }
+      mpfr_clear (x);
+      mpfr_clear (y);
+      mpfr_clear (z);
+    }
+  mpfr_clear (t);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -451,10 +513,12 @@ main (int argc, char *argv[])
 
   test_generic (MPFR_PREC_MIN, 100, 15);
   test_generic (MPFR_SINCOS_THRESHOLD-1, MPFR_SINCOS_THRESHOLD+1, 2);
+  test_generic (MPFR_SIN_DIRECT_THRESHOLD-1, MPFR_SIN_DIRECT_THRESHOLD+1, 2);
   test_sign ();
   check_tiny ();
   check_binary128 ();
   check_212 ();
+  check_direct ();
 
   data_check ("data/sin", mpfr_sin, "mpfr_sin");
   bad_cases (mpfr_sin, mpfr_asin, "mpfr_sin", 256, -40, 0, 4, 128, 800, 50);
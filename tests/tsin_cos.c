@@ -664,7 +664,170 @@ coverage_01032011 (void)
   mpfr_clears(val, cval, sval, svalf, (mpfr_ptr) 0);
 }
 
+/* Check sin(x), or cos(x) if cosine is non-zero, computed by mpfr_sin or
+   mpfr_cos, or by mpfr_sincos_fast if fast is non-zero, against its
+   approximation ref with an absolute error at most 2^(-err). */
+static void
+check_huge_one (mpfr_srcptr x, mpfr_srcptr ref, mpfr_exp_t err,
+                mpfr_rnd_t r, int fast, int cosine)
+{
+  mpfr_t y, z, yref;
+
+  if (MPFR_IS_ZERO (ref) ||
+      ! mpfr_can_round (ref, MPFR_GET_EXP (ref) + err, MPFR_RNDN, MPFR_RNDZ,
+                        MPFR_PREC (x) + (r == MPFR_RNDN)))
+    return;
+  mpfr_inits2 (MPFR_PREC (x), y, z, yref, (mpfr_ptr) 0);
+  mpfr_set (yref, ref, r);
+  if (fast)
+    mpfr_sincos_fast (cosine ? z : y, cosine ? y : z, x, r);
+  else if (cosine)
+    mpfr_cos (y, x, r);
+  else
+    mpfr_sin (y, x, r);
+  if (! mpfr_equal_p (y, yref))
+    {
+      printf ("Error in %s for a large argument, rnd=%s\n",
+              fast ? "mpfr_sincos_fast" : cosine ? "mpfr_cos" : "mpfr_sin",
+              mpfr_print_rnd_mode (r));
+      printf ("x = "); mpfr_dump (x);
+      printf ("expected "); mpfr_dump (yref);
+      printf ("got      "); mpfr_dump (y);
+      exit (1);
+    }
+  mpfr_clears (y, z, yref, (mpfr_ptr) 0);
+}
+
+/* Check the argument reduction of large arguments (see trig_reduce.c)
+   against a remainder by 2*Pi computed on EXP(x) + 100 more bits than the
+   target precision, for the target precision of x. */
+static void
+check_huge_args (void)
+{
+  mpfr_t x, pi2, xr, s, c;
+  mpfr_prec_t p, w;
+  mpfr_exp_t e;
+  mpfr_rnd_t r;
+  int i, fast;
+
+  for (i = 0; i < 200; i++)
+    {
+      /* a few tests of the reduction by Pi/2 of mpfr_sincos_fast */
+      fast = i < 6;
+      p = fast ? 1000 : MPFR_PREC_MIN + randlimb () % 300;
+      e = 2 + randlimb () % (i % 2 ? 100 : 5000);
+      w = p + 100;
+      mpfr_init2 (x, p);
+      mpfr_init2 (pi2, e + w);
+      mpfr_init2 (xr, w);
+      mpfr_inits2 (w, s, c, (mpfr_ptr) 0);
+      do
+        mpfr_urandomb (x, RANDS);
+      while (mpfr_zero_p (x));
+      mpfr_set_exp (x, e);
+      if (randlimb () % 2)
+        mpfr_neg (x, x, MPFR_RNDN);
+      mpfr_const_pi (pi2, MPFR_RNDN);
+      mpfr_mul_2ui (pi2, pi2, 1, MPFR_RNDN);
+      /* |xr - x - 2k*Pi| <= 2^(1-w), and the errors on s and c are less
+         than 2^(2-w) */
+      mpfr_remainder (xr, x, pi2, MPFR_RNDN);
+      mpfr_sin_cos (s, c, xr, MPFR_RNDN);
+      r = RND_RAND_NO_RNDF ();
+      check_huge_one (x, s, w - 2, r, fast, 0);
+      check_huge_one (x, c, w - 2, r, fast, 1);
+      mpfr_clears (x, pi2, xr, s, c, (mpfr_ptr) 0);
+    }
+}
+
 /* tsin_cos prec [N] performs N tests with prec bits */
+#ifdef MPFR_FIXED_MAXPREC
+/* Check that y = f(x) rounded with rnd and inexact flag inex, where t is
+   an approximation of f(x) with an error at most 1/2 ulp, if it can be
+   rounded. */
+static void
+check_fixed_one (const char *s, mpfr_srcptr x, mpfr_srcptr y, int inex,
+                 mpfr_srcptr t, mpfr_rnd_t rnd)
+{
+  mpfr_t z;
+  int inex2;
+
+  if (! mpfr_can_round (t, MPFR_PREC (t) - 1, MPFR_RNDN, MPFR_RNDZ,
+                        MPFR_PREC (y) + (rnd == MPFR_RNDN)))
+    return;
+  mpfr_init2 (z, MPFR_PREC (y));
+  inex2 = mpfr_set (z, t, rnd);
+  if (! mpfr_equal_p (y, z) || ! SAME_SIGN (inex, inex2))
+    {
+      printf ("Error in check_fixed for %s, prec=%lu, rnd=%s\nx=", s,
+              (unsigned long) MPFR_PREC (y), mpfr_print_rnd_mode (rnd));
+      mpfr_dump (x);
+      printf ("expected "); mpfr_dump (z);
+      printf ("got      "); mpfr_dump (y);
+      exit (1);
+    }
+  mpfr_clear (z);
+}
+
+/* Check the table-driven kernel used up to MPFR_FIXED_MAXPREC bits against
+   the general algorithm, for random arguments and arguments close to
+   k*Pi/2 + j/2^7, i.e., close to the boundaries of the tables. */
+static void
+check_fixed (void)
+{
+  mpfr_prec_t p, p2 = 2 * MPFR_FIXED_MAXPREC + 64;
+  mpfr_t x, y, z, s, c;
+  int i, inex;
+  mpfr_rnd_t rnd;
+
+  mpfr_inits2 (p2, s, c, (mpfr_ptr) 0);
+  for (p = MPFR_PREC_MIN; p <= MPFR_FIXED_MAXPREC; p++)
+    {
+      mpfr_inits2 (p, y, z, (mpfr_ptr) 0);
+      mpfr_init2 (x, MPFR_PREC_MIN + (randlimb () % (2 * p)));
+      for (i = 0; i < 20; i++)
+        {
+          if (i < 10)
+            {
+              /* 2^(e-1) <= |x| < 2^e with -20 <= e <= 30 */
+              mpfr_urandomb (x, RANDS);
+              if (mpfr_zero_p (x))
+                continue;
+              mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % 51) - 20);
+            }
+          else
+            {
+              mpfr_const_pi (s, MPFR_RNDN);
+              mpfr_mul_ui (s, s, randlimb () % 1000, MPFR_RNDN);
+              mpfr_div_2ui (s, s, 1, MPFR_RNDN);
+              mpfr_set_ui_2exp (c, randlimb () % 101, -7, MPFR_RNDN);
+              mpfr_add (s, s, c, MPFR_RNDN);
+              mpfr_set (x, s, MPFR_RNDN);
+              if (randlimb () & 1)
+                mpfr_nextabove (x);
+              if (mpfr_zero_p (x))
+                continue;
+            }
+          if (randlimb () & 1)
+            mpfr_neg (x, x, MPFR_RNDN);
+          rnd = RND_RAND_NO_RNDF ();
+          mpfr_sin_cos (s, c, x, MPFR_RNDN);
+          inex = mpfr_sin_cos (y, z, x, rnd);
+          check_fixed_one ("mpfr_sin_cos", x, y,
+                           (inex & 3) == 2 ? -1 : inex & 3, s, rnd);
+          check_fixed_one ("mpfr_sin_cos", x, z,
+                           (inex >> 2) == 2 ? -1 : inex >> 2, c, rnd);
+          inex = mpfr_sin (y, x, rnd);
+          check_fixed_one ("mpfr_sin", x, y, inex, s, rnd);
+          inex = mpfr_cos (z, x, rnd);
+          check_fixed_one ("mpfr_cos", x, z, inex, c, rnd);
+        }
+      mpfr_clears (x, y, z, (mpfr_ptr) 0);
+    }
+  mpfr_clears (s, c, (mpfr_ptr) 0);
+}
+#endif
+
 int
 main (int argc, char *argv[])
 {
@@ -688,6 +851,10 @@ main (int argc, char *argv[])
   consistency ();
 
   test_mpfr_sincos_fast ();
+  check_huge_args ();
+#ifdef MPFR_FIXED_MAXPREC
+  check_fixed ();
+#endif
 
   check_nans ();
 
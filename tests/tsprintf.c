@@ -44,6 +44,44 @@ const int prec_max_printf = 5000; /* limit for random precision in
 
 int randsize;
 
+/* Check mpfr_format_vapply with the format string fmt compiled by
+   mpfr_format_compile, with a full buffer or a random size, where
+   expected and n0 are the output and the return value of mpfr_vsprintf. */
+static void
+check_format_vapply (const char *expected, int n0, const char *fmt,
+                     va_list ap)
+{
+  mpfr_format_t f;
+  char buffer[BUF_SIZE];
+  int n1, size;
+
+  mpfr_format_compile (f, fmt);
+  size = randlimb () % 2 ? BUF_SIZE : (int) (randlimb () % (n0 + 1));
+  buffer[size < BUF_SIZE ? size : 0] = 17;
+  n1 = mpfr_format_vapply (size == 0 ? NULL : buffer, size, f, ap);
+  mpfr_format_clear (f);
+  if (n0 != n1 || (size < BUF_SIZE && buffer[size] != 17)
+      || (size != 0 && (strncmp (expected, buffer, size - 1) != 0
+                        || buffer[MIN (size - 1, n0)] != '\0')))
+    {
+      printf ("Error in mpfr_format_vapply (s, %d, f, ...) for \"%s\"\n",
+              size, fmt);
+      printf ("expected: %d \"%s\"\n", n0, expected);
+      printf ("got:      %d \"%s\"\n", n1, size == 0 ? "" : buffer);
+      exit (1);
+    }
+}
+
+static void
+check_format_apply (const char *expected, int n0, const char *fmt, ...)
+{
+  va_list ap;
+
+  va_start (ap, fmt);
+  check_format_vapply (expected, n0, fmt, ap);
+  va_end (ap);
+}
+
 /* 1. compare expected string with the string BUFFER returned by
    mpfr_sprintf(buffer, fmt, x)
    2. then test mpfr_snprintf (buffer, p, fmt, x) with a random p. */
@@ -100,6 +138,8 @@ check_sprintf (const char *expected, const char *fmt, mpfr_srcptr x)
       printf ("expected: \"%s\"\ngot:      \"%s\"\n", part_expected, buffer);
       exit (1);
     }
+
+  check_format_apply (expected, n0, fmt, x);
 }
 
 /* 1. compare expected string with the string BUFFER returned by
@@ -165,6 +205,10 @@ check_vsprintf (const char *expected, const char *fmt, ...)
       exit (1);
     }
 
+  va_start (ap1, fmt);
+  check_format_vapply (expected, n0, fmt, ap1);
+  va_end (ap1);
+
   return n0;
 }
 
@@ -1743,6 +1787,157 @@ check_null (void)
 #endif
 }
 
+/* Check mpfr_format_compile and the reuse of a compiled format string
+   (the other tests of mpfr_format_vapply are done by check_sprintf and
+   check_vsprintf). */
+static void
+format_compile (void)
+{
+  const char *interpreted[] = { "%n", "%d%Rn", "%Rd", "%",
+                                "%Rg%99999999999999999999999d" };
+  mpfr_format_t f;
+  mpfr_t x;
+  char s0[256], s1[256];
+  int i, n0, n1;
+
+  for (i = 0; i < numberof (interpreted); i++)
+    {
+      if (mpfr_format_compile (f, interpreted[i]) == 0)
+        {
+          printf ("Error in format_compile: \"%s\" should be interpreted\n",
+                  interpreted[i]);
+          exit (1);
+        }
+      mpfr_format_clear (f);
+    }
+
+  mpfr_init2 (x, 53);
+  if (mpfr_format_compile (f, "[%5d] %-8s t=%.6Rf err=%.3RDe%%%c%Pu") != 0)
+    {
+      printf ("Error in format_compile: the format should be compiled\n");
+      exit (1);
+    }
+  for (i = 0; i < 100; i++)
+    {
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (long) (randlimb () % 200) - 100, MPFR_RNDN);
+      if (i & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      n0 = mpfr_snprintf (s0, sizeof (s0),
+                          "[%5d] %-8s t=%.6Rf err=%.3RDe%%%c%Pu",
+                          i, "solver", x, x, 'A' + i % 26, mpfr_get_prec (x));
+      n1 = mpfr_format_apply (s1, sizeof (s1), f,
+                              i, "solver", x, x, 'A' + i % 26,
+                              mpfr_get_prec (x));
+      if (n0 != n1 || strcmp (s0, s1) != 0)
+        {
+          printf ("Error in format_compile for i = %d\n", i);
+          printf ("expected: %d \"%s\"\n", n0, s0);
+          printf ("got:      %d \"%s\"\n", n1, s1);
+          exit (1);
+        }
+    }
+  mpfr_format_clear (f);
+  mpfr_clear (x);
+
+  /* simple native conversion specifications, output directly */
+  {
+    const char *nfmt = "%-5d|%+d|% i|%05d|%-07d|%ld|%+ld|%lu|%u|%.2s|%-6s|"
+      "%3c|%s|%.10s|%06u%%";
+    const int iv[] = { 0, 1, -1, 123456, INT_MIN, INT_MAX };
+    const long lv[] = { 0, -17, LONG_MIN, LONG_MAX };
+
+    if (mpfr_format_compile (f, nfmt) != 0)
+      {
+        printf ("Error in format_compile: \"%s\" should be compiled\n",
+                nfmt);
+        exit (1);
+      }
+    for (i = 0; i < 24; i++)
+      {
+        int a = iv[i % numberof (iv)];
+        long l = lv[i % numberof (lv)];
+
+#define NATIVE_ARGS a, a, a, a, a, l, l, (unsigned long) l, (unsigned int) a, \
+          "abc", "xy", 'z', "", "0123456789abc", (unsigned int) i
+        n0 = mpfr_snprintf (s0, sizeof (s0), nfmt, NATIVE_ARGS);
+        n1 = mpfr_format_apply (s1, i < 20 ? sizeof (s1) : 7, f,
+                                NATIVE_ARGS);
+        if (n0 != n1 || strncmp (s0, s1, i < 20 ? sizeof (s1) : 6) != 0)
+          {
+            printf ("Error in format_compile (native) for i = %d\n", i);
+            printf ("expected: %d \"%s\"\n", n0, s0);
+            printf ("got:      %d \"%s\"\n", n1, s1);
+            exit (1);
+          }
+        n1 = mpfr_format_apply (NULL, 0, f, NATIVE_ARGS);
+#undef NATIVE_ARGS
+        if (n0 != n1)
+          {
+            printf ("Error in format_compile (native, size 0) for i = %d\n",
+                    i);
+            printf ("expected %d, got %d\n", n0, n1);
+            exit (1);
+          }
+      }
+    mpfr_format_clear (f);
+  }
+}
+
+/* With only MPFR conversion specifiers and a large enough buffer,
+   mpfr_snprintf and mpfr_format_apply should not allocate any memory for
+   numbers of usual precision and exponent (after a first call, which may
+   fill caches).
+   This is not checked when the temporary allocations may use the heap or
+   with the expensive assertions, which use temporary variables. */
+static void
+no_allocation (void)
+{
+#if !defined(MPFR_HAVE_GMP_IMPL) && MPFR_ALLOCA_MAX >= 4096 \
+  && MPFR_WANT_ASSERT < 2
+  const char *fmt[] = { "%.17Rg", "%Re", "%RDe", "%Ra", "%Rb", "%.30Rf",
+                        "%'20.5Rf", "%-+12.3RUg|", "% .0Rf" };
+  mpfr_prec_t prec[] = { 24, 53, 64, 113 };
+  long e[] = { 0, 20, -20, 1000, -1000 };
+  char buf[512];
+  mpfr_t x;
+  int i, j, k, r, r2;
+
+  if (tests_memory_disabled)
+    return;
+
+  for (j = 0; j < numberof (prec); j++)
+    for (k = 0; k < numberof (e); k++)
+      {
+        mpfr_init2 (x, prec[j]);
+        mpfr_const_pi (x, MPFR_RNDN);
+        mpfr_mul_2si (x, x, e[k], MPFR_RNDN);
+        if (k & 1)
+          mpfr_neg (x, x, MPFR_RNDN);
+        for (i = 0; i < numberof (fmt); i++)
+          {
+            mpfr_format_t f;
+
+            mpfr_snprintf (buf, sizeof (buf), fmt[i], x);
+            mpfr_format_compile (f, fmt[i]);
+            tests_reset_maxsize ();
+            r = mpfr_snprintf (buf, sizeof (buf), fmt[i], x);
+            r2 = mpfr_format_apply (buf, sizeof (buf), f, x);
+            if (tests_get_maxsize () != 0 || r <= 0 || r2 != r)
+              {
+                printf ("Error in no_allocation for format %s, "
+                        "prec = %ld, e = %ld\n", fmt[i], (long) prec[j], e[k]);
+                printf ("got r = %d, r2 = %d, maxsize = %lu\n", r, r2,
+                        (unsigned long) tests_get_maxsize ());
+                exit (1);
+              }
+            mpfr_format_clear (f);
+          }
+        mpfr_clear (x);
+      }
+#endif
+}
+
 #if defined(HAVE_LOCALE_H) && defined(HAVE_SETLOCALE)
 
 /* The following tests should be equivalent to those from test_locale()
@@ -1919,6 +2114,8 @@ main (int argc, char **argv)
   check_length_overflow ();
   large_prec_for_g ();
   check_null ();
+  format_compile ();
+  no_allocation ();
   test_locale ();
 
   if (getenv ("MPFR_CHECK_LIBC_PRINTF"))
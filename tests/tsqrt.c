@@ -921,6 +921,63 @@ coverage (void)
     }
 }
 
+/* Check mpfr_sqrt_newton against the classical square root (the Newton
+   step is not used by mpfr_sqrt for these precisions with the default
+   threshold). It may fail (return 0), but not too often, and must fail
+   when the square root is exact. */
+static void
+check_newton (int n)
+{
+  mpfr_t u, s1, s2;
+  mpfr_prec_t p;
+  mpfr_rnd_t rnd;
+  int i, inex1, inex2, nfail = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      p = MPFR_NEWTON_PREC_MIN + randlimb () % 5000;
+      mpfr_inits2 (p, s1, s2, (mpfr_ptr) 0);
+      mpfr_init2 (u, p + (randlimb () % 256) - 128);
+      mpfr_urandomb (u, RANDS);
+      if (mpfr_zero_p (u))
+        goto next;
+      mpfr_mul_2si (u, u, (long) (randlimb () % 64) - 32, MPFR_RNDN);
+      rnd = RND_RAND_NO_RNDF ();
+      inex1 = mpfr_sqrt (s1, u, rnd);
+      inex2 = mpfr_sqrt_newton (s2, u, rnd);
+      if (inex2 == 0)
+        nfail++;
+      else if (! mpfr_equal_p (s1, s2) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in mpfr_sqrt_newton for p=%lu, rnd=%s\n",
+                  (unsigned long) p, mpfr_print_rnd_mode (rnd));
+          printf ("u = ");
+          mpfr_dump (u);
+          printf ("expected ");
+          mpfr_dump (s1);
+          printf ("got      ");
+          mpfr_dump (s2);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+
+      /* exact square root: u = s1^2 (exact square), thus sqrt(u) = s1 */
+      mpfr_set_prec (u, 2 * p);
+      inex1 = mpfr_sqr (u, s1, MPFR_RNDN);
+      MPFR_ASSERTN (inex1 == 0);
+      inex2 = mpfr_sqrt_newton (s2, u, rnd);
+      MPFR_ASSERTN (inex2 == 0);
+    next:
+      mpfr_clears (u, s1, s2, (mpfr_ptr) 0);
+    }
+
+  if (nfail > n / 10)
+    {
+      printf ("mpfr_sqrt_newton failed %d times out of %d\n", nfail, n);
+      exit (1);
+    }
+}
+
 #define TEST_FUNCTION test_sqrt
 #define TEST_RANDOM_POS 8
 #include "tgeneric.c"
@@ -934,6 +991,7 @@ main (void)
   tests_start_mpfr ();
 
   coverage ();
+  check_newton (200);
   check_underflow ();
   check_overflow ();
   testall_rndf (16);
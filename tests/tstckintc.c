@@ -68,6 +68,92 @@ test_get_size (void)
 
 /*************************************************************************/
 
+/* Test the tables of mpfr_custom_table_init: fill a table, copy it as it
+   would be read from a file, and check the views of its entries. */
+#define TABLE_N 50
+static void
+test_table (void)
+{
+  mpfr_prec_t p;
+  size_t size, i;
+  mp_limb_t *t, *u;
+  mpfr_t x, y[TABLE_N], v;
+  char *s;
+  int inex;
+
+  mpfr_init2 (x, 300);
+  for (p = 1; p <= 300; p += 37)
+    {
+      size = mpfr_custom_table_size (p, TABLE_N);
+      MPFR_ASSERTN (size % sizeof (mp_limb_t) == 0);
+      t = (mp_limb_t *) tests_allocate (size);
+      u = (mp_limb_t *) tests_allocate (size);
+      mpfr_custom_table_init (t, p, TABLE_N);
+      for (i = 0; i < TABLE_N; i++)
+        {
+          mpfr_init2 (y[i], p);
+          if (i == 1)
+            mpfr_set_inf (x, -1);
+          else if (i == 2)
+            mpfr_set_zero (x, -1);
+          else if (i == 3)
+            mpfr_set_nan (x);  /* entry 3 is left as NaN */
+          else
+            {
+              mpfr_urandomb (x, RANDS);
+              mpfr_mul_2si (x, x, (long) (i * 1000) - 20000, MPFR_RNDN);
+              if (i & 1)
+                mpfr_neg (x, x, MPFR_RNDN);
+            }
+          inex = mpfr_set (y[i], x, MPFR_RNDZ);
+          if (i != 3 && mpfr_custom_table_set (t, i, x, MPFR_RNDZ) != inex)
+            {
+              printf ("Error in test_table: wrong ternary value for p = %ld,"
+                      " i = %lu\n", (long) p, (unsigned long) i);
+              exit (1);
+            }
+        }
+      memcpy (u, t, size);
+      memset (t, 0xff, size);
+
+      MPFR_ASSERTN (mpfr_custom_table_check (u, size) == TABLE_N);
+      MPFR_ASSERTN (mpfr_custom_table_check (t, size) == 0);
+      MPFR_ASSERTN (mpfr_custom_table_check (u, size - 1) == 0);
+      MPFR_ASSERTN (mpfr_custom_table_check (u, 4 * sizeof (mp_limb_t)) == 0);
+      u[1]++;  /* another limb size */
+      MPFR_ASSERTN (mpfr_custom_table_check (u, size) == 0);
+      u[1]--;
+
+      for (i = 0; i < TABLE_N; i++)
+        {
+          mpfr_custom_table_get (v, u, i);
+          /* the significand is in the table */
+          s = (char *) mpfr_custom_get_significand (v);
+          MPFR_ASSERTN (s > (char *) u && s < (char *) u + size);
+          /* use the view as an input */
+          mpfr_set (x, v, MPFR_RNDN);
+          if (mpfr_get_prec (v) != p || mpfr_signbit (v) != mpfr_signbit (x)
+              || ! (mpfr_nan_p (x) ? mpfr_nan_p (y[i]) :
+                    mpfr_equal_p (x, y[i])))
+            {
+              printf ("Error in test_table for p = %ld, i = %lu\n",
+                      (long) p, (unsigned long) i);
+              printf ("expected ");
+              mpfr_dump (y[i]);
+              printf ("got      ");
+              mpfr_dump (v);
+              exit (1);
+            }
+          mpfr_clear (y[i]);
+        }
+      tests_free (t, size);
+      tests_free (u, size);
+    }
+  mpfr_clear (x);
+}
+
+/*************************************************************************/
+
 #define BUFFER_SIZE 250
 #define PREC_TESTED 200
 
@@ -508,6 +594,7 @@ main (void)
 {
   tests_start_mpfr ();
   test_get_size ();
+  test_table ();
   /* We test iff long = mp_limb_t */
   if (sizeof (long) == sizeof (mp_limb_t))
     {
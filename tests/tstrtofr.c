@@ -1601,6 +1601,270 @@ random_tests (void)
     }
 }
 
+static void
+check_mpn_set_str_aux (int b, unsigned char *str, size_t len)
+{
+  mp_limb_t *r1, *r2;
+  mp_size_t n, n1, n2;
+
+  n = len * 6 / GMP_NUMB_BITS + 2;  /* enough for b <= 64 */
+  r1 = (mp_limb_t *) tests_allocate (n * sizeof (mp_limb_t));
+  r2 = (mp_limb_t *) tests_allocate (n * sizeof (mp_limb_t));
+  n1 = mpn_set_str (r1, str, len, b);
+  n2 = mpfr_mpn_set_str (r2, str, len, b);
+  if (n1 != n2 || mpn_cmp (r1, r2, n1) != 0)
+    {
+      printf ("Error in mpfr_mpn_set_str for b=%d, len=%lu\n", b,
+              (unsigned long) len);
+      exit (1);
+    }
+  tests_free (r1, n * sizeof (mp_limb_t));
+  tests_free (r2, n * sizeof (mp_limb_t));
+}
+
+static void
+check_mpn_set_str (void)
+{
+  static int base[] = { 3, 10, 7, 10, 36, 62, 12 };
+  unsigned char *str;
+  size_t len, j;
+  int i, l;
+
+  for (i = 0; i < numberof (base); i++)
+    {
+      int b = base[i];
+
+      /* b^(len-1) >= 2^(l*(len-1)), thus the string of len digits has at
+         least MPFR_SET_STR_DC_THRESHOLD limbs */
+      for (l = 1; (2 << l) <= b; l++)
+        ;
+      len = (MPFR_SET_STR_DC_THRESHOLD + randlimb () % 5000)
+        * GMP_NUMB_BITS / l + 1;
+      str = (unsigned char *) tests_allocate (len);
+
+      /* random digits */
+      for (j = 0; j < len; j++)
+        str[j] = randlimb () % b;
+      str[0] |= 1;
+      check_mpn_set_str_aux (b, str, len);
+      check_mpn_set_str_aux (b, str, 100);
+      /* long runs of zeros or of digits b-1 in the middle */
+      memset (str + len / 3, 0, len / 3);
+      check_mpn_set_str_aux (b, str, len);
+      memset (str + len / 3, b - 1, len / 3);
+      check_mpn_set_str_aux (b, str, len);
+      /* b^(len-1), b^(len-1) + 1 and b^len - 1 */
+      memset (str, 0, len);
+      str[0] = 1;
+      check_mpn_set_str_aux (b, str, len);
+      str[len - 1] = 1;
+      check_mpn_set_str_aux (b, str, len);
+      memset (str, b - 1, len);
+      check_mpn_set_str_aux (b, str, len);
+
+      tests_free (str, len);
+      if (i == 3)
+        mpfr_free_cache ();
+    }
+}
+
+/* Check that the exact decimal expansion of 3*2^(-N), which has about
+   0.7*N digits, is parsed into the exact value in a small precision, and
+   that changing its last digit gives an inexact result. */
+static void
+check_huge_exact (void)
+{
+  mpfr_t x, y;
+  mpfr_exp_t e;
+  char *s, *t;
+  size_t m;
+  int inex;
+
+  mpfr_init2 (x, 2);
+  mpfr_init2 (y, 53);
+  mpfr_set_ui_2exp (x, 3, -60000, MPFR_RNDN);
+  s = mpfr_get_str (NULL, &e, 10, 50000, x, MPFR_RNDN);
+  m = strlen (s);
+  t = (char *) tests_allocate (m + 32);
+  sprintf (t, "%s@%ld", s, (long) (e - (mpfr_exp_t) m));
+
+  inex = mpfr_strtofr (y, t, NULL, 10, MPFR_RNDN);
+  if (inex != 0 || ! mpfr_equal_p (x, y))
+    {
+      printf ("Error in check_huge_exact (exact case), inex = %d\n", inex);
+      printf ("y = ");
+      mpfr_dump (y);
+      exit (1);
+    }
+
+  /* the last significant digit is 5 */
+  m = strrchr (t, '5') - t;
+  t[m] = '6';
+  inex = mpfr_strtofr (y, t, NULL, 10, MPFR_RNDZ);
+  if (inex >= 0 || ! mpfr_equal_p (x, y))
+    {
+      printf ("Error in check_huge_exact (RNDZ), inex = %d\n", inex);
+      printf ("y = ");
+      mpfr_dump (y);
+      exit (1);
+    }
+  inex = mpfr_strtofr (y, t, NULL, 10, MPFR_RNDU);
+  mpfr_nextbelow (y);
+  if (inex <= 0 || ! mpfr_equal_p (x, y))
+    {
+      printf ("Error in check_huge_exact (RNDU), inex = %d\n", inex);
+      printf ("y = ");
+      mpfr_dump (y);
+      exit (1);
+    }
+
+  tests_free (t, strlen (s) + 32);
+  mpfr_free_str (s);
+  mpfr_clear (x);
+  mpfr_clear (y);
+}
+
+/* Check the strings parsed by the fast path for short decimal strings,
+   in base 0 or 10, against the correct rounding of the exact value given
+   by mpfr_set_q, for all the formats of the significand and exponent, and
+   with a reduced exponent range to get underflows and overflows. */
+static void
+check_short (void)
+{
+  static const char *exact[] = {
+    "9007199254740993", "4503599627370496.5", "0.1", "1.5", "0.125e-2",
+    "-100000000000000000000e-20", "1180591620717411303424e-1",
+    "123456789012345678901", "-0.00000000000000000000000009999",
+    "7.2057594037927933e16", "1e5150", "1e-5150", "1e5160", "2.5e-5160" };
+  mpfr_t x, y;
+  mpz_t z, t;
+  mpq_t q;
+  char s[128], dig[32], *end;
+  long E;
+  int i, k, nd, base, inex, inex2, r;
+  mpfr_flags_t flags, flags2;
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+
+  mpfr_inits2 (128, x, y, (mpfr_ptr) 0);
+  mpz_init (z);
+  mpz_init (t);
+  mpq_init (q);
+  for (i = 0; i < 20000; i++)
+    {
+      mpfr_prec_t p = i % 4 == 0 ? 53 : 2 + randlimb () % 127;
+
+      mpfr_set_prec (x, p);
+      mpfr_set_prec (y, p);
+      r = RND_RAND_NO_RNDF ();
+      base = (randlimb () & 1) ? 0 : 10;
+      if (i < numberof (exact))
+        {
+          strcpy (s, exact[i]);
+          strcat (s, ",");
+        }
+      else
+        {
+          /* a significand of nd digits, with the point after k digits */
+          nd = 1 + randlimb () % 21;
+          for (k = 0; k < nd; k++)
+            dig[k] = '0' + randlimb () % 10;
+          dig[nd] = '\0';
+          k = randlimb () % (nd + 1);
+          E = (long) (randlimb () % 801) - 400;
+          if (randlimb () % 8 == 0)
+            E *= 13;
+          sprintf (s, "%s%s%s%.*s%s%s%s", (randlimb () & 1) ? " \t" : "",
+                   (randlimb () & 1) ? "-" : "+",
+                   (randlimb () & 1) ? "000" : "", k, dig,
+                   k < nd || (randlimb () & 1) ? "." : "", dig + k,
+                   (randlimb () & 1) ? "000" : "");
+          if (E != 0 || (randlimb () & 1))
+            sprintf (s + strlen (s), "%c%ld%s", (randlimb () & 1) ? 'e' : 'E',
+                     E, (randlimb () & 1) ? "xyz" : "");
+        }
+      if (i % 3 == 0)
+        {
+          set_emin (-1100);
+          set_emax (1100);
+        }
+
+      /* q = the exact value of s */
+      {
+        const char *c = s;
+        int neg = 0;
+        long nf = 0;
+
+        mpz_set_ui (z, 0);
+        E = 0;
+        while (*c == ' ' || *c == '\t')
+          c++;
+        if (*c == '-' || *c == '+')
+          neg = *c++ == '-';
+        for (k = 0; *c != '\0'; c++)
+          {
+            if (*c == '.')
+              k = 1;
+            else if (*c >= '0' && *c <= '9')
+              {
+                mpz_mul_ui (z, z, 10);
+                mpz_add_ui (z, z, *c - '0');
+                nf += k;
+              }
+            else
+              break;
+          }
+        if (*c == 'e' || *c == 'E')
+          E = strtol (c + 1, NULL, 10);
+        E -= nf;
+        mpz_ui_pow_ui (t, 10, E < 0 ? -E : E);
+        if (E >= 0)
+          {
+            mpz_mul (z, z, t);
+            mpz_set_ui (t, 1);
+          }
+        if (neg)
+          mpz_neg (z, z);
+        mpq_set_num (q, z);
+        mpq_set_den (q, t);
+        mpq_canonicalize (q);
+      }
+
+      mpfr_clear_flags ();
+      inex = mpfr_strtofr (x, s, &end, base, (mpfr_rnd_t) r);
+      flags = __gmpfr_flags;
+      mpfr_clear_flags ();
+      inex2 = mpfr_set_q (y, q, (mpfr_rnd_t) r);
+      flags2 = __gmpfr_flags;
+      if (mpq_sgn (q) == 0 && s[strspn (s, " \t")] == '-')
+        mpfr_neg (y, y, MPFR_RNDN);
+      set_emin (emin);
+      set_emax (emax);
+      if (! mpfr_equal_p (x, y) || MPFR_SIGN (x) != MPFR_SIGN (y) ||
+          ! SAME_SIGN (inex, inex2) || flags != flags2 ||
+          strcspn (s, "xyz,") != end - s)
+        {
+          printf ("Error in check_short for s = \"%s\", base %d, %s, "
+                  "prec %ld\n", s, base, mpfr_print_rnd_mode ((mpfr_rnd_t) r),
+                  (long) p);
+          printf ("got      ");
+          mpfr_dump (x);
+          printf ("expected ");
+          mpfr_dump (y);
+          printf ("inex = %d, expected %d, end = %ld\n", inex, inex2,
+                  (long) (end - s));
+          printf ("flags =");
+          flags_out (flags);
+          printf ("expected");
+          flags_out (flags2);
+          exit (1);
+        }
+    }
+  mpq_clear (q);
+  mpz_clear (z);
+  mpz_clear (t);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1621,6 +1885,9 @@ main (int argc, char *argv[])
   bug20181127 ();
   bug20230606 ();
   random_tests ();
+  check_mpn_set_str ();
+  check_huge_exact ();
+  check_short ();
 
   tests_end_mpfr ();
   return 0;
@@ -0,0 +1,240 @@
+/* Test file for mpfr_tan_sec and mpfr_sin_cos_tan.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include "mpfr-test.h"
+
+/* Check mpfr_tan_sec against mpfr_tan and mpfr_sec (values, ternary
+   values and flags) on x, with output precisions py and pz. If alias is 1
+   (resp. 2), the first (resp. second) output is x itself (thus has the
+   precision of x). */
+static void
+check (mpfr_srcptr x, mpfr_prec_t py, mpfr_prec_t pz, mpfr_rnd_t rnd,
+       int alias)
+{
+  mpfr_t y1, z1, y2, z2;
+  int inex1, inex2, inex_y, inex_z;
+  mpfr_flags_t flags1, flags2;
+
+  if (alias == 1)
+    py = MPFR_PREC (x);
+  else if (alias == 2)
+    pz = MPFR_PREC (x);
+  mpfr_inits2 (py, y1, y2, (mpfr_ptr) 0);
+  mpfr_inits2 (pz, z1, z2, (mpfr_ptr) 0);
+
+  mpfr_clear_flags ();
+  inex_y = mpfr_tan (y1, x, rnd);
+  inex_z = mpfr_sec (z1, x, rnd);
+  inex1 = INEX (inex_y, inex_z);
+  flags1 = __gmpfr_flags;
+
+  if (alias == 1)
+    {
+      mpfr_set (y2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_tan_sec (y2, z2, y2, rnd);
+      flags2 = __gmpfr_flags;
+    }
+  else if (alias == 2)
+    {
+      mpfr_set (z2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_tan_sec (y2, z2, z2, rnd);
+      flags2 = __gmpfr_flags;
+    }
+  else
+    {
+      mpfr_clear_flags ();
+      inex2 = mpfr_tan_sec (y2, z2, x, rnd);
+      flags2 = __gmpfr_flags;
+    }
+
+  if (! (SAME_VAL (y1, y2) && SAME_VAL (z1, z2) && inex1 == inex2 &&
+         flags1 == flags2))
+    {
+      printf ("Error in mpfr_tan_sec for rnd=%s, alias=%d, x=\n",
+              mpfr_print_rnd_mode (rnd), alias);
+      mpfr_dump (x);
+      printf ("expected tan   "); mpfr_dump (y1);
+      printf ("got            "); mpfr_dump (y2);
+      printf ("expected sec   "); mpfr_dump (z1);
+      printf ("got            "); mpfr_dump (z2);
+      printf ("expected inex = %d, flags =", inex1);
+      flags_out (flags1);
+      printf ("got      inex = %d, flags =", inex2);
+      flags_out (flags2);
+      exit (1);
+    }
+
+  mpfr_clears (y1, z1, y2, z2, (mpfr_ptr) 0);
+}
+
+/* Check mpfr_sin_cos_tan against mpfr_sin, mpfr_cos and mpfr_tan, as
+   above; alias is 0 or the number of the output that is x itself. */
+static void
+check3 (mpfr_srcptr x, mpfr_prec_t ps, mpfr_prec_t pc, mpfr_prec_t pt,
+        mpfr_rnd_t rnd, int alias)
+{
+  mpfr_t s1, c1, t1, s2, c2, t2;
+  int inex1, inex2, inex_s, inex_c, inex_t;
+  mpfr_flags_t flags1, flags2;
+
+  if (alias == 1)
+    ps = MPFR_PREC (x);
+  else if (alias == 2)
+    pc = MPFR_PREC (x);
+  else if (alias == 3)
+    pt = MPFR_PREC (x);
+  mpfr_inits2 (ps, s1, s2, (mpfr_ptr) 0);
+  mpfr_inits2 (pc, c1, c2, (mpfr_ptr) 0);
+  mpfr_inits2 (pt, t1, t2, (mpfr_ptr) 0);
+
+  mpfr_clear_flags ();
+  inex_s = mpfr_sin (s1, x, rnd);
+  inex_c = mpfr_cos (c1, x, rnd);
+  inex_t = mpfr_tan (t1, x, rnd);
+  inex1 = INEX3 (inex_s, inex_c, inex_t);
+  flags1 = __gmpfr_flags;
+
+  if (alias == 1)
+    {
+      mpfr_set (s2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_sin_cos_tan (s2, c2, t2, s2, rnd);
+    }
+  else if (alias == 2)
+    {
+      mpfr_set (c2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_sin_cos_tan (s2, c2, t2, c2, rnd);
+    }
+  else if (alias == 3)
+    {
+      mpfr_set (t2, x, MPFR_RNDN);
+      mpfr_clear_flags ();
+      inex2 = mpfr_sin_cos_tan (s2, c2, t2, t2, rnd);
+    }
+  else
+    {
+      mpfr_clear_flags ();
+      inex2 = mpfr_sin_cos_tan (s2, c2, t2, x, rnd);
+    }
+  flags2 = __gmpfr_flags;
+
+  if (! (SAME_VAL (s1, s2) && SAME_VAL (c1, c2) && SAME_VAL (t1, t2) &&
+         inex1 == inex2 && flags1 == flags2))
+    {
+      printf ("Error in mpfr_sin_cos_tan for rnd=%s, alias=%d, x=\n",
+              mpfr_print_rnd_mode (rnd), alias);
+      mpfr_dump (x);
+      printf ("expected sin "); mpfr_dump (s1);
+      printf ("got          "); mpfr_dump (s2);
+      printf ("expected cos "); mpfr_dump (c1);
+      printf ("got          "); mpfr_dump (c2);
+      printf ("expected tan "); mpfr_dump (t1);
+      printf ("got          "); mpfr_dump (t2);
+      printf ("expected inex = %d, flags =", inex1);
+      flags_out (flags1);
+      printf ("got      inex = %d, flags =", inex2);
+      flags_out (flags2);
+      exit (1);
+    }
+
+  mpfr_clears (s1, c1, t1, s2, c2, t2, (mpfr_ptr) 0);
+}
+
+static void
+check_special (void)
+{
+  mpfr_t x;
+  int rnd;
+
+  mpfr_init2 (x, 17);
+  RND_LOOP_NO_RNDF (rnd)
+    {
+      mpfr_set_nan (x);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_inf (x, 1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_inf (x, -1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_set_zero (x, 1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 1);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 3);
+      mpfr_set_zero (x, -1);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 2);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 1);
+      /* tiny x */
+      mpfr_set_si_2exp (x, 1, -100, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+      mpfr_neg (x, x, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+      /* close to Pi/2 */
+      mpfr_const_pi (x, MPFR_RNDN);
+      mpfr_div_2ui (x, x, 1, MPFR_RNDN);
+      check (x, 17, 17, (mpfr_rnd_t) rnd, 0);
+      check3 (x, 17, 17, 17, (mpfr_rnd_t) rnd, 0);
+    }
+  mpfr_clear (x);
+}
+
+static void
+check_random (int n)
+{
+  mpfr_t x;
+  int i;
+
+  mpfr_init (x);
+  for (i = 0; i < n; i++)
+    {
+      mpfr_set_prec (x, MPFR_PREC_MIN + randlimb () % 200);
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (long) (randlimb () % 40) - 30, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      check (x, MPFR_PREC_MIN + randlimb () % 200,
+             MPFR_PREC_MIN + randlimb () % 200, RND_RAND_NO_RNDF (),
+             randlimb () % 3);
+      check3 (x, MPFR_PREC_MIN + randlimb () % 200,
+              MPFR_PREC_MIN + randlimb () % 200,
+              MPFR_PREC_MIN + randlimb () % 200, RND_RAND_NO_RNDF (),
+              randlimb () % 4);
+    }
+  mpfr_clear (x);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_special ();
+  check_random (1000);
+
+  tests_end_mpfr ();
+  return 0;
+}
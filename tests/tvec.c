@@ -0,0 +1,231 @@
+/* Test file for mpfr_exp_vec, mpfr_log_vec, mpfr_sin_vec, mpfr_cos_vec and
+   mpfr_sin_cos_vec.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 64
+
+typedef int (*vec_fun) (int *, const mpfr_ptr *, const mpfr_ptr *,
+                        unsigned long, mpfr_rnd_t);
+typedef int (*fun) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+/* Set x to a random input: a special value, +/-1, or a random number
+   whose exponent is small in most cases, but may be large enough for
+   exp to overflow or underflow in a reduced exponent range. */
+static void
+random_input (mpfr_ptr x)
+{
+  switch (randlimb () % 16)
+    {
+    case 0:
+      mpfr_set_nan (x);
+      break;
+    case 1:
+      mpfr_set_inf (x, RAND_SIGN ());
+      break;
+    case 2:
+      mpfr_set_zero (x, RAND_SIGN ());
+      break;
+    case 3:
+      mpfr_set_si (x, RAND_SIGN (), MPFR_RNDN);
+      break;
+    default:
+      mpfr_urandomb (x, RANDS);
+      if (MPFR_IS_ZERO (x))
+        mpfr_set_ui (x, 3, MPFR_RNDN);
+      mpfr_mul_2si (x, x, randlimb () % 8 == 0 ?
+                    (long) (randlimb () % 13) : (long) (randlimb () % 41) - 30,
+                    MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+    }
+}
+
+/* Compare vf on N random inputs with a loop on f. If alias is non-zero,
+   the results are computed in place. */
+static void
+check_fun (const char *name, vec_fun vf, fun f, int alias, int reduced)
+{
+  mpfr_t x[N], y[N], z[N];
+  mpfr_ptr xp[N], yp[N];
+  int t[N], inex[N], i, res;
+  mpfr_rnd_t rnd = RND_RAND_NO_RNDF ();
+  mpfr_flags_t flags1, flags2;
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_prec_t py = MPFR_PREC_MIN + (randlimb () & 1 ? randlimb () % 128
+                                        : randlimb () % 300);
+
+      mpfr_init2 (x[i], alias ? py : MPFR_PREC_MIN + randlimb () % 200);
+      mpfr_init2 (y[i], py);
+      mpfr_init2 (z[i], py);
+      random_input (x[i]);
+      xp[i] = x[i];
+      yp[i] = alias ? x[i] : y[i];
+    }
+
+  if (reduced)
+    {
+      set_emin (-100);
+      set_emax (100);
+    }
+
+  mpfr_clear_flags ();
+  mpfr_set_erangeflag ();
+  res = 0;
+  for (i = 0; i < N; i++)
+    {
+      inex[i] = f (z[i], x[i], rnd);
+      res |= inex[i];
+    }
+  flags1 = __gmpfr_flags;
+
+  mpfr_clear_flags ();
+  mpfr_set_erangeflag ();
+  i = vf (t, yp, xp, N, rnd);
+  flags2 = __gmpfr_flags;
+
+  set_emin (MPFR_EMIN_DEFAULT);
+  set_emax (MPFR_EMAX_DEFAULT);
+
+  if ((i != 0) != (res != 0) || flags1 != flags2)
+    {
+      printf ("Error in mpfr_%s_vec (%s, reduced=%d):\n", name,
+              mpfr_print_rnd_mode (rnd), reduced);
+      printf ("return values %d and %d\n", res, i);
+      printf ("expected flags:"); flags_out (flags1);
+      printf ("got flags:     "); flags_out (flags2);
+      exit (1);
+    }
+  for (i = 0; i < N; i++)
+    if (! SAME_VAL (yp[i], z[i]) || ! SAME_SIGN (t[i], inex[i]))
+      {
+        printf ("Error in mpfr_%s_vec (%s, reduced=%d) for i=%d:\n",
+                name, mpfr_print_rnd_mode (rnd), reduced, i);
+        printf ("expected "); mpfr_dump (z[i]);
+        printf ("got      "); mpfr_dump (yp[i]);
+        printf ("inex = %d, expected %d\n", t[i], inex[i]);
+        exit (1);
+      }
+
+  /* t may be NULL */
+  if (! alias)
+    {
+      i = vf (NULL, yp, xp, N, rnd);
+      MPFR_ASSERTN ((i != 0) == (res != 0));
+    }
+
+  for (i = 0; i < N; i++)
+    mpfr_clears (x[i], y[i], z[i], (mpfr_ptr) 0);
+}
+
+static void
+check_sin_cos (int reduced)
+{
+  mpfr_t x[N], s[N], c[N], s2, c2;
+  mpfr_ptr xp[N], sp[N], cp[N];
+  int t[N], inex, i;
+  mpfr_rnd_t rnd = RND_RAND_NO_RNDF ();
+  mpfr_flags_t flags1, flags2;
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_init2 (x[i], MPFR_PREC_MIN + randlimb () % 200);
+      mpfr_init2 (s[i], MPFR_PREC_MIN + randlimb () % 160);
+      mpfr_init2 (c[i], MPFR_PREC_MIN + randlimb () % 160);
+      random_input (x[i]);
+      xp[i] = x[i];
+      sp[i] = s[i];
+      cp[i] = c[i];
+    }
+
+  if (reduced)
+    {
+      set_emin (-3);
+      set_emax (1);
+    }
+
+  mpfr_clear_flags ();
+  mpfr_sin_cos_vec (t, sp, cp, xp, N, rnd);
+  flags2 = __gmpfr_flags;
+
+  mpfr_clear_flags ();
+  for (i = 0; i < N; i++)
+    {
+      mpfr_init2 (s2, MPFR_PREC (s[i]));
+      mpfr_init2 (c2, MPFR_PREC (c[i]));
+      inex = mpfr_sin_cos (s2, c2, x[i], rnd);
+      if (! SAME_VAL (s[i], s2) || ! SAME_VAL (c[i], c2) || t[i] != inex)
+        {
+          printf ("Error in mpfr_sin_cos_vec (%s, reduced=%d) for i=%d:\n",
+                  mpfr_print_rnd_mode (rnd), reduced, i);
+          printf ("x = "); mpfr_dump (x[i]);
+          printf ("expected "); mpfr_dump (s2);
+          printf ("         "); mpfr_dump (c2);
+          printf ("got      "); mpfr_dump (s[i]);
+          printf ("         "); mpfr_dump (c[i]);
+          printf ("inex = %d, expected %d\n", t[i], inex);
+          exit (1);
+        }
+      mpfr_clears (s2, c2, (mpfr_ptr) 0);
+    }
+  flags1 = __gmpfr_flags;
+
+  set_emin (MPFR_EMIN_DEFAULT);
+  set_emax (MPFR_EMAX_DEFAULT);
+
+  if (flags1 != flags2)
+    {
+      printf ("Error in mpfr_sin_cos_vec (%s, reduced=%d):\n",
+              mpfr_print_rnd_mode (rnd), reduced);
+      printf ("expected flags:"); flags_out (flags1);
+      printf ("got flags:     "); flags_out (flags2);
+      exit (1);
+    }
+
+  for (i = 0; i < N; i++)
+    mpfr_clears (x[i], s[i], c[i], (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  int k;
+
+  tests_start_mpfr ();
+
+  /* n = 0 */
+  MPFR_ASSERTN (mpfr_exp_vec (NULL, NULL, NULL, 0, MPFR_RNDN) == 0);
+
+  for (k = 0; k < 100; k++)
+    {
+      check_fun ("exp", mpfr_exp_vec, mpfr_exp, k & 1, (k >> 1) & 1);
+      check_fun ("log", mpfr_log_vec, mpfr_log, k & 1, (k >> 1) & 1);
+      check_fun ("sin", mpfr_sin_vec, mpfr_sin, k & 1, (k >> 1) & 1);
+      check_fun ("cos", mpfr_cos_vec, mpfr_cos, k & 1, (k >> 1) & 1);
+      check_sin_cos (k & 1);
+    }
+
+  tests_end_mpfr ();
+  return 0;
+}
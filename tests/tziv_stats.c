@@ -0,0 +1,127 @@
+/* Test file for the statistics of the Ziv loops and the adaptive mode.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 512
+
+/* Set *calls and *fails to the sums over all the Ziv loops. */
+static void
+get_total (unsigned long *calls, unsigned long *fails)
+{
+  unsigned long i, c, f;
+
+  *calls = *fails = 0;
+  for (i = 0; mpfr_get_ziv_stats (i, &c, &f) != NULL; i++)
+    {
+      MPFR_ASSERTN (f <= c);
+      *calls += c;
+      *fails += f;
+    }
+}
+
+static void
+check_settings (void)
+{
+  MPFR_ASSERTN (mpfr_get_ziv_adapt () == 0);
+  mpfr_set_ziv_adapt (17);
+  MPFR_ASSERTN (mpfr_get_ziv_adapt () != 0);
+  mpfr_set_ziv_adapt (0);
+  MPFR_ASSERTN (mpfr_get_ziv_adapt () == 0);
+  MPFR_ASSERTN (mpfr_get_ziv_stats (ULONG_MAX, NULL, NULL) == NULL);
+}
+
+/* Compute log(1+k*2^(-60)) for 1 <= k <= N in 200 bits, a hard case for
+   the first attempt of the Ziv loop of mpfr_log (cancellation), without
+   and with the adaptive mode: the results must be the same. */
+static void
+check_log (void)
+{
+  mpfr_t x, y[N];
+  mpfr_rnd_t rnd;
+  unsigned long k, calls0, fails0, calls1, fails1;
+  int inex[N], inex1;
+
+  mpfr_init2 (x, 200);
+  for (k = 0; k < N; k++)
+    mpfr_init2 (y[k], 200);
+  rnd = RND_RAND_NO_RNDF ();
+
+  mpfr_reset_ziv_stats ();
+  get_total (&calls0, &fails0);
+  MPFR_ASSERTN (calls0 == 0 && fails0 == 0);
+
+  for (k = 0; k < N; k++)
+    {
+      mpfr_set_ui_2exp (x, k + 1, -60, MPFR_RNDN);
+      mpfr_add_ui (x, x, 1, MPFR_RNDN);
+      inex[k] = mpfr_log (y[k], x, rnd);
+    }
+  get_total (&calls0, &fails0);
+#ifndef MPFR_USE_LOGGING
+  MPFR_ASSERTN (calls0 >= N);
+#endif
+
+  mpfr_reset_ziv_stats ();
+  mpfr_set_ziv_adapt (1);
+  for (k = 0; k < N; k++)
+    {
+      mpfr_set_ui_2exp (x, k + 1, -60, MPFR_RNDN);
+      mpfr_add_ui (x, x, 1, MPFR_RNDN);
+      inex1 = mpfr_log (x, x, rnd);
+      if (! mpfr_equal_p (x, y[k]) || ! SAME_SIGN (inex1, inex[k]))
+        {
+          printf ("Error in check_log for k=%lu, rnd=%s\n", k + 1,
+                  mpfr_print_rnd_mode (rnd));
+          printf ("expected "); mpfr_dump (y[k]);
+          printf ("got      "); mpfr_dump (x);
+          printf ("inex = %d, inex1 = %d\n", inex[k], inex1);
+          exit (1);
+        }
+    }
+  mpfr_set_ziv_adapt (0);
+  get_total (&calls1, &fails1);
+
+  /* If all the first attempts failed, the initial precision must have been
+     increased in the adaptive mode. */
+  if (fails0 >= N && fails1 >= fails0)
+    {
+      printf ("Error in check_log: no adaptation (%lu/%lu, %lu/%lu)\n",
+              fails0, calls0, fails1, calls1);
+      exit (1);
+    }
+
+  mpfr_clear (x);
+  for (k = 0; k < N; k++)
+    mpfr_clear (y[k]);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_settings ();
+  check_log ();
+
+  tests_end_mpfr ();
+  return 0;
+}
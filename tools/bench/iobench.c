@@ -0,0 +1,182 @@
+/* iobench -- benchmark the text input and output of arrays of numbers,
+   with the array functions and with the scalar ones.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+       + ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  return (unsigned long) ((double) clock () / ((double) CLOCKS_PER_SEC / 1e6));
+#endif
+}
+
+#define NB_RAND_FLOAT 100000  /* number of random numbers */
+
+/* the operations timed for each precision */
+enum { OUT_STR, OUT_ARRAY, INP_STR, INP_ARRAY, NOPS };
+static const char *opname[] = { "out_str", "out_str_array",
+                                "inp_str", "inp_str_array" };
+
+/* Write the numbers of x to f (rewound first), or read them back into y,
+   with the scalar functions or with the array ones. */
+static void
+do_op (int op, FILE *f, mpfr_ptr *x, mpfr_ptr *y, size_t n)
+{
+  size_t i;
+
+  rewind (f);
+  switch (op)
+    {
+    case OUT_STR:
+      for (i = 0; i < n; i++)
+        {
+          mpfr_out_str (f, 10, 0, x[i], MPFR_RNDN);
+          putc ('\n', f);
+        }
+      break;
+    case OUT_ARRAY:
+      mpfr_out_str_array (f, 10, 0, x, n, MPFR_RNDN);
+      break;
+    case INP_STR:
+      for (i = 0; i < n; i++)
+        mpfr_inp_str (y[i], f, 10, MPFR_RNDN);
+      break;
+    default:
+      if (mpfr_inp_str_array (y, n, f, 10, MPFR_RNDN) != n)
+        {
+          printf ("Error in mpfr_inp_str_array\n");
+          exit (1);
+        }
+    }
+  fflush (f);
+}
+
+/* Usage: iobench. For each precision of precs, print the number of numbers
+   written or read per second in base 10 (with the number of digits given by
+   mpfr_get_str_ndigits) to or from a temporary file, by mpfr_out_str and
+   mpfr_inp_str called on each number, and by mpfr_out_str_array and
+   mpfr_inp_str_array called on an array of NB_RAND_FLOAT numbers between
+   2^(-100) and 2^100. */
+int
+main (void)
+{
+  static const mpfr_prec_t precs[] = { 24, 53, 113, 256 };
+  gmp_randstate_t randstate;
+  mpfr_ptr x[NB_RAND_FLOAT], y[NB_RAND_FLOAT];
+  unsigned long niter, k, ti;
+  int i, j, op;
+  FILE *f;
+
+  f = tmpfile ();
+  if (f == NULL)
+    {
+      printf ("Can't create a temporary file\n");
+      exit (1);
+    }
+  for (i = 0; i < NB_RAND_FLOAT; i++)
+    {
+      x[i] = (mpfr_ptr) malloc (sizeof (mpfr_t));
+      y[i] = (mpfr_ptr) malloc (sizeof (mpfr_t));
+      if (x[i] == NULL || y[i] == NULL)
+        {
+          printf ("Can't allocate memory\n");
+          exit (1);
+        }
+    }
+
+  gmp_randinit_default (randstate);
+  printf ("GMP : %s  MPFR : %s\n", gmp_version, mpfr_get_version ());
+  printf ("Numbers per second:\n");
+  printf ("%10s", "precision");
+  for (op = 0; op < NOPS; op++)
+    printf (" %14s", opname[op]);
+  printf ("\n");
+
+  for (j = 0; j < (int) (sizeof (precs) / sizeof (precs[0])); j++)
+    {
+      for (i = 0; i < NB_RAND_FLOAT; i++)
+        {
+          mpfr_init2 (x[i], precs[j]);
+          mpfr_init2 (y[i], precs[j]);
+          mpfr_urandomb (x[i], randstate);
+          mpfr_mul_2si (x[i], x[i],
+                        (long) gmp_urandomm_ui (randstate, 201) - 100,
+                        MPFR_RNDN);
+          if (gmp_urandomb_ui (randstate, 1))
+            mpfr_neg (x[i], x[i], MPFR_RNDN);
+        }
+      printf ("%10ld", (long) precs[j]);
+      for (op = 0; op < NOPS; op++)
+        {
+          /* calibrate so that each measurement takes about 0.2 s */
+          for (niter = 1; ; niter <<= 1)
+            {
+              unsigned long t0 = get_cputime ();
+              for (k = 0; k < niter; k++)
+                do_op (op, f, x, y, NB_RAND_FLOAT);
+              ti = get_cputime () - t0;
+              if (ti >= 200000)
+                break;
+            }
+          printf (" %14.3e", (double) niter * NB_RAND_FLOAT
+                  / ((double) ti / 1e6));
+          fflush (stdout);
+        }
+      printf ("\n");
+      for (i = 0; i < NB_RAND_FLOAT; i++)
+        {
+          if (! mpfr_equal_p (x[i], y[i]))
+            {
+              printf ("Error, number %d not read back correctly\n", i);
+              exit (1);
+            }
+          mpfr_clear (x[i]);
+          mpfr_clear (y[i]);
+        }
+    }
+
+  for (i = 0; i < NB_RAND_FLOAT; i++)
+    {
+      free (x[i]);
+      free (y[i]);
+    }
+  fclose (f);
+  gmp_randclear (randstate);
+  return 0;
+}
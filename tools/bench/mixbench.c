@@ -0,0 +1,147 @@
+/* mixbench -- benchmark mpfr_add, mpfr_sub and mpfr_mul for a matrix of
+   precision triples (destination, first operand, second operand).
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* number of random numbers */
+#define NB_RAND_FLOAT 1000
+
+/* precisions of the matrix: every triple (pa, pb, pc) is timed */
+static const mpfr_prec_t precs[] = { 24, 53, 64, 113, 128 };
+#define NPRECS ((int) (sizeof (precs) / sizeof (precs[0])))
+
+static const char *opname[] = { "add", "sub", "mul" };
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+       + ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  return (unsigned long) ((double) clock () / ((double) CLOCKS_PER_SEC / 1e6));
+#endif
+}
+
+static mpfr_t *
+bench_random_array (int n, mpfr_prec_t precision, gmp_randstate_t randstate)
+{
+  int j;
+  mpfr_t *ptr;
+
+  ptr = (mpfr_t *) malloc (n * sizeof (mpfr_t));
+  if (ptr == NULL)
+    {
+      printf ("Can't allocate memory for %d numbers\n", n);
+      exit (1);
+    }
+  for (j = 0; j < n; j++)
+    {
+      mpfr_init2 (ptr[j], precision);
+      mpfr_urandomb (ptr[j], randstate);
+    }
+  return ptr;
+}
+
+static void
+bench_free_array (int n, mpfr_t *ptr)
+{
+  int j;
+
+  for (j = 0; j < n; j++)
+    mpfr_clear (ptr[j]);
+  free (ptr);
+}
+
+/* time niter rounds over the arrays, return the time in microseconds */
+static unsigned long
+time_op (int op, unsigned long niter, mpfr_t *z, mpfr_t *x, mpfr_t *y)
+{
+  unsigned long i, t0;
+  int k;
+
+  t0 = get_cputime ();
+  for (i = 0; i < niter; i++)
+    for (k = 0; k < NB_RAND_FLOAT; k++)
+      {
+        if (op == 0)
+          mpfr_add (z[k], x[k], y[k], MPFR_RNDN);
+        else if (op == 1)
+          mpfr_sub (z[k], x[k], y[k], MPFR_RNDN);
+        else
+          mpfr_mul (z[k], x[k], y[k], MPFR_RNDN);
+      }
+  return get_cputime () - t0;
+}
+
+int
+main (void)
+{
+  gmp_randstate_t randstate;
+  mpfr_t *x, *y, *z;
+  int op, i, j, k;
+  unsigned long niter, ti;
+
+  gmp_randinit_default (randstate);
+
+  printf ("GMP : %s  MPFR : %s\n", gmp_version, mpfr_get_version ());
+  printf ("Millions of operations per second, for each operation and\n"
+          "precisions prec(z) <- prec(x), prec(y):\n");
+  for (op = 0; op < 3; op++)
+    for (i = 0; i < NPRECS; i++)
+      for (j = 0; j < NPRECS; j++)
+        for (k = 0; k < NPRECS; k++)
+          {
+            z = bench_random_array (NB_RAND_FLOAT, precs[i], randstate);
+            x = bench_random_array (NB_RAND_FLOAT, precs[j], randstate);
+            y = bench_random_array (NB_RAND_FLOAT, precs[k], randstate);
+
+            /* calibrate so that each measurement takes about 0.1 s */
+            for (niter = 1; (ti = time_op (op, niter, z, x, y)) < 100000;
+                 niter <<= 1)
+              ;
+            printf ("%s %3lu <- %3lu, %3lu : %8.2f\n", opname[op],
+                    (unsigned long) precs[i], (unsigned long) precs[j],
+                    (unsigned long) precs[k],
+                    (double) niter * NB_RAND_FLOAT / (double) ti);
+            fflush (stdout);
+
+            bench_free_array (NB_RAND_FLOAT, x);
+            bench_free_array (NB_RAND_FLOAT, y);
+            bench_free_array (NB_RAND_FLOAT, z);
+          }
+
+  gmp_randclear (randstate);
+  return 0;
+}
@@ -0,0 +1,153 @@
+/* printbench -- benchmark the formatted output functions on typical
+   logging workloads.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+       + ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  return (unsigned long) ((double) clock () / ((double) CLOCKS_PER_SEC / 1e6));
+#endif
+}
+
+#define NB_RAND_FLOAT 1000  /* number of random numbers */
+
+/* the formats timed, as found in typical log messages */
+static const char *fmts[] = {
+  "%.17Rg",
+  "%Re",
+  "%.6Rf",
+  "%Ra",
+  "x = %.10Rg, step %d\n",
+  "[%5d] %-12s t=%.6Rf err=%.3Re\n"
+};
+#define NFMTS ((int) (sizeof (fmts) / sizeof (fmts[0])))
+
+/* Output x (and y, i) with the format number f, given as a string or
+   compiled in cf if cf is not NULL. */
+static int
+do_print (char *buf, size_t n, int f, mpfr_format_srcptr cf,
+          mpfr_ptr x, mpfr_ptr y, int i)
+{
+  if (cf != NULL)
+    {
+      if (f == 4)
+        return mpfr_format_apply (buf, n, cf, x, i);
+      else if (f == 5)
+        return mpfr_format_apply (buf, n, cf, i, "solver", x, y);
+      else
+        return mpfr_format_apply (buf, n, cf, x);
+    }
+  if (f == 4)
+    return mpfr_snprintf (buf, n, fmts[f], x, i);
+  else if (f == 5)
+    return mpfr_snprintf (buf, n, fmts[f], i, "solver", x, y);
+  else
+    return mpfr_snprintf (buf, n, fmts[f], x);
+}
+
+/* Usage: printbench. For each format of fmts and each precision of precs,
+   print the number of calls per second to mpfr_snprintf into a buffer of
+   256 characters, on random numbers between 2^(-100) and 2^100, then the
+   same for mpfr_format_apply with the format compiled by
+   mpfr_format_compile. */
+int
+main (void)
+{
+  static const mpfr_prec_t precs[] = { 24, 53, 113, 256 };
+  gmp_randstate_t randstate;
+  mpfr_t x[NB_RAND_FLOAT];
+  mpfr_format_t cf;
+  char buf[256];
+  unsigned long niter, k, ti;
+  int i, j, f, compiled;
+
+  gmp_randinit_default (randstate);
+  printf ("GMP : %s  MPFR : %s\n", gmp_version, mpfr_get_version ());
+  for (compiled = 0; compiled < 2; compiled++)
+    {
+      printf (compiled ? "\nCalls to mpfr_format_apply per second:\n"
+              : "Calls to mpfr_snprintf per second:\n");
+      printf ("%-34s", "format");
+      for (j = 0; j < (int) (sizeof (precs) / sizeof (precs[0])); j++)
+        printf (" %10ld", (long) precs[j]);
+      printf ("\n");
+
+      for (f = 0; f < NFMTS; f++)
+        {
+          /* print the format on one line, without the final newline */
+          for (i = 0; fmts[f][i] != '\0' && fmts[f][i] != '\n'; i++)
+            putchar (fmts[f][i]);
+          printf ("%*s", 34 - i, "");
+          mpfr_format_compile (cf, fmts[f]);
+          for (j = 0; j < (int) (sizeof (precs) / sizeof (precs[0])); j++)
+            {
+              for (i = 0; i < NB_RAND_FLOAT; i++)
+                {
+                  mpfr_init2 (x[i], precs[j]);
+                  mpfr_urandomb (x[i], randstate);
+                  mpfr_mul_2si (x[i], x[i],
+                                (long) gmp_urandomm_ui (randstate, 201) - 100,
+                                MPFR_RNDN);
+                }
+              /* calibrate so that each measurement takes about 0.2 s */
+              for (niter = 1; ; niter <<= 1)
+                {
+                  unsigned long t0 = get_cputime ();
+                  for (k = 0; k < niter; k++)
+                    for (i = 0; i < NB_RAND_FLOAT; i++)
+                      do_print (buf, sizeof (buf), f, compiled ? cf : NULL,
+                                x[i], x[NB_RAND_FLOAT - 1 - i], i);
+                  ti = get_cputime () - t0;
+                  if (ti >= 200000)
+                    break;
+                }
+              printf (" %10.3e", (double) niter * NB_RAND_FLOAT
+                      / ((double) ti / 1e6));
+              fflush (stdout);
+              for (i = 0; i < NB_RAND_FLOAT; i++)
+                mpfr_clear (x[i]);
+            }
+          mpfr_format_clear (cf);
+          printf ("\n");
+        }
+    }
+
+  gmp_randclear (randstate);
+  return 0;
+}
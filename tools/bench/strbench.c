@@ -0,0 +1,224 @@
+/* strbench -- benchmark the conversions between mpfr_t and decimal strings
+   for short literals and for 10^3 to 10^7 digits.
+
+Copyright 2025 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+       + ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  return (unsigned long) ((double) clock () / ((double) CLOCKS_PER_SEC / 1e6));
+#endif
+}
+
+/* the operations timed for each number of digits */
+enum { SET_FULL, SET_53, SET_EXACT, GET_FULL, NOPS };
+static const char *opname[] = { "set_str", "set_str/53", "set_str/exact",
+                                "get_str" };
+
+static void
+do_op (int op, mpfr_ptr x, mpfr_ptr y, const char *s, const char *sexact,
+       char *buf, size_t m)
+{
+  mpfr_exp_t e;
+
+  if (op == SET_FULL)
+    mpfr_set_str (x, s, 10, MPFR_RNDN);
+  else if (op == SET_53)
+    mpfr_set_str (y, s, 10, MPFR_RNDN);
+  else if (op == SET_EXACT)
+    mpfr_set_str (y, sexact, 10, MPFR_RNDN);
+  else
+    mpfr_get_str (buf, &e, 10, m, x, MPFR_RNDN);
+}
+
+#define NSHORT 1000  /* number of short literals */
+
+/* Print the number of short decimal literals parsed per second by
+   mpfr_strtofr, for some usual precisions: random literals with 17
+   significant digits and an exponent between -300 and 300, and random
+   literals with 1 to 6 digits such as 2.5 or 0.0625 (many of them are
+   exact in binary). */
+static void
+short_bench (gmp_randstate_t randstate)
+{
+  static const mpfr_prec_t precs[] = { 24, 53, 64, 113, 128 };
+  char *lit[2][NSHORT];
+  mpfr_t x;
+  unsigned long i, k, niter, ti;
+  int j, kind;
+
+  for (i = 0; i < NSHORT; i++)
+    {
+      lit[0][i] = (char *) malloc (32);
+      lit[1][i] = (char *) malloc (32);
+      if (lit[0][i] == NULL || lit[1][i] == NULL)
+        {
+          printf ("Can't allocate memory\n");
+          exit (1);
+        }
+      sprintf (lit[0][i], "%lu.%08lu%08lue%ld",
+               1 + gmp_urandomm_ui (randstate, 9),
+               gmp_urandomm_ui (randstate, 100000000),
+               gmp_urandomm_ui (randstate, 100000000),
+               (long) gmp_urandomm_ui (randstate, 601) - 300);
+      k = gmp_urandomm_ui (randstate, 6);
+      sprintf (lit[1][i], "%.*f", (int) k,
+               (double) (1 + gmp_urandomm_ui (randstate, 1000000)) / 1e6
+               * (k == 0 ? 1e6 : 10.0));
+    }
+
+  printf ("Short literals parsed per second by mpfr_strtofr:\n");
+  printf ("%10s %14s %14s\n", "precision", "17 digits", "1-6 digits");
+  for (j = 0; j < (int) (sizeof (precs) / sizeof (precs[0])); j++)
+    {
+      mpfr_init2 (x, precs[j]);
+      printf ("%10ld", (long) precs[j]);
+      for (kind = 0; kind < 2; kind++)
+        {
+          for (niter = 1; ; niter <<= 1)
+            {
+              unsigned long t0 = get_cputime ();
+              for (k = 0; k < niter; k++)
+                for (i = 0; i < NSHORT; i++)
+                  mpfr_strtofr (x, lit[kind][i], NULL, 10, MPFR_RNDN);
+              ti = get_cputime () - t0;
+              if (ti >= 200000)
+                break;
+            }
+          printf (" %14.3e", (double) niter * NSHORT / ((double) ti / 1e6));
+        }
+      printf ("\n");
+      mpfr_clear (x);
+    }
+  printf ("\n");
+
+  for (i = 0; i < NSHORT; i++)
+    {
+      free (lit[0][i]);
+      free (lit[1][i]);
+    }
+}
+
+/* Usage: strbench [max_digits]. First, the number of short literals parsed
+   per second is given (see short_bench). Then, for each number of digits
+   m = 10^3, 10^4,
+   ..., max_digits (10^7 by default), the following operations are timed:
+     set_str       : mpfr_set_str on a random string of m digits, with a
+                     precision of m*log2(10) bits;
+     set_str/53    : the same, but with a precision of 53 bits;
+     set_str/exact : mpfr_set_str on the m-digit decimal expansion of a
+                     dyadic number 3*2^(-k), with a precision of 53 bits,
+                     where the result is exact;
+     get_str       : mpfr_get_str with m digits, from the first case. */
+int
+main (int argc, char *argv[])
+{
+  gmp_randstate_t randstate;
+  unsigned long max_digits = 10000000, m, i, niter, ti;
+  int op;
+
+  if (argc > 1)
+    max_digits = strtoul (argv[1], NULL, 10);
+
+  gmp_randinit_default (randstate);
+  printf ("GMP : %s  MPFR : %s\n", gmp_version, mpfr_get_version ());
+  short_bench (randstate);
+  printf ("Time in seconds per operation:\n");
+  printf ("%10s", "digits");
+  for (op = 0; op < NOPS; op++)
+    printf (" %14s", opname[op]);
+  printf ("\n");
+
+  for (m = 1000; m <= max_digits; m *= 10)
+    {
+      mpfr_t x, y;
+      mpfr_exp_t e;
+      char *s, *sexact, *buf;
+
+      /* random string 0.ddd...d */
+      s = (char *) malloc (m + 3);
+      buf = (char *) malloc (m + 2);
+      if (s == NULL || buf == NULL)
+        {
+          printf ("Can't allocate memory for %lu digits\n", m);
+          exit (1);
+        }
+      s[0] = '0';
+      s[1] = '.';
+      for (i = 0; i < m; i++)
+        s[i + 2] = '0' + gmp_urandomm_ui (randstate, 10);
+      s[m + 2] = '\0';
+      mpfr_init2 (x, (mpfr_prec_t) (m * 3.3219280948873626) + 1);
+      mpfr_init2 (y, 53);
+
+      /* 3*2^(-k) has less than m significant digits, thus it is exact */
+      mpfr_set_ui_2exp (y, 3, - (long) ((m - 2) / 0.69897000433601886),
+                        MPFR_RNDN);
+      sexact = mpfr_get_str (NULL, &e, 10, m, y, MPFR_RNDN);
+      sexact = (char *) realloc (sexact, m + 32);
+      sprintf (sexact + strlen (sexact), "@%ld", (long) e - (long) m);
+
+      printf ("%10lu", m);
+      for (op = 0; op < NOPS; op++)
+        {
+          /* calibrate so that each measurement takes about 0.2 s */
+          for (niter = 1; ; niter <<= 1)
+            {
+              unsigned long t0 = get_cputime ();
+              for (i = 0; i < niter; i++)
+                do_op (op, x, y, s, sexact, buf, m);
+              ti = get_cputime () - t0;
+              if (ti >= 200000)
+                break;
+            }
+          printf (" %14.3e", (double) ti / 1e6 / (double) niter);
+          fflush (stdout);
+        }
+      printf ("\n");
+
+      mpfr_clear (x);
+      mpfr_clear (y);
+      free (s);
+      free (sexact);
+      free (buf);
+    }
+
+  gmp_randclear (randstate);
+  return 0;
+}
@@ -42,6 +42,11 @@ static short sqrhigh_ktab[] = {MPFR_SQRHIGH_TAB};
 static short divhigh_ktab[] = {MPFR_DIVHIGH_TAB};
 #define MPFR_DIVHIGH_TAB_SIZE (numberof_const (divhigh_ktab))
 
+#ifdef MPFR_MULHIGH_NM_TAB
+static short mulhigh_nm_tab[] = {MPFR_MULHIGH_NM_TAB};
+#define MPFR_MULHIGH_NM_TAB_SIZE (numberof_const (mulhigh_nm_tab))
+#endif
+
 int main (void)
 {
   int err = 0, n;
@@ -67,5 +72,14 @@ int main (void)
         err = 1;
       }
 
+#ifdef MPFR_MULHIGH_NM_TAB
+  for (n = 1; n < MPFR_MULHIGH_NM_TAB_SIZE; n++)
+    if (mulhigh_nm_tab[n] != -1 && mulhigh_nm_tab[n] < 1)
+      {
+        printf ("Error, mulhigh_nm_tab[%d] = %d\n", n, mulhigh_nm_tab[n]);
+        err = 1;
+      }
+#endif
+
   return err;
 }
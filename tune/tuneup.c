@@ -276,6 +276,53 @@ speed_mpfr_sincos (struct speed_params *s)
   SPEED_MPFR_FUNC2 (mpfr_sin_cos);
 }
 
+/* Setup mpfr_sin. Since the direct computation of sin(x) is the most
+   interesting for small arguments and the sqrt(1-cos(x)^2) one for
+   arguments that do not need any reduction, the time is measured for
+   x*2^(-20), x and x*2^20, where 1/2 <= x < 1. */
+mpfr_prec_t mpfr_sin_direct_threshold;
+#undef MPFR_SIN_DIRECT_THRESHOLD
+#define MPFR_SIN_DIRECT_THRESHOLD mpfr_sin_direct_threshold
+#include "sin.c"
+static void
+mpfr_sin_mix (mpfr_ptr w, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_t t;
+
+  MPFR_ALIAS (t, x, MPFR_SIGN (x), MPFR_GET_EXP (x) - 20);
+  mpfr_sin (w, t, rnd_mode);
+  mpfr_sin (w, x, rnd_mode);
+  MPFR_ALIAS (t, x, MPFR_SIGN (x), MPFR_GET_EXP (x) + 20);
+  mpfr_sin (w, t, rnd_mode);
+}
+static double
+speed_mpfr_sin (struct speed_params *s)
+{
+  SPEED_MPFR_FUNC (mpfr_sin_mix);
+}
+
+/* Setup mpfr_atan */
+mpfr_prec_t mpfr_atan_table_threshold;
+#undef MPFR_ATAN_TABLE_THRESHOLD
+#define MPFR_ATAN_TABLE_THRESHOLD mpfr_atan_table_threshold
+#include "atan.c"
+static double
+speed_mpfr_atan (struct speed_params *s)
+{
+  SPEED_MPFR_FUNC (mpfr_atan);
+}
+
+/* Setup mpfr_log */
+mpfr_prec_t mpfr_log_threshold;
+#undef MPFR_LOG_THRESHOLD
+#define MPFR_LOG_THRESHOLD mpfr_log_threshold
+#include "log.c"
+static double
+speed_mpfr_log (struct speed_params *s)
+{
+  SPEED_MPFR_FUNC (mpfr_log);
+}
+
 /* Setup mpfr_mul, mpfr_sqr and mpfr_div */
 /* Since mpfr_mul() deals with both mul and sqr, and contains an assert that
    the thresholds are >= 1, we initialize both values to 1 to avoid a failed
@@ -284,14 +331,30 @@ speed_mpfr_sincos (struct speed_params *s)
 mpfr_prec_t mpfr_mul_threshold = 1;
 mpfr_prec_t mpfr_sqr_threshold = 1;
 mpfr_prec_t mpfr_div_threshold;
+mpfr_prec_t mpfr_div_newton_threshold = MPFR_PREC_MAX;
+mpfr_prec_t mpfr_sqrt_newton_threshold = MPFR_PREC_MAX;
+mpfr_prec_t mpfr_div_precomp_threshold = MPFR_PREC_MAX;
 #undef  MPFR_MUL_THRESHOLD
 #define MPFR_MUL_THRESHOLD mpfr_mul_threshold
 #undef  MPFR_SQR_THRESHOLD
 #define MPFR_SQR_THRESHOLD mpfr_sqr_threshold
 #undef  MPFR_DIV_THRESHOLD
 #define MPFR_DIV_THRESHOLD mpfr_div_threshold
+#undef  MPFR_DIV_NEWTON_THRESHOLD
+#define MPFR_DIV_NEWTON_THRESHOLD mpfr_div_newton_threshold
+#undef  MPFR_SQRT_NEWTON_THRESHOLD
+#define MPFR_SQRT_NEWTON_THRESHOLD mpfr_sqrt_newton_threshold
+#undef  MPFR_DIV_PRECOMP_THRESHOLD
+#define MPFR_DIV_PRECOMP_THRESHOLD mpfr_div_precomp_threshold
+/* The table of the unbalanced short product is zero-initialized, so that it
+   is not used (in mpfr_mul) before it has been tuned. */
+#ifndef MPFR_MULHIGH_NM_SIZE
+# define MPFR_MULHIGH_NM_SIZE 64
+#endif
+#define MPFR_MULHIGH_NM_TAB_SIZE MPFR_MULHIGH_NM_SIZE
 #include "mul.c"
 #include "div.c"
+#include "sqrt.c"
 static double
 speed_mpfr_mul (struct speed_params *s)
 {
@@ -307,6 +370,137 @@ speed_mpfr_div (struct speed_params *s)
 {
   SPEED_MPFR_OP (mpfr_div);
 }
+static double
+speed_mpfr_sqrt (struct speed_params *s)
+{
+  SPEED_MPFR_FUNC (mpfr_sqrt);
+}
+/* same as SPEED_MPFR_OP (mpfr_div), with a precomputed divisor */
+static double
+speed_mpfr_div_precomp (struct speed_params *s)
+{
+  unsigned  i;
+  mpfr_limb_ptr wp;
+  double    t;
+  mpfr_t    w, x, y;
+  mpfr_divisor_t d;
+  mp_size_t size;
+  MPFR_TMP_DECL (marker);
+
+  SPEED_RESTRICT_COND (s->size >= MPFR_PREC_MIN);
+  SPEED_RESTRICT_COND (s->size <= MPFR_PREC_MAX);
+  MPFR_TMP_MARK (marker);
+
+  size = (s->size-1)/GMP_NUMB_BITS+1;
+  s->xp[size-1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_TMP_INIT1 (s->xp, x, s->size);
+  MPFR_SET_EXP (x, 0);
+  s->yp[size-1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_TMP_INIT1 (s->yp, y, s->size);
+  MPFR_SET_EXP (y, 0);
+  mpfr_divisor_init (d, y);
+
+  MPFR_TMP_INIT (wp, w, s->size, size);
+
+  speed_operand_src (s, s->xp, size);
+  speed_operand_src (s, s->yp, size);
+  speed_operand_dst (s, wp, size);
+  speed_cache_fill (s);
+
+  speed_starttime ();
+  i = s->reps;
+  do
+    mpfr_div_by_precomp (w, x, d, MPFR_RNDN);
+  while (--i != 0);
+  t = speed_endtime ();
+
+  mpfr_divisor_clear (d);
+  MPFR_TMP_FREE (marker);
+  return t;
+}
+
+/* Setup mpfr_mpn_get_str */
+mp_size_t mpfr_get_str_dc_threshold = MP_SIZE_T_MAX;
+#undef  MPFR_GET_STR_DC_THRESHOLD
+#define MPFR_GET_STR_DC_THRESHOLD mpfr_get_str_dc_threshold
+mp_size_t mpfr_set_str_dc_threshold = MP_SIZE_T_MAX;
+#undef  MPFR_SET_STR_DC_THRESHOLD
+#define MPFR_SET_STR_DC_THRESHOLD mpfr_set_str_dc_threshold
+#include "mpn_get_str.c"
+static double
+speed_mpfr_get_str (struct speed_params *s)
+{
+  unsigned  i;
+  double    t;
+  mpfr_t    x;
+  mp_size_t size;
+  size_t    m;
+  char      *str;
+  mpfr_exp_t e;
+  MPFR_TMP_DECL (marker);
+
+  SPEED_RESTRICT_COND (s->size >= MPFR_PREC_MIN);
+  SPEED_RESTRICT_COND (s->size <= MPFR_PREC_MAX);
+  MPFR_TMP_MARK (marker);
+
+  size = (s->size-1)/GMP_NUMB_BITS+1;
+  s->xp[size-1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_TMP_INIT1 (s->xp, x, s->size);
+  MPFR_SET_EXP (x, 0);
+  m = mpfr_get_str_ndigits (10, s->size);
+  str = (char *) MPFR_TMP_ALLOC (m + 2);
+
+  speed_operand_src (s, s->xp, size);
+  speed_cache_fill (s);
+
+  speed_starttime ();
+  i = s->reps;
+  do
+    mpfr_get_str (str, &e, 10, m, x, MPFR_RNDN);
+  while (--i != 0);
+  t = speed_endtime ();
+
+  MPFR_TMP_FREE (marker);
+  return t;
+}
+
+/* s->size: number of bits of the integer read by mpfr_mpn_set_str
+   from a string of decimal digits */
+static double
+speed_mpfr_set_str (struct speed_params *s)
+{
+  unsigned  i;
+  double    t;
+  mp_limb_t *rp;
+  mp_size_t size;
+  size_t    m, j;
+  unsigned char *str;
+  MPFR_TMP_DECL (marker);
+
+  SPEED_RESTRICT_COND (s->size >= MPFR_PREC_MIN);
+  SPEED_RESTRICT_COND (s->size <= MPFR_PREC_MAX);
+  MPFR_TMP_MARK (marker);
+
+  size = (s->size-1)/GMP_NUMB_BITS+1;
+  m = mpfr_get_str_ndigits (10, s->size);
+  str = (unsigned char *) MPFR_TMP_ALLOC (m);
+  for (j = 0; j < m; j++)
+    str[j] = (s->xp[j % size] >> (4 * (j % 8))) % 10;
+  str[0] |= 1;
+  rp = MPFR_TMP_LIMBS_ALLOC (size + 2);
+
+  speed_cache_fill (s);
+
+  speed_starttime ();
+  i = s->reps;
+  do
+    mpfr_mpn_set_str (rp, str, m, 10);
+  while (--i != 0);
+  t = speed_endtime ();
+
+  MPFR_TMP_FREE (marker);
+  return t;
+}
 
 /************************************************
  * Common functions (inspired by GMP function)  *
@@ -565,6 +759,37 @@ tune_simple_func (mpfr_prec_t *threshold,
   return;
 }
 
+/* Tune the threshold of a Newton iteration (see newton.c). Contrary to
+   tune_simple_func, algo 2 might never be faster (in particular when GMP
+   has a subquadratic division), thus we first look for a precision where
+   it is faster, doubling the precision from pstart up to pmax. If there is
+   none, the threshold is set to MPFR_PREC_MAX (algo 2 is never used). */
+static void
+tune_newton_func (mpfr_prec_t *threshold,
+                  double (*func) (struct speed_params *),
+                  mpfr_prec_t pstart, mpfr_prec_t pmax)
+{
+  mpfr_prec_t p;
+
+  for (p = pstart; p <= pmax; p *= 2)
+    if (domeasure (threshold, func, p) < -0.05)
+      break;
+  if (p > pmax)
+    {
+      if (verbose)
+        printf ("Algo 2 is never faster up to precision %lu\n",
+                (unsigned long) pmax);
+      *threshold = MPFR_PREC_MAX;
+      return;
+    }
+  if (p == pstart)
+    {
+      *threshold = pstart;
+      return;
+    }
+  tune_simple_func (threshold, func, p / 2);
+}
+
 /* Tune a function which behavior depends on both p and x,
    in a given direction.
    It assumes that for (x,p) close to zero, algo1 is used
@@ -964,6 +1189,196 @@ tune_div_mulders (FILE *f)
     putchar ('\n');
 }
 
+/* Since MPFR_GET_STR_DC_THRESHOLD is also the size of the leaves of the
+   recursion in mpfr_mpn_get_str, tune_simple_func cannot be used: for each
+   candidate threshold n, compare the conversion of 2n limbs with and
+   without the cached powers. */
+static void
+tune_get_str (FILE *f)
+{
+  struct speed_params s;
+  mp_size_t n;
+  double t1, t2;
+
+  if (verbose)
+    printf ("Tuning mpfr_mpn_get_str...\n");
+  s.align_xp = s.align_yp = s.align_wp = 64;
+  for (n = 64; n <= 32768; n *= 2)
+    {
+      s.size = 2 * n * GMP_NUMB_BITS;
+      s.xp = (mp_ptr) malloc (2 * n * sizeof (mp_limb_t));
+      if (s.xp == NULL)
+        {
+          fprintf (stderr, "Can't allocate memory.\n");
+          abort ();
+        }
+      mpn_random (s.xp, 2 * n);
+      s.yp = s.xp;
+      mpfr_get_str_dc_threshold = MP_SIZE_T_MAX;
+      t1 = mpfr_speed_measure (speed_mpfr_get_str, &s, "mpn_get_str");
+      mpfr_get_str_dc_threshold = n;
+      t2 = mpfr_speed_measure (speed_mpfr_get_str, &s, "mpfr_mpn_get_str");
+      free (s.xp);
+      if (verbose)
+        printf ("n=%lu: %e %e\n", (unsigned long) n, t1, t2);
+      if (t2 < t1)
+        break;
+    }
+  mpfr_get_str_dc_threshold = n;
+  fprintf (f, "#define MPFR_GET_STR_DC_THRESHOLD %lu /* limbs */\n",
+           (unsigned long) n);
+}
+
+/* Same as tune_get_str, for MPFR_SET_STR_DC_THRESHOLD. */
+static void
+tune_set_str (FILE *f)
+{
+  struct speed_params s;
+  mp_size_t n;
+  double t1, t2;
+
+  if (verbose)
+    printf ("Tuning mpfr_mpn_set_str...\n");
+  s.align_xp = s.align_yp = s.align_wp = 64;
+  for (n = 64; n <= 32768; n *= 2)
+    {
+      s.size = 2 * n * GMP_NUMB_BITS;
+      s.xp = (mp_ptr) malloc (2 * n * sizeof (mp_limb_t));
+      if (s.xp == NULL)
+        {
+          fprintf (stderr, "Can't allocate memory.\n");
+          abort ();
+        }
+      mpn_random (s.xp, 2 * n);
+      s.yp = s.xp;
+      mpfr_set_str_dc_threshold = MP_SIZE_T_MAX;
+      t1 = mpfr_speed_measure (speed_mpfr_set_str, &s, "mpn_set_str");
+      mpfr_set_str_dc_threshold = n;
+      t2 = mpfr_speed_measure (speed_mpfr_set_str, &s, "mpfr_mpn_set_str");
+      free (s.xp);
+      if (verbose)
+        printf ("n=%lu: %e %e\n", (unsigned long) n, t1, t2);
+      if (t2 < t1)
+        break;
+    }
+  mpfr_set_str_dc_threshold = n;
+  fprintf (f, "#define MPFR_SET_STR_DC_THRESHOLD %lu /* limbs */\n",
+           (unsigned long) n);
+}
+
+/* s->size: number of limbs of the short operand c (and of the result)
+   s->r   : number of neglected limbs of the long operand b, which has
+            s->size + 1 + s->r limbs, so that s->r is the value of d
+            in mpfr_mul */
+static double
+speed_mpfr_mul_nm (struct speed_params *s)
+{
+  unsigned  i;
+  mpfr_limb_ptr wp;
+  double    t;
+  mpfr_t    w, x, y;
+  mp_size_t m, bn;
+  MPFR_TMP_DECL (marker);
+
+  m = s->size;
+  bn = m + 1 + (mp_size_t) s->r;
+  MPFR_TMP_MARK (marker);
+
+  s->xp[bn-1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_TMP_INIT1 (s->xp, x, bn * GMP_NUMB_BITS);
+  MPFR_SET_EXP (x, 0);
+  s->yp[m-1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_TMP_INIT1 (s->yp, y, m * GMP_NUMB_BITS);
+  MPFR_SET_EXP (y, 0);
+
+  MPFR_TMP_INIT (wp, w, m * GMP_NUMB_BITS, m);
+
+  speed_operand_src (s, s->xp, bn);
+  speed_operand_src (s, s->yp, m);
+  speed_operand_dst (s, wp, m);
+  speed_cache_fill (s);
+
+  speed_starttime ();
+  i = s->reps;
+  do
+    mpfr_mul (w, x, y, MPFR_RNDN);
+  while (--i != 0);
+  t = speed_endtime ();
+
+  MPFR_TMP_FREE (marker);
+  return t;
+}
+
+#define MULHIGH_NM_MAX_NEGLECTED 64
+
+/* Tune mulhigh_nm_tab[m], i.e., find the minimal number of neglected limbs
+   of the long operand for which the unbalanced short product is faster in
+   mpfr_mul than the full product, with a short operand of m limbs. */
+static mp_size_t
+tune_mul_nm_upto (mp_size_t m)
+{
+  struct speed_params s;
+  mp_size_t d;
+  double t1, t2;
+  MPFR_TMP_DECL (marker);
+
+  if (m == 0)
+    return -1;
+
+  MPFR_TMP_MARK (marker);
+  s.align_xp = s.align_yp = s.align_wp = 64;
+  s.size = m;
+  s.xp   = (mp_ptr) MPFR_TMP_ALLOC ((m + 1 + MULHIGH_NM_MAX_NEGLECTED)
+                                    * sizeof (mp_limb_t));
+  s.yp   = (mp_ptr) MPFR_TMP_ALLOC (m * sizeof (mp_limb_t));
+  mpn_random (s.xp, m + 1 + MULHIGH_NM_MAX_NEGLECTED);
+  mpn_random (s.yp, m);
+
+  for (d = 1 ; d <= MULHIGH_NM_MAX_NEGLECTED ; d++)
+    {
+      s.r = d;
+      mulhigh_nm_tab[m] = -1;
+      t1 = mpfr_speed_measure (speed_mpfr_mul_nm, &s, "mpfr_mul");
+      mulhigh_nm_tab[m] = d;
+      t2 = mpfr_speed_measure (speed_mpfr_mul_nm, &s, "mpfr_mulhigh_nm");
+      if (t2 * TOLERANCE < t1)
+        break;
+    }
+
+  if (d > MULHIGH_NM_MAX_NEGLECTED)
+    d = -1;
+  mulhigh_nm_tab[m] = d;
+
+  MPFR_TMP_FREE (marker);
+  return d;
+}
+
+/* The table is only used for a short operand of at most MPFR_MUL_THRESHOLD
+   limbs, thus it must be tuned after MPFR_MUL_THRESHOLD. */
+static void
+tune_mul_nm (FILE *f, mp_size_t threshold)
+{
+  mp_size_t k, size;
+
+  size = MIN (threshold + 1, MPFR_MULHIGH_NM_TAB_SIZE);
+  if (verbose)
+    printf ("Tuning mpfr_mulhigh_nm[%d]", (int) size);
+  fprintf (f, "#define MPFR_MULHIGH_NM_TAB  \\\n ");
+  for (k = 0 ; k < size ; k++)
+    {
+      fprintf (f, "%d", (int) tune_mul_nm_upto (k));
+      if (k != size - 1)
+        fputc (',', f);
+      if ((k+1) % 16 == 0)
+        fprintf (f, " \\\n ");
+      if (verbose)
+        putchar ('.');
+    }
+  fprintf (f, " \n");
+  if (verbose)
+    putchar ('\n');
+}
+
 /*******************************************************
  *            Tuning functions for mpfr_ai             *
  *******************************************************/
@@ -1072,6 +1487,9 @@ all (const char *filename)
   fprintf (f, "#define MPFR_MUL_THRESHOLD %lu /* limbs */\n",
            (unsigned long) (mpfr_mul_threshold - 1) / GMP_NUMB_BITS + 1);
 
+  /* Tune the unbalanced short product used by mpfr_mul */
+  tune_mul_nm (f, (mpfr_mul_threshold - 1) / GMP_NUMB_BITS + 1);
+
   /* Tune mpfr_sqr (threshold is in limbs, but it doesn't matter too much) */
   if (verbose)
     printf ("Tuning mpfr_sqr...\n");
@@ -1088,6 +1506,46 @@ all (const char *filename)
   fprintf (f, "#define MPFR_DIV_THRESHOLD %lu /* limbs */\n",
            (unsigned long) (mpfr_div_threshold - 1) / GMP_NUMB_BITS + 1);
 
+  /* Tune the Newton division and square root */
+  if (verbose)
+    printf ("Tuning mpfr_div_newton...\n");
+  tune_newton_func (&mpfr_div_newton_threshold, speed_mpfr_div,
+                    4096, 1 << 22);
+  if (mpfr_div_newton_threshold == MPFR_PREC_MAX)
+    fprintf (f, "#define MPFR_DIV_NEWTON_THRESHOLD MPFR_PREC_MAX"
+             " /* bits */\n");
+  else
+    fprintf (f, "#define MPFR_DIV_NEWTON_THRESHOLD %lu /* bits */\n",
+             (unsigned long) mpfr_div_newton_threshold);
+  if (verbose)
+    printf ("Tuning mpfr_sqrt_newton...\n");
+  tune_newton_func (&mpfr_sqrt_newton_threshold, speed_mpfr_sqrt,
+                    4096, 1 << 22);
+  if (mpfr_sqrt_newton_threshold == MPFR_PREC_MAX)
+    fprintf (f, "#define MPFR_SQRT_NEWTON_THRESHOLD MPFR_PREC_MAX"
+             " /* bits */\n");
+  else
+    fprintf (f, "#define MPFR_SQRT_NEWTON_THRESHOLD %lu /* bits */\n",
+             (unsigned long) mpfr_sqrt_newton_threshold);
+
+  /* Tune the Newton division with a precomputed divisor */
+  if (verbose)
+    printf ("Tuning mpfr_div_by_precomp...\n");
+  tune_newton_func (&mpfr_div_precomp_threshold, speed_mpfr_div_precomp,
+                    4096, 1 << 22);
+  if (mpfr_div_precomp_threshold == MPFR_PREC_MAX)
+    fprintf (f, "#define MPFR_DIV_PRECOMP_THRESHOLD MPFR_PREC_MAX"
+             " /* bits */\n");
+  else
+    fprintf (f, "#define MPFR_DIV_PRECOMP_THRESHOLD %lu /* bits */\n",
+             (unsigned long) mpfr_div_precomp_threshold);
+
+  /* Tune mpfr_mpn_get_str */
+  tune_get_str (f);
+
+  /* Tune mpfr_mpn_set_str */
+  tune_set_str (f);
+
   /* Tune mpfr_exp_2 */
   if (verbose)
     printf ("Tuning mpfr_exp_2...\n");
@@ -1111,6 +1569,35 @@ all (const char *filename)
   fprintf (f, "#define MPFR_SINCOS_THRESHOLD %lu /* bits */\n",
            (unsigned long) mpfr_sincos_threshold);
 
+  /* Tune mpfr_sin */
+  if (verbose)
+    printf ("Tuning mpfr_sin...\n");
+  tune_simple_func (&mpfr_sin_direct_threshold, speed_mpfr_sin,
+                    MPFR_PREC_MIN+GMP_NUMB_BITS);
+  fprintf (f, "#define MPFR_SIN_DIRECT_THRESHOLD %lu /* bits */\n",
+           (unsigned long) mpfr_sin_direct_threshold);
+
+  /* Tune mpfr_atan: the table-based argument reduction is used below
+     the threshold */
+  if (verbose)
+    printf ("Tuning mpfr_atan...\n");
+  tune_simple_func (&mpfr_atan_table_threshold, speed_mpfr_atan,
+                    MPFR_PREC_MIN+GMP_NUMB_BITS);
+  fprintf (f, "#define MPFR_ATAN_TABLE_THRESHOLD %lu /* bits */\n",
+           (unsigned long) mpfr_atan_table_threshold);
+
+  /* Tune mpfr_log: the Newton iteration on mpfr_exp is only faster than
+     the AGM in very high precision, if ever */
+  if (verbose)
+    printf ("Tuning mpfr_log...\n");
+  tune_newton_func (&mpfr_log_threshold, speed_mpfr_log,
+                    1 << 15, 1 << 22);
+  if (mpfr_log_threshold == MPFR_PREC_MAX)
+    fprintf (f, "#define MPFR_LOG_THRESHOLD MPFR_PREC_MAX /* bits */\n");
+  else
+    fprintf (f, "#define MPFR_LOG_THRESHOLD %lu /* bits */\n",
+             (unsigned long) mpfr_log_threshold);
+
   /* Tune mpfr_ai */
   if (verbose)
     printf ("Tuning mpfr_ai...\n");